@@ -166,6 +166,153 @@ done:
     return ret_value;
 } /* end H5DOread_chunk() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5DOwrite_chunks
+ *
+ * Purpose:     Writes several entire chunks to the file directly.
+ *              OFFSETS holds the offsets of the NCHUNKS chunks, one after
+ *              the other, and FILTERS, DATA_SIZES and BUFS the filter
+ *              mask, size and data of each chunk.
+ *
+ *              File space for the chunks is allocated together and
+ *              adjacent chunks are written with one I/O operation.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5DOwrite_chunks(hid_t dset_id, hid_t dxpl_id, size_t nchunks, const uint32_t *filters,
+    const hsize_t *offsets, const size_t *data_sizes, const void **bufs)
+{
+    hbool_t created_dxpl = FALSE;       /* Whether we created a DXPL */
+    hbool_t do_direct_write = TRUE;     /* Flag for direct writes */
+    herr_t  ret_value = FAIL;           /* Return value */
+
+    /* Check arguments */
+    if(dset_id < 0)
+        goto done;
+    if(!nchunks)
+        goto done;
+    if(!filters || !offsets || !data_sizes || !bufs)
+        goto done;
+
+    /* If the user passed in a default DXPL, create one to pass to H5Dwrite() */
+    if(H5P_DEFAULT == dxpl_id) {
+        if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+            goto done;
+        created_dxpl = TRUE;
+    } /* end if */
+
+    /* Set direct write parameters */
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, &do_direct_write) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_NCHUNKS_NAME, &nchunks) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_FILTER_MASKS_NAME, &filters) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_NAME, &offsets) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZES_NAME, &data_sizes) < 0)
+        goto done;
+
+    /* Write chunks */
+    if(H5Dwrite(dset_id, 0, H5S_ALL, H5S_ALL, dxpl_id, bufs) < 0)
+        goto done;
+
+    /* Indicate success */
+    ret_value = SUCCEED;
+
+done:
+    if(created_dxpl) {
+        if(H5Pclose(dxpl_id) < 0)
+            ret_value = FAIL;
+    } /* end if */
+    else if(dxpl_id >= 0) {
+        /* Reset the direct write flag and # of chunks on user DXPL */
+        do_direct_write = FALSE;
+        nchunks = 0;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, &do_direct_write) < 0)
+            ret_value = FAIL;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_NCHUNKS_NAME, &nchunks) < 0)
+            ret_value = FAIL;
+    }
+
+    return ret_value;
+} /* end H5DOwrite_chunks() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5DOread_chunks
+ *
+ * Purpose:     Reads several entire chunks from the file directly.
+ *              OFFSETS holds the offsets of the NCHUNKS chunks, one after
+ *              the other; each chunk is read into its buffer in BUFS and
+ *              its filter mask returned in FILTERS.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5DOread_chunks(hid_t dset_id, hid_t dxpl_id, size_t nchunks, const hsize_t *offsets,
+    uint32_t *filters, void **bufs)
+{
+    hbool_t created_dxpl = FALSE;       /* Whether we created a DXPL */
+    hbool_t do_direct_read = TRUE;      /* Flag for direct reads */
+    herr_t  ret_value = FAIL;           /* Return value */
+
+    /* Check arguments */
+    if(dset_id < 0)
+        goto done;
+    if(!nchunks)
+        goto done;
+    if(!offsets || !filters || !bufs)
+        goto done;
+
+    /* If the user passed in a default DXPL, create one to pass to H5Dread() */
+    if(H5P_DEFAULT == dxpl_id) {
+        if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+            goto done;
+        created_dxpl = TRUE;
+    } /* end if */
+
+    /* Set direct read parameters */
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, &do_direct_read) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_NCHUNKS_NAME, &nchunks) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME, &offsets) < 0)
+        goto done;
+    if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FILTER_MASKS_NAME, &filters) < 0)
+        goto done;
+
+    /* Read chunks */
+    if(H5Dread(dset_id, 0, H5S_ALL, H5S_ALL, dxpl_id, bufs) < 0)
+        goto done;
+
+    /* Indicate success */
+    ret_value = SUCCEED;
+
+done:
+    if(created_dxpl) {
+        if(H5Pclose(dxpl_id) < 0)
+            ret_value = FAIL;
+    } /* end if */
+    else if(dxpl_id >= 0) {
+        /* Reset the direct read flag and # of chunks on user DXPL */
+        do_direct_read = FALSE;
+        nchunks = 0;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME, &do_direct_read) < 0)
+            ret_value = FAIL;
+        if(H5Pset(dxpl_id, H5D_XFER_DIRECT_CHUNK_NCHUNKS_NAME, &nchunks) < 0)
+            ret_value = FAIL;
+    }
+
+    return ret_value;
+} /* end H5DOread_chunks() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5DOappend()
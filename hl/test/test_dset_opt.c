@@ -40,6 +40,9 @@
 #define DATASETNAME10       "read_w_valid_cache"
 #define DATASETNAME11       "unallocated_chunk"
 #define DATASETNAME12       "unfiltered_data"
+/* Datasets for Direct Read/Write tests of several chunks */
+#define DATASETNAME13       "multi_chunks"
+#define DATASETNAME14       "multi_chunks_unfiltered"
 
 #define RANK         2
 #define NX     16
@@ -1968,6 +1971,200 @@ error:
     return 1;
 } /* test_read_unallocated_chunk() */
 
+/*-------------------------------------------------------------------------
+ * Function:    test_multi_chunks
+ *
+ * Purpose:     Test writing and reading several chunks at once with
+ *              H5DOwrite_chunks and H5DOread_chunks, including chunks
+ *              whose filter is skipped, overwriting chunks in place and
+ *              with chunks of a new size, and invalid offsets.
+ *
+ * Return:      Success:        0
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_multi_chunks(hid_t file)
+{
+    hid_t       dataspace = -1, dataset = -1, dataset2 = -1;
+    hid_t       cparms = -1, dxpl = -1;
+    hsize_t     dims[2]  = {NX, NY};
+    hsize_t     maxdims[2] = {H5S_UNLIMITED, H5S_UNLIMITED};
+    hsize_t     chunk_dims[2] = {CHUNK_NX, CHUNK_NY};
+    int         chunks[NX / CHUNK_NX][CHUNK_NX * CHUNK_NY]; /* Filtered chunks written */
+    int         check_chunks[NX / CHUNK_NX][CHUNK_NX * CHUNK_NY]; /* Chunks read */
+    int         check_data[NX][NY];         /* Dataset read */
+    hsize_t     offsets[NX / CHUNK_NX][2];  /* Offsets of chunks */
+    uint32_t    filters[NX / CHUNK_NX];     /* Filter masks of chunks */
+    uint32_t    check_filters[NX / CHUNK_NX];   /* Filter masks read */
+    size_t      sizes[NX / CHUNK_NX];       /* Sizes of chunks */
+    const void  *bufs[NX / CHUNK_NX];       /* Chunks written */
+    void        *check_bufs[NX / CHUNK_NX]; /* Chunks read */
+    size_t      nchunks = NX / CHUNK_NX;    /* # of chunks written at once */
+    size_t      chunk_nbytes = CHUNK_NX * CHUNK_NY * sizeof(int);
+    herr_t      status;
+    size_t      u;
+    int         i, j;
+
+    TESTING("H5DOwrite_chunks and H5DOread_chunks");
+
+    /* Create a dataset with the "bogus1" filter, which adds ADD_ON to each
+     * value written */
+    if((dataspace = H5Screate_simple(RANK, dims, maxdims)) < 0)
+        goto error;
+    if((cparms = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        goto error;
+    if(H5Pset_chunk(cparms, RANK, chunk_dims) < 0)
+        goto error;
+    if(H5Zregister(H5Z_BOGUS1) < 0)
+        goto error;
+    if(H5Pset_filter(cparms, H5Z_FILTER_BOGUS1, 0, (size_t)0, NULL) < 0)
+        goto error;
+    if((dataset = H5Dcreate2(file, DATASETNAME13, H5T_NATIVE_INT, dataspace, H5P_DEFAULT,
+            cparms, H5P_DEFAULT)) < 0)
+        goto error;
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        goto error;
+
+    /* Write the chunks on the diagonal, the last one with its filter skipped */
+    for(u = 0; u < nchunks; u++) {
+        for(i = 0; i < CHUNK_NX * CHUNK_NY; i++)
+            chunks[u][i] = (int)u * 100 + i + ((u < nchunks - 1) ? ADD_ON : 0);
+        offsets[u][0] = offsets[u][1] = u * CHUNK_NX;
+        filters[u] = (u < nchunks - 1) ? 0 : 1;
+        sizes[u] = chunk_nbytes;
+        bufs[u] = chunks[u];
+        check_bufs[u] = check_chunks[u];
+    } /* end for */
+    if(H5DOwrite_chunks(dataset, dxpl, nchunks, filters, &offsets[0][0], sizes, bufs) < 0)
+        goto error;
+
+    /* Read the dataset back through the filter pipeline */
+    if(H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, check_data) < 0)
+        goto error;
+    for(i = 0; i < NX; i++)
+        for(j = 0; j < NY; j++) {
+            int expect = 0;
+
+            if(i / CHUNK_NX == j / CHUNK_NY)
+                expect = (i / CHUNK_NX) * 100 + (i % CHUNK_NX) * CHUNK_NY + (j % CHUNK_NY);
+            if(check_data[i][j] != expect) {
+                HDprintf("    Read different values than written.\n");
+                HDprintf("    At index %d,%d\n", i, j);
+                HDprintf("    expect: %d, got: %d\n", expect, check_data[i][j]);
+                goto error;
+            } /* end if */
+        } /* end for */
+
+    /* Read the raw chunks back, in a different order */
+    for(u = 0; u < nchunks; u++) {
+        offsets[u][0] = offsets[u][1] = (nchunks - 1 - u) * CHUNK_NX;
+        check_bufs[u] = check_chunks[nchunks - 1 - u];
+    } /* end for */
+    if(H5DOread_chunks(dataset, dxpl, nchunks, &offsets[0][0], check_filters, check_bufs) < 0)
+        goto error;
+    for(u = 0; u < nchunks; u++) {
+        if(check_filters[u] != filters[nchunks - 1 - u]) {
+            HDprintf("    Read different filter mask than written for chunk %u.\n", (unsigned)u);
+            goto error;
+        } /* end if */
+        if(HDmemcmp(check_chunks[u], chunks[u], chunk_nbytes)) {
+            HDprintf("    Read different chunk than written for chunk %u.\n", (unsigned)u);
+            goto error;
+        } /* end if */
+    } /* end for */
+
+    /* Overwrite two chunks, one in place and one with a chunk of a new
+     * size, and write a new chunk */
+    for(i = 0; i < CHUNK_NX * CHUNK_NY; i++) {
+        chunks[0][i] = -i + ADD_ON;
+        chunks[1][i] = 2 * i;
+        chunks[2][i] = 3 * i + ADD_ON;
+    } /* end for */
+    offsets[0][0] = offsets[0][1] = 0;
+    offsets[1][0] = offsets[1][1] = CHUNK_NX;
+    offsets[2][0] = 0; offsets[2][1] = CHUNK_NY;
+    sizes[1] = chunk_nbytes / 2;
+    filters[0] = filters[1] = filters[2] = 0;
+    if(H5DOwrite_chunks(dataset, dxpl, (size_t)3, filters, &offsets[0][0], sizes, bufs) < 0)
+        goto error;
+    for(u = 0; u < nchunks; u++)
+        check_bufs[u] = check_chunks[u];
+    HDmemset(check_chunks, 0, sizeof(check_chunks));
+    if(H5DOread_chunks(dataset, H5P_DEFAULT, (size_t)3, &offsets[0][0], check_filters, check_bufs) < 0)
+        goto error;
+    for(u = 0; u < 3; u++)
+        if(check_filters[u] != 0 || HDmemcmp(check_chunks[u], chunks[u], sizes[u])) {
+            HDprintf("    Read different chunk than written for chunk %u.\n", (unsigned)u);
+            goto error;
+        } /* end if */
+    sizes[1] = chunk_nbytes;
+
+    /* Chunks given twice and offsets off the chunk boundaries must fail */
+    offsets[1][0] = offsets[1][1] = 0;
+    H5E_BEGIN_TRY {
+        status = H5DOwrite_chunks(dataset, dxpl, (size_t)2, filters, &offsets[0][0], sizes, bufs);
+    } H5E_END_TRY;
+    if(status != FAIL)
+        goto error;
+    offsets[1][0] = 1;
+    H5E_BEGIN_TRY {
+        status = H5DOread_chunks(dataset, dxpl, (size_t)2, &offsets[0][0], check_filters, check_bufs);
+    } H5E_END_TRY;
+    if(status != FAIL)
+        goto error;
+
+    /* The direct read properties must have been reset on the user's DXPL */
+    if(H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, check_data) < 0)
+        goto error;
+    if(check_data[0][CHUNK_NY + 1] != 3)
+        goto error;
+
+    /* Unfiltered chunks must be the dataset's chunk size */
+    if(H5Premove_filter(cparms, H5Z_FILTER_ALL) < 0)
+        goto error;
+    if((dataset2 = H5Dcreate2(file, DATASETNAME14, H5T_NATIVE_INT, dataspace, H5P_DEFAULT,
+            cparms, H5P_DEFAULT)) < 0)
+        goto error;
+    for(u = 0; u < nchunks; u++)
+        offsets[u][0] = offsets[u][1] = u * CHUNK_NX;
+    if(H5DOwrite_chunks(dataset2, H5P_DEFAULT, nchunks, filters, &offsets[0][0], sizes, bufs) < 0)
+        goto error;
+    sizes[0] = chunk_nbytes / 2;
+    H5E_BEGIN_TRY {
+        status = H5DOwrite_chunks(dataset2, H5P_DEFAULT, nchunks, filters, &offsets[0][0], sizes, bufs);
+    } H5E_END_TRY;
+    if(status != FAIL)
+        goto error;
+    if(H5Dread(dataset2, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, check_data) < 0)
+        goto error;
+    if(check_data[CHUNK_NX][CHUNK_NY + 1] != 2 || check_data[2 * CHUNK_NX][2 * CHUNK_NY + 1] != 3 * 1 + ADD_ON)
+        goto error;
+
+    /* Close/release resources. */
+    H5Dclose(dataset);
+    H5Dclose(dataset2);
+    H5Sclose(dataspace);
+    H5Pclose(cparms);
+    H5Pclose(dxpl);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Dclose(dataset2);
+        H5Sclose(dataspace);
+        H5Pclose(cparms);
+        H5Pclose(dxpl);
+    } H5E_END_TRY;
+
+    H5_FAILED();
+    return 1;
+} /* test_multi_chunks() */
+
 /*-------------------------------------------------------------------------
  * Function:	Main function
  *
@@ -2012,6 +2209,9 @@ int main( void )
     nerrors += test_read_unfiltered_dset(file_id);
     nerrors += test_read_unallocated_chunk(file_id);
 
+    /* Test direct read and write of several chunks */
+    nerrors += test_multi_chunks(file_id);
+
     if(H5Fclose(file_id) < 0)
         goto error;
 
@@ -632,18 +632,22 @@ done:
 static H5B_ins_t
 H5D__btree_remove(H5F_t *f, hid_t dxpl_id, haddr_t addr, void *_lt_key /*in,out */ ,
 	hbool_t *lt_key_changed /*out */ ,
-	void H5_ATTR_UNUSED * _udata /*in,out */ ,
+	void *_udata /*in,out */ ,
 	void H5_ATTR_UNUSED * _rt_key /*in,out */ ,
 	hbool_t *rt_key_changed /*out */ )
 {
     H5D_btree_key_t    *lt_key = (H5D_btree_key_t *)_lt_key;
+    H5D_chunk_common_ud_t *udata = (H5D_chunk_common_ud_t *)_udata;
     H5B_ins_t ret_value=H5B_INS_REMOVE; /* Return value */
 
     FUNC_ENTER_STATIC
 
+    HDassert(udata);
+    HDassert(udata->storage);
+
     /* Remove raw data chunk from file */
     H5_CHECK_OVERFLOW(lt_key->nbytes, uint32_t, hsize_t);
-    if(H5MF_xfree(f, H5FD_MEM_DRAW, dxpl_id, addr, (hsize_t)lt_key->nbytes) < 0)
+    if(H5D__chunk_free_block(f, dxpl_id, udata->storage, addr, (hsize_t)lt_key->nbytes) < 0)
 	HGOTO_ERROR(H5E_STORAGE, H5E_CANTFREE, H5B_INS_ERROR, "unable to free chunk")
 
     /* Mark keys as unchanged */
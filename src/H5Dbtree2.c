@@ -64,6 +64,7 @@ typedef struct H5D_bt2_ctx_t {
 typedef struct H5D_bt2_remove_ud_t {
     H5F_t *f;                   /* File pointer for operation */
     hid_t dxpl_id;              /* DXPL ID for operation */
+    const H5O_storage_chunk_t *storage; /* Chunked storage of the dataset */
 } H5D_bt2_remove_ud_t;
 
 /* Callback info for iteration over chunks in v2 B-tree */
@@ -1193,7 +1194,7 @@ H5D__bt2_remove_cb(const void *_record, void *_udata)
 
     /* Free the space in the file for the object being removed */
     H5_CHECK_OVERFLOW(record->nbytes, uint32_t, hsize_t);
-    if(H5MF_xfree(udata->f, H5FD_MEM_DRAW, udata->dxpl_id, record->chunk_addr, (hsize_t)record->nbytes) < 0)
+    if(H5D__chunk_free_block(udata->f, udata->dxpl_id, udata->storage, record->chunk_addr, (hsize_t)record->nbytes) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
 
 done:
@@ -1248,6 +1249,7 @@ H5D__bt2_idx_remove(const H5D_chk_idx_info_t *idx_info, H5D_chunk_common_ud_t *u
     /* Initialize user data for removal callback */
     remove_udata.f = idx_info->f;
     remove_udata.dxpl_id = idx_info->dxpl_id;
+    remove_udata.storage = idx_info->storage;
 
     /* Prepare user data for compare callback */
     bt2_udata.ndims = idx_info->layout->ndims - 1;
@@ -1314,6 +1316,7 @@ H5D__bt2_idx_delete(const H5D_chk_idx_info_t *idx_info)
 	/* Initialize user data for removal callback */
 	remove_udata.f = idx_info->f;
 	remove_udata.dxpl_id = idx_info->dxpl_id;
+	remove_udata.storage = idx_info->storage;
 
 	/* Set remove operation.  Do not remove chunks in SWMR_WRITE mode */
         if(H5F_INTENT(idx_info->f) & H5F_ACC_SWMR_WRITE)
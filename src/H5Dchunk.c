@@ -111,6 +111,43 @@
 #define H5D_RDCC_NEWLY_DISABLED_FILTERS 0x02u   /* Filters have been disabled since
                                                  * the last flush */
 
+/* Number of slots in each set of the chunk cache's hash table: a chunk may
+ * be cached in any slot of the set its coordinates hash to */
+#define H5D_CHUNK_CACHE_NWAYS 8
+
+/* Number of chunk accesses between decisions whether to resize the chunk
+ * cache, and the hit rate below which a full cache is grown, when the cache
+ * is resized automatically (see H5Pset_chunk_cache_resize) */
+#define H5D_CHUNK_CACHE_RESIZE_EPOCH 256
+#define H5D_CHUNK_CACHE_RESIZE_HIT_RATE 0.9
+
+/* Number of chunks fetched in each batch, per thread unfiltering them, when
+ * reading filtered chunks in batches (see H5Pset_chunk_filter_nthreads) */
+#define H5D_CHUNK_FILTER_BATCH_PER_THREAD 4
+
+/* Largest number of bytes of adjacent chunks read or written directly with
+ * one I/O operation, through a temporary buffer */
+#define H5D_CHUNK_DIRECT_COALESCE_MAX (4 * 1024 * 1024)
+
+/* Number of chunks which must be read in sequence (with the same stride
+ * between their indices) before chunks are read ahead */
+#define H5D_CHUNK_READ_AHEAD_NSEQ 3
+
+/* The selected chunks are looked up with a single pass over the chunk index,
+ * instead of one search per chunk, when at least this many chunks are
+ * selected and they are at least 1/H5D_CHUNK_LOOKUP_BATCH_DENSITY of the
+ * chunks in the dataset.  The chunks removed when a dataset shrinks are
+ * found the same way. */
+#define H5D_CHUNK_LOOKUP_BATCH_MIN 8
+#define H5D_CHUNK_LOOKUP_BATCH_DENSITY 4
+
+/* Chunks may only be unfiltered on worker threads when the library is
+ * thread-safe (so that each thread has its own error stack) and the memory
+ * allocator keeps no shared state of its own */
+#if defined(H5_HAVE_THREADSAFE) && !defined(H5_MEMORY_ALLOC_SANITY_CHECK)
+#define H5D_CHUNK_FILTER_THREADS
+#endif /* H5_HAVE_THREADSAFE && !H5_MEMORY_ALLOC_SANITY_CHECK */
+
 
 /******************/
 /* Local Typedefs */
@@ -128,14 +165,52 @@ typedef struct H5D_rdcc_ent_t {
     H5F_block_t chunk_block;    /*offset/length of chunk in file        */
     hsize_t     chunk_idx;  	/*index of chunk in dataset             */
     uint8_t	*chunk;		/*the unfiltered chunk data		*/
+    void	*filtered;	/*chunk data with filters applied, ahead of flush */
+    size_t	filtered_nbytes; /*size of filtered chunk data		*/
+    unsigned	filtered_mask;	/*filter mask of filtered chunk data	*/
+    void	*image;		/*filtered image of chunk as stored in file, moved to second tier on eviction */
     unsigned	idx;		/*index in hash table			*/
+    uint64_t	tick;		/*cache tick of last access		*/
     struct H5D_rdcc_ent_t *next;/*next item in doubly-linked list	*/
     struct H5D_rdcc_ent_t *prev;/*previous item in doubly-linked list	*/
     struct H5D_rdcc_ent_t *tmp_next;/*next item in temporary doubly-linked list */
     struct H5D_rdcc_ent_t *tmp_prev;/*previous item in temporary doubly-linked list */
+    struct H5D_rdcc_ent_t *pool_next;/*next item in file-wide pool list	*/
+    struct H5D_rdcc_ent_t *pool_prev;/*previous item in file-wide pool list */
+    const H5D_t *dset;		/*open dataset which cached the entry	*/
 } H5D_rdcc_ent_t;
 typedef H5D_rdcc_ent_t *H5D_rdcc_ent_ptr_t; /* For free lists */
 
+/* Filtered image of a chunk as stored in the file, kept in the second tier
+ * of the chunk cache after the chunk was evicted from the first, so that the
+ * chunk can be brought back into the cache without reading it again */
+typedef struct H5D_rdcc_img_t {
+    haddr_t	addr;		/*address of chunk in file		*/
+    size_t	nbytes;		/*size of filtered chunk		*/
+    hsize_t 	scaled[H5O_LAYOUT_NDIMS]; /*scaled chunk 'name' (coordinates) */
+    void	*image;		/*the filtered chunk data		*/
+    struct H5D_rdcc_img_t *next;/*next (more recently used) image	*/
+    struct H5D_rdcc_img_t *prev;/*previous (less recently used) image	*/
+} H5D_rdcc_img_t;
+
+/* Block in the file holding one or more identical chunks of a dataset whose
+ * chunks are deduplicated */
+typedef struct H5D_chunk_dedup_ent_t {
+    haddr_t	addr;		/*address of block in file		*/
+    hsize_t	nbytes;		/*size of block				*/
+    unsigned	nrefs;		/*number of chunks stored in the block	*/
+    hbool_t	hashed;		/*whether the block's contents are hashed */
+    unsigned	hash;		/*hash of the block's contents		*/
+    unsigned	filter_mask;	/*filters skipped for the contents	*/
+    struct H5D_chunk_dedup_ent_t *hash_next; /*next block with same hash */
+} H5D_chunk_dedup_ent_t;
+
+/* Blocks of a dataset whose chunks are deduplicated */
+typedef struct H5D_chunk_dedup_t {
+    H5SL_t	*blocks;	/*all blocks, by address		*/
+    H5SL_t	*hashes;	/*first hashed block, by hash		*/
+} H5D_chunk_dedup_t;
+
 /* Callback info for iteration to prune chunks */
 typedef struct H5D_chunk_it_ud1_t {
     H5D_chunk_common_ud_t common;       /* Common info for B-tree user data (must be first) */
@@ -209,6 +284,45 @@ typedef struct H5D_chunk_it_ud5_t {
     hsize_t       	*dset_dims;             /* Dataset dimensions */
 } H5D_chunk_it_ud5_t;
 
+/* Callback info for iteration to return information about chunks */
+typedef struct H5D_chunk_it_ud6_t {
+    unsigned            ndims;                  /* Number of dimensions of dataset */
+    const uint32_t      *chunk_dim;             /* Chunk dimensions */
+    hsize_t             offset[H5O_LAYOUT_NDIMS];   /* Logical offset of current chunk */
+
+    /* needed for H5Dchunk_iter */
+    H5D_chunk_iter_op_t op;                     /* Application callback */
+    void                *op_data;               /* Application data for callback */
+
+    /* needed for H5Dget_num_chunks and H5Dget_chunk_info */
+    hsize_t             idx;                    /* Index of current chunk */
+    hsize_t             start;                  /* Index of first chunk to return information about */
+    hsize_t             nchunks;                /* Number of chunks to return information about */
+    hsize_t             *offsets;               /* Logical offsets of chunks */
+    unsigned            *filter_masks;          /* Filter masks of chunks */
+    haddr_t             *addrs;                 /* File addresses of chunks */
+    hsize_t             *sizes;                 /* Sizes of chunks in file */
+} H5D_chunk_it_ud6_t;
+
+/* Callback info for iteration to find the chunks outside a dataset's new
+ * extent */
+typedef struct H5D_chunk_it_ud7_t {
+    unsigned            ndims;                  /* Number of dimensions of dataset */
+    const uint32_t      *chunk_dim;             /* Chunk dimensions */
+    const hsize_t       *space_dim;             /* New dataset dimensions */
+    size_t              nused;                  /* Number of chunks found */
+    size_t              nalloc;                 /* Number of chunks with room in 'scaled' */
+    hsize_t             *scaled;                /* Scaled offsets of chunks found (ndims + 1 each) */
+} H5D_chunk_it_ud7_t;
+
+/* File space of chunks removed from the index, freed together once the
+ * chunks have all been removed */
+typedef struct H5D_chunk_free_batch_t {
+    size_t              nused;                  /* Number of blocks */
+    size_t              nalloc;                 /* Number of blocks with room in 'blocks' */
+    H5F_block_t         *blocks;                /* Blocks to free */
+} H5D_chunk_free_batch_t;
+
 /* Callback info for nonexistent readvv operation */
 typedef struct H5D_chunk_readvv_ud_t {
     unsigned char *rbuf;        /* Read buffer to initialize */
@@ -224,6 +338,57 @@ typedef struct H5D_chunk_file_iter_ud_t {
 #endif /* H5_HAVE_PARALLEL */
 } H5D_chunk_file_iter_ud_t;
 
+/* Callback info for looking up the selected chunks with one pass over the
+ * chunk index */
+typedef struct H5D_chunk_lookup_batch_ud_t {
+    const H5D_chunk_map_t *fm;          /* Chunk map, holding the selected chunks */
+    const H5O_layout_chunk_t *layout;   /* Chunked layout info */
+    unsigned ndims;                     /* Rank of dataset */
+} H5D_chunk_lookup_batch_ud_t;
+
+/* A chunk looked up (and possibly read & unfiltered) ahead of the main read
+ * loop, when reading filtered chunks in batches */
+typedef struct H5D_chunk_prefetch_t {
+    const H5D_chunk_info_t *chunk_info; /* Chunk's selection information */
+    H5D_chunk_ud_t      udata;          /* Chunk's location in the file */
+    size_t              nbytes;         /* Size of chunk's data in buffer */
+    size_t              buf_size;       /* Size of buffer */
+    void                *buf;           /* Unfiltered chunk (NULL if not prefetched) */
+    void                *image;         /* Filtered image of chunk, for second tier of cache (or NULL) */
+    hsize_t             scaled[H5O_LAYOUT_NDIMS]; /* Chunk's scaled coordinates, when read ahead */
+} H5D_chunk_prefetch_t;
+
+/* A chunk read or written directly, with others, by
+ * H5D__chunk_direct_read_multi or H5D__chunk_direct_write_multi */
+typedef struct H5D_chunk_direct_t {
+    size_t              idx;            /* Index of chunk in caller's arrays */
+    hsize_t             scaled[H5O_LAYOUT_NDIMS]; /* Chunk's scaled coordinates */
+    H5D_chunk_ud_t      udata;          /* Chunk's location in the file */
+    hbool_t             need_insert;    /* Whether the chunk needs to be inserted into the index */
+    H5F_block_t         old_block;      /* File space to release once the chunk has new space */
+} H5D_chunk_direct_t;
+
+/* A batch of chunks, in the order they appear in the chunk map */
+typedef struct H5D_chunk_batch_t {
+    const H5O_pline_t   *pline;         /* I/O pipeline of dataset */
+    H5Z_EDC_t           err_detect;     /* Error detection setting */
+    H5Z_cb_t            filter_cb;      /* Filter failure callback */
+    unsigned            nthreads;       /* # of threads for unfiltering chunks */
+    size_t              max_chunks;     /* Size of 'chunk' array */
+    size_t              nchunks;        /* # of chunks in current batch */
+    size_t              curr;           /* Next chunk in batch to be read */
+    H5D_chunk_prefetch_t *chunk;        /* Chunks in batch */
+} H5D_chunk_batch_t;
+
+/* Batch of dirty chunk cache entries, filtered ahead of being flushed */
+typedef struct H5D_chunk_flush_batch_t {
+    const H5O_pline_t   *pline;         /* I/O pipeline info */
+    H5Z_EDC_t           err_detect;     /* Error detection info */
+    size_t              chunk_size;     /* Size of a chunk, unfiltered */
+    size_t              nents;          /* # of entries in batch */
+    H5D_rdcc_ent_t      **ent;          /* Entries in batch */
+} H5D_chunk_flush_batch_t;
+
 #ifdef H5_HAVE_PARALLEL
 /* information to construct a collective I/O operation for filling chunks */
 typedef struct H5D_chunk_coll_info_t {
@@ -270,6 +435,12 @@ static void *H5D__chunk_mem_xfree(void *chk, const H5O_pline_t *pline);
 static void *H5D__chunk_mem_realloc(void *chk, size_t size,
     const H5O_pline_t *pline);
 static herr_t H5D__chunk_cinfo_cache_reset(H5D_chunk_cached_t *last);
+static hbool_t H5D__chunk_addr_map_usable(const H5D_t *dset);
+static int H5D__chunk_addr_map_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
+static herr_t H5D__chunk_addr_map_build(const H5D_t *dset, hid_t dxpl_id);
+static void H5D__chunk_addr_map_reset(H5D_rdcc_t *rdcc);
+static void H5D__chunk_addr_map_set(const H5D_t *dset, const hsize_t *scaled,
+    haddr_t addr, hsize_t nbytes, unsigned filter_mask);
 static herr_t H5D__chunk_cinfo_cache_update(H5D_chunk_cached_t *last,
     const H5D_chunk_ud_t *udata);
 static hbool_t H5D__chunk_cinfo_cache_found(const H5D_chunk_cached_t *last,
@@ -285,23 +456,96 @@ static herr_t H5D__chunk_file_cb(void *elem, const H5T_t *type, unsigned ndims,
 static herr_t H5D__chunk_mem_cb(void *elem, const H5T_t *type, unsigned ndims,
     const hsize_t *coords, void *fm);
 static unsigned H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled);
+static unsigned H5D__chunk_cache_find(const H5D_shared_t *shared, const hsize_t *scaled);
+static unsigned H5D__chunk_cache_victim(const H5D_rdcc_t *rdcc, unsigned set);
+static herr_t H5D__chunk_cache_rehash(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache);
+static herr_t H5D__chunk_cache_resize(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, size_t nbytes_max);
+static herr_t H5D__chunk_cache_adapt(const H5D_io_info_t *io_info);
+static void *H5D__chunk_image_take(const H5D_t *dset, haddr_t addr,
+    const hsize_t *scaled, size_t nbytes);
+static herr_t H5D__chunk_image_put(const H5D_t *dset, haddr_t addr,
+    const hsize_t *scaled, size_t nbytes, void *image);
+static void H5D__chunk_image_remove(const H5D_t *dset, haddr_t addr);
+static void H5D__chunk_image_reset(H5D_rdcc_t *rdcc);
+static void H5D__chunk_image_attach(const H5D_t *dset, H5D_rdcc_ent_t *ent,
+    void *image);
+static void *H5D__chunk_image_detach(H5D_rdcc_t *rdcc, H5D_rdcc_ent_t *ent);
 static herr_t H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t reset);
 static herr_t H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *ent, hbool_t flush);
+static herr_t H5D__chunk_flush_filter_batch(const H5D_t *dset,
+    const H5D_dxpl_cache_t *dxpl_cache, H5D_rdcc_ent_t *start,
+    H5D_rdcc_ent_t **end);
+static void *H5D__chunk_filtered_take(H5D_rdcc_t *rdcc, H5D_rdcc_ent_t *ent);
+#ifdef H5D_CHUNK_FILTER_THREADS
+static herr_t H5D__chunk_flush_filter(size_t idx, void *_batch);
+#endif /* H5D_CHUNK_FILTER_THREADS */
 static hbool_t H5D__chunk_is_partial_edge_chunk(unsigned dset_ndims,
     const uint32_t *chunk_dims, const hsize_t *chunk_scaled, const hsize_t *dset_dims);
 static void *H5D__chunk_lock(const H5D_io_info_t *io_info,
-    H5D_chunk_ud_t *udata, hbool_t relax, hbool_t prev_unfilt_chunk);
+    H5D_chunk_ud_t *udata, hbool_t relax, hbool_t prev_unfilt_chunk,
+    H5D_chunk_prefetch_t *prefetch);
 static herr_t H5D__chunk_unlock(const H5D_io_info_t *io_info,
     const H5D_chunk_ud_t *udata, hbool_t dirty, void *chunk,
     uint32_t naccessed);
 static herr_t H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
     const H5D_dxpl_cache_t *dxpl_cache, size_t size);
+static void H5D__chunk_pool_append(H5D_rdcc_pool_t *pool, H5D_rdcc_ent_t *ent);
+static void H5D__chunk_pool_remove(H5D_rdcc_pool_t *pool, H5D_rdcc_ent_t *ent);
+static herr_t H5D__chunk_pool_prune(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, size_t size);
+static herr_t H5D__chunk_prefetch(const H5D_io_info_t *io_info,
+    const H5D_chunk_map_t *fm, H5SL_node_t *chunk_node, H5D_chunk_batch_t *batch);
+static herr_t H5D__chunk_prefetch_unfilter(size_t idx, void *_batch);
+static herr_t H5D__chunk_prefetch_read(const H5D_io_info_t *io_info,
+    H5D_chunk_batch_t *batch, H5D_chunk_prefetch_t **read_order, size_t nread);
+static herr_t H5D__chunk_read_ahead(const H5D_io_info_t *io_info);
+static int H5D__chunk_lookup_batch_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
+static herr_t H5D__chunk_lookup_batch(const H5D_io_info_t *io_info,
+    H5D_chunk_map_t *fm);
+static herr_t H5D__chunk_lookup_sel(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_chunk_map_t *fm, const H5D_chunk_info_t *chunk_info,
+    H5D_chunk_ud_t *udata);
+static int H5D__chunk_prefetch_cmp(const void *_pf1, const void *_pf2);
+static int H5D__chunk_direct_cmp_scaled(const void *_chk1, const void *_chk2);
+static int H5D__chunk_direct_cmp_addr(const void *_chk1, const void *_chk2);
+static herr_t H5D__chunk_direct_init(const H5D_t *dset, size_t nchunks,
+    const hsize_t offsets[], H5D_chunk_direct_t **chunks, H5D_chunk_direct_t ***order);
+static herr_t H5D__chunk_check_size(const H5D_chk_idx_info_t *idx_info, hsize_t length);
+static htri_t H5D__chunk_stream_write(const H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, H5D_chunk_info_t *chunk_info,
+    H5D_chunk_ud_t *udata);
 static herr_t H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata, hbool_t new_unfilt_chunk);
+static hbool_t H5D__chunk_prune_is_outside(unsigned ndims, const uint32_t *chunk_dim,
+    const hsize_t *scaled, const hsize_t *space_dim);
+static herr_t H5D__chunk_prune_add(H5D_chunk_it_ud7_t *udata, const hsize_t *scaled);
+static int H5D__chunk_prune_find_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
+static herr_t H5D__chunk_prune_remove(H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, const H5D_chk_idx_info_t *idx_info,
+    const hsize_t *old_dim);
+static int H5D__chunk_free_batch_cmp(const void *_blk1, const void *_blk2);
 static herr_t H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info,
     const H5F_block_t *old_chunk, H5F_block_t *new_chunk, hbool_t *need_insert,
     hsize_t scaled[]);
+static H5D_chunk_dedup_ent_t *H5D__chunk_dedup_add(H5D_chunk_dedup_t *dedup,
+    haddr_t addr, hsize_t nbytes);
+static herr_t H5D__chunk_dedup_unhash(H5D_chunk_dedup_t *dedup,
+    H5D_chunk_dedup_ent_t *blk);
+static int H5D__chunk_dedup_build_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
+static herr_t H5D__chunk_dedup_free_cb(void *item, void *key, void *op_data);
+static herr_t H5D__chunk_dedup_create(const H5D_chk_idx_info_t *idx_info);
+static herr_t H5D__chunk_dedup_load(const H5D_chk_idx_info_t *idx_info);
+static herr_t H5D__chunk_dedup_dest(H5O_storage_chunk_t *storage);
+static hbool_t H5D__chunk_dedup_is_shared(const H5O_storage_chunk_t *storage,
+    haddr_t addr);
+static herr_t H5D__chunk_dedup_find(const H5D_t *dset, unsigned hash,
+    unsigned filter_mask, const void *buf, size_t nbytes,
+    H5D_chunk_dedup_ent_t **found);
+static herr_t H5D__chunk_dedup_set_hash(H5D_chunk_dedup_t *dedup, haddr_t addr,
+    hsize_t nbytes, unsigned hash, unsigned filter_mask);
 #ifdef H5_HAVE_PARALLEL
 static herr_t H5D__chunk_collective_fill(const H5D_t *dset, hid_t dxpl_id,
     H5D_chunk_coll_info_t *chunk_info, size_t chunk_size, const void *fill_buf);
@@ -309,6 +553,10 @@ static herr_t H5D__chunk_collective_fill(const H5D_t *dset, hid_t dxpl_id,
 
 static int
 H5D__chunk_dump_index_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
+static int H5D__chunk_iter_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
+static int H5D__chunk_info_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
+static int H5D__chunk_iter_real(H5D_t *dset, hid_t dxpl_id, H5D_chunk_cb_func_t cb,
+    H5D_chunk_it_ud6_t *udata);
 
 /*********************/
 /* Package Variables */
@@ -363,6 +611,19 @@ H5FL_SEQ_DEFINE_STATIC(H5D_rdcc_ent_ptr_t);
 /* Declare a free list to manage H5D_rdcc_ent_t objects */
 H5FL_DEFINE_STATIC(H5D_rdcc_ent_t);
 
+/* Declare a free list to manage H5D_rdcc_pool_t objects */
+H5FL_DEFINE_STATIC(H5D_rdcc_pool_t);
+
+/* Declare a free list to manage in-memory copies of chunk indices */
+H5FL_SEQ_DEFINE_STATIC(H5D_chunk_addr_t);
+
+/* Declare a free list to manage H5D_rdcc_img_t objects */
+H5FL_DEFINE_STATIC(H5D_rdcc_img_t);
+
+/* Declare free lists to manage the blocks of deduplicated datasets */
+H5FL_DEFINE_STATIC(H5D_chunk_dedup_t);
+H5FL_DEFINE_STATIC(H5D_chunk_dedup_ent_t);
+
 /* Declare a free list to manage the H5D_chunk_info_t struct */
 H5FL_DEFINE(H5D_chunk_info_t);
 
@@ -435,6 +696,9 @@ H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters,
     old_chunk.offset = udata.chunk_block.offset;
     old_chunk.length = udata.chunk_block.length;
 
+    /* Discard the old chunk's filtered image from the chunk cache */
+    H5D__chunk_image_remove(dset, old_chunk.offset);
+
     /* Check if the chunk needs to be inserted (it also could exist already
      *      and the chunk allocate operation could resize it)
      */
@@ -483,6 +747,7 @@ H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters,
     /* Write the data to the file */
     if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, data_size, io_info.raw_dxpl_id, buf) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+    dset->shared->cache.chunk.stats.nbytes_written += data_size;
 
     /* Insert the chunk record into the index */
     if(need_insert && layout->storage.u.chunk.ops->insert) {
@@ -491,6 +756,7 @@ H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t filters,
 
         if((layout->storage.u.chunk.ops->insert)(&idx_info, &udata, NULL) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+        H5D__chunk_addr_map_set(dset, scaled, udata.chunk_block.offset, udata.chunk_block.length, filters);
     } /* end if */
 
 done:
@@ -577,7 +843,7 @@ H5D__chunk_direct_read(const H5D_t *dset, hid_t dxpl_id, hsize_t *offset,
         hbool_t flush;
 
         /* Sanity checks  */
-        HDassert(udata.idx_hint < rdcc->nslots);
+        HDassert(udata.idx_hint < rdcc->nsets * rdcc->nways);
         HDassert(rdcc->slot[udata.idx_hint]);
 
         flush = (ent->dirty == TRUE) ? TRUE : FALSE;
@@ -608,6 +874,7 @@ H5D__chunk_direct_read(const H5D_t *dset, hid_t dxpl_id, hsize_t *offset,
     /* Read the chunk data into the supplied buffer */
     if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, udata.chunk_block.length, io_info.raw_dxpl_id, buf) < 0)
         HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+    dset->shared->cache.chunk.stats.nbytes_read += udata.chunk_block.length;
     
     /* Return the filter mask */
     *filters = udata.filter_mask;
@@ -620,6 +887,511 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_direct_read() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_direct_cmp_scaled
+ *
+ * Purpose:     Compare the scaled coordinates of two chunks read or
+ *              written directly, for finding chunks given twice.
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_direct_cmp_scaled(const void *_chk1, const void *_chk2)
+{
+    const H5D_chunk_direct_t *chk1 = *(const H5D_chunk_direct_t * const *)_chk1;
+    const H5D_chunk_direct_t *chk2 = *(const H5D_chunk_direct_t * const *)_chk2;
+    unsigned u;
+    int ret_value = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < H5O_LAYOUT_NDIMS && 0 == ret_value; u++)
+        if(chk1->scaled[u] < chk2->scaled[u])
+            ret_value = -1;
+        else if(chk1->scaled[u] > chk2->scaled[u])
+            ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_direct_cmp_scaled() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_direct_cmp_addr
+ *
+ * Purpose:     Compare the file addresses of two chunks read or written
+ *              directly, for sorting them into the order of their I/O.
+ *
+ * Return:      -1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_direct_cmp_addr(const void *_chk1, const void *_chk2)
+{
+    const H5D_chunk_direct_t *chk1 = *(const H5D_chunk_direct_t * const *)_chk1;
+    const H5D_chunk_direct_t *chk2 = *(const H5D_chunk_direct_t * const *)_chk2;
+    int ret_value = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(H5F_addr_lt(chk1->udata.chunk_block.offset, chk2->udata.chunk_block.offset))
+        ret_value = -1;
+    else if(H5F_addr_gt(chk1->udata.chunk_block.offset, chk2->udata.chunk_block.offset))
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_direct_cmp_addr() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_direct_init
+ *
+ * Purpose:     Set up the chunks read or written directly, from their
+ *              offsets in the dataset (NCHUNKS arrays of the dataset's
+ *              rank, one after the other), checking that the offsets are
+ *              valid and that no chunk is given twice.
+ *
+ *              The chunks are returned in *CHUNKS, in the caller's order,
+ *              and pointers to them in *ORDER.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_direct_init(const H5D_t *dset, size_t nchunks, const hsize_t offsets[],
+    H5D_chunk_direct_t **chunks, H5D_chunk_direct_t ***order)
+{
+    unsigned    ndims = dset->shared->ndims;    /* Rank of dataset */
+    size_t      u;                      /* Local index variable */
+    unsigned    v;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(nchunks > 0);
+    HDassert(chunks && order);
+
+    if(NULL == offsets)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk offsets")
+    if(NULL == (*chunks = (H5D_chunk_direct_t *)H5MM_calloc(nchunks * sizeof(H5D_chunk_direct_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunks")
+    if(NULL == (*order = (H5D_chunk_direct_t **)H5MM_malloc(nchunks * sizeof(H5D_chunk_direct_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk order")
+
+    for(u = 0; u < nchunks; u++) {
+        const hsize_t *offset = &offsets[u * ndims];
+        H5D_chunk_direct_t *chk = &(*chunks)[u];
+
+        for(v = 0; v < ndims; v++) {
+            /* Make sure the offset doesn't exceed the dataset's dimensions */
+            if(offset[v] > dset->shared->curr_dims[v])
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL, "offset exceeds dimensions of dataset")
+
+            /* Make sure the offset fall right on a chunk's boundary */
+            if(offset[v] % dset->shared->layout.u.chunk.dim[v])
+                HGOTO_ERROR(H5E_DATASPACE, H5E_BADTYPE, FAIL, "offset doesn't fall on chunks's boundary")
+
+            chk->scaled[v] = offset[v] / dset->shared->layout.u.chunk.dim[v];
+        } /* end for */
+        chk->idx = u;
+        (*order)[u] = chk;
+    } /* end for */
+
+    /* Check for chunks given more than once */
+    HDqsort(*order, nchunks, sizeof(H5D_chunk_direct_t *), H5D__chunk_direct_cmp_scaled);
+    for(u = 1; u < nchunks; u++)
+        if(0 == H5D__chunk_direct_cmp_scaled(&(*order)[u - 1], &(*order)[u]))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "chunk given more than once")
+
+done:
+    if(ret_value < 0) {
+        *chunks = (H5D_chunk_direct_t *)H5MM_xfree(*chunks);
+        *order = (H5D_chunk_direct_t **)H5MM_xfree(*order);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_direct_init() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_direct_write_multi
+ *
+ * Purpose:     Internal routine to write several chunks directly into the
+ *              file.  OFFSETS holds the offsets of the NCHUNKS chunks,
+ *              one after the other, and FILTERS, DATA_SIZES and BUFS the
+ *              filter mask, size and data of each.
+ *
+ *              File space for all the chunks which need it is allocated
+ *              together, and the chunks are written in order of their
+ *              addresses, combining adjacent chunks into one write.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_direct_write_multi(const H5D_t *dset, hid_t dxpl_id, size_t nchunks,
+    const uint32_t filters[], const hsize_t offsets[], const size_t data_sizes[],
+    const void * const bufs[])
+{
+    const H5O_layout_t *layout = &(dset->shared->layout);       /* Dataset layout */
+    H5D_chunk_direct_t *chunks = NULL;  /* Chunks written */
+    H5D_chunk_direct_t **order = NULL;  /* Chunks in order of their I/O */
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    H5D_io_info_t io_info;              /* to hold the dset and two dxpls (meta and raw data) */
+    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+    hbool_t     have_dxpl_cache = FALSE;    /* Whether the DXPL cache was filled */
+    hsize_t     alloc_size = 0;         /* Size of file space allocated for chunks */
+    haddr_t     alloc_addr;             /* Address of file space allocated for chunks */
+    uint8_t     *wbuf = NULL;           /* Buffer for writing adjacent chunks together */
+    size_t      u, v;                   /* Local index variables */
+    hbool_t md_dxpl_generated = FALSE;  /* bool to indicate whether we should free the md_dxpl_id at exit */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    /* Sanity checks */
+    HDassert(dset && H5D_CHUNKED == layout->type);
+    HDassert(nchunks > 0);
+
+    if(NULL == filters || NULL == data_sizes || NULL == bufs)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk filters, sizes or data")
+    for(u = 0; u < nchunks; u++) {
+        if(0 == data_sizes[u] || NULL == bufs[u])
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk data")
+#if H5_SIZEOF_SIZE_T > 4
+        /* (Chunk sizes are limited to 32-bits currently) */
+        if(data_sizes[u] > (size_t)0xffffffff)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+#endif /* H5_SIZEOF_SIZE_T > 4 */
+    } /* end for */
+
+    io_info.dset = dset;
+    io_info.raw_dxpl_id = dxpl_id;
+    io_info.md_dxpl_id = dxpl_id;
+
+    /* set the dxpl IO type for sanity checking at the FD layer */
+#ifdef H5_DEBUG_BUILD
+    if(H5D_set_io_info_dxpls(&io_info, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't set metadata and raw data dxpls")
+    md_dxpl_generated = TRUE;
+#endif /* H5_DEBUG_BUILD */
+
+    /* Set up the chunks */
+    if(H5D__chunk_direct_init(dset, nchunks, offsets, &chunks, &order) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up chunks")
+
+    /* Allocate dataspace and initialize it if it hasn't been. */
+    if(!(*layout->ops->is_space_alloc)(&layout->storage))
+        if(H5D__alloc_storage(&io_info, H5D_ALLOC_WRITE, FALSE, NULL) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize storage")
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.dxpl_id = io_info.md_dxpl_id;
+    idx_info.pline = &(dset->shared->dcpl_cache.pline);
+    idx_info.layout = &(dset->shared->layout.u.chunk);
+    idx_info.storage = &(dset->shared->layout.storage.u.chunk);
+
+    /* Count the chunks sharing each block, before any is rewritten */
+    if(H5D__chunk_dedup_load(&idx_info) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to count chunks in deduplicated blocks")
+
+    /* Look up the chunks, evicting them from the chunk cache without
+     * flushing them, and find out which need file space */
+    for(u = 0; u < nchunks; u++) {
+        H5D_chunk_direct_t *chk = &chunks[u];
+        H5F_block_t old_chunk;          /* Offset/length of old chunk */
+
+        if(H5D__chunk_lookup(dset, io_info.md_dxpl_id, chk->scaled, &chk->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        if(UINT_MAX != chk->udata.idx_hint) {
+            if(!have_dxpl_cache) {
+                if(H5D__get_dxpl_cache(io_info.raw_dxpl_id, &dxpl_cache) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+                have_dxpl_cache = TRUE;
+            } /* end if */
+            if(H5D__chunk_cache_evict(dset, io_info.md_dxpl_id, dxpl_cache, dset->shared->cache.chunk.slot[chk->udata.idx_hint], FALSE) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
+            chk->udata.idx_hint = UINT_MAX;
+        } /* end if */
+
+        /* Set the file block information for the old and new chunk */
+        old_chunk = chk->udata.chunk_block;
+        H5D__chunk_image_remove(dset, old_chunk.offset);
+        chk->udata.chunk_block.length = data_sizes[u];
+        chk->udata.filter_mask = filters[u];
+        chk->need_insert = FALSE;
+        chk->old_block.offset = HADDR_UNDEF;
+        chk->old_block.length = 0;
+
+        if(0 == idx_info.pline->nused) {
+            if(data_sizes[u] != idx_info.layout->size)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "size of unfiltered chunk doesn't match dataset's chunk size")
+
+            /* Overwrite existing unfiltered chunks in place; chunks without
+             * an index are located by their position */
+            if(H5F_addr_defined(old_chunk.offset))
+                continue;
+            if(H5D_CHUNK_IDX_NONE == idx_info.storage->idx_type) {
+                chk->udata.chunk_block.offset = HADDR_UNDEF;
+                if(H5D__chunk_file_alloc(&idx_info, NULL, &chk->udata.chunk_block, &chk->need_insert, chk->scaled) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "unable to allocate chunk")
+                continue;
+            } /* end if */
+        } /* end if */
+        else {
+            if(H5D__chunk_check_size(&idx_info, chk->udata.chunk_block.length) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "invalid chunk size")
+
+            /* Overwrite existing filtered chunks of the same size in place,
+             * unless identical chunks share the block */
+            if(H5F_addr_defined(old_chunk.offset)) {
+                hbool_t shared = H5D__chunk_dedup_is_shared(idx_info.storage, old_chunk.offset);
+
+                if(!shared && old_chunk.length == chk->udata.chunk_block.length)
+                    continue;
+
+                /* Release previous chunk once the new space is allocated,
+                 * unless a SWMR reader may still find it (as
+                 * H5D__chunk_file_alloc does) */
+                if(shared || !(H5F_INTENT(idx_info.f) & H5F_ACC_SWMR_WRITE))
+                    chk->old_block = old_chunk;
+            } /* end if */
+        } /* end else */
+
+        /* The chunk gets new file space */
+        chk->udata.chunk_block.offset = HADDR_UNDEF;
+        chk->need_insert = TRUE;
+        alloc_size += chk->udata.chunk_block.length;
+    } /* end for */
+
+    /* Allocate file space for the chunks which need it together */
+    if(alloc_size > 0) {
+        if(HADDR_UNDEF == (alloc_addr = H5MF_alloc(idx_info.f, H5FD_MEM_DRAW, idx_info.dxpl_id, alloc_size)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "file allocation failed")
+        for(u = 0; u < nchunks; u++)
+            if(!H5F_addr_defined(chunks[u].udata.chunk_block.offset)) {
+                chunks[u].udata.chunk_block.offset = alloc_addr;
+                alloc_addr += chunks[u].udata.chunk_block.length;
+
+                /* Keep track of every block of a deduplicated dataset */
+                if(idx_info.storage->dedup && NULL == H5D__chunk_dedup_add(idx_info.storage->dedup, chunks[u].udata.chunk_block.offset, chunks[u].udata.chunk_block.length))
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't add deduplicated block")
+            } /* end if */
+
+        /* Release the space of the chunks which moved */
+        for(u = 0; u < nchunks; u++)
+            if(H5F_addr_defined(chunks[u].old_block.offset))
+                if(H5D__chunk_free_block(idx_info.f, idx_info.dxpl_id, idx_info.storage, chunks[u].old_block.offset, chunks[u].old_block.length) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
+    } /* end if */
+
+    /* Write the chunks in order of their addresses, combining adjacent
+     * chunks into one write */
+    HDqsort(order, nchunks, sizeof(H5D_chunk_direct_t *), H5D__chunk_direct_cmp_addr);
+    for(u = 0; u < nchunks; u = v) {
+        haddr_t addr = order[u]->udata.chunk_block.offset;     /* Address of chunks written */
+        size_t  len = (size_t)order[u]->udata.chunk_block.length;  /* Length of chunks written */
+
+        for(v = u + 1; v < nchunks; v++) {
+            if(!H5F_addr_eq(addr + len, order[v]->udata.chunk_block.offset)
+                    || len + (size_t)order[v]->udata.chunk_block.length > H5D_CHUNK_DIRECT_COALESCE_MAX)
+                break;
+            len += (size_t)order[v]->udata.chunk_block.length;
+        } /* end for */
+
+        if(v == u + 1) {
+            if(H5F_block_write(idx_info.f, H5FD_MEM_DRAW, addr, len, io_info.raw_dxpl_id, bufs[order[u]->idx]) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+        } /* end if */
+        else {
+            size_t w, off;
+
+            if(NULL == wbuf && NULL == (wbuf = (uint8_t *)H5MM_malloc(H5D_CHUNK_DIRECT_COALESCE_MAX)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for write buffer")
+            for(w = u, off = 0; w < v; w++) {
+                HDmemcpy(wbuf + off, bufs[order[w]->idx], (size_t)order[w]->udata.chunk_block.length);
+                off += (size_t)order[w]->udata.chunk_block.length;
+            } /* end for */
+            if(H5F_block_write(idx_info.f, H5FD_MEM_DRAW, addr, len, io_info.raw_dxpl_id, wbuf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+        } /* end else */
+        dset->shared->cache.chunk.stats.nbytes_written += len;
+    } /* end for */
+
+    /* Insert the records of the chunks with new file space into the index */
+    if(layout->storage.u.chunk.ops->insert)
+        for(u = 0; u < nchunks; u++)
+            if(chunks[u].need_insert) {
+                if((layout->storage.u.chunk.ops->insert)(&idx_info, &chunks[u].udata, NULL) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+                H5D__chunk_addr_map_set(dset, chunks[u].scaled, chunks[u].udata.chunk_block.offset, chunks[u].udata.chunk_block.length, chunks[u].udata.filter_mask);
+            } /* end if */
+
+    /* The last chunk looked up may have been moved or inserted */
+    H5D__chunk_cinfo_cache_reset(&dset->shared->cache.chunk.last);
+
+done:
+    if(wbuf)
+        H5MM_xfree(wbuf);
+    if(chunks)
+        H5MM_xfree(chunks);
+    if(order)
+        H5MM_xfree(order);
+#ifdef H5_DEBUG_BUILD
+    if(md_dxpl_generated && H5I_dec_ref(io_info.md_dxpl_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't close metadata dxpl")
+#endif /* H5_DEBUG_BUILD */
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_direct_write_multi() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_direct_read_multi
+ *
+ * Purpose:     Internal routine to read several chunks directly from the
+ *              file.  OFFSETS holds the offsets of the NCHUNKS chunks,
+ *              one after the other; each chunk is read into the buffer
+ *              in BUFS and its filter mask returned in FILTERS.
+ *
+ *              The chunks are read in order of their addresses,
+ *              combining adjacent chunks into one read.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_direct_read_multi(const H5D_t *dset, hid_t dxpl_id, size_t nchunks,
+    const hsize_t offsets[], uint32_t filters[], void * const bufs[])
+{
+    const H5O_layout_t *layout = &(dset->shared->layout);    /* Dataset layout */
+    const H5D_rdcc_t   *rdcc = &(dset->shared->cache.chunk); /* raw data chunk cache */
+    H5D_chunk_direct_t *chunks = NULL;  /* Chunks read */
+    H5D_chunk_direct_t **order = NULL;  /* Chunks in order of their I/O */
+    H5D_io_info_t io_info;              /* to hold the dset and two dxpls (meta and raw data) */
+    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+    hbool_t     have_dxpl_cache = FALSE;    /* Whether the DXPL cache was filled */
+    uint8_t     *rbuf = NULL;           /* Buffer for reading adjacent chunks together */
+    size_t      u, v;                   /* Local index variables */
+    hbool_t md_dxpl_generated = FALSE;  /* bool to indicate whether we should free the md_dxpl_id at exit */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    /* Sanity checks */
+    HDassert(dset && H5D_CHUNKED == layout->type);
+    HDassert(nchunks > 0);
+
+    if(NULL == filters || NULL == bufs)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk filters or buffers")
+    for(u = 0; u < nchunks; u++)
+        if(NULL == bufs[u])
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no chunk buffer")
+
+    io_info.dset = dset;
+    io_info.raw_dxpl_id = dxpl_id;
+    io_info.md_dxpl_id = dxpl_id;
+
+    /* set the dxpl IO type for sanity checking at the FD layer */
+#ifdef H5_DEBUG_BUILD
+    if(H5D_set_io_info_dxpls(&io_info, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't set metadata and raw data dxpls")
+    md_dxpl_generated = TRUE;
+#endif /* H5_DEBUG_BUILD */
+
+    if(!(*layout->ops->is_space_alloc)(&layout->storage))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "storage is not initialized")
+
+    /* Set up the chunks */
+    if(H5D__chunk_direct_init(dset, nchunks, offsets, &chunks, &order) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set up chunks")
+
+    /* Look up the chunks, flushing cached chunks to the file first */
+    for(u = 0; u < nchunks; u++) {
+        H5D_chunk_direct_t *chk = &chunks[u];
+
+        if(H5D__chunk_lookup(dset, io_info.md_dxpl_id, chk->scaled, &chk->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        if(UINT_MAX != chk->udata.idx_hint) {
+            H5D_rdcc_ent_t *ent = rdcc->slot[chk->udata.idx_hint];
+
+            if(!have_dxpl_cache) {
+                if(H5D__get_dxpl_cache(io_info.raw_dxpl_id, &dxpl_cache) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+                have_dxpl_cache = TRUE;
+            } /* end if */
+
+            /* Flush the chunk to disk and clear the cache entry */
+            if(H5D__chunk_cache_evict(dset, io_info.md_dxpl_id, dxpl_cache, ent, TRUE) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
+
+            /* Get the new file address / chunk size after flushing */
+            if(H5D__chunk_lookup(dset, io_info.md_dxpl_id, chk->scaled, &chk->udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        } /* end if */
+
+        /* Make sure the address of the chunk is returned. */
+        if(!H5F_addr_defined(chk->udata.chunk_block.offset))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "chunk address isn't defined")
+        filters[u] = chk->udata.filter_mask;
+    } /* end for */
+
+    /* Read the chunks in order of their addresses, combining adjacent
+     * chunks into one read */
+    HDqsort(order, nchunks, sizeof(H5D_chunk_direct_t *), H5D__chunk_direct_cmp_addr);
+    for(u = 0; u < nchunks; u = v) {
+        haddr_t addr = order[u]->udata.chunk_block.offset;     /* Address of chunks read */
+        size_t  len = (size_t)order[u]->udata.chunk_block.length;  /* Length of chunks read */
+
+        for(v = u + 1; v < nchunks; v++) {
+            if(!H5F_addr_eq(addr + len, order[v]->udata.chunk_block.offset)
+                    || len + (size_t)order[v]->udata.chunk_block.length > H5D_CHUNK_DIRECT_COALESCE_MAX)
+                break;
+            len += (size_t)order[v]->udata.chunk_block.length;
+        } /* end for */
+
+        if(v == u + 1) {
+            if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, addr, len, io_info.raw_dxpl_id, bufs[order[u]->idx]) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+        } /* end if */
+        else {
+            size_t w, off;
+
+            if(NULL == rbuf && NULL == (rbuf = (uint8_t *)H5MM_malloc(H5D_CHUNK_DIRECT_COALESCE_MAX)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for read buffer")
+            if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, addr, len, io_info.raw_dxpl_id, rbuf) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunks")
+            for(w = u, off = 0; w < v; w++) {
+                HDmemcpy(bufs[order[w]->idx], rbuf + off, (size_t)order[w]->udata.chunk_block.length);
+                off += (size_t)order[w]->udata.chunk_block.length;
+            } /* end for */
+        } /* end else */
+        dset->shared->cache.chunk.stats.nbytes_read += len;
+    } /* end for */
+
+done:
+    if(rbuf)
+        H5MM_xfree(rbuf);
+    if(chunks)
+        H5MM_xfree(chunks);
+    if(order)
+        H5MM_xfree(order);
+#ifdef H5_DEBUG_BUILD
+    if(md_dxpl_generated && H5I_dec_ref(io_info.md_dxpl_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't close metadata dxpl")
+#endif /* H5_DEBUG_BUILD */
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_direct_read_multi() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__get_chunk_storage_size
@@ -698,7 +1470,7 @@ H5D__get_chunk_storage_size(H5D_t *dset, hid_t dxpl_id, const hsize_t *offset, h
             H5D_rdcc_ent_t *ent = rdcc->slot[udata.idx_hint];
 
             /* Sanity checks  */
-            HDassert(udata.idx_hint < rdcc->nslots);
+            HDassert(udata.idx_hint < rdcc->nsets * rdcc->nways);
             HDassert(rdcc->slot[udata.idx_hint]);
 
             /* If the cached chunk is dirty, it must be flushed to get accurate size */
@@ -819,6 +1591,10 @@ H5D__chunk_set_info(const H5D_t *dset)
     if(H5D__chunk_set_info_real(&dset->shared->layout.u.chunk, dset->shared->ndims, dset->shared->curr_dims, dset->shared->max_dims) < 0)
 	HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't set layout's chunk info")
 
+    /* The chunk indices in the in-memory copy of the chunk index are for the
+     * old dimensions; it's rebuilt when next needed */
+    H5D__chunk_addr_map_reset(&dset->shared->cache.chunk);
+
     /* Call the index's "resize" callback */
     if(dset->shared->layout.storage.u.chunk.ops->resize && (dset->shared->layout.storage.u.chunk.ops->resize)(&dset->shared->layout.u.chunk) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to resize chunk index information")
@@ -904,7 +1680,7 @@ done:
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_construct(H5F_t H5_ATTR_UNUSED *f, H5D_t *dset)
+H5D__chunk_construct(H5F_t *f, H5D_t *dset)
 {
     unsigned u;                 /* Local index variable */
     herr_t ret_value = SUCCEED; /* Return value */
@@ -945,6 +1721,19 @@ H5D__chunk_construct(H5F_t H5_ATTR_UNUSED *f, H5D_t *dset)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "chunk size must be <= maximum dimension size for fixed-sized dimensions")
     } /* end for */
 
+    /* Only filtered chunks are deduplicated, as unfiltered chunks are
+     * overwritten in place */
+    if((dset->shared->layout.u.chunk.flags & H5O_LAYOUT_CHUNK_DEDUP_IDENTICAL_CHUNKS)
+            && 0 == dset->shared->dcpl_cache.pline.nused)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "deduplicating chunks requires a filter pipeline")
+
+    /* Libraries which don't know that chunks may share blocks would free a
+     * shared block when one of its chunks is rewritten, so the layout flag
+     * is only written to files restricted to the latest format */
+    if((dset->shared->layout.u.chunk.flags & H5O_LAYOUT_CHUNK_DEDUP_IDENTICAL_CHUNKS)
+            && !H5F_USE_LATEST_FLAGS(f, H5F_LATEST_LAYOUT_MSG))
+        HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "deduplicating chunks requires the latest file format")
+
     /* Reset address and pointer of the array struct for the chunked storage index */
     if(H5D_chunk_idx_reset(&dset->shared->layout.storage.u.chunk, TRUE) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to reset chunked storage index")
@@ -992,21 +1781,58 @@ H5D__chunk_init(H5F_t *f, hid_t dxpl_id, const H5D_t *dset, hid_t dapl_id)
     if(rdcc->nslots == H5D_CHUNK_CACHE_NSLOTS_DEFAULT)
         rdcc->nslots = H5F_RDCC_NSLOTS(f);
 
+    /* (When a file-wide budget is set, a dataset may use all of it by default) */
     if(H5P_get(dapl, H5D_ACS_DATA_CACHE_BYTE_SIZE_NAME, &rdcc->nbytes_max) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get data cache byte size")
     if(rdcc->nbytes_max == H5D_CHUNK_CACHE_NBYTES_DEFAULT)
-        rdcc->nbytes_max = H5F_RDCC_NBYTES(f);
+        rdcc->nbytes_max = H5F_RDCC_POOL_NBYTES(f) > 0 ? H5F_RDCC_POOL_NBYTES(f) : H5F_RDCC_NBYTES(f);
 
     if(H5P_get(dapl, H5D_ACS_PREEMPT_READ_CHUNKS_NAME, &rdcc->w0) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get preempt read chunks")
     if(rdcc->w0 < 0)
         rdcc->w0 = H5F_RDCC_W0(f);
 
+    if(H5P_get(dapl, H5D_ACS_CHUNK_FLUSH_NTHREADS_NAME, &rdcc->flush_nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get # of chunk flush threads")
+
+    if(H5P_get(dapl, H5D_ACS_CHUNK_READ_AHEAD_NAME, &rdcc->ra.nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get # of chunks to read ahead")
+    rdcc->ra.nseq = 0;
+
+    if(H5P_get(dapl, H5D_ACS_CHUNK_ADDR_MAP_NAME, &rdcc->addr_map.max_nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get max. # of chunks in address map")
+
+    /* Start a resized cache within its range */
+    if(H5P_get(dapl, H5D_ACS_CHUNK_CACHE_MIN_NBYTES_NAME, &rdcc->resize.min_nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get min. size of chunk cache")
+    if(H5P_get(dapl, H5D_ACS_CHUNK_CACHE_MAX_NBYTES_NAME, &rdcc->resize.max_nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get max. size of chunk cache")
+    if(rdcc->resize.max_nbytes > 0 && rdcc->nslots > 0)
+        rdcc->nbytes_max = MIN(MAX(rdcc->nbytes_max, rdcc->resize.min_nbytes), rdcc->resize.max_nbytes);
+    rdcc->resize.nhits = rdcc->resize.nmisses = 0;
+    rdcc->resize.tick = rdcc->tick;
+
+    if(H5P_get(dapl, H5D_ACS_CHUNK_CACHE_IMAGES_NAME, &rdcc->img.nbytes_max) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get size of filtered chunk images cache")
+#ifdef H5_HAVE_PARALLEL
+    /* (Filtered chunks written collectively bypass the chunk cache) */
+    if(H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+        rdcc->img.nbytes_max = 0;
+#endif /* H5_HAVE_PARALLEL */
+
     /* If nbytes_max or nslots is 0, set them both to 0 and avoid allocating space */
-    if(!rdcc->nbytes_max || !rdcc->nslots)
+    if(!rdcc->nbytes_max || !rdcc->nslots) {
         rdcc->nbytes_max = rdcc->nslots = 0;
+        rdcc->nsets = 0;
+        rdcc->nways = 0;
+    } /* end if */
     else {
-        rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nslots);
+        /* Divide the slots into sets, rounding the number of slots up to
+         * fill the last set */
+        rdcc->nways = (unsigned)MIN(rdcc->nslots, H5D_CHUNK_CACHE_NWAYS);
+        rdcc->nsets = (rdcc->nslots + rdcc->nways - 1) / rdcc->nways;
+
+        rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nsets * rdcc->nways);
         if(NULL == rdcc->slot)
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
 
@@ -1045,6 +1871,36 @@ H5D__chunk_init(H5F_t *f, hid_t dxpl_id, const H5D_t *dset, hid_t dapl_id)
     if(H5D__chunk_set_info(dset) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set # of chunks for dataset")
 
+    /* Read the chunk index into memory, if requested */
+    if(H5D__chunk_addr_map_usable(dset))
+        if(H5D__chunk_addr_map_build(dset, dxpl_id) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to build chunk address map")
+
+#ifdef H5_HAVE_PARALLEL
+    /* Deduplicated chunks can't be written in parallel */
+    if((dset->shared->layout.u.chunk.flags & H5O_LAYOUT_CHUNK_DEDUP_IDENTICAL_CHUNKS)
+            && (H5F_INTENT(f) & H5F_ACC_RDWR) && H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+        HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "deduplicated chunks can't be written in parallel")
+#endif /* H5_HAVE_PARALLEL */
+
+    /* Share the file-wide chunk cache budget with the file's other open
+     * datasets, if one is set */
+    if(rdcc->nsets > 0 && H5F_RDCC_POOL_NBYTES(f) > 0) {
+        H5D_rdcc_pool_t *pool = H5F_RDCC_POOL(f);
+
+        if(NULL == pool) {
+            if(NULL == (pool = H5FL_CALLOC(H5D_rdcc_pool_t)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk cache pool")
+            pool->nbytes_max = H5F_RDCC_POOL_NBYTES(f);
+            if(H5F_SET_RDCC_POOL(f, pool) < 0) {
+                pool = H5FL_FREE(H5D_rdcc_pool_t, pool);
+                HGOTO_ERROR(H5E_FILE, H5E_CANTSET, FAIL, "can't set chunk cache pool")
+            } /* end if */
+        } /* end if */
+        pool->nrefs++;
+        rdcc->pool = pool;
+    } /* end if */
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_init() */
@@ -1162,6 +2018,7 @@ H5D__chunk_io_init(const H5D_io_info_t *io_info, const H5D_type_info_t *type_inf
     /* Point at the dataspaces */
     fm->file_space = file_space;
     fm->mem_space = mem_space;
+    fm->addrs_known = FALSE;
 
     /* Special case for only one element in selection */
     /* (usually appending a record) */
@@ -2187,9 +3044,370 @@ done:
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_read
+ * Function:	H5D__chunk_prefetch_cmp
  *
- * Purpose:	Read from a chunked dataset.
+ * Purpose:	Compare the file addresses of two prefetched chunks, for
+ *              sorting them into the order they are read in.
+ *
+ * Return:	-1, 0, 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_prefetch_cmp(const void *_pf1, const void *_pf2)
+{
+    const H5D_chunk_prefetch_t *pf1 = *(const H5D_chunk_prefetch_t * const *)_pf1;
+    const H5D_chunk_prefetch_t *pf2 = *(const H5D_chunk_prefetch_t * const *)_pf2;
+    int ret_value = 0;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(H5F_addr_lt(pf1->udata.chunk_block.offset, pf2->udata.chunk_block.offset))
+        ret_value = -1;
+    else if(H5F_addr_gt(pf1->udata.chunk_block.offset, pf2->udata.chunk_block.offset))
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_prefetch_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prefetch_unfilter
+ *
+ * Purpose:	Apply the I/O pipeline (in reverse) to one prefetched chunk
+ *              of a batch.  This may be called on a worker thread, so it
+ *              must only touch the chunk's own entry in the batch, and
+ *              any errors pushed by the filters on a worker thread are
+ *              discarded.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_prefetch_unfilter(size_t idx, void *_batch)
+{
+    H5D_chunk_batch_t *batch = (H5D_chunk_batch_t *)_batch;
+    H5D_chunk_prefetch_t *pf = &batch->chunk[idx];
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Skip chunks that weren't read.  (No error is pushed here, since
+     * errors can't be pushed from worker threads: the caller reports
+     * the failure) */
+    if(pf->buf)
+        ret_value = H5Z_pipeline(batch->pline, H5Z_FLAG_REVERSE, &(pf->udata.filter_mask),
+                batch->err_detect, batch->filter_cb, &pf->nbytes,
+                &pf->buf_size, &pf->buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_prefetch_unfilter() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prefetch_read
+ *
+ * Purpose:	Read the NREAD chunks in READ_ORDER from the file, in order
+ *              of their file addresses, and then unfilter the chunks in
+ *              BATCH which were read.  When the library is thread-safe,
+ *              the chunks are unfiltered concurrently by up to
+ *              BATCH->NTHREADS threads.  Chunks whose filtered images are
+ *              in the second tier of the chunk cache are taken from there
+ *              instead of being read.  On failure, the chunks read are
+ *              released.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_prefetch_read(const H5D_io_info_t *io_info, H5D_chunk_batch_t *batch,
+    H5D_chunk_prefetch_t **read_order, size_t nread)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    hbool_t keep_images = (dset->shared->cache.chunk.img.nbytes_max > 0 && batch->pline->nused > 0); /* Whether to keep the filtered images */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(batch);
+    HDassert(read_order || 0 == nread);
+
+    /* Read the chunks in the order they are stored in the file */
+    if(nread > 1)
+        HDqsort(read_order, nread, sizeof(H5D_chunk_prefetch_t *), H5D__chunk_prefetch_cmp);
+    for(u = 0; u < nread; u++) {
+        H5D_chunk_prefetch_t *pf = read_order[u];
+
+        H5_CHECKED_ASSIGN(pf->nbytes, size_t, pf->udata.chunk_block.length, hsize_t);
+        pf->buf_size = pf->nbytes;
+        if(NULL == (pf->buf = H5D__chunk_mem_alloc(pf->nbytes, batch->pline)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+
+        /* Copy the filtered chunk from the second tier of the cache, or
+         * read it and keep a copy for when the chunk is evicted */
+        if(keep_images)
+            pf->image = H5D__chunk_image_take(dset, pf->udata.chunk_block.offset, pf->udata.common.scaled, pf->nbytes);
+        if(pf->image)
+            HDmemcpy(pf->buf, pf->image, pf->nbytes);
+        else {
+            if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, pf->udata.chunk_block.offset, pf->nbytes, io_info->raw_dxpl_id, pf->buf) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+            dset->shared->cache.chunk.stats.nbytes_read += pf->nbytes;
+            if(keep_images) {
+                if(NULL == (pf->image = H5MM_malloc(pf->nbytes)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk image")
+                HDmemcpy(pf->image, pf->buf, pf->nbytes);
+            } /* end if */
+        } /* end else */
+    } /* end for */
+
+    /* Unfilter the chunks read */
+    if(nread > 0) {
+        double filter_start = H5_get_time();    /* Time unfiltering started */
+#ifdef H5D_CHUNK_FILTER_THREADS
+        hbool_t use_threads = (batch->nthreads > 1 && nread > 1);
+
+        /* Only the library's own filters are safe to run on other threads:
+         * application & plugin filters may call back into the library */
+        if(use_threads) {
+            htri_t builtin;
+
+            if((builtin = H5Z_pipeline_builtin(batch->pline)) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't check filter pipeline")
+            use_threads = (hbool_t)builtin;
+        } /* end if */
+
+        if(use_threads) {
+            if(H5TS_parallel_for(batch->nthreads, batch->nchunks, H5D__chunk_prefetch_unfilter, batch) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+        } /* end if */
+        else
+#endif /* H5D_CHUNK_FILTER_THREADS */
+            for(u = 0; u < batch->nchunks; u++)
+                if(H5D__chunk_prefetch_unfilter(u, batch) < 0)
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+        dset->shared->cache.chunk.stats.filter_time += H5_get_time() - filter_start;
+    } /* end if */
+
+done:
+    /* Release the chunks read, on error */
+    if(ret_value < 0)
+        for(u = 0; u < nread; u++) {
+            if(read_order[u]->buf)
+                read_order[u]->buf = H5D__chunk_mem_xfree(read_order[u]->buf, batch->pline);
+            read_order[u]->image = H5MM_xfree(read_order[u]->image);
+        } /* end for */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_prefetch_read() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prefetch
+ *
+ * Purpose:	Start a new batch of chunks for H5D__chunk_read, beginning
+ *              with CHUNK_NODE in the chunk map.  Each chunk in the batch
+ *              is looked up in the chunk index, and the filtered chunks
+ *              which aren't in the chunk cache are read from the file, in
+ *              order of their file addresses, and then unfiltered.  When
+ *              the library is thread-safe, the chunks are unfiltered
+ *              concurrently by up to BATCH->NTHREADS threads.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_prefetch(const H5D_io_info_t *io_info, const H5D_chunk_map_t *fm,
+    H5SL_node_t *chunk_node, H5D_chunk_batch_t *batch)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    const H5O_layout_t *layout = &(dset->shared->layout); /* Dataset layout */
+    H5D_chunk_prefetch_t **read_order = NULL;   /* Chunks to read, in address order */
+    size_t nread = 0;                   /* # of chunks to read */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(batch);
+    HDassert(batch->curr == batch->nchunks);
+
+    if(NULL == (read_order = (H5D_chunk_prefetch_t **)H5MM_malloc(batch->max_chunks * sizeof(H5D_chunk_prefetch_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+
+    /* Look up the chunks for the batch */
+    batch->nchunks = batch->curr = 0;
+    while(chunk_node && batch->nchunks < batch->max_chunks) {
+        H5D_chunk_prefetch_t *pf = &batch->chunk[batch->nchunks];
+
+        pf->chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
+        pf->buf = NULL;
+        pf->image = NULL;
+        if(H5D__chunk_lookup_sel(dset, io_info->md_dxpl_id, fm, pf->chunk_info, &pf->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* Chunks which are stored in the file (with their filters applied)
+         * but aren't in the chunk cache are read as part of the batch */
+        if(UINT_MAX == pf->udata.idx_hint && H5F_addr_defined(pf->udata.chunk_block.offset)
+                && !((layout->u.chunk.flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
+                    && H5D__chunk_is_partial_edge_chunk(dset->shared->ndims, layout->u.chunk.dim,
+                        pf->chunk_info->scaled, dset->shared->curr_dims)))
+            read_order[nread++] = pf;
+
+        batch->nchunks++;
+        chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
+    } /* end while */
+
+    /* Read & unfilter the chunks which aren't cached */
+    if(H5D__chunk_prefetch_read(io_info, batch, read_order, nread) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read batch of raw data chunks")
+
+done:
+    read_order = (H5D_chunk_prefetch_t **)H5MM_xfree(read_order);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_prefetch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_read_ahead
+ *
+ * Purpose:	Read the next chunks in the sequence the dataset's chunks
+ *              are being read in into the chunk cache, after
+ *              H5D__chunk_read has found the chunks being read in order
+ *              (or with a constant stride between their indices).  The
+ *              chunks which are stored in the file but not cached are
+ *              read in order of their file addresses and unfiltered
+ *              together, as for a batch of chunks read by H5D__chunk_read,
+ *              and then added to the cache unlocked.  Since the chunks
+ *              are only read on speculation, failing to read or unfilter
+ *              them isn't an error.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_read_ahead(const H5D_io_info_t *io_info)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    const H5O_layout_t *layout = &(dset->shared->layout); /* Dataset layout */
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Dataset's chunk cache */
+    hsize_t *scaled = io_info->store->chunk.scaled;     /* Scaled coordinates of last chunk read */
+    H5D_chunk_batch_t batch;            /* Chunks read ahead */
+    H5D_chunk_prefetch_t **read_order = NULL;   /* Chunks to read, in address order */
+    size_t chunk_size;                  /* Size of a chunk, unfiltered */
+    size_t max_chunks;                  /* Max. # of chunks to read ahead */
+    size_t nread = 0;                   /* # of chunks to read */
+    hsize_t idx;                        /* Index of chunk */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(rdcc->ra.nchunks > 0);
+    HDassert(rdcc->ra.stride > 0);
+
+    batch.chunk = NULL;
+    batch.nchunks = batch.curr = 0;
+
+    /* Only read ahead as many chunks as fit in the cache along with the
+     * last chunk read */
+    H5_CHECKED_ASSIGN(chunk_size, size_t, layout->u.chunk.size, uint32_t);
+    if(0 == rdcc->nsets || chunk_size > rdcc->nbytes_max)
+        HGOTO_DONE(SUCCEED)
+    max_chunks = MIN(rdcc->ra.nchunks, rdcc->nbytes_max / chunk_size - 1);
+    if(rdcc->pool)
+        max_chunks = MIN(max_chunks, rdcc->pool->nbytes_max / chunk_size - 1);
+    if(0 == max_chunks)
+        HGOTO_DONE(SUCCEED)
+
+    /* Set up the batch */
+    batch.pline = &(dset->shared->dcpl_cache.pline);
+    batch.err_detect = io_info->dxpl_cache->err_detect;
+    batch.filter_cb = io_info->dxpl_cache->filter_cb;
+    batch.nthreads = batch.pline->nused > 0 ? MAX(io_info->dxpl_cache->chunk_filter_nthreads, 1) : 1;
+    batch.max_chunks = max_chunks;
+    if(NULL == (batch.chunk = (H5D_chunk_prefetch_t *)H5MM_malloc(batch.max_chunks * sizeof(H5D_chunk_prefetch_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+    if(NULL == (read_order = (H5D_chunk_prefetch_t **)H5MM_malloc(batch.max_chunks * sizeof(H5D_chunk_prefetch_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+
+    /* Look up the next chunks in the sequence, keeping the ones to read */
+    idx = rdcc->ra.last;
+    for(u = 0; u < max_chunks; u++) {
+        H5D_chunk_prefetch_t *pf = &batch.chunk[batch.nchunks];
+
+        /* Stop at the end of the dataset */
+        if(idx >= layout->u.chunk.nchunks || layout->u.chunk.nchunks - idx <= rdcc->ra.stride)
+            break;
+        idx += rdcc->ra.stride;
+
+        pf->chunk_info = NULL;
+        pf->buf = NULL;
+        pf->image = NULL;
+        if(H5VM_array_calc_pre(idx, dset->shared->ndims, layout->u.chunk.down_chunks, pf->scaled) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't compute chunk's scaled coordinates")
+        pf->scaled[dset->shared->ndims] = 0;
+        if(H5D__chunk_lookup(dset, io_info->md_dxpl_id, pf->scaled, &pf->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* Skip chunks which are cached already or aren't in the file, and
+         * partial edge chunks which aren't filtered */
+        if(UINT_MAX == pf->udata.idx_hint && H5F_addr_defined(pf->udata.chunk_block.offset)
+                && !((layout->u.chunk.flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
+                    && H5D__chunk_is_partial_edge_chunk(dset->shared->ndims, layout->u.chunk.dim,
+                        pf->scaled, dset->shared->curr_dims))) {
+            read_order[nread++] = pf;
+            batch.nchunks++;
+        } /* end if */
+    } /* end for */
+
+    /* Read & unfilter the chunks, giving up quietly on failure */
+    if(H5D__chunk_prefetch_read(io_info, &batch, read_order, nread) < 0) {
+        H5E_clear_stack(NULL);
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* Add the chunks to the cache */
+    for(u = 0; u < batch.nchunks; u++) {
+        H5D_chunk_prefetch_t *pf = &batch.chunk[u];
+        void *chunk;                    /* Pointer to locked chunk buffer */
+
+        io_info->store->chunk.scaled = pf->scaled;
+        if(NULL == (chunk = H5D__chunk_lock(io_info, &pf->udata, FALSE, FALSE, pf)))
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+        if(H5D__chunk_unlock(io_info, &pf->udata, FALSE, chunk, (uint32_t)0) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+    } /* end for */
+
+done:
+    /* Release the batch, and any chunks in it that weren't cached */
+    io_info->store->chunk.scaled = scaled;
+    if(batch.chunk) {
+        for(u = 0; u < batch.nchunks; u++) {
+            if(batch.chunk[u].buf)
+                batch.chunk[u].buf = H5D__chunk_mem_xfree(batch.chunk[u].buf, batch.pline);
+            batch.chunk[u].image = H5MM_xfree(batch.chunk[u].image);
+        } /* end for */
+        batch.chunk = (H5D_chunk_prefetch_t *)H5MM_xfree(batch.chunk);
+    } /* end if */
+    read_order = (H5D_chunk_prefetch_t **)H5MM_xfree(read_order);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_read_ahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_read
+ *
+ * Purpose:	Read from a chunked dataset.
  *
  * Return:	Non-negative on success/Negative on failure
  *
@@ -2212,6 +3430,13 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
     uint32_t    src_accessed_bytes = 0; /* Total accessed size in a chunk */
     hbool_t     skip_missing_chunks = FALSE;    /* Whether to skip missing chunks */
+    hbool_t     fill_missing_chunks = FALSE;    /* Whether to fill the selection in missing chunks directly */
+    const H5O_fill_t *fill = &(io_info->dset->shared->dcpl_cache.fill);    /* Fill value info */
+    const void  *fill_buf = NULL;       /* Fill value, in the dataset's datatype */
+    void        *zero_fill = NULL;      /* Zeroed fill value, when none is set */
+    H5D_chunk_batch_t batch;            /* Batch of chunks read ahead of time */
+    H5D_chunk_prefetch_t *prefetch = NULL; /* Chunk already read & unfiltered */
+    H5D_rdcc_t  *rdcc = &(io_info->dset->shared->cache.chunk);  /* Dataset's chunk cache */
     herr_t	ret_value = SUCCEED;	/*return value		*/
 
     FUNC_ENTER_STATIC
@@ -2222,6 +3447,21 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     HDassert(type_info);
     HDassert(fm);
 
+    /* Set up reading filtered chunks in batches, if requested */
+    batch.chunk = NULL;
+    batch.nchunks = batch.curr = 0;
+    if(io_info->dxpl_cache->chunk_filter_nthreads > 1
+            && io_info->dset->shared->dcpl_cache.pline.nused > 0
+            && !fm->use_single && H5SL_count(fm->sel_chunks) > 1) {
+        batch.pline = &(io_info->dset->shared->dcpl_cache.pline);
+        batch.err_detect = io_info->dxpl_cache->err_detect;
+        batch.filter_cb = io_info->dxpl_cache->filter_cb;
+        batch.nthreads = io_info->dxpl_cache->chunk_filter_nthreads;
+        batch.max_chunks = MIN((size_t)batch.nthreads * H5D_CHUNK_FILTER_BATCH_PER_THREAD, H5SL_count(fm->sel_chunks));
+        if(NULL == (batch.chunk = (H5D_chunk_prefetch_t *)H5MM_malloc(batch.max_chunks * sizeof(H5D_chunk_prefetch_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+    } /* end if */
+
     /* Set up "nonexistent" I/O info object */
     HDmemcpy(&nonexistent_io_info, io_info, sizeof(nonexistent_io_info));
     nonexistent_io_info.layout_ops = *H5D_LOPS_NONEXISTENT;
@@ -2243,7 +3483,6 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     cpt_store.compact.dirty = &cpt_dirty;
 
     {
-        const H5O_fill_t *fill = &(io_info->dset->shared->dcpl_cache.fill);    /* Fill value info */
         H5D_fill_value_t fill_status;       /* Fill value status */
 
         /* Check the fill value status */
@@ -2258,8 +3497,29 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                  fill_status != H5D_FILL_VALUE_USER_DEFINED &&
                  fill_status != H5D_FILL_VALUE_DEFAULT))
             skip_missing_chunks = TRUE;
+
+        /* Otherwise, the fill value may be written straight into the
+         * application's buffer for chunks which were never written, unless
+         * the background buffer or a data transform would be needed.
+         * (Without a fill value set, zeros in the dataset's datatype are
+         * converted, as for chunks filled in the cache.)
+         */
+        else if(type_info->is_xform_noop && H5T_BKG_NO == type_info->need_bkg) {
+            fill_missing_chunks = TRUE;
+            fill_buf = fill->buf;
+            if(NULL == fill_buf && !type_info->is_conv_noop) {
+                if(NULL == (zero_fill = H5MM_calloc(type_info->src_type_size)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for fill value")
+                fill_buf = zero_fill;
+            } /* end if */
+        } /* end if */
     }
 
+    /* Look up the locations of the selected chunks together, when there
+     * are enough of them */
+    if(H5D__chunk_lookup_batch(io_info, fm) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk addresses")
+
     /* Iterate through nodes in chunk skip list */
     chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
     while(chunk_node) {
@@ -2269,16 +3529,47 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
         /* Get the actual chunk information from the skip list node */
         chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
 
+        /* Check for reading chunks in batches */
+        if(batch.chunk) {
+            H5D_chunk_prefetch_t *pf;   /* Chunk's entry in batch */
+
+            /* Start the next batch, if the current one is done */
+            if(batch.curr == batch.nchunks)
+                if(H5D__chunk_prefetch(io_info, fm, chunk_node, &batch) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read batch of raw data chunks")
+
+            /* Take the chunk from the batch */
+            pf = &batch.chunk[batch.curr++];
+            HDassert(pf->chunk_info == chunk_info);
+            prefetch = pf->buf ? pf : NULL;
+
+            /* The location of chunks not read ahead of time must be looked
+             * up again, since reading the previous chunks in the batch could
+             * have changed the contents of the chunk cache.
+             */
+            if(prefetch)
+                udata = pf->udata;
+        } /* end if */
+
         /* Get the info for the chunk in the file */
-        if(H5D__chunk_lookup(io_info->dset, io_info->md_dxpl_id, chunk_info->scaled, &udata) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        if(!prefetch)
+            if(H5D__chunk_lookup_sel(io_info->dset, io_info->md_dxpl_id, fm, chunk_info, &udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
 
         /* Sanity check */
         HDassert((H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length > 0) || 
                 (!H5F_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length == 0));
 
+        /* Fill the selection with the fill value for a chunk which was never
+         * written, without bringing the chunk into the cache */
+        if(fill_missing_chunks && !H5F_addr_defined(udata.chunk_block.offset)
+                && UINT_MAX == udata.idx_hint) {
+            if(H5D__fill(fill_buf, type_info->dset_type, io_info->u.rbuf, type_info->mem_type,
+                    chunk_info->mspace, io_info->md_dxpl_id) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to fill selection with fill value")
+        } /* end if */
         /* Check for non-existant chunk & skip it if appropriate */
-        if(H5F_addr_defined(udata.chunk_block.offset) || UINT_MAX != udata.idx_hint
+        else if(H5F_addr_defined(udata.chunk_block.offset) || UINT_MAX != udata.idx_hint
                 || !skip_missing_chunks) {
             H5D_io_info_t *chk_io_info;     /* Pointer to I/O info object for this chunk */
             void *chunk = NULL;             /* Pointer to locked chunk buffer */
@@ -2298,7 +3589,9 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 src_accessed_bytes = chunk_info->chunk_points * (uint32_t)type_info->src_type_size;
 
                 /* Lock the chunk into the cache */
-                if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, FALSE, FALSE)))
+                chunk = H5D__chunk_lock(io_info, &udata, FALSE, FALSE, prefetch);
+                prefetch = NULL;
+                if(NULL == chunk)
                     HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
 
                 /* Set up the storage buffer information for this chunk */
@@ -2307,36 +3600,189 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 /* Point I/O info at contiguous I/O info for this chunk */
                 chk_io_info = &cpt_io_info;
             } /* end if */
-            else if(H5F_addr_defined(udata.chunk_block.offset)) {
-                /* Set up the storage address information for this chunk */
-                ctg_store.contig.dset_addr = udata.chunk_block.offset;
-
-                /* Point I/O info at temporary I/O info for this chunk */
-                chk_io_info = &ctg_io_info;
-            } /* end else if */
             else {
-                /* Point I/O info at "nonexistent" I/O info for this chunk */
-                chk_io_info = &nonexistent_io_info;
+                /* Chunks which bypass the cache count as misses, so a
+                 * cache too small for them is grown */
+                rdcc->resize.nmisses++;
+
+                if(H5F_addr_defined(udata.chunk_block.offset)) {
+                    /* Set up the storage address information for this chunk */
+                    ctg_store.contig.dset_addr = udata.chunk_block.offset;
+
+                    /* Point I/O info at temporary I/O info for this chunk */
+                    chk_io_info = &ctg_io_info;
+                } /* end if */
+                else {
+                    /* Point I/O info at "nonexistent" I/O info for this chunk */
+                    chk_io_info = &nonexistent_io_info;
+                } /* end else */
             } /* end else */
 
             /* Perform the actual read operation */
             if((io_info->io_ops.single_read)(chk_io_info, type_info,
                     (hsize_t)chunk_info->chunk_points, chunk_info->fspace, chunk_info->mspace) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "chunked read failed")
+            if(chk_io_info == &ctg_io_info)
+                io_info->dset->shared->cache.chunk.stats.nbytes_read += (hsize_t)chunk_info->chunk_points * type_info->src_type_size;
 
             /* Release the cache lock on the chunk. */
             if(chunk && H5D__chunk_unlock(io_info, &udata, FALSE, chunk, src_accessed_bytes) < 0)
                 HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
         } /* end if */
 
+        /* Track whether the chunks are being read in sequence */
+        if(rdcc->ra.nchunks > 0) {
+            if(rdcc->ra.nseq > 0 && chunk_info->index > rdcc->ra.last) {
+                if(chunk_info->index - rdcc->ra.last == rdcc->ra.stride)
+                    rdcc->ra.nseq++;
+                else {
+                    rdcc->ra.stride = chunk_info->index - rdcc->ra.last;
+                    rdcc->ra.nseq = 2;
+                } /* end else */
+            } /* end if */
+            else {
+                rdcc->ra.stride = 0;
+                rdcc->ra.nseq = 1;
+            } /* end else */
+            rdcc->ra.last = chunk_info->index;
+        } /* end if */
+
         /* Advance to next chunk in list */
         chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
     } /* end while */
 
+    /* Read the next chunks in the sequence ahead of time, if the chunks are
+     * being read in sequence */
+    if(rdcc->ra.nchunks > 0 && rdcc->ra.nseq >= H5D_CHUNK_READ_AHEAD_NSEQ)
+        if(H5D__chunk_read_ahead(io_info) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read ahead raw data chunks")
+
+    /* Resize the cache for the chunks being accessed */
+    if(rdcc->resize.max_nbytes > 0 && rdcc->nslots > 0)
+        if(H5D__chunk_cache_adapt(io_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to resize raw data chunk cache")
+
 done:
+    /* The chunk locations looked up are only valid for this read */
+    fm->addrs_known = FALSE;
+
+    H5MM_xfree(zero_fill);
+
+    /* Release the batch, and any chunks in it that weren't used */
+    if(batch.chunk) {
+        for(batch.curr = 0; batch.curr < batch.nchunks; batch.curr++) {
+            if(batch.chunk[batch.curr].buf)
+                batch.chunk[batch.curr].buf = H5D__chunk_mem_xfree(batch.chunk[batch.curr].buf, batch.pline);
+            batch.chunk[batch.curr].image = H5MM_xfree(batch.chunk[batch.curr].image);
+        } /* end for */
+        batch.chunk = (H5D_chunk_prefetch_t *)H5MM_xfree(batch.chunk);
+    } /* end if */
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__chunk_read() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_stream_write
+ *
+ * Purpose:	Writes a whole chunk straight from the application's buffer
+ *              to the file, when the elements for the chunk form a single
+ *              contiguous run of the buffer.  Any copy of the chunk in the
+ *              chunk cache is discarded without being flushed.
+ *
+ * Return:	TRUE if the chunk was written, FALSE if the memory selection
+ *              for the chunk is not contiguous, negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__chunk_stream_write(const H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
+    H5D_chunk_info_t *chunk_info, H5D_chunk_ud_t *udata)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to dataset info */
+    H5S_sel_iter_t mem_iter;            /* Memory selection iteration info */
+    hbool_t     mem_iter_init = FALSE;  /* Whether the memory iterator has been initialized */
+    hsize_t     mem_off;                /* Offset of the chunk's elements in the buffer */
+    size_t      mem_len;                /* Length of the first run of the chunk's elements */
+    size_t      nseq;                   /* Number of sequences retrieved */
+    size_t      nelem;                  /* Number of elements retrieved */
+    size_t      chunk_size;             /* Size of the chunk in bytes */
+    hbool_t     need_insert = FALSE;    /* Whether the chunk needs to be inserted into the index */
+    htri_t      ret_value = TRUE;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(io_info);
+    HDassert(type_info);
+    HDassert(chunk_info);
+    HDassert(udata);
+
+    chunk_size = (size_t)dset->shared->layout.u.chunk.size;
+
+    /* Find the first run of the chunk's elements in the buffer */
+    if(H5S_select_iter_init(&mem_iter, chunk_info->mspace, type_info->src_type_size) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize memory selection information")
+    mem_iter_init = TRUE;
+    if(H5S_SELECT_GET_SEQ_LIST(chunk_info->mspace, 0, &mem_iter, (size_t)1, (size_t)chunk_info->chunk_points, &nseq, &nelem, &mem_off, &mem_len) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "sequence length generation failed")
+
+    /* The chunk can only be streamed if it is one contiguous run */
+    if(nseq != 1 || mem_len != chunk_size)
+        HGOTO_DONE(FALSE)
+
+    /* Evict the (old) entry from the cache if present, but do not flush
+     * it to disk */
+    if(UINT_MAX != udata->idx_hint) {
+        if(H5D__chunk_cache_evict(dset, io_info->md_dxpl_id, io_info->dxpl_cache, dset->shared->cache.chunk.slot[udata->idx_hint], FALSE) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
+        udata->idx_hint = UINT_MAX;
+    } /* end if */
+
+    /* If the chunk hasn't been allocated on disk, do so now. */
+    if(!H5F_addr_defined(udata->chunk_block.offset)) {
+        H5D_chk_idx_info_t idx_info;    /* Chunked index info */
+
+        /* Compose chunked index info struct */
+        idx_info.f = dset->oloc.file;
+        idx_info.dxpl_id = io_info->md_dxpl_id;
+        idx_info.pline = &(dset->shared->dcpl_cache.pline);
+        idx_info.layout = &(dset->shared->layout.u.chunk);
+        idx_info.storage = &(dset->shared->layout.storage.u.chunk);
+
+        /* Set up the size of chunk for user data */
+        udata->chunk_block.length = dset->shared->layout.u.chunk.size;
+
+        /* Allocate the chunk */
+        if(H5D__chunk_file_alloc(&idx_info, NULL, &udata->chunk_block, &need_insert, chunk_info->scaled) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert/resize chunk on chunk level")
+
+        /* Make sure the address of the chunk is returned. */
+        if(!H5F_addr_defined(udata->chunk_block.offset))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "chunk address isn't defined")
+
+        /* Insert the chunk record into the index */
+        if(need_insert && dset->shared->layout.storage.u.chunk.ops->insert)
+            if((dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, udata, NULL) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+
+        /* Cache the new chunk information */
+        H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, udata);
+        H5D__chunk_addr_map_set(dset, chunk_info->scaled, udata->chunk_block.offset, udata->chunk_block.length, udata->filter_mask);
+    } /* end if */
+
+    /* Write the chunk straight from the application's buffer */
+    if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata->chunk_block.offset, chunk_size, io_info->raw_dxpl_id, (const uint8_t *)io_info->u.wbuf + mem_off) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+    dset->shared->cache.chunk.stats.nbytes_written += chunk_size;
+
+done:
+    if(mem_iter_init && H5S_SELECT_ITER_RELEASE(&mem_iter) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "unable to release selection iterator")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_stream_write() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_write
@@ -2362,6 +3808,7 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     H5D_storage_t cpt_store;            /* Chunk storage information as compact dataset */
     hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
     uint32_t    dst_accessed_bytes = 0; /* Total accessed size in a chunk */
+    hbool_t     stream = FALSE;         /* Whether whole chunks may be written straight to the file */
     herr_t	ret_value = SUCCEED;	/* Return value		*/
 
     FUNC_ENTER_STATIC
@@ -2388,6 +3835,16 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     /* Initialize temporary compact storage info */
     cpt_store.compact.dirty = &cpt_dirty;
 
+    /* Check if whole chunks may be streamed from the application's buffer */
+    if(io_info->dxpl_cache->chunk_stream_write && type_info->is_conv_noop
+            && type_info->is_xform_noop && fm->fsel_type != H5S_SEL_POINTS
+            && io_info->dset->shared->dcpl_cache.pline.nused == 0
+#ifdef H5_HAVE_PARALLEL
+            && !io_info->using_mpi_vfd
+#endif /* H5_HAVE_PARALLEL */
+            )
+        stream = TRUE;
+
     /* Iterate through nodes in chunk skip list */
     chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
     while(chunk_node) {
@@ -2413,6 +3870,19 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
 	/* Set chunk's [scaled] coordinates */
 	io_info->store->chunk.scaled = chunk_info->scaled;
 
+        /* Write the whole chunk straight to the file, if possible */
+        if(stream && (chunk_info->chunk_points * type_info->src_type_size) == ctg_store.contig.dset_size) {
+            htri_t streamed;            /* Whether the chunk was written */
+
+            if((streamed = H5D__chunk_stream_write(io_info, type_info, chunk_info, &udata)) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to stream chunk to file")
+            if(streamed) {
+                /* Advance to next chunk in list */
+                chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
+                continue;
+            } /* end if */
+        } /* end if */
+
         /* Determine if we should use the chunk cache */
         if((cacheable = H5D__chunk_cacheable(io_info, udata.chunk_block.offset, TRUE)) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't tell if chunk is cacheable")
@@ -2432,7 +3902,7 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 entire_chunk = FALSE;
 
             /* Lock the chunk into the cache */
-            if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, entire_chunk, FALSE)))
+            if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, entire_chunk, FALSE, NULL)))
                 HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
 
             /* Set up the storage buffer information for this chunk */
@@ -2442,6 +3912,9 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
             chk_io_info = &cpt_io_info;
         } /* end if */
         else {
+            /* Chunks which bypass the cache count as misses */
+            io_info->dset->shared->cache.chunk.resize.nmisses++;
+
             /* If the chunk hasn't been allocated on disk, do so now. */
             if(!H5F_addr_defined(udata.chunk_block.offset)) {
                 /* Compose chunked index info struct */
@@ -2487,15 +3960,22 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
 		HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
 	} /* end if */
 	else {
+            io_info->dset->shared->cache.chunk.stats.nbytes_written += (hsize_t)chunk_info->chunk_points * type_info->dst_type_size;
             if(need_insert && io_info->dset->shared->layout.storage.u.chunk.ops->insert)
                 if((io_info->dset->shared->layout.storage.u.chunk.ops->insert)(&idx_info, &udata, NULL) < 0)
                     HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+            H5D__chunk_addr_map_set(io_info->dset, chunk_info->scaled, udata.chunk_block.offset, udata.chunk_block.length, udata.filter_mask);
 	} /* end else */
 
         /* Advance to next chunk in list */
         chunk_node = H5D_CHUNK_GET_NEXT_NODE(fm, chunk_node);
     } /* end while */
 
+    /* Resize the cache for the chunks being accessed */
+    if(io_info->dset->shared->cache.chunk.resize.max_nbytes > 0 && io_info->dset->shared->cache.chunk.nslots > 0)
+        if(H5D__chunk_cache_adapt(io_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to resize raw data chunk cache")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__chunk_write() */
@@ -2521,6 +4001,7 @@ H5D__chunk_flush(H5D_t *dset, hid_t dxpl_id)
     H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
     H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);
     H5D_rdcc_ent_t	*ent, *next;
+    H5D_rdcc_ent_t	*batch_end;     /* First entry after the current batch of filtered chunks */
     unsigned		nerrors = 0;    /* Count of any errors encountered when flushing chunks */
     herr_t ret_value = SUCCEED;         /* Return value */
 
@@ -2534,8 +4015,15 @@ H5D__chunk_flush(H5D_t *dset, hid_t dxpl_id)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
 
     /* Loop over all entries in the chunk cache */
+    batch_end = rdcc->head;
     for(ent = rdcc->head; ent; ent = next) {
 	next = ent->next;
+
+        /* Filter the next batch of dirty chunks */
+        if(ent == batch_end)
+            if(H5D__chunk_flush_filter_batch(dset, dxpl_cache, ent, &batch_end) < 0)
+                nerrors++;
+
         if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, FALSE) < 0)
             nerrors++;
     } /* end for */
@@ -2619,6 +4107,7 @@ H5D__chunk_dest(H5D_t *dset, hid_t dxpl_id)
     H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
     H5D_rdcc_t	*rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
     H5D_rdcc_ent_t	*ent = NULL, *next = NULL;      /* Pointer to current & next cache entries */
+    H5D_rdcc_ent_t	*batch_end = NULL;      /* First entry after the current batch of filtered chunks */
     int		nerrors = 0;            /* Accumulated count of errors */
     H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
     herr_t      ret_value = SUCCEED;       /* Return value */
@@ -2633,9 +4122,20 @@ H5D__chunk_dest(H5D_t *dset, hid_t dxpl_id)
     if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
         nerrors++;
 
+    /* Don't keep the images of the chunks evicted, the second tier of the
+     * cache is about to be released */
+    rdcc->img.nbytes_max = 0;
+
     /* Flush all the cached chunks */
+    batch_end = rdcc->head;
     for(ent = rdcc->head; ent; ent = next) {
         next = ent->next;
+
+        /* Filter the next batch of dirty chunks */
+        if(ent == batch_end)
+            if(H5D__chunk_flush_filter_batch(dset, dxpl_cache, ent, &batch_end) < 0)
+                nerrors++;
+
         if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
             nerrors++;
     } /* end for */
@@ -2644,9 +4144,24 @@ H5D__chunk_dest(H5D_t *dset, hid_t dxpl_id)
     if(nerrors)
         HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
 
+    /* Stop sharing the file-wide budget, releasing it with the last dataset */
+    if(rdcc->pool) {
+        HDassert(rdcc->pool->nrefs > 0);
+        if(0 == --rdcc->pool->nrefs) {
+            HDassert(NULL == rdcc->pool->head);
+            HDassert(0 == rdcc->pool->nbytes_used);
+            rdcc->pool = H5FL_FREE(H5D_rdcc_pool_t, rdcc->pool);
+            if(H5F_SET_RDCC_POOL(dset->oloc.file, NULL) < 0)
+                HDONE_ERROR(H5E_FILE, H5E_CANTSET, FAIL, "can't reset chunk cache pool")
+        } /* end if */
+    } /* end if */
+
     /* Release cache structures */
     if(rdcc->slot)
         rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
+    H5D__chunk_addr_map_reset(rdcc);
+    H5D__chunk_image_reset(rdcc);
+    HDassert(0 == rdcc->img.nbytes_used);
     HDmemset(rdcc, 0, sizeof(H5D_rdcc_t));
 
     /* Compose chunked index info struct */
@@ -2657,6 +4172,7 @@ H5D__chunk_dest(H5D_t *dset, hid_t dxpl_id)
     idx_info.storage = &dset->shared->layout.storage.u.chunk;
 
     /* Free any index structures */
+    H5D__chunk_dedup_dest(sc);
     if(dset->shared->layout.storage.u.chunk.ops->dest &&
             (dset->shared->layout.storage.u.chunk.ops->dest)(&idx_info) < 0)
 	HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to release chunk index info")
@@ -2694,6 +4210,10 @@ H5D_chunk_idx_reset(H5O_storage_chunk_t *storage, hbool_t reset_addr)
     if((storage->ops->reset)(storage, reset_addr) < 0)
 	HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to reset chunk index info")
 
+    /* The counts of chunks sharing blocks belong to the open dataset */
+    storage->dedup = NULL;
+    storage->free_batch = NULL;
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D_chunk_idx_reset() */
@@ -2762,16 +4282,214 @@ H5D__chunk_cinfo_cache_update(H5D_chunk_cached_t *last, const H5D_chunk_ud_t *ud
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* H5D__chunk_cinfo_cache_update() */
 
-
+
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_cinfo_cache_found
- *
- * Purpose:	Look for chunk info in cache
+ * Function:	H5D__chunk_addr_map_usable
  *
- * Return:	TRUE/FALSE/FAIL
+ * Purpose:	Check if the locations of a dataset's chunks should be kept
+ *              in memory: the dataset's access property list asked for
+ *              it, the dataset has few enough chunks and its chunk index
+ *              needs to be searched to find a chunk.
  *
- * Programmer:	Quincey Koziol
- *              November 27, 2007
+ * Return:	TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__chunk_addr_map_usable(const H5D_t *dset)
+{
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);
+    hbool_t ret_value = TRUE;           /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(0 == dset->shared->cache.chunk.addr_map.max_nchunks || 0 == layout->nchunks
+            || layout->nchunks > dset->shared->cache.chunk.addr_map.max_nchunks)
+        HGOTO_DONE(FALSE)
+
+    /* Chunks without an index, or with only one, are found directly.  (The
+     * chunk indices used by extensible arrays whose unlimited dimension isn't
+     * the slowest changing one aren't computed here.) */
+    if(layout->idx_type == H5D_CHUNK_IDX_NONE || layout->idx_type == H5D_CHUNK_IDX_SINGLE
+            || (layout->idx_type == H5D_CHUNK_IDX_EARRAY && layout->u.earray.unlim_dim > 0))
+        HGOTO_DONE(FALSE)
+#ifdef H5_HAVE_PARALLEL
+    if(H5F_HAS_FEATURE(dset->oloc.file, H5FD_FEAT_HAS_MPI))
+        HGOTO_DONE(FALSE)
+#endif /* H5_HAVE_PARALLEL */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_addr_map_usable() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_addr_map_cb
+ *
+ * Purpose:	Copy the location of a chunk into the in-memory copy of the
+ *              chunk index.
+ *
+ * Return:	H5_ITER_CONT (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_addr_map_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
+{
+    const H5D_t *dset = (const H5D_t *)_udata;  /* Dataset */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);
+    H5D_chunk_addr_t *chunk_addr;       /* Chunk's location in memory */
+    unsigned    u;                      /* Local index variable */
+    int         ret_value = H5_ITER_CONT;   /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Ignore chunks outside the dataset's current extent */
+    for(u = 0; u < layout->ndims - 1; u++)
+        if(chunk_rec->scaled[u] >= layout->chunks[u])
+            HGOTO_DONE(H5_ITER_CONT)
+
+    chunk_addr = &dset->shared->cache.chunk.addr_map.addr[H5VM_array_offset_pre(layout->ndims - 1, layout->down_chunks, chunk_rec->scaled)];
+    chunk_addr->addr = chunk_rec->chunk_addr;
+    chunk_addr->nbytes = chunk_rec->nbytes;
+    chunk_addr->filter_mask = chunk_rec->filter_mask;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_addr_map_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_addr_map_build
+ *
+ * Purpose:	Read the locations of all the chunks of a dataset into an
+ *              array in memory, indexed by the chunks' indices in the
+ *              dataset's current dimensions.  The array is kept up to
+ *              date as chunks are allocated or removed, and looking up a
+ *              chunk in it replaces searching the chunk index.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_addr_map_build(const H5D_t *dset, hid_t dxpl_id)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Dataset's chunk cache */
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    hsize_t     nchunks = dset->shared->layout.u.chunk.nchunks;    /* # of chunks in dataset */
+    hsize_t     u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(NULL == rdcc->addr_map.addr);
+    HDassert(nchunks > 0 && nchunks <= rdcc->addr_map.max_nchunks);
+
+    /* Allocate the array, with every chunk unallocated */
+    if(NULL == (rdcc->addr_map.addr = H5FL_SEQ_MALLOC(H5D_chunk_addr_t, (size_t)nchunks)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk address map")
+    rdcc->addr_map.nchunks = nchunks;
+    for(u = 0; u < nchunks; u++) {
+        rdcc->addr_map.addr[u].addr = HADDR_UNDEF;
+        rdcc->addr_map.addr[u].nbytes = 0;
+        rdcc->addr_map.addr[u].filter_mask = 0;
+    } /* end for */
+
+    /* Copy the locations of the chunks in the index */
+    if((sc->ops->is_space_alloc)(sc)) {
+        H5D_chk_idx_info_t idx_info;    /* Chunked index info */
+
+        /* Compose chunked index info struct */
+        idx_info.f = dset->oloc.file;
+        idx_info.dxpl_id = dxpl_id;
+        idx_info.pline = &dset->shared->dcpl_cache.pline;
+        idx_info.layout = &dset->shared->layout.u.chunk;
+        idx_info.storage = sc;
+
+        if((sc->ops->iterate)(&idx_info, H5D__chunk_addr_map_cb, (void *)dset) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to iterate over chunk index to build address map")
+    } /* end if */
+
+done:
+    if(ret_value < 0)
+        H5D__chunk_addr_map_reset(rdcc);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_addr_map_build() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_addr_map_reset
+ *
+ * Purpose:	Release the in-memory copy of the chunk index, if there's
+ *              one.
+ *
+ * Return:	None
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_addr_map_reset(H5D_rdcc_t *rdcc)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    if(rdcc->addr_map.addr)
+        rdcc->addr_map.addr = H5FL_SEQ_FREE(H5D_chunk_addr_t, rdcc->addr_map.addr);
+    rdcc->addr_map.nchunks = 0;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5D__chunk_addr_map_reset() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_addr_map_set
+ *
+ * Purpose:	Update the location of a chunk in the in-memory copy of the
+ *              chunk index, if there's one, after the chunk was inserted
+ *              into (or removed from) the chunk index.
+ *
+ * Return:	None
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_addr_map_set(const H5D_t *dset, const hsize_t *scaled, haddr_t addr,
+    hsize_t nbytes, unsigned filter_mask)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);    /* Dataset's chunk cache */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);
+    H5D_chunk_addr_t *chunk_addr;       /* Chunk's location in memory */
+    unsigned u;                         /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(rdcc->addr_map.addr) {
+        for(u = 0; u < layout->ndims - 1; u++)
+            if(scaled[u] >= layout->chunks[u])
+                break;
+        if(u == layout->ndims - 1) {
+            chunk_addr = &rdcc->addr_map.addr[H5VM_array_offset_pre(layout->ndims - 1, layout->down_chunks, scaled)];
+            chunk_addr->addr = addr;
+            H5_CHECKED_ASSIGN(chunk_addr->nbytes, uint32_t, nbytes, hsize_t);
+            chunk_addr->filter_mask = filter_mask;
+        } /* end if */
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5D__chunk_addr_map_set() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cinfo_cache_found
+ *
+ * Purpose:	Look for chunk info in cache
+ *
+ * Return:	TRUE/FALSE/FAIL
+ *
+ * Programmer:	Quincey Koziol
+ *              November 27, 2007
  *
  *-------------------------------------------------------------------------
  */
@@ -2868,172 +4586,1527 @@ done:
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_hash_val
+ * Function:	H5D__chunk_hash_val
+ *
+ * Purpose:	To calculate the index of a set of slots in the chunk cache,
+ *		based on the dataset's scaled coordinates and sizes of the
+ *		faster dimensions.
+ *
+ * Return:	Hash value index
+ *
+ * Programmer:	Vailin Choi; Nov 2014
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled)
+{
+    hsize_t val;        /* Intermediate value */
+    unsigned ndims = shared->ndims;      /* Rank of dataset */
+    unsigned ret = 0;   /* Value to return */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(shared);
+    HDassert(scaled);
+
+    /* If the fastest changing dimension doesn't have enough entropy, use
+     *  other dimensions too
+     */
+    if(ndims > 1 && shared->cache.chunk.scaled_dims[ndims - 1] <= shared->cache.chunk.nsets) {
+        unsigned u;          /* Local index variable */
+
+        val = scaled[0];
+        for(u = 1; u < ndims; u++) {
+            val <<= shared->cache.chunk.scaled_encode_bits[u];
+            val ^= scaled[u];
+        } /* end for */
+    } /* end if */
+    else
+        val = scaled[ndims - 1];
+
+    /* Modulo value against the number of sets of slots */
+    ret = (unsigned)(val % shared->cache.chunk.nsets);
+
+    FUNC_LEAVE_NOAPI(ret)
+} /* H5D__chunk_hash_val() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_find
+ *
+ * Purpose:	Search the set of slots that a chunk's scaled coordinates
+ *		hash to for the chunk's cache entry.
+ *
+ * Return:	Index of the chunk's slot in the hash table, or UINT_MAX
+ *		if the chunk isn't cached
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_cache_find(const H5D_shared_t *shared, const hsize_t *scaled)
+{
+    const H5D_rdcc_t *rdcc = &(shared->cache.chunk);   /* Dataset's chunk cache */
+    unsigned first;     /* Index of first slot in set */
+    unsigned u, v;      /* Local index variables */
+    unsigned ret_value = UINT_MAX;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(shared);
+    HDassert(scaled);
+
+    if(rdcc->nsets > 0) {
+        first = H5D__chunk_hash_val(shared, scaled) * rdcc->nways;
+        for(u = first; u < first + rdcc->nways; u++) {
+            const H5D_rdcc_ent_t *ent = rdcc->slot[u];
+
+            if(ent) {
+                /* Verify that the cache entry is the correct chunk */
+                for(v = 0; v < shared->ndims; v++)
+                    if(scaled[v] != ent->scaled[v])
+                        break;
+                if(v == shared->ndims)
+                    HGOTO_DONE(u)
+            } /* end if */
+        } /* end for */
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_find() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_victim
+ *
+ * Purpose:	Choose the slot in a set of the chunk cache's hash table
+ *		for a new entry: an empty slot if there is one, otherwise
+ *		the slot of the set's least recently used unlocked entry,
+ *		which must be preempted first.
+ *
+ * Return:	Index of the slot in the hash table, or UINT_MAX if all
+ *		the entries in the set are locked
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_cache_victim(const H5D_rdcc_t *rdcc, unsigned set)
+{
+    unsigned first = set * rdcc->nways; /* Index of first slot in set */
+    unsigned u;                         /* Local index variable */
+    unsigned ret_value = UINT_MAX;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(set < rdcc->nsets);
+
+    for(u = first; u < first + rdcc->nways; u++) {
+        const H5D_rdcc_ent_t *ent = rdcc->slot[u];
+
+        if(NULL == ent)
+            HGOTO_DONE(u)
+        if(!ent->locked && (UINT_MAX == ret_value || ent->tick < rdcc->slot[ret_value]->tick))
+            ret_value = u;
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_victim() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_rehash
+ *
+ * Purpose:	Put each chunk in the cache into the set of slots its
+ *		coordinates hash to, in a hash table that holds none of
+ *		them, starting with the most recently added chunks.  The
+ *		chunks that no longer fit in their sets are evicted.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_rehash(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache)
+{
+    H5D_rdcc_t         *rdcc = &(dset->shared->cache.chunk);	/*raw data chunk cache */
+    H5D_rdcc_ent_t     *ent, *prev;	/*cache entry  */
+    H5D_rdcc_ent_t     tmp_head;        /* Sentinel entry for temporary entry list */
+    H5D_rdcc_ent_t     *tmp_tail;       /* Tail pointer for temporary entry list */
+    herr_t              ret_value = SUCCEED;      /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Add temporary entry list to rdcc */
+    (void)HDmemset(&tmp_head, 0, sizeof(tmp_head));
+    rdcc->tmp_head = &tmp_head;
+    tmp_tail = &tmp_head;
+
+    for(ent = rdcc->tail; ent; ent = prev) {
+        unsigned	    idx;	/* New index number	*/
+
+        /* Get the pointer to the previous cache entry */
+        prev = ent->prev;
+
+        idx = H5D__chunk_cache_victim(rdcc, H5D__chunk_hash_val(dset->shared, ent->scaled));
+        if(UINT_MAX != idx && NULL == rdcc->slot[idx]) {
+            /* Insert this chunk into its new location in hash table */
+            rdcc->slot[idx] = ent;
+            ent->idx = idx;
+        } /* end if */
+        else {
+            HDassert(ent->locked == FALSE);
+            HDassert(ent->deleted == FALSE);
+
+            /* The chunk's set is full: insert the entry into the temporary
+             * list, but do not evict (yet).  (Its old index may be past
+             * the end of a smaller hash table.) */
+            HDassert(!ent->tmp_next);
+            HDassert(!ent->tmp_prev);
+            tmp_tail->tmp_next = ent;
+            ent->tmp_prev = tmp_tail;
+            tmp_tail = ent;
+            ent->idx = 0;
+        } /* end else */
+    } /* end for */
+
+    /* tmp_tail is no longer needed, and will be invalidated by
+     * H5D_chunk_cache_evict anyways. */
+    tmp_tail = NULL;
+
+    /* Evict chunks that are still on the temporary list */
+    while(tmp_head.tmp_next) {
+        ent = tmp_head.tmp_next;
+
+        /* Remove the old entry from the cache */
+        if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+    } /* end while */
+
+done:
+    /* Remove temporary list from rdcc */
+    rdcc->tmp_head = NULL;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_rehash() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_resize
+ *
+ * Purpose:	Change the size of a dataset's chunk cache to NBYTES_MAX,
+ *		scaling the number of slots in its hash table by the same
+ *		factor.  Chunks are preempted when the cache is shrunk.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_resize(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, size_t nbytes_max)
+{
+    H5D_rdcc_t  *rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+    H5D_rdcc_ent_t **slot;              /* New hash table */
+    size_t      nslots;                 /* New # of slots */
+    size_t      nsets;                  /* New # of sets of slots */
+    unsigned    nways;                  /* New # of slots in each set */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(rdcc->nslots > 0 && rdcc->nbytes_max > 0);
+    HDassert(nbytes_max > 0);
+
+    /* Scale the number of slots, and divide them into sets */
+    nslots = (size_t)((double)rdcc->nslots * ((double)nbytes_max / (double)rdcc->nbytes_max));
+    nslots = MAX(nslots, H5D_CHUNK_CACHE_NWAYS);
+    nways = (unsigned)MIN(nslots, H5D_CHUNK_CACHE_NWAYS);
+    nsets = (nslots + nways - 1) / nways;
+
+    /* Preempt chunks until they fit in the smaller cache */
+    if(nbytes_max < rdcc->nbytes_max) {
+        rdcc->nbytes_max = nbytes_max;
+        if(H5D__chunk_cache_prune(dset, dxpl_id, dxpl_cache, (size_t)0) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt chunks from cache")
+    } /* end if */
+    rdcc->nbytes_max = nbytes_max;
+    rdcc->nslots = nslots;
+
+    /* Move the chunks to a new hash table, when the number of sets changes */
+    if(nsets != rdcc->nsets || nways != rdcc->nways) {
+        if(NULL == (slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, nsets * nways)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+        rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
+        rdcc->slot = slot;
+        rdcc->nsets = nsets;
+        rdcc->nways = nways;
+
+        if(H5D__chunk_cache_rehash(dset, dxpl_id, dxpl_cache) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to rehash raw data chunk cache")
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_resize() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_cache_adapt
+ *
+ * Purpose:	At the end of each epoch of chunk accesses, decide whether
+ *		to resize a dataset's chunk cache within the range set with
+ *		H5Pset_chunk_cache_resize.  The cache is doubled (to at
+ *		least two chunks) when it was full, or too small for a chunk,
+ *		and the hit rate was low, and shrunk to twice the
+ *		size of the chunks accessed during the epoch (but not below
+ *		one chunk) when those chunks filled less than a quarter of
+ *		it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_adapt(const H5D_io_info_t *io_info)
+{
+    const H5D_t *dset = io_info->dset;  /* Dataset */
+    H5D_rdcc_t  *rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+    size_t      chunk_size = dset->shared->layout.u.chunk.size;    /* Size of a chunk */
+    size_t      naccesses = rdcc->resize.nhits + rdcc->resize.nmisses;  /* # of accesses in epoch */
+    size_t      nbytes_accessed = 0;    /* Size of cached chunks accessed in epoch */
+    size_t      nbytes_max = rdcc->nbytes_max;  /* New size of cache */
+    const H5D_rdcc_ent_t *ent;          /* Cache entry */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(rdcc->resize.max_nbytes > 0);
+
+    if(naccesses < H5D_CHUNK_CACHE_RESIZE_EPOCH)
+        HGOTO_DONE(SUCCEED)
+
+    for(ent = rdcc->head; ent; ent = ent->next)
+        if(ent->tick > rdcc->resize.tick)
+            nbytes_accessed += chunk_size;
+
+    if((double)rdcc->resize.nhits < H5D_CHUNK_CACHE_RESIZE_HIT_RATE * (double)naccesses
+            && rdcc->nbytes_used + chunk_size > rdcc->nbytes_max) {
+        nbytes_max = rdcc->nbytes_max > rdcc->resize.max_nbytes / 2 ? rdcc->resize.max_nbytes : 2 * rdcc->nbytes_max;
+
+        /* Make room for at least two chunks, so chunks larger than the
+         * cache, which bypass it, start being cached */
+        if(nbytes_max / 2 < chunk_size)
+            nbytes_max = chunk_size > rdcc->resize.max_nbytes / 2 ? rdcc->resize.max_nbytes : 2 * chunk_size;
+    } /* end if */
+    else if(nbytes_accessed < rdcc->nbytes_max / 4)
+        nbytes_max = MAX3(2 * nbytes_accessed, chunk_size, rdcc->resize.min_nbytes);
+
+    if(nbytes_max != rdcc->nbytes_max)
+        if(H5D__chunk_cache_resize(dset, io_info->md_dxpl_id, io_info->dxpl_cache, nbytes_max) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to resize raw data chunk cache")
+
+    /* Start the next epoch */
+    rdcc->resize.nhits = rdcc->resize.nmisses = 0;
+    rdcc->resize.tick = rdcc->tick;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_adapt() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_image_take
+ *
+ * Purpose:	Take the filtered image of the chunk at ADDR out of the
+ *		second tier of the dataset's chunk cache, as the chunk is
+ *		brought back into the first.  If SCALED is non-NULL, the
+ *		image is only returned if it has scaled coordinates SCALED
+ *		and NBYTES bytes in the file (a mismatched image is just
+ *		discarded).
+ *
+ * Return:	The image, owned by the caller from then on, or NULL if it
+ *		isn't cached
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5D__chunk_image_take(const H5D_t *dset, haddr_t addr, const hsize_t *scaled,
+    size_t nbytes)
+{
+    H5D_rdcc_t  *rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+    H5D_rdcc_img_t *img;                /* Cached image */
+    void        *ret_value = NULL;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(NULL == rdcc->img.sl || NULL == (img = (H5D_rdcc_img_t *)H5SL_remove(rdcc->img.sl, &addr)))
+        HGOTO_DONE(NULL)
+
+    /* Unlink it from the list */
+    if(img->prev)
+        img->prev->next = img->next;
+    else
+        rdcc->img.head = img->next;
+    if(img->next)
+        img->next->prev = img->prev;
+    else
+        rdcc->img.tail = img->prev;
+    rdcc->img.nbytes_used -= img->nbytes;
+
+    if(scaled && (img->nbytes != nbytes || HDmemcmp(img->scaled, scaled, sizeof(hsize_t) * dset->shared->ndims)))
+        H5MM_xfree(img->image);
+    else
+        ret_value = img->image;
+    img = H5FL_FREE(H5D_rdcc_img_t, img);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_image_take() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_image_put
+ *
+ * Purpose:	Keep IMAGE, the filtered image of a chunk as it is stored
+ *		at ADDR in the file, in the second tier of the dataset's
+ *		chunk cache, as the chunk is evicted from the first.  The
+ *		least recently used images are discarded to make room for
+ *		it.  IMAGE is owned by the cache from then on, whether this
+ *		succeeds or not.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_image_put(const H5D_t *dset, haddr_t addr, const hsize_t *scaled,
+    size_t nbytes, void *image)
+{
+    H5D_rdcc_t  *rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+    H5D_rdcc_img_t *img = NULL;         /* New cached image */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(H5F_addr_defined(addr));
+    HDassert(image);
+
+    /* Replace any image at the same address */
+    H5D__chunk_image_remove(dset, addr);
+    if(nbytes > rdcc->img.nbytes_max)
+        HGOTO_DONE(SUCCEED)
+
+    if(NULL == rdcc->img.sl)
+        if(NULL == (rdcc->img.sl = H5SL_create(H5SL_TYPE_HADDR, NULL)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "can't create skip list for chunk images")
+
+    /* Discard the least recently used images.  (The images kept with
+     * cached chunks count against the budget too, so there may still be
+     * no room) */
+    while(rdcc->img.head && rdcc->img.nbytes_used + nbytes > rdcc->img.nbytes_max)
+        H5D__chunk_image_remove(dset, rdcc->img.head->addr);
+    if(rdcc->img.nbytes_used + nbytes > rdcc->img.nbytes_max)
+        HGOTO_DONE(SUCCEED)
+
+    if(NULL == (img = H5FL_MALLOC(H5D_rdcc_img_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk image")
+    img->image = image;
+    img->addr = addr;
+    img->nbytes = nbytes;
+    HDmemcpy(img->scaled, scaled, sizeof(hsize_t) * dset->shared->ndims);
+    if(H5SL_insert(rdcc->img.sl, img, &img->addr) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't insert chunk image into skip list")
+    image = NULL;
+
+    /* Append it to the list */
+    img->next = NULL;
+    img->prev = rdcc->img.tail;
+    if(rdcc->img.tail)
+        rdcc->img.tail->next = img;
+    else
+        rdcc->img.head = img;
+    rdcc->img.tail = img;
+    rdcc->img.nbytes_used += nbytes;
+    img = NULL;
+
+done:
+    /* Release the image, if it wasn't kept */
+    H5MM_xfree(image);
+    if(img)
+        img = H5FL_FREE(H5D_rdcc_img_t, img);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_image_put() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_image_remove
+ *
+ * Purpose:	Discard the image of the chunk at ADDR (if any) from the
+ *		second tier of the dataset's chunk cache, before the chunk
+ *		is written again.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_image_remove(const H5D_t *dset, haddr_t addr)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    H5MM_xfree(H5D__chunk_image_take(dset, addr, NULL, (size_t)0));
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_image_remove() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_image_reset
+ *
+ * Purpose:	Discard all the images in the second tier of a dataset's
+ *		chunk cache.  (The images kept with cached chunks remain,
+ *		and stay charged to the second tier's budget)
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_image_reset(H5D_rdcc_t *rdcc)
+{
+    H5D_rdcc_img_t *img, *next;         /* Cached images */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(img = rdcc->img.head; img; img = next) {
+        next = img->next;
+        rdcc->img.nbytes_used -= img->nbytes;
+        H5MM_xfree(img->image);
+        img = H5FL_FREE(H5D_rdcc_img_t, img);
+    } /* end for */
+    rdcc->img.head = rdcc->img.tail = NULL;
+    if(rdcc->img.sl) {
+        H5SL_close(rdcc->img.sl);
+        rdcc->img.sl = NULL;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_image_reset() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_image_attach
+ *
+ * Purpose:	Keep IMAGE, the filtered image of the chunk in cache entry
+ *		ENT, with the entry, charging it to the budget of the second
+ *		tier of the dataset's chunk cache.  The least recently used
+ *		images in the second tier are discarded to make room for it;
+ *		if there still isn't room, IMAGE is discarded instead.  IMAGE
+ *		is owned by the cache from then on.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_image_attach(const H5D_t *dset, H5D_rdcc_ent_t *ent, void *image)
+{
+    H5D_rdcc_t  *rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+    size_t      nbytes = (size_t)ent->chunk_block.length;  /* Size of image */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(NULL == ent->image);
+    HDassert(image);
+
+    /* Discard the least recently used images */
+    while(rdcc->img.head && rdcc->img.nbytes_used + nbytes > rdcc->img.nbytes_max)
+        H5D__chunk_image_remove(dset, rdcc->img.head->addr);
+
+    if(rdcc->img.nbytes_used + nbytes <= rdcc->img.nbytes_max) {
+        ent->image = image;
+        rdcc->img.nbytes_used += nbytes;
+    } /* end if */
+    else
+        H5MM_xfree(image);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_image_attach() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_image_detach
+ *
+ * Purpose:	Take the filtered image (if any) kept with cache entry ENT
+ *		from it, releasing its charge to the budget of the second
+ *		tier of the chunk cache.
+ *
+ * Return:	The image, which the caller must free or put in the second
+ *		tier (NULL if the entry has none)
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5D__chunk_image_detach(H5D_rdcc_t *rdcc, H5D_rdcc_ent_t *ent)
+{
+    void        *ret_value = ent->image;        /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(ent->image) {
+        HDassert(rdcc->img.nbytes_used >= (size_t)ent->chunk_block.length);
+        rdcc->img.nbytes_used -= (size_t)ent->chunk_block.length;
+        ent->image = NULL;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_image_detach() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_dedup_add
+ *
+ * Purpose:	Count another chunk stored in the block at ADDR of a
+ *		dataset whose chunks are deduplicated.
+ *
+ * Return:	Success:	Pointer to the block's entry
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5D_chunk_dedup_ent_t *
+H5D__chunk_dedup_add(H5D_chunk_dedup_t *dedup, haddr_t addr, hsize_t nbytes)
+{
+    H5D_chunk_dedup_ent_t *blk;         /* Block's entry */
+    H5D_chunk_dedup_ent_t *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dedup);
+    HDassert(H5F_addr_defined(addr));
+
+    if(NULL != (blk = (H5D_chunk_dedup_ent_t *)H5SL_search(dedup->blocks, &addr)))
+        blk->nrefs++;
+    else {
+        if(NULL == (blk = H5FL_CALLOC(H5D_chunk_dedup_ent_t)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for deduplicated block")
+        blk->addr = addr;
+        blk->nbytes = nbytes;
+        blk->nrefs = 1;
+        if(H5SL_insert(dedup->blocks, blk, &blk->addr) < 0) {
+            blk = H5FL_FREE(H5D_chunk_dedup_ent_t, blk);
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, NULL, "can't insert deduplicated block")
+        } /* end if */
+    } /* end else */
+
+    ret_value = blk;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_dedup_add() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_dedup_unhash
+ *
+ * Purpose:	Take a block out of the chain of blocks whose contents have
+ *		the same hash, before its contents change or it's freed.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_dedup_unhash(H5D_chunk_dedup_t *dedup, H5D_chunk_dedup_ent_t *blk)
+{
+    H5D_chunk_dedup_ent_t *prev;        /* Block before BLK in the chain */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(blk->hashed) {
+        prev = (H5D_chunk_dedup_ent_t *)H5SL_search(dedup->hashes, &blk->hash);
+        HDassert(prev);
+        if(prev == blk) {
+            /* The chain is keyed by its first block, so pass the key on */
+            H5SL_remove(dedup->hashes, &blk->hash);
+            if(blk->hash_next && H5SL_insert(dedup->hashes, blk->hash_next, &blk->hash_next->hash) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't insert deduplicated block hash")
+        } /* end if */
+        else {
+            while(prev->hash_next != blk)
+                prev = prev->hash_next;
+            prev->hash_next = blk->hash_next;
+        } /* end else */
+        blk->hash_next = NULL;
+        blk->hashed = FALSE;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_dedup_unhash() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_dedup_set_hash
+ *
+ * Purpose:	Record the hash of the contents just written to the block
+ *		at ADDR, so that identical chunks written later can share
+ *		the block.  A block that's new to the dataset holds one
+ *		chunk.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_dedup_set_hash(H5D_chunk_dedup_t *dedup, haddr_t addr, hsize_t nbytes,
+    unsigned hash, unsigned filter_mask)
+{
+    H5D_chunk_dedup_ent_t *blk;         /* Block's entry */
+    H5D_chunk_dedup_ent_t *head;        /* First block with the same hash */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dedup);
+
+    if(NULL == (blk = (H5D_chunk_dedup_ent_t *)H5SL_search(dedup->blocks, &addr))) {
+        if(NULL == (blk = H5D__chunk_dedup_add(dedup, addr, nbytes)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't add deduplicated block")
+    } /* end if */
+    else if(H5D__chunk_dedup_unhash(dedup, blk) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "can't remove deduplicated block hash")
+    HDassert(blk->nrefs == 1);
+
+    blk->nbytes = nbytes;
+    blk->hash = hash;
+    blk->filter_mask = filter_mask;
+    blk->hashed = TRUE;
+    if(NULL != (head = (H5D_chunk_dedup_ent_t *)H5SL_search(dedup->hashes, &hash))) {
+        blk->hash_next = head->hash_next;
+        head->hash_next = blk;
+    } /* end if */
+    else if(H5SL_insert(dedup->hashes, blk, &blk->hash) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't insert deduplicated block hash")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_dedup_set_hash() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_dedup_find
+ *
+ * Purpose:	Look for a block of the dataset whose contents are the same
+ *		as the NBYTES bytes of filtered chunk in BUF.  Blocks with
+ *		the same hash are read back and compared, so a block is
+ *		only shared when its contents really are identical.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_dedup_find(const H5D_t *dset, unsigned hash, unsigned filter_mask,
+    const void *buf, size_t nbytes, H5D_chunk_dedup_ent_t **found)
+{
+    H5D_chunk_dedup_t *dedup = dset->shared->layout.storage.u.chunk.dedup;
+    H5D_chunk_dedup_ent_t *blk;         /* Block with the same hash */
+    void        *cmp_buf = NULL;        /* Contents of block */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(dedup);
+    HDassert(found);
+
+    *found = NULL;
+    for(blk = (H5D_chunk_dedup_ent_t *)H5SL_search(dedup->hashes, &hash); blk; blk = blk->hash_next)
+        if(blk->nbytes == nbytes && blk->filter_mask == filter_mask) {
+            if(NULL == cmp_buf && NULL == (cmp_buf = H5MM_malloc(nbytes)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk comparison")
+            if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, blk->addr, nbytes, H5AC_rawdata_dxpl_id, cmp_buf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read raw data chunk")
+            if(0 == HDmemcmp(cmp_buf, buf, nbytes)) {
+                *found = blk;
+                break;
+            } /* end if */
+        } /* end if */
+
+done:
+    H5MM_xfree(cmp_buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_dedup_find() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_dedup_is_shared
+ *
+ * Purpose:	Check whether the block at ADDR holds more than one chunk,
+ *		in which case it mustn't be overwritten or resized.
+ *
+ * Return:	TRUE if the block is shared, FALSE otherwise
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__chunk_dedup_is_shared(const H5O_storage_chunk_t *storage, haddr_t addr)
+{
+    H5D_chunk_dedup_ent_t *blk;         /* Block's entry */
+    hbool_t     ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(storage->dedup && NULL != (blk = (H5D_chunk_dedup_ent_t *)H5SL_search(storage->dedup->blocks, &addr)))
+        ret_value = (blk->nrefs > 1);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_dedup_is_shared() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_dedup_build_cb
+ *
+ * Purpose:	Count a chunk of the index in the block it's stored in.
+ *
+ * Return:	H5_ITER_CONT on success/H5_ITER_ERROR on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_dedup_build_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
+{
+    H5D_chunk_dedup_t *dedup = (H5D_chunk_dedup_t *)_udata;   /* Blocks of dataset */
+    int         ret_value = H5_ITER_CONT;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(NULL == H5D__chunk_dedup_add(dedup, chunk_rec->chunk_addr, (hsize_t)chunk_rec->nbytes))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, H5_ITER_ERROR, "can't add deduplicated block")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_dedup_build_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_dedup_create
+ *
+ * Purpose:	Count the chunks stored in each block of a dataset whose
+ *		chunks are deduplicated, from its chunk index.  The counts
+ *		aren't stored in the file, so they're made again when an
+ *		open dataset first writes or removes a chunk, or when it's
+ *		deleted.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_dedup_create(const H5D_chk_idx_info_t *idx_info)
+{
+    H5D_chunk_dedup_t *dedup;           /* Blocks of dataset */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(idx_info);
+    HDassert(idx_info->storage);
+    HDassert(NULL == idx_info->storage->dedup);
+
+    if(NULL == (dedup = H5FL_CALLOC(H5D_chunk_dedup_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for deduplicated blocks")
+    idx_info->storage->dedup = dedup;
+    if(NULL == (dedup->blocks = H5SL_create(H5SL_TYPE_HADDR, NULL)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "can't create skip list for deduplicated blocks")
+    if(NULL == (dedup->hashes = H5SL_create(H5SL_TYPE_UNSIGNED, NULL)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "can't create skip list for deduplicated block hashes")
+
+    if((idx_info->storage->ops->is_space_alloc)(idx_info->storage))
+        if((idx_info->storage->ops->iterate)(idx_info, H5D__chunk_dedup_build_cb, dedup) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to count chunks in deduplicated blocks")
+
+done:
+    if(ret_value < 0 && idx_info->storage->dedup)
+        H5D__chunk_dedup_dest(idx_info->storage);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_dedup_create() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_dedup_load
+ *
+ * Purpose:	Make sure the chunks stored in each block are counted, if
+ *		the dataset's chunks are deduplicated, before a chunk's
+ *		block may be freed, rewritten or shared.  Datasets which
+ *		are only read never count them.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_dedup_load(const H5D_chk_idx_info_t *idx_info)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(idx_info);
+    HDassert(idx_info->layout);
+    HDassert(idx_info->storage);
+
+    if((idx_info->layout->flags & H5O_LAYOUT_CHUNK_DEDUP_IDENTICAL_CHUNKS)
+            && NULL == idx_info->storage->dedup)
+        if(H5D__chunk_dedup_create(idx_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to count chunks in deduplicated blocks")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_dedup_load() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_dedup_free_cb
+ *
+ * Purpose:	Release an entry for a block of a deduplicated dataset.
+ *
+ * Return:	0
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_dedup_free_cb(void *item, void H5_ATTR_UNUSED *key, void H5_ATTR_UNUSED *op_data)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    item = H5FL_FREE(H5D_chunk_dedup_ent_t, item);
+
+    FUNC_LEAVE_NOAPI(0)
+} /* end H5D__chunk_dedup_free_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_dedup_dest
+ *
+ * Purpose:	Discard the counts of chunks in the blocks of a dataset
+ *		whose chunks are deduplicated.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_dedup_dest(H5O_storage_chunk_t *storage)
+{
+    H5D_chunk_dedup_t *dedup = storage->dedup;  /* Blocks of dataset */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(dedup) {
+        if(dedup->hashes)
+            H5SL_close(dedup->hashes);
+        if(dedup->blocks)
+            H5SL_destroy(dedup->blocks, H5D__chunk_dedup_free_cb, NULL);
+        dedup = H5FL_FREE(H5D_chunk_dedup_t, dedup);
+        storage->dedup = NULL;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__chunk_dedup_dest() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_free_block
+ *
+ * Purpose:	Release the file space of a chunk that's being removed or
+ *		moved.  When the dataset's chunks are deduplicated, the
+ *		space is only freed once no other chunk is stored in it.
+ *		While chunks are removed in bulk, the space is freed after
+ *		all of them have been removed.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_free_block(H5F_t *f, hid_t dxpl_id, const H5O_storage_chunk_t *storage,
+    haddr_t addr, hsize_t nbytes)
+{
+    H5D_chunk_dedup_ent_t *blk;         /* Block's entry */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(f);
+    HDassert(storage);
+
+    if(storage->dedup && NULL != (blk = (H5D_chunk_dedup_ent_t *)H5SL_search(storage->dedup->blocks, &addr))) {
+        /* Other chunks are still stored in the block */
+        if(blk->nrefs > 1) {
+            blk->nrefs--;
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+
+        if(H5D__chunk_dedup_unhash(storage->dedup, blk) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "can't remove deduplicated block hash")
+        H5SL_remove(storage->dedup->blocks, &addr);
+        blk = H5FL_FREE(H5D_chunk_dedup_ent_t, blk);
+    } /* end if */
+
+    /* Free the block with the others removed together, if chunks are
+     * being removed in bulk */
+    if(storage->free_batch) {
+        H5D_chunk_free_batch_t *batch = storage->free_batch;
+
+        if(batch->nused == batch->nalloc) {
+            size_t new_nalloc = MAX(64, batch->nalloc * 2);
+            H5F_block_t *new_blocks;
+
+            if(NULL == (new_blocks = (H5F_block_t *)H5MM_realloc(batch->blocks, new_nalloc * sizeof(H5F_block_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for blocks to free")
+            batch->blocks = new_blocks;
+            batch->nalloc = new_nalloc;
+        } /* end if */
+        batch->blocks[batch->nused].offset = addr;
+        batch->blocks[batch->nused].length = nbytes;
+        batch->nused++;
+    } /* end if */
+    else if(H5MF_xfree(f, H5FD_MEM_DRAW, dxpl_id, addr, nbytes) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_free_block() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_lookup
+ *
+ * Purpose:	Loops up a chunk in cache and on disk, and retrieves
+ *              information about that chunk.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Albert Cheng
+ *              June 27, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *scaled,
+    H5D_chunk_ud_t *udata)
+{
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    unsigned idx;                       /* Index of chunk in cache, if present */
+    herr_t ret_value = SUCCEED;	        /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(dset->shared->layout.u.chunk.ndims > 0);
+    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+    HDassert(scaled);
+    HDassert(udata);
+
+    /* Initialize the query information about the chunk we are looking for */
+    udata->common.layout = &(dset->shared->layout.u.chunk);
+    udata->common.storage = &(dset->shared->layout.storage.u.chunk);
+    udata->common.scaled = scaled;
+
+    /* Reset information about the chunk we are looking for */
+    udata->chunk_block.offset = HADDR_UNDEF;
+    udata->chunk_block.length = 0;
+    udata->filter_mask = 0;
+    udata->new_unfilt_chunk = FALSE;
+
+    /* Check for chunk in cache */
+    idx = H5D__chunk_cache_find(dset->shared, scaled);
+
+    /* Retrieve chunk addr */
+    if(UINT_MAX != idx) {
+        const H5D_rdcc_ent_t *ent = dset->shared->cache.chunk.slot[idx]; /* Cache entry */
+
+        udata->idx_hint = idx;
+        udata->chunk_block.offset = ent->chunk_block.offset;
+        udata->chunk_block.length = ent->chunk_block.length;;
+        udata->chunk_idx = ent->chunk_idx;
+    } /* end if */
+    else {
+        const H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);
+        const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);
+        hsize_t chunk_index = HSIZET_MAX;   /* Index of chunk in the in-memory chunk index */
+
+        /* Invalidate idx_hint, to signal that the chunk is not in cache */
+        udata->idx_hint = UINT_MAX;
+
+        /* (Re)build the in-memory copy of the chunk index, if it's needed */
+        if(rdcc->addr_map.max_nchunks > 0 && NULL == rdcc->addr_map.addr && H5D__chunk_addr_map_usable(dset))
+            if(H5D__chunk_addr_map_build(dset, dxpl_id) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to build chunk address map")
+
+        /* Look for the chunk in the in-memory chunk index, if there's one */
+        if(rdcc->addr_map.addr) {
+            unsigned u;
+
+            for(u = 0; u < layout->ndims - 1; u++)
+                if(scaled[u] >= layout->chunks[u])
+                    break;
+            if(u == layout->ndims - 1)
+                chunk_index = H5VM_array_offset_pre(layout->ndims - 1, layout->down_chunks, scaled);
+        } /* end if */
+        if(chunk_index < rdcc->addr_map.nchunks) {
+            const H5D_chunk_addr_t *chunk_addr = &rdcc->addr_map.addr[chunk_index];
+
+            if(H5F_addr_defined(chunk_addr->addr)) {
+                udata->chunk_block.offset = chunk_addr->addr;
+                udata->chunk_block.length = chunk_addr->nbytes;
+                udata->filter_mask = chunk_addr->filter_mask;
+            } /* end if */
+
+            /* (Same as the chunk index computed by the array indices) */
+            udata->chunk_idx = H5VM_array_offset_pre(layout->ndims - 1, layout->max_down_chunks, scaled);
+        } /* end if */
+        /* Check for cached information */
+        else if(!H5D__chunk_cinfo_cache_found(&rdcc->last, udata)) {
+            H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+#ifdef H5_HAVE_PARALLEL
+            H5P_coll_md_read_flag_t temp_cmr;   /* Temp value to hold the coll metadata read setting */
+#endif /* H5_HAVE_PARALLEL */
+
+            /* Compose chunked index info struct */
+            idx_info.f = dset->oloc.file;
+            idx_info.dxpl_id = dxpl_id;
+            idx_info.pline = &dset->shared->dcpl_cache.pline;
+            idx_info.layout = &dset->shared->layout.u.chunk;
+            idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+#ifdef H5_HAVE_PARALLEL
+            if(H5F_HAS_FEATURE(idx_info.f, H5FD_FEAT_HAS_MPI)) {
+                /* disable collective metadata read for chunk indexes
+                   as it is highly unlikely that users would read the
+                   same chunks from all processes. MSC - might turn on
+                   for root node? */
+                temp_cmr = H5F_COLL_MD_READ(idx_info.f);
+                H5F_set_coll_md_read(idx_info.f, H5P_FORCE_FALSE);
+            } /* end if */
+#endif /* H5_HAVE_PARALLEL */
+
+            /* Go get the chunk information */
+            if((dset->shared->layout.storage.u.chunk.ops->get_addr)(&idx_info, udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't query chunk address")
+
+#ifdef H5_HAVE_PARALLEL
+            if(H5F_HAS_FEATURE(idx_info.f, H5FD_FEAT_HAS_MPI))
+                H5F_set_coll_md_read(idx_info.f, temp_cmr);
+#endif /* H5_HAVE_PARALLEL */
+
+            /* Cache the information retrieved */
+            H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, udata);
+        } /* end if */
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_lookup() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_lookup_batch_cb
+ *
+ * Purpose:	Record the location of a chunk in the chunk index, if the
+ *              chunk is one of the selected chunks whose location isn't
+ *              known yet.
+ *
+ * Return:	H5_ITER_CONT (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_lookup_batch_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
+{
+    H5D_chunk_lookup_batch_ud_t *udata = (H5D_chunk_lookup_batch_ud_t *)_udata;
+    H5D_chunk_info_t *chunk_info;       /* Selected chunk's info */
+    hsize_t     chunk_index;            /* Index of chunk in dataset */
+    unsigned    u;                      /* Local index variable */
+    int         ret_value = H5_ITER_CONT;   /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Ignore chunks outside the dataset's current extent */
+    for(u = 0; u < udata->ndims; u++)
+        if(chunk_rec->scaled[u] >= udata->layout->chunks[u])
+            HGOTO_DONE(H5_ITER_CONT)
+
+    /* Check if the chunk is selected */
+    chunk_index = H5VM_array_offset_pre(udata->ndims, udata->layout->down_chunks, chunk_rec->scaled);
+    if(NULL != (chunk_info = (H5D_chunk_info_t *)H5SL_search(udata->fm->sel_chunks, &chunk_index)))
+        if(chunk_info->addr_known) {
+            chunk_info->chunk_block.offset = chunk_rec->chunk_addr;
+            chunk_info->chunk_block.length = chunk_rec->nbytes;
+            chunk_info->filter_mask = chunk_rec->filter_mask;
+        } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_lookup_batch_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_lookup_batch
+ *
+ * Purpose:	Look up the locations of all the chunks selected in FM with
+ *              one pass over the chunk index, instead of searching the
+ *              index once for each chunk, when the selected chunks are a
+ *              large enough part of the dataset.  The locations found are
+ *              kept in the chunks' info, for H5D__chunk_lookup_sel, until
+ *              the end of the read.
+ *
+ *              Chunks which are in the chunk cache are still looked up
+ *              one at a time, since their location may change when they
+ *              are flushed.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_lookup_batch(const H5D_io_info_t *io_info, H5D_chunk_map_t *fm)
+{
+    const H5D_t *dset = io_info->dset;  /* Local pointer to the dataset info */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);    /* Chunked layout info */
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    H5SL_node_t *chunk_node;            /* Current node in chunk skip list */
+    size_t      nsel;                   /* # of chunks selected */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(!fm->addrs_known);
+
+    /* Only look up many chunks, making up enough of the dataset, when the
+     * chunk index isn't in memory already */
+    if(fm->use_single || dset->shared->cache.chunk.addr_map.addr)
+        HGOTO_DONE(SUCCEED)
+    nsel = H5SL_count(fm->sel_chunks);
+    if(nsel < H5D_CHUNK_LOOKUP_BATCH_MIN || (hsize_t)nsel * H5D_CHUNK_LOOKUP_BATCH_DENSITY < layout->nchunks)
+        HGOTO_DONE(SUCCEED)
+
+    /* Chunks without an index, or with only one, are found directly.  The
+     * chunk indices used when inserting chunks into an extensible array
+     * whose unlimited dimension isn't the slowest changing one aren't
+     * available from the iteration, so those are looked up one at a time
+     * too. */
+    if(layout->idx_type == H5D_CHUNK_IDX_NONE || layout->idx_type == H5D_CHUNK_IDX_SINGLE
+            || (layout->idx_type == H5D_CHUNK_IDX_EARRAY && layout->u.earray.unlim_dim > 0))
+        HGOTO_DONE(SUCCEED)
+#ifdef H5_HAVE_PARALLEL
+    if(H5F_HAS_FEATURE(dset->oloc.file, H5FD_FEAT_HAS_MPI))
+        HGOTO_DONE(SUCCEED)
+#endif /* H5_HAVE_PARALLEL */
+
+    /* Reset the locations of the selected chunks, noting which are cached */
+    for(chunk_node = H5SL_first(fm->sel_chunks); chunk_node; chunk_node = H5SL_next(chunk_node)) {
+        H5D_chunk_info_t *chunk_info = (H5D_chunk_info_t *)H5SL_item(chunk_node);
+
+        chunk_info->addr_known = (UINT_MAX == H5D__chunk_cache_find(dset->shared, chunk_info->scaled));
+        chunk_info->chunk_block.offset = HADDR_UNDEF;
+        chunk_info->chunk_block.length = 0;
+        chunk_info->filter_mask = 0;
+    } /* end for */
+
+    /* Find the selected chunks in the index, if it exists */
+    if((sc->ops->is_space_alloc)(sc)) {
+        H5D_chk_idx_info_t idx_info;            /* Chunked index info */
+        H5D_chunk_lookup_batch_ud_t udata;      /* User data for iteration callback */
+
+        /* Compose chunked index info struct */
+        idx_info.f = dset->oloc.file;
+        idx_info.dxpl_id = io_info->md_dxpl_id;
+        idx_info.pline = &dset->shared->dcpl_cache.pline;
+        idx_info.layout = &dset->shared->layout.u.chunk;
+        idx_info.storage = sc;
+
+        udata.fm = fm;
+        udata.layout = layout;
+        udata.ndims = dset->shared->ndims;
+
+        if((sc->ops->iterate)(&idx_info, H5D__chunk_lookup_batch_cb, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to iterate over chunk index")
+    } /* end if */
+
+    fm->addrs_known = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_lookup_batch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_lookup_sel
+ *
+ * Purpose:	Get the info about a selected chunk, as H5D__chunk_lookup
+ *              does, using the location found by H5D__chunk_lookup_batch
+ *              if there is one.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_lookup_sel(const H5D_t *dset, hid_t dxpl_id, const H5D_chunk_map_t *fm,
+    const H5D_chunk_info_t *chunk_info, H5D_chunk_ud_t *udata)
+{
+    herr_t ret_value = SUCCEED;	        /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Look the chunk up on its own, unless its location is known already */
+    if(!fm->addrs_known || !chunk_info->addr_known
+            || UINT_MAX != H5D__chunk_cache_find(dset->shared, chunk_info->scaled)) {
+        if(H5D__chunk_lookup(dset, dxpl_id, chunk_info->scaled, udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+    } /* end if */
+    else {
+        const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);    /* Chunked layout info */
+
+        udata->common.layout = layout;
+        udata->common.storage = &(dset->shared->layout.storage.u.chunk);
+        udata->common.scaled = chunk_info->scaled;
+        udata->chunk_block = chunk_info->chunk_block;
+        udata->filter_mask = chunk_info->filter_mask;
+        udata->new_unfilt_chunk = FALSE;
+        udata->idx_hint = UINT_MAX;
+
+        /* (Same as the chunk index computed by the array indices) */
+        udata->chunk_idx = H5VM_array_offset_pre(layout->ndims - 1, layout->max_down_chunks, chunk_info->scaled);
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_lookup_sel() */
+
+
+#ifdef H5D_CHUNK_FILTER_THREADS
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_flush_filter
  *
- * Purpose:	To calculate an index based on the dataset's scaled coordinates and
- *		sizes of the faster dimensions.
+ * Purpose:	Apply the I/O pipeline to a copy of one dirty chunk of a
+ *              batch, saving the result in the chunk's cache entry for
+ *              H5D__chunk_flush_entry.  This is called on a worker
+ *              thread, so it must only touch the chunk's own entry.
  *
- * Return:	Hash value index
+ *              No filter failure callback is made and no error is pushed
+ *              here: if a filter fails, the entry is left without filtered
+ *              data and the chunk is filtered again when it is flushed,
+ *              where any error is reported.
  *
- * Programmer:	Vailin Choi; Nov 2014
+ * Return:	Non-negative on success/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
-static unsigned
-H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled)
+static herr_t
+H5D__chunk_flush_filter(size_t idx, void *_batch)
 {
-    hsize_t val;        /* Intermediate value */
-    unsigned ndims = shared->ndims;      /* Rank of dataset */
-    unsigned ret = 0;   /* Value to return */
+    H5D_chunk_flush_batch_t *batch = (H5D_chunk_flush_batch_t *)_batch;
+    H5D_rdcc_ent_t *ent = batch->ent[idx];
+    H5Z_cb_t    filter_cb = {NULL, NULL};       /* No filter failure callback */
+    void        *buf = NULL;                    /* Buffer for filtered chunk */
+    size_t      alloc = batch->chunk_size;      /* Bytes allocated for BUF */
+    size_t      nbytes = batch->chunk_size;     /* Chunk size (in bytes) */
+    unsigned    filter_mask = 0;                /* Filters skipped */
+    herr_t      ret_value = SUCCEED;            /* Return value */
 
     FUNC_ENTER_STATIC_NOERR
 
     /* Sanity check */
-    HDassert(shared);
-    HDassert(scaled);
-
-    /* If the fastest changing dimension doesn't have enough entropy, use
-     *  other dimensions too
-     */
-    if(ndims > 1 && shared->cache.chunk.scaled_dims[ndims - 1] <= shared->cache.chunk.nslots) {
-        unsigned u;          /* Local index variable */
-
-        val = scaled[0];
-        for(u = 1; u < ndims; u++) {
-            val <<= shared->cache.chunk.scaled_encode_bits[u];
-            val ^= scaled[u];
-        } /* end for */
+    HDassert(ent->dirty);
+    HDassert(NULL == ent->filtered);
+
+    if(NULL == (buf = H5MM_malloc(alloc)))
+        HGOTO_DONE(FAIL)
+    HDmemcpy(buf, ent->chunk, alloc);
+    if(H5Z_pipeline(batch->pline, 0, &filter_mask, batch->err_detect, filter_cb,
+            &nbytes, &alloc, &buf) < 0)
+        HGOTO_DONE(FAIL)
+
+    /* Keep the filtered chunk, unless an optional filter was skipped */
+    if(0 == filter_mask) {
+        ent->filtered = buf;
+        ent->filtered_nbytes = nbytes;
+        ent->filtered_mask = filter_mask;
+        buf = NULL;
     } /* end if */
-    else
-        val = scaled[ndims - 1];
 
-    /* Modulo value against the number of array slots */
-    ret = (unsigned)(val % shared->cache.chunk.nslots);
+done:
+    H5MM_xfree(buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush_filter() */
+#endif /* H5D_CHUNK_FILTER_THREADS */
 
-    FUNC_LEAVE_NOAPI(ret)
-} /* H5D__chunk_hash_val() */
 
-
 /*-------------------------------------------------------------------------
- * Function:	H5D__chunk_lookup
- *
- * Purpose:	Loops up a chunk in cache and on disk, and retrieves
- *              information about that chunk.
+ * Function:	H5D__chunk_flush_filter_batch
+ *
+ * Purpose:	Filter a batch of the dirty chunks in the chunk cache ahead
+ *              of them being flushed, starting at entry START and going
+ *              toward the tail of the cache's list.  The filters are
+ *              applied concurrently, by up to the number of threads set
+ *              with H5Pset_chunk_flush_nthreads, and each entry keeps its
+ *              filtered chunk until H5D__chunk_flush_entry writes it.
+ *              The filtered chunks are charged to the chunk cache's
+ *              budget while they're kept.
+ *
+ *              On return, END points to the entry following the last one
+ *              examined, or is NULL if there are no more entries or no
+ *              batch can be filtered.
+ *
+ *              Nothing is done unless the library is thread-safe.  If
+ *              any chunk in the batch can't be filtered, the whole batch
+ *              is discarded and the chunks are filtered as they're
+ *              flushed instead, where any error is reported: no errors
+ *              are pushed while the batch is filtered.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Albert Cheng
- *              June 27, 1998
- *
  *-------------------------------------------------------------------------
  */
-herr_t
-H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id, const hsize_t *scaled,
-    H5D_chunk_ud_t *udata)
+static herr_t
+H5D__chunk_flush_filter_batch(const H5D_t *dset, const H5D_dxpl_cache_t *dxpl_cache,
+    H5D_rdcc_ent_t *start, H5D_rdcc_ent_t **end)
 {
-    H5D_rdcc_ent_t  *ent = NULL;        /* Cache entry */
-    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
-    unsigned idx;                       /* Index of chunk in cache, if present */
-    hbool_t found = FALSE;              /* In cache? */
-    herr_t ret_value = SUCCEED;	        /* Return value */
+#ifdef H5D_CHUNK_FILTER_THREADS
+    H5D_rdcc_t  *rdcc = &(dset->shared->cache.chunk);   /* Dataset's chunk cache */
+    const H5O_pline_t *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    H5D_chunk_flush_batch_t batch;      /* Batch of entries to filter */
+    size_t      u;                      /* Local index variable */
+#endif /* H5D_CHUNK_FILTER_THREADS */
+    herr_t      ret_value = SUCCEED;    /* Return value */
 
-    FUNC_ENTER_PACKAGE
+    FUNC_ENTER_STATIC
 
-    /* Sanity checks */
+    /* Sanity check */
     HDassert(dset);
-    HDassert(dset->shared->layout.u.chunk.ndims > 0);
-    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
-    HDassert(scaled);
-    HDassert(udata);
+    HDassert(dxpl_cache);
+    HDassert(end);
 
-    /* Initialize the query information about the chunk we are looking for */
-    udata->common.layout = &(dset->shared->layout.u.chunk);
-    udata->common.storage = &(dset->shared->layout.storage.u.chunk);
-    udata->common.scaled = scaled;
+    *end = NULL;
 
-    /* Reset information about the chunk we are looking for */
-    udata->chunk_block.offset = HADDR_UNDEF;
-    udata->chunk_block.length = 0;
-    udata->filter_mask = 0;
-    udata->new_unfilt_chunk = FALSE;
+#ifdef H5D_CHUNK_FILTER_THREADS
+    batch.nents = 0;
+    batch.ent = NULL;
 
-    /* Check for chunk in cache */
-    if(dset->shared->cache.chunk.nslots > 0) {
-        /* Determine the chunk's location in the hash table */
-        idx = H5D__chunk_hash_val(dset->shared, scaled);
-
-        /* Get the chunk cache entry for that location */
-        ent = dset->shared->cache.chunk.slot[idx];
-        if(ent) {
-            unsigned u;                  /* Counter */
-
-            /* Speculatively set the 'found' flag */
-            found = TRUE;
-
-            /* Verify that the cache entry is the correct chunk */
-            for(u = 0; u < dset->shared->ndims; u++)
-                if(scaled[u] != ent->scaled[u]) {
-                    found = FALSE;
-                    break;
+    if(rdcc->flush_nthreads > 1 && pline->nused > 0) {
+        H5D_rdcc_ent_t *ent;            /* Current cache entry */
+        size_t max_ents = (size_t)rdcc->flush_nthreads * H5D_CHUNK_FILTER_BATCH_PER_THREAD;
+        htri_t builtin;                 /* Whether the pipeline is all built-in filters */
+
+        /* Only the library's own filters are safe to run on other threads:
+         * application & plugin filters may call back into the library */
+        if((builtin = H5Z_pipeline_builtin(pline)) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't check filter pipeline")
+        if(!builtin)
+            HGOTO_DONE(SUCCEED)
+
+        if(NULL == (batch.ent = (H5D_rdcc_ent_t **)H5MM_malloc(max_ents * sizeof(H5D_rdcc_ent_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk batch")
+
+        /* Collect the dirty entries which will be filtered when flushed */
+        for(ent = start; ent && batch.nents < max_ents; ent = ent->next)
+            if(ent->dirty && !ent->locked && NULL == ent->filtered
+                    && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS))
+                batch.ent[batch.nents++] = ent;
+        *end = ent;
+
+        if(batch.nents > 1) {
+            double filter_start;    /* Time filtering started */
+            hbool_t discard;        /* Whether errors were being discarded */
+            herr_t status;          /* Status of filtering the batch */
+
+            batch.pline = pline;
+            batch.err_detect = dxpl_cache->err_detect;
+            batch.chunk_size = dset->shared->layout.u.chunk.size;
+
+            filter_start = H5_get_time();
+            discard = H5E_set_discard(TRUE);
+            status = H5TS_parallel_for(rdcc->flush_nthreads, batch.nents, H5D__chunk_flush_filter, &batch);
+            (void)H5E_set_discard(discard);
+            for(u = 0; u < batch.nents; u++) {
+                H5D_rdcc_ent_t *bent = batch.ent[u];
+
+                if(status < 0)
+                    bent->filtered = H5MM_xfree(bent->filtered);
+                else if(bent->filtered) {
+                    /* Charge the filtered chunk to the cache's budget */
+                    rdcc->nbytes_used += bent->filtered_nbytes;
+                    if(rdcc->pool)
+                        rdcc->pool->nbytes_used += bent->filtered_nbytes;
                 } /* end if */
+            } /* end for */
+            rdcc->stats.filter_time += H5_get_time() - filter_start;
         } /* end if */
     } /* end if */
 
-    /* Retrieve chunk addr */
-    if(found) {
-        udata->idx_hint = idx;
-        udata->chunk_block.offset = ent->chunk_block.offset;
-        udata->chunk_block.length = ent->chunk_block.length;;
-        udata->chunk_idx = ent->chunk_idx;
-    } /* end if */
-    else {
-        /* Invalidate idx_hint, to signal that the chunk is not in cache */
-        udata->idx_hint = UINT_MAX;
-
-        /* Check for cached information */
-        if(!H5D__chunk_cinfo_cache_found(&dset->shared->cache.chunk.last, udata)) {
-            H5D_chk_idx_info_t idx_info;        /* Chunked index info */
-#ifdef H5_HAVE_PARALLEL
-            H5P_coll_md_read_flag_t temp_cmr;   /* Temp value to hold the coll metadata read setting */
-#endif /* H5_HAVE_PARALLEL */
+done:
+    batch.ent = (H5D_rdcc_ent_t **)H5MM_xfree(batch.ent);
+#endif /* H5D_CHUNK_FILTER_THREADS */
 
-            /* Compose chunked index info struct */
-            idx_info.f = dset->oloc.file;
-            idx_info.dxpl_id = dxpl_id;
-            idx_info.pline = &dset->shared->dcpl_cache.pline;
-            idx_info.layout = &dset->shared->layout.u.chunk;
-            idx_info.storage = &dset->shared->layout.storage.u.chunk;
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush_filter_batch() */
 
-#ifdef H5_HAVE_PARALLEL
-            if(H5F_HAS_FEATURE(idx_info.f, H5FD_FEAT_HAS_MPI)) {
-                /* disable collective metadata read for chunk indexes
-                   as it is highly unlikely that users would read the
-                   same chunks from all processes. MSC - might turn on
-                   for root node? */
-                temp_cmr = H5F_COLL_MD_READ(idx_info.f);
-                H5F_set_coll_md_read(idx_info.f, H5P_FORCE_FALSE);
-            } /* end if */
-#endif /* H5_HAVE_PARALLEL */
 
-            /* Go get the chunk information */
-            if((dset->shared->layout.storage.u.chunk.ops->get_addr)(&idx_info, udata) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't query chunk address")
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_filtered_take
+ *
+ * Purpose:	Take the chunk filtered ahead of being flushed (if any)
+ *              from a chunk cache entry, releasing its charge to the
+ *              cache's budget.
+ *
+ * Return:	The filtered chunk, which the caller must free (NULL if
+ *              the entry has none)
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5D__chunk_filtered_take(H5D_rdcc_t *rdcc, H5D_rdcc_ent_t *ent)
+{
+    void *ret_value = ent->filtered;    /* Return value */
 
-#ifdef H5_HAVE_PARALLEL
-            if(H5F_HAS_FEATURE(idx_info.f, H5FD_FEAT_HAS_MPI))
-                H5F_set_coll_md_read(idx_info.f, temp_cmr);
-#endif /* H5_HAVE_PARALLEL */
+    FUNC_ENTER_STATIC_NOERR
 
-            /* Cache the information retrieved */
-            H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, udata);
-        } /* end if */
-    } /* end else */
+    if(ent->filtered) {
+        HDassert(rdcc->nbytes_used >= ent->filtered_nbytes);
+        rdcc->nbytes_used -= ent->filtered_nbytes;
+        if(rdcc->pool)
+            rdcc->pool->nbytes_used -= ent->filtered_nbytes;
+        ent->filtered = NULL;
+    } /* end if */
 
-done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* H5D__chunk_lookup() */
+} /* end H5D__chunk_filtered_take() */
+
 
-
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_flush_entry
  *
@@ -3054,6 +6127,8 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
     H5D_rdcc_ent_t *ent, hbool_t reset)
 {
     void	*buf = NULL;	        /* Temporary buffer		*/
+    void	*filtered;	        /* Chunk filtered ahead of flush */
+    double	filter_start;	        /* Time filtering started */
     hbool_t	point_of_no_return = FALSE;
     H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
     herr_t	ret_value = SUCCEED;	/* Return value			*/
@@ -3067,12 +6142,22 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
     HDassert(ent);
     HDassert(!ent->locked);
 
+    /* Take the chunk filtered ahead of the flush (if any) from the entry */
+    filtered = H5D__chunk_filtered_take(&(dset->shared->cache.chunk), ent);
+
     buf = ent->chunk;
     if(ent->dirty) {
         H5D_chk_idx_info_t idx_info;    /* Chunked index info */
         H5D_chunk_ud_t 	udata;		/* pass through B-tree		*/
         hbool_t must_alloc = FALSE;     /* Whether the chunk must be allocated */
         hbool_t need_insert = FALSE;    /* Whether the chunk needs to be inserted into the index */
+        hbool_t is_filtered = FALSE;    /* Whether the chunk is written filtered */
+        hbool_t is_dup = FALSE;         /* Whether an identical chunk is already stored */
+        unsigned hash = 0;              /* Hash of the filtered chunk */
+
+        /* The image of the chunk in the file is about to change */
+        H5D__chunk_image_remove(dset, ent->chunk_block.offset);
+        H5MM_xfree(H5D__chunk_image_detach(&(dset->shared->cache.chunk), ent));
 
         /* Set up user data for index callbacks */
         udata.common.layout = &dset->shared->layout.u.chunk;
@@ -3089,31 +6174,42 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
             size_t alloc = udata.chunk_block.length;        /* Bytes allocated for BUF	*/
             size_t nbytes;                      /* Chunk size (in bytes) */
 
-            if(!reset) {
-                /*
-                 * Copy the chunk to a new buffer before running it through
-                 * the pipeline because we'll want to save the original buffer
-                 * for later.
-                 */
-                if(NULL == (buf = H5MM_malloc(alloc)))
-                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
-                HDmemcpy(buf, ent->chunk, alloc);
+            if(filtered) {
+                /* The chunk has already been run through the pipeline */
+                buf = filtered;
+                filtered = NULL;
+                nbytes = ent->filtered_nbytes;
+                udata.filter_mask = ent->filtered_mask;
             } /* end if */
             else {
-                /*
-                 * If we are reseting and something goes wrong after this
-                 * point then it's too late to recover because we may have
-                 * destroyed the original data by calling H5Z_pipeline().
-                 * The only safe option is to continue with the reset
-                 * even if we can't write the data to disk.
-                 */
-                point_of_no_return = TRUE;
-                ent->chunk = NULL;
+                if(!reset) {
+                    /*
+                     * Copy the chunk to a new buffer before running it through
+                     * the pipeline because we'll want to save the original buffer
+                     * for later.
+                     */
+                    if(NULL == (buf = H5MM_malloc(alloc)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
+                    HDmemcpy(buf, ent->chunk, alloc);
+                } /* end if */
+                else {
+                    /*
+                     * If we are reseting and something goes wrong after this
+                     * point then it's too late to recover because we may have
+                     * destroyed the original data by calling H5Z_pipeline().
+                     * The only safe option is to continue with the reset
+                     * even if we can't write the data to disk.
+                     */
+                    point_of_no_return = TRUE;
+                    ent->chunk = NULL;
+                } /* end else */
+                H5_CHECKED_ASSIGN(nbytes, size_t, udata.chunk_block.length, hsize_t);
+                filter_start = H5_get_time();
+                if(H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata.filter_mask), dxpl_cache->err_detect,
+                         dxpl_cache->filter_cb, &nbytes, &alloc, &buf) < 0)
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
+                dset->shared->cache.chunk.stats.filter_time += H5_get_time() - filter_start;
             } /* end else */
-            H5_CHECKED_ASSIGN(nbytes, size_t, udata.chunk_block.length, hsize_t);
-            if(H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata.filter_mask), dxpl_cache->err_detect,
-                     dxpl_cache->filter_cb, &nbytes, &alloc, &buf) < 0)
-                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
 #if H5_SIZEOF_SIZE_T > 4
             /* Check for the chunk expanding too much to encode in a 32-bit value */
             if(nbytes > ((size_t)0xffffffff))
@@ -3123,6 +6219,7 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
 
             /* Indicate that the chunk must be allocated */
             must_alloc = TRUE;
+            is_filtered = TRUE;
         } /* end if */
         else if(!H5F_addr_defined(udata.chunk_block.offset)) {
             /* Indicate that the chunk must be allocated */
@@ -3145,17 +6242,48 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
 
         HDassert(!(ent->edge_chunk_state & H5D_RDCC_NEWLY_DISABLED_FILTERS));
 
+        /* Compose chunked index info struct */
+        idx_info.f = dset->oloc.file;
+        idx_info.dxpl_id = dxpl_id;
+        idx_info.pline = &dset->shared->dcpl_cache.pline;
+        idx_info.layout = &dset->shared->layout.u.chunk;
+        idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+        /* Store the chunk in a block holding identical contents already, if
+         * there is one, instead of writing another copy */
+        if(is_filtered && H5D__chunk_dedup_load(&idx_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to count chunks in deduplicated blocks")
+        if(is_filtered && sc->dedup) {
+            H5D_chunk_dedup_ent_t *dup;     /* Block with identical contents */
+
+            H5_CHECK_OVERFLOW(udata.chunk_block.length, hsize_t, size_t);
+            hash = (unsigned)H5_checksum_lookup3(buf, (size_t)udata.chunk_block.length, 0);
+            if(H5D__chunk_dedup_find(dset, hash, udata.filter_mask, buf, (size_t)udata.chunk_block.length, &dup) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to look for identical chunk")
+            if(dup) {
+                if(!H5F_addr_eq(dup->addr, ent->chunk_block.offset)) {
+                    /* Release the chunk's previous block */
+                    if(H5F_addr_defined(ent->chunk_block.offset)
+                            && (H5D__chunk_dedup_is_shared(sc, ent->chunk_block.offset)
+                                || !(H5F_INTENT(idx_info.f) & H5F_ACC_SWMR_WRITE)))
+                        if(H5D__chunk_free_block(idx_info.f, dxpl_id, sc, ent->chunk_block.offset, ent->chunk_block.length) < 0)
+                            HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
+
+                    dup->nrefs++;
+                    udata.chunk_block.offset = dup->addr;
+                    need_insert = TRUE;
+                    ent->chunk_block.offset = udata.chunk_block.offset;
+                    ent->chunk_block.length = udata.chunk_block.length;
+                } /* end if */
+                must_alloc = FALSE;
+                is_dup = TRUE;
+            } /* end if */
+        } /* end if */
+
         /* Check if the chunk needs to be allocated (it also could exist already
          *      and the chunk alloc operation could resize it)
          */
         if(must_alloc) {
-            /* Compose chunked index info struct */
-            idx_info.f = dset->oloc.file;
-            idx_info.dxpl_id = dxpl_id;
-            idx_info.pline = &dset->shared->dcpl_cache.pline;
-            idx_info.layout = &dset->shared->layout.u.chunk;
-            idx_info.storage = &dset->shared->layout.storage.u.chunk;
-
             /* Create the chunk it if it doesn't exist, or reallocate the chunk
              *  if its size changed.
              */
@@ -3169,9 +6297,25 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
 
         /* Write the data to the file */
         HDassert(H5F_addr_defined(udata.chunk_block.offset));
-        H5_CHECK_OVERFLOW(udata.chunk_block.length, hsize_t, size_t);
-        if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, (size_t)udata.chunk_block.length, H5AC_rawdata_dxpl_id, buf) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+        if(!is_dup) {
+            H5_CHECK_OVERFLOW(udata.chunk_block.length, hsize_t, size_t);
+            if(H5F_block_write(dset->oloc.file, H5FD_MEM_DRAW, udata.chunk_block.offset, (size_t)udata.chunk_block.length, H5AC_rawdata_dxpl_id, buf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+            dset->shared->cache.chunk.stats.nbytes_written += udata.chunk_block.length;
+
+            /* Let identical chunks written later share the block */
+            if(is_filtered && sc->dedup)
+                if(H5D__chunk_dedup_set_hash(sc->dedup, udata.chunk_block.offset, udata.chunk_block.length, hash, udata.filter_mask) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to record hash of chunk")
+        } /* end if */
+
+        /* Keep the filtered image with the entry, so the chunk needn't be
+         * read if it's evicted and accessed again */
+        H5D__chunk_image_remove(dset, udata.chunk_block.offset);
+        if(is_filtered && dset->shared->cache.chunk.img.nbytes_max > 0) {
+            H5D__chunk_image_attach(dset, ent, buf);
+            buf = NULL;
+        } /* end if */
 
         /* Insert the chunk record into the index */
         if(need_insert && dset->shared->layout.storage.u.chunk.ops->insert)
@@ -3180,6 +6324,7 @@ H5D__chunk_flush_entry(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
 
         /* Cache the chunk's info, in case it's accessed again shortly */
         H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, &udata);
+        H5D__chunk_addr_map_set(dset, ent->scaled, udata.chunk_block.offset, udata.chunk_block.length, udata.filter_mask);
 
         /* Mark cache entry as clean */
         ent->dirty = FALSE;
@@ -3204,6 +6349,9 @@ done:
     if(buf != ent->chunk)
         H5MM_xfree(buf);
 
+    /* Free the filtered chunk, if it wasn't written */
+    H5MM_xfree(filtered);
+
     /*
      * If we reached the point of no return then we have no choice but to
      * reset the entry.  This can only happen if RESET is true but the
@@ -3246,7 +6394,10 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
     HDassert(dxpl_cache);
     HDassert(ent);
     HDassert(!ent->locked);
-    HDassert(ent->idx < rdcc->nslots);
+    HDassert(ent->idx < rdcc->nsets * rdcc->nways);
+
+    /* Increment # of evicted entries */
+    rdcc->stats.nevictions++;
 
     if(flush) {
         /* Flush */
@@ -3259,8 +6410,22 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
             ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
                     ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
                     : &(dset->shared->dcpl_cache.pline)));
+        H5MM_xfree(H5D__chunk_filtered_take(rdcc, ent));
     } /* end else */
 
+    /* Move the chunk's filtered image to the second tier of the cache,
+     * unless the chunk is being discarded */
+    if(ent->image) {
+        void *image = H5D__chunk_image_detach(rdcc, ent);   /* Chunk's filtered image */
+
+        if(flush && rdcc->img.nbytes_max > 0) {
+            if(H5D__chunk_image_put(dset, ent->chunk_block.offset, ent->scaled, (size_t)ent->chunk_block.length, image) < 0)
+                HDONE_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to cache filtered chunk image")
+        } /* end if */
+        else
+            H5MM_xfree(image);
+    } /* end if */
+
     /* Unlink from list */
     if(ent->prev)
         ent->prev->next = ent->next;
@@ -3287,6 +6452,12 @@ H5D__chunk_cache_evict(const H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t
          */
         rdcc->slot[ent->idx] = NULL;
 
+    /* Remove from the file-wide pool */
+    if(rdcc->pool) {
+        H5D__chunk_pool_remove(rdcc->pool, ent);
+        rdcc->pool->nbytes_used -= dset->shared->layout.u.chunk.size;
+    } /* end if */
+
     /* Remove from cache */
     HDassert(rdcc->slot[ent->idx] != ent);
     ent->idx = UINT_MAX;
@@ -3382,6 +6553,19 @@ H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
 	    if(cur) {
                 int j;          /* Local index variable */
 
+                /* Filter a batch of the dirty chunks that are next in line
+                 * for preemption, if this chunk hasn't been filtered already.
+                 * Any chunks left filtered are written when they're flushed
+                 * later (or discarded if they're modified again), and count
+                 * against the cache's budget until then.
+                 */
+                if(cur->dirty && NULL == cur->filtered) {
+                    H5D_rdcc_ent_t *batch_end;  /* Entry following the batch (unused) */
+
+                    if(H5D__chunk_flush_filter_batch(dset, dxpl_cache, cur, &batch_end) < 0)
+                        nerrors++;
+                } /* end if */
+
 		for(j = 0; j < nmeth; j++) {
 		    if(p[j] == cur)
                         p[j] = NULL;
@@ -3400,14 +6584,168 @@ H5D__chunk_cache_prune(const H5D_t *dset, hid_t dxpl_id,
             w[i] -= 1;
     } /* end while */
 
-    if(nerrors)
-	HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+    if(nerrors)
+	HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_prune() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_pool_append
+ *
+ * Purpose:	Add a cache entry to the end of the file-wide pool's list,
+ *		as the most recently used entry.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_pool_append(H5D_rdcc_pool_t *pool, H5D_rdcc_ent_t *ent)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(pool);
+    HDassert(ent);
+    HDassert(NULL == ent->pool_next && NULL == ent->pool_prev);
+
+    if(pool->tail) {
+        pool->tail->pool_next = ent;
+        ent->pool_prev = pool->tail;
+        pool->tail = ent;
+    } /* end if */
+    else
+        pool->head = pool->tail = ent;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_pool_append() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_pool_remove
+ *
+ * Purpose:	Unlink a cache entry from the file-wide pool's list.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_pool_remove(H5D_rdcc_pool_t *pool, H5D_rdcc_ent_t *ent)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(pool);
+    HDassert(ent);
+
+    if(ent->pool_prev)
+        ent->pool_prev->pool_next = ent->pool_next;
+    else
+        pool->head = ent->pool_next;
+    if(ent->pool_next)
+        ent->pool_next->pool_prev = ent->pool_prev;
+    else
+        pool->tail = ent->pool_prev;
+    ent->pool_prev = ent->pool_next = NULL;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_pool_remove() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_pool_prune
+ *
+ * Purpose:	Prune the file-wide chunk cache pool by preempting the least
+ *		recently used unlocked entries, from any of the file's open
+ *		datasets, until the pool has room for something which is
+ *		SIZE bytes.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_pool_prune(const H5D_t *dset, hid_t dxpl_id,
+    const H5D_dxpl_cache_t *dxpl_cache, size_t size)
+{
+    H5D_rdcc_pool_t	*pool = dset->shared->cache.chunk.pool;
+    H5D_rdcc_ent_t	*ent, *next;	/* Current & next entries in the pool */
+    int		nerrors = 0;            /* Accumulated error count during preemptions */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(pool);
+
+    for(ent = pool->head; ent && (pool->nbytes_used + size) > pool->nbytes_max; ent = next) {
+        next = ent->pool_next;
+
+        /* (Entries of other datasets are flushed through the dataset which
+         * cached them) */
+        if(!ent->locked)
+            if(H5D__chunk_cache_evict(ent->dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
+                nerrors++;
+    } /* end for */
+
+    if(nerrors)
+	HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_pool_prune() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_pool_close
+ *
+ * Purpose:	Preempt the entries which were cached through DSET from the
+ *		file-wide pool, when DSET is closed while the dataset is
+ *		still open through other IDs, since the pool preempts
+ *		entries through the dataset which cached them.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_pool_close(const H5D_t *dset, hid_t dxpl_id)
+{
+    H5D_rdcc_t		*rdcc = &(dset->shared->cache.chunk);
+    H5D_dxpl_cache_t    _dxpl_cache;    /* Data transfer property cache buffer */
+    H5D_dxpl_cache_t    *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+    H5D_rdcc_ent_t	*ent, *next;	/* Current & next entries in the cache */
+    int		nerrors = 0;            /* Accumulated error count during preemptions */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    HDassert(H5D_CHUNKED == dset->shared->layout.type);
+
+    if(rdcc->pool) {
+        /* Fill the DXPL cache values for later use */
+        if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+
+        for(ent = rdcc->head; ent; ent = next) {
+            next = ent->next;
+            if(ent->dset == dset) {
+                HDassert(!ent->locked);
+                if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
+                    nerrors++;
+            } /* end if */
+        } /* end for */
+
+        if(nerrors)
+            HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+    } /* end if */
 
 done:
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_cache_prune() */
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_pool_close() */
+
 
-
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_lock
  *
@@ -3426,6 +6764,11 @@ done:
  *		for output functions that are about to overwrite the entire
  *		chunk.
  *
+ *		If PREFETCH is non-NULL, it holds the chunk's data, already
+ *		read from the file and unfiltered, and is used instead of
+ *		reading the chunk again.  Its buffers are owned by this
+ *		routine from then on, whether it succeeds or not.
+ *
  * Return:	Success:	Ptr to a file chunk.
  *
  *		Failure:	NULL
@@ -3437,7 +6780,7 @@ done:
  */
 static void *
 H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
-    hbool_t relax, hbool_t prev_unfilt_chunk)
+    hbool_t relax, hbool_t prev_unfilt_chunk, H5D_chunk_prefetch_t *prefetch)
 {
     const H5D_t         *dset = io_info->dset;  /* Local pointer to the dataset info */
     const H5O_pline_t   *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info - always equal to the pline passed to H5D__chunk_mem_alloc */
@@ -3451,6 +6794,7 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
     size_t		chunk_size;		/*size of a chunk	*/
     hbool_t             disable_filters = FALSE; /* Whether to disable filters (when adding to cache) */
     void		*chunk = NULL;		/*the file chunk	*/
+    void		*image = NULL;		/*filtered image of the file chunk */
     void		*ret_value = NULL;	/* Return value         */
 
     FUNC_ENTER_STATIC
@@ -3464,6 +6808,7 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
     HDassert(TRUE == H5P_isa_class(io_info->raw_dxpl_id, H5P_DATASET_XFER));
     HDassert(!(udata->new_unfilt_chunk && prev_unfilt_chunk));
     HDassert(!rdcc->tmp_head);
+    HDassert(!prefetch || (prefetch->buf && UINT_MAX == udata->idx_hint && !relax && !prev_unfilt_chunk && !udata->new_unfilt_chunk));
 
     /* Get the chunk's size */
     HDassert(layout->u.chunk.size > 0);
@@ -3472,7 +6817,7 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
     /* Check if the chunk is in the cache */
     if(UINT_MAX != udata->idx_hint) {
         /* Sanity check */
-        HDassert(udata->idx_hint < rdcc->nslots);
+        HDassert(udata->idx_hint < rdcc->nsets * rdcc->nways);
         HDassert(rdcc->slot[udata->idx_hint]);
 
         /* Get the entry */
@@ -3492,6 +6837,8 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
          * Already in the cache.  Count a hit.
          */
         rdcc->stats.nhits++;
+        rdcc->resize.nhits++;
+        ent->tick = ++rdcc->tick;
 
         /* Make adjustments if the edge chunk status changed recently */
         if(pline->nused) {
@@ -3572,6 +6919,12 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
             ent->next = ent->next->next;
             ent->prev->next = ent;
         } /* end if */
+
+        /* Make the chunk the most recently used one in the file-wide pool */
+        if(rdcc->pool && ent != rdcc->pool->tail) {
+            H5D__chunk_pool_remove(rdcc->pool, ent);
+            H5D__chunk_pool_append(rdcc->pool, ent);
+        } /* end if */
     } /* end if */
     else {
         haddr_t             chunk_addr;         /* Address of chunk on disk */
@@ -3636,25 +6989,58 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
              *      or an init if it isn't.
              */
 
+            /* Check if the chunk was already read & unfiltered */
+            if(prefetch) {
+                /* Sanity check */
+                HDassert(H5F_addr_defined(chunk_addr));
+
+                chunk = prefetch->buf;
+                prefetch->buf = NULL;
+                image = prefetch->image;
+                prefetch->image = NULL;
+
+                /* Increment # of cache misses */
+                rdcc->stats.nmisses++;
+            } /* end if */
             /* Check if the chunk exists on disk */
-            if(H5F_addr_defined(chunk_addr)) {
+            else if(H5F_addr_defined(chunk_addr)) {
                 size_t my_chunk_alloc = chunk_alloc;	/* Allocated buffer size */
                 size_t buf_alloc = chunk_alloc;	        /* [Re-]allocated buffer size */
+                hbool_t keep_image = (rdcc->img.nbytes_max > 0 && old_pline && old_pline->nused
+                        && !udata->new_unfilt_chunk);   /* Whether to keep the filtered image */
 
                 /* Chunk size on disk isn't [likely] the same size as the final chunk
                  * size in memory, so allocate memory big enough. */
                 if(NULL == (chunk = H5D__chunk_mem_alloc(my_chunk_alloc, (udata->new_unfilt_chunk ? old_pline : pline))))
                     HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for raw data chunk")
-                if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, chunk_addr, my_chunk_alloc, io_info->raw_dxpl_id, chunk) < 0)
-                    HGOTO_ERROR(H5E_IO, H5E_READERROR, NULL, "unable to read raw data chunk")
+
+                /* Copy the filtered chunk from the second tier of the cache,
+                 * or read it and keep a copy for when the chunk is evicted */
+                if(keep_image)
+                    image = H5D__chunk_image_take(dset, chunk_addr, udata->common.scaled, my_chunk_alloc);
+                if(image)
+                    HDmemcpy(chunk, image, my_chunk_alloc);
+                else {
+                    if(H5F_block_read(dset->oloc.file, H5FD_MEM_DRAW, chunk_addr, my_chunk_alloc, io_info->raw_dxpl_id, chunk) < 0)
+                        HGOTO_ERROR(H5E_IO, H5E_READERROR, NULL, "unable to read raw data chunk")
+                    rdcc->stats.nbytes_read += my_chunk_alloc;
+                    if(keep_image) {
+                        if(NULL == (image = H5MM_malloc(my_chunk_alloc)))
+                            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for chunk image")
+                        HDmemcpy(image, chunk, my_chunk_alloc);
+                    } /* end if */
+                } /* end else */
 
                 if(old_pline && old_pline->nused) {
+                    double filter_start = H5_get_time();    /* Time unfiltering started */
+
                     if(H5Z_pipeline(old_pline, H5Z_FLAG_REVERSE,
                             &(udata->filter_mask),
                             io_info->dxpl_cache->err_detect,
                             io_info->dxpl_cache->filter_cb,
                             &my_chunk_alloc, &buf_alloc, &chunk) < 0)
                         HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, NULL, "data pipeline read failed")
+                    rdcc->stats.filter_time += H5_get_time() - filter_start;
 
                     /* Reallocate chunk if necessary */
                     if(udata->new_unfilt_chunk) {
@@ -3718,20 +7104,23 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
         } /* end else */
 
         /* See if the chunk can be cached */
-        if(rdcc->nslots > 0 && chunk_size <= rdcc->nbytes_max) {
-            /* Calculate the index */
-            udata->idx_hint = H5D__chunk_hash_val(io_info->dset->shared, udata->common.scaled);
-
-            /* Add the chunk to the cache only if the slot is not already locked */
-            ent = rdcc->slot[udata->idx_hint];
-            if(!ent || !ent->locked) {
+        if(rdcc->nsets > 0 && chunk_size <= rdcc->nbytes_max
+                && (NULL == rdcc->pool || chunk_size <= rdcc->pool->nbytes_max)) {
+            /* Choose a slot in the set the chunk hashes to */
+            udata->idx_hint = H5D__chunk_cache_victim(rdcc, H5D__chunk_hash_val(io_info->dset->shared, udata->common.scaled));
+
+            /* Add the chunk to the cache only if the set has a slot which
+             * isn't locked */
+            if(UINT_MAX != udata->idx_hint) {
                 /* Preempt enough things from the cache to make room */
-                if(ent) {
+                if(NULL != (ent = rdcc->slot[udata->idx_hint])) {
                     if(H5D__chunk_cache_evict(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, ent, TRUE) < 0)
                         HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk from cache")
                 } /* end if */
                 if(H5D__chunk_cache_prune(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, chunk_size) < 0)
                     HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from cache")
+                if(rdcc->pool && H5D__chunk_pool_prune(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, chunk_size) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from file-wide cache pool")
 
                 /* Create a new entry */
                 if(NULL == (ent = H5FL_CALLOC(H5D_rdcc_ent_t)))
@@ -3749,11 +7138,17 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                 H5_CHECKED_ASSIGN(ent->rd_count, uint32_t, chunk_size, size_t);
                 H5_CHECKED_ASSIGN(ent->wr_count, uint32_t, chunk_size, size_t);
                 ent->chunk = (uint8_t *)chunk;
+                if(image) {
+                    H5D__chunk_image_attach(dset, ent, image);
+                    image = NULL;
+                } /* end if */
 
                 /* Add it to the cache */
                 HDassert(NULL == rdcc->slot[udata->idx_hint]);
                 rdcc->slot[udata->idx_hint] = ent;
                 ent->idx = udata->idx_hint;
+                ent->tick = ++rdcc->tick;
+                rdcc->resize.nmisses++;
                 rdcc->nbytes_used += chunk_size;
                 rdcc->nused++;
 
@@ -3768,6 +7163,13 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                 ent->tmp_next = NULL;
                 ent->tmp_prev = NULL;
 
+                /* Add it to the file-wide pool */
+                ent->dset = io_info->dset;
+                if(rdcc->pool) {
+                    H5D__chunk_pool_append(rdcc->pool, ent);
+                    rdcc->pool->nbytes_used += chunk_size;
+                } /* end if */
+
             } /* end if */
             else
                 /* We did not add the chunk to cache */
@@ -3783,7 +7185,7 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
         ent->locked = TRUE;
         chunk = ent->chunk;
     } /* end if */
-    else
+    else {
         /*
          * The chunk cannot be placed in cache so we don't cache it. This is the
          * reason all those arguments have to be repeated for the unlock
@@ -3791,6 +7193,16 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
          */
         udata->idx_hint = UINT_MAX;
 
+        /* Its filtered image goes straight to the second tier of the cache */
+        if(image) {
+            herr_t status = H5D__chunk_image_put(dset, udata->chunk_block.offset, udata->common.scaled, (size_t)udata->chunk_block.length, image);
+
+            image = NULL;
+            if(status < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, NULL, "unable to cache filtered chunk image")
+        } /* end if */
+    } /* end else */
+
     /* Set return value */
     ret_value = chunk;
 
@@ -3804,6 +7216,16 @@ done:
         if(chunk)
             chunk = H5D__chunk_mem_xfree(chunk, pline);
 
+    /* Release the filtered image, if it wasn't kept */
+    H5MM_xfree(image);
+
+    /* Release the prefetched chunk, if it wasn't used */
+    if(prefetch) {
+        if(prefetch->buf)
+            prefetch->buf = H5D__chunk_mem_xfree(prefetch->buf, &(dset->shared->dcpl_cache.pline));
+        prefetch->image = H5MM_xfree(prefetch->image);
+    } /* end if */
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_lock() */
 
@@ -3835,7 +7257,7 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
     hbool_t dirty, void *chunk, uint32_t naccessed)
 {
     const H5O_layout_t *layout = &(io_info->dset->shared->layout); /* Dataset layout */
-    const H5D_rdcc_t	*rdcc = &(io_info->dset->shared->cache.chunk);
+    H5D_rdcc_t		*rdcc = &(io_info->dset->shared->cache.chunk);
     herr_t              ret_value = SUCCEED;      /* Return value */
 
     FUNC_ENTER_STATIC
@@ -3880,8 +7302,15 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
             fake_ent.chunk_block.length = udata->chunk_block.length;
             fake_ent.chunk = (uint8_t *)chunk;
 
-            if(H5D__chunk_flush_entry(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, &fake_ent, TRUE) < 0)
+            if(H5D__chunk_flush_entry(io_info->dset, io_info->md_dxpl_id, io_info->dxpl_cache, &fake_ent, TRUE) < 0) {
+                H5MM_xfree(fake_ent.image);
                 HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
+            } /* end if */
+
+            /* The chunk isn't cached, so its filtered image goes straight to
+             * the second tier of the cache */
+            if(fake_ent.image && H5D__chunk_image_put(io_info->dset, fake_ent.chunk_block.offset, fake_ent.scaled, (size_t)fake_ent.chunk_block.length, fake_ent.image) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to cache filtered chunk image")
         } /* end if */
         else {
             if(chunk)
@@ -3893,7 +7322,7 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
         H5D_rdcc_ent_t	*ent;   /* Chunk's entry in the cache */
 
         /* Sanity check */
-	HDassert(udata->idx_hint < rdcc->nslots);
+	HDassert(udata->idx_hint < rdcc->nsets * rdcc->nways);
 	HDassert(rdcc->slot[udata->idx_hint]);
 	HDassert(rdcc->slot[udata->idx_hint]->chunk == chunk);
 
@@ -3905,6 +7334,9 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
         if(dirty) {
             ent->dirty = TRUE;
             ent->wr_count -= MIN(ent->wr_count, naccessed);
+
+            /* Discard the chunk filtered ahead of flush, it's out of date */
+            H5MM_xfree(H5D__chunk_filtered_take(rdcc, ent));
         } /* end if */
         else
             ent->rd_count -= MIN(ent->rd_count, naccessed);
@@ -3992,16 +7424,385 @@ H5D__chunk_allocated(H5D_t *dset, hid_t dxpl_id, hsize_t *nbytes)
     idx_info.layout = &dset->shared->layout.u.chunk;
     idx_info.storage = &dset->shared->layout.storage.u.chunk;
 
+    /* Count each block shared by identical chunks once */
+    if(dset->shared->layout.u.chunk.flags & H5O_LAYOUT_CHUNK_DEDUP_IDENTICAL_CHUNKS) {
+        hbool_t temp_dedup = (NULL == sc->dedup);   /* Whether the counts are made just for this */
+        H5SL_node_t *node;              /* Node for a block */
+
+        if(temp_dedup && H5D__chunk_dedup_create(&idx_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to count chunks in deduplicated blocks")
+        for(node = H5SL_first(sc->dedup->blocks); node; node = H5SL_next(node))
+            chunk_bytes += ((H5D_chunk_dedup_ent_t *)H5SL_item(node))->nbytes;
+        if(temp_dedup)
+            H5D__chunk_dedup_dest(sc);
+    } /* end if */
     /* Iterate over the chunks */
-    if((dset->shared->layout.storage.u.chunk.ops->iterate)(&idx_info, H5D__chunk_allocated_cb, &chunk_bytes) < 0)
+    else if((dset->shared->layout.storage.u.chunk.ops->iterate)(&idx_info, H5D__chunk_allocated_cb, &chunk_bytes) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to retrieve allocated chunk information from index")
 
     /* Set number of bytes for caller */
     *nbytes = chunk_bytes;
 
 done:
-    FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_allocated() */
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_allocated() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_iter_cb
+ *
+ * Purpose:	Call the application's callback for a chunk in the index.
+ *
+ * Return:	Value returned by the application's callback
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_iter_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
+{
+    H5D_chunk_it_ud6_t *udata = (H5D_chunk_it_ud6_t *)_udata;   /* User data from caller */
+    unsigned u;                         /* Local index variable */
+    int ret_value = H5_ITER_CONT;       /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Compute the chunk's logical offset */
+    for(u = 0; u < udata->ndims; u++)
+        udata->offset[u] = chunk_rec->scaled[u] * udata->chunk_dim[u];
+
+    /* Make the application's callback */
+    ret_value = (udata->op)(udata->offset, (unsigned)chunk_rec->filter_mask, chunk_rec->chunk_addr, (hsize_t)chunk_rec->nbytes, udata->op_data);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_iter_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_info_cb
+ *
+ * Purpose:	Count a chunk in the index and, when it's among the chunks
+ *		requested, return information about it.
+ *
+ * Return:	H5_ITER_CONT, or H5_ITER_STOP after the last chunk requested
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_info_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
+{
+    H5D_chunk_it_ud6_t *udata = (H5D_chunk_it_ud6_t *)_udata;   /* User data from caller */
+    int ret_value = H5_ITER_CONT;       /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(udata->idx >= udata->start && udata->idx - udata->start < udata->nchunks) {
+        size_t n = (size_t)(udata->idx - udata->start);    /* Chunk's index in caller's arrays */
+
+        if(udata->offsets) {
+            unsigned u;                 /* Local index variable */
+
+            for(u = 0; u < udata->ndims; u++)
+                udata->offsets[n * udata->ndims + u] = chunk_rec->scaled[u] * udata->chunk_dim[u];
+        } /* end if */
+        if(udata->filter_masks)
+            udata->filter_masks[n] = (unsigned)chunk_rec->filter_mask;
+        if(udata->addrs)
+            udata->addrs[n] = chunk_rec->chunk_addr;
+        if(udata->sizes)
+            udata->sizes[n] = (hsize_t)chunk_rec->nbytes;
+
+        /* Stop after the last chunk requested */
+        if(n + 1 == udata->nchunks)
+            ret_value = H5_ITER_STOP;
+    } /* end if */
+    udata->idx++;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_info_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_iter_real
+ *
+ * Purpose:	Flush the cached chunks of a dataset to the file, then
+ *		iterate over its chunk index, making the callback for each
+ *		chunk stored in the file.
+ *
+ * Return:	Value returned by the last callback, or negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_iter_real(H5D_t *dset, hid_t dxpl_id, H5D_chunk_cb_func_t cb,
+    H5D_chunk_it_ud6_t *udata)
+{
+    const H5O_layout_t *layout = &(dset->shared->layout);      /* Dataset layout */
+    const H5D_rdcc_t   *rdcc = &(dset->shared->cache.chunk);	/* Raw data chunk cache */
+    H5D_rdcc_ent_t     *ent;            /* Cache entry  */
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+    H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+    int ret_value = H5_ITER_CONT;       /* Return value */
+
+    FUNC_ENTER_STATIC_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    /* Sanity checks */
+    HDassert(dset && H5D_CHUNKED == layout->type);
+    HDassert(cb);
+    HDassert(udata);
+
+    /* Set up the dimensions for the callback */
+    udata->ndims = dset->shared->ndims;
+    udata->chunk_dim = layout->u.chunk.dim;
+
+    /* Fill the DXPL cache values for later use */
+    if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+
+    /* Flush the cached chunks, so the index holds all chunks and their sizes */
+    for(ent = rdcc->head; ent; ent = ent->next)
+        if(H5D__chunk_flush_entry(dset, dxpl_id, dxpl_cache, ent, FALSE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
+
+    /* Nothing to do if no chunk has been stored */
+    if(!(*layout->ops->is_space_alloc)(&layout->storage))
+        HGOTO_DONE(H5_ITER_CONT)
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.dxpl_id = dxpl_id;
+    idx_info.pline = &dset->shared->dcpl_cache.pline;
+    idx_info.layout = &dset->shared->layout.u.chunk;
+    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+    /* Iterate over the chunks */
+    if((ret_value = (layout->storage.u.chunk.ops->iterate)(&idx_info, cb, udata)) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADITER, FAIL, "unable to iterate over chunk index")
+
+done:
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__chunk_iter_real() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_iter
+ *
+ * Purpose:	Make the application's callback for each chunk of a
+ *		dataset stored in the file, in the order of the chunk index.
+ *
+ * Return:	Value returned by the last callback, or negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_iter(H5D_t *dset, hid_t dxpl_id, H5D_chunk_iter_op_t op, void *op_data)
+{
+    H5D_chunk_it_ud6_t udata;           /* User data for callback */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(op);
+
+    HDmemset(&udata, 0, sizeof(udata));
+    udata.op = op;
+    udata.op_data = op_data;
+
+    if((ret_value = H5D__chunk_iter_real(dset, dxpl_id, H5D__chunk_iter_cb, &udata)) < 0)
+        HERROR(H5E_DATASET, H5E_BADITER, "iteration over chunks failed");
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_iter() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__get_num_chunks
+ *
+ * Purpose:	Return the number of chunks of a dataset stored in the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__get_num_chunks(H5D_t *dset, hid_t dxpl_id, hsize_t *nchunks)
+{
+    H5D_chunk_it_ud6_t udata;           /* User data for callback */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(nchunks);
+
+    /* Count the chunks, without returning information about any */
+    HDmemset(&udata, 0, sizeof(udata));
+    if(H5D__chunk_iter_real(dset, dxpl_id, H5D__chunk_info_cb, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADITER, FAIL, "unable to count chunks")
+
+    *nchunks = udata.idx;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__get_num_chunks() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__get_chunk_info
+ *
+ * Purpose:	Return the logical offsets, filter masks, file addresses
+ *		and sizes of NCHUNKS chunks of a dataset, starting with
+ *		chunk number START in the order of the chunk index, with
+ *		one pass over the index.  The offsets are returned one
+ *		after the other in OFFSETS.  Any of the arrays may be NULL.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__get_chunk_info(H5D_t *dset, hid_t dxpl_id, hsize_t start, hsize_t nchunks,
+    hsize_t *offsets, unsigned *filter_masks, haddr_t *addrs, hsize_t *sizes)
+{
+    H5D_chunk_it_ud6_t udata;           /* User data for callback */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(nchunks > 0);
+
+    HDmemset(&udata, 0, sizeof(udata));
+    udata.start = start;
+    udata.nchunks = nchunks;
+    udata.offsets = offsets;
+    udata.filter_masks = filter_masks;
+    udata.addrs = addrs;
+    udata.sizes = sizes;
+    if(H5D__chunk_iter_real(dset, dxpl_id, H5D__chunk_info_cb, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADITER, FAIL, "unable to retrieve chunk information from index")
+
+    /* Check that all the chunks requested were found */
+    if(udata.idx < start || udata.idx - start < nchunks)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "chunk index out of range")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__get_chunk_info() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__get_chunk_info_by_coord
+ *
+ * Purpose:	Return the filter mask, file address and size of the chunk
+ *		at a logical offset in a dataset.  A chunk which isn't
+ *		stored in the file has the address HADDR_UNDEF and size 0.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__get_chunk_info_by_coord(H5D_t *dset, hid_t dxpl_id, const hsize_t *offset,
+    unsigned *filter_mask, haddr_t *addr, hsize_t *size)
+{
+    const H5O_layout_t *layout = &(dset->shared->layout);    /* Dataset layout */
+    const H5D_rdcc_t   *rdcc = &(dset->shared->cache.chunk); /* raw data chunk cache */
+    hsize_t scaled[H5O_LAYOUT_NDIMS];   /* Scaled coordinates for this chunk */
+    H5D_io_info_t io_info;              /* to hold the dset and two dxpls (meta and raw data) */
+    H5D_chunk_ud_t udata;               /* User data for querying chunk info */
+    H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+    unsigned u;                         /* Local index variable */
+    hbool_t md_dxpl_generated = FALSE;  /* bool to indicate whether we should free the md_dxpl_id at exit */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_PACKAGE_TAG(dxpl_id, dset->oloc.addr, FAIL)
+
+    /* Sanity checks */
+    HDassert(dset && H5D_CHUNKED == layout->type);
+    HDassert(offset);
+
+    if(filter_mask)
+        *filter_mask = 0;
+    if(addr)
+        *addr = HADDR_UNDEF;
+    if(size)
+        *size = 0;
+
+    io_info.dset = dset;
+    io_info.raw_dxpl_id = dxpl_id;
+    io_info.md_dxpl_id = dxpl_id;
+
+    /* set the dxpl IO type for sanity checking at the FD layer */
+#ifdef H5_DEBUG_BUILD
+    if(H5D_set_io_info_dxpls(&io_info, dxpl_id) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, FAIL, "can't set metadata and raw data dxpls")
+    md_dxpl_generated = TRUE;
+#endif /* H5_DEBUG_BUILD */
+
+    /* Check the offset and compute the chunk's scaled coordinates */
+    for(u = 0; u < dset->shared->ndims; u++) {
+        if(offset[u] >= dset->shared->curr_dims[u])
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "offset exceeds dimensions of dataset")
+        if(offset[u] % layout->u.chunk.dim[u])
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADRANGE, FAIL, "offset doesn't fall on chunks's boundary")
+        scaled[u] = offset[u] / layout->u.chunk.dim[u];
+    } /* end for */
+    scaled[dset->shared->ndims] = 0;
+
+    /* Flush the chunk if it's cached and dirty, so the index is current */
+    if(UINT_MAX != (u = H5D__chunk_cache_find(dset->shared, scaled)) && rdcc->slot[u]->dirty) {
+        H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
+        H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
+
+        if(H5D__get_dxpl_cache(io_info.raw_dxpl_id, &dxpl_cache) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
+        if(H5D__chunk_flush_entry(dset, io_info.md_dxpl_id, dxpl_cache, rdcc->slot[u], FALSE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
+    } /* end if */
+
+    /* Nothing to return if no chunk has been stored */
+    if(!(*layout->ops->is_space_alloc)(&layout->storage))
+        HGOTO_DONE(SUCCEED)
+
+    /* Compose chunked index info struct */
+    idx_info.f = dset->oloc.file;
+    idx_info.dxpl_id = io_info.md_dxpl_id;
+    idx_info.pline = &dset->shared->dcpl_cache.pline;
+    idx_info.layout = &dset->shared->layout.u.chunk;
+    idx_info.storage = &dset->shared->layout.storage.u.chunk;
+
+    /* Query the chunk index (not the chunk cache, which doesn't hold the
+     * chunk's filter mask) */
+    udata.common.layout = &dset->shared->layout.u.chunk;
+    udata.common.storage = &dset->shared->layout.storage.u.chunk;
+    udata.common.scaled = scaled;
+    udata.chunk_block.offset = HADDR_UNDEF;
+    udata.chunk_block.length = 0;
+    udata.filter_mask = 0;
+    if((layout->storage.u.chunk.ops->get_addr)(&idx_info, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't query chunk address")
+
+    if(H5F_addr_defined(udata.chunk_block.offset)) {
+        if(filter_mask)
+            *filter_mask = udata.filter_mask;
+        if(addr)
+            *addr = udata.chunk_block.offset;
+        if(size)
+            *size = udata.chunk_block.length;
+    } /* end if */
+
+done:
+#ifdef H5_DEBUG_BUILD
+    if(md_dxpl_generated && H5I_dec_ref(io_info.md_dxpl_id) < 0)
+        HDONE_ERROR(H5E_DATASET, H5E_CANTDEC, FAIL, "can't close metadata dxpl")
+#endif /* H5_DEBUG_BUILD */
+    FUNC_LEAVE_NOAPI_TAG(ret_value, FAIL)
+} /* end H5D__get_chunk_info_by_coord() */
 
 
 /*-------------------------------------------------------------------------
@@ -4378,6 +8179,7 @@ H5D__chunk_allocate(const H5D_io_info_t *io_info, hbool_t full_overwrite, hsize_
 	    if(need_insert && ops->insert)
                 if((ops->insert)(&idx_info, &udata, dset) < 0)
                     HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+            H5D__chunk_addr_map_set(dset, scaled, udata.chunk_block.offset, udata.chunk_block.length, udata.filter_mask);
 
             /* Increment indices and adjust the edge chunk state */
             carry = TRUE;
@@ -4594,7 +8396,7 @@ H5D__chunk_update_old_edge_chunks(H5D_t *dset, hid_t dxpl_id, hsize_t old_dim[])
                     || (UINT_MAX != chk_udata.idx_hint)) {
                 /* Lock the chunk into cache.  H5D__chunk_lock will take care of
                 * updating the chunk to no longer be an edge chunk. */
-                if(NULL == (chunk = (void *)H5D__chunk_lock(&chk_io_info, &chk_udata, FALSE, TRUE)))
+                if(NULL == (chunk = (void *)H5D__chunk_lock(&chk_io_info, &chk_udata, FALSE, TRUE, NULL)))
                     HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to lock raw data chunk")
 
                 /* Unlock the chunk */
@@ -4862,7 +8664,7 @@ H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata, hbool_t new_unfilt_chunk)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTSELECT, FAIL, "unable to select hyperslab")
 
     /* Lock the chunk into the cache, to get a pointer to the chunk buffer */
-    if(NULL == (chunk = (void *)H5D__chunk_lock(io_info, &chk_udata, FALSE, FALSE)))
+    if(NULL == (chunk = (void *)H5D__chunk_lock(io_info, &chk_udata, FALSE, FALSE, NULL)))
         HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to lock raw data chunk")
 
 
@@ -4915,6 +8717,281 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__chunk_prune_fill */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prune_is_outside
+ *
+ * Purpose:	Check if a chunk lies entirely outside a dataset's extent.
+ *
+ * Return:	TRUE if the chunk is outside the extent, FALSE otherwise
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__chunk_prune_is_outside(unsigned ndims, const uint32_t *chunk_dim,
+    const hsize_t *scaled, const hsize_t *space_dim)
+{
+    unsigned u;                         /* Local index variable */
+    hbool_t ret_value = FALSE;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < ndims; u++)
+        if((scaled[u] * chunk_dim[u]) >= space_dim[u])
+            HGOTO_DONE(TRUE)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_prune_is_outside() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prune_add
+ *
+ * Purpose:	Add a chunk to the list of chunks outside a dataset's new
+ *              extent.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_prune_add(H5D_chunk_it_ud7_t *udata, const hsize_t *scaled)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(udata->nused == udata->nalloc) {
+        size_t new_nalloc = MAX(64, udata->nalloc * 2);
+        hsize_t *new_scaled;
+
+        if(NULL == (new_scaled = (hsize_t *)H5MM_realloc(udata->scaled, new_nalloc * (udata->ndims + 1) * sizeof(hsize_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk offsets")
+        udata->scaled = new_scaled;
+        udata->nalloc = new_nalloc;
+    } /* end if */
+    HDmemcpy(&udata->scaled[udata->nused * (udata->ndims + 1)], scaled, udata->ndims * sizeof(hsize_t));
+    udata->scaled[(udata->nused * (udata->ndims + 1)) + udata->ndims] = 0;
+    udata->nused++;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_prune_add() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prune_find_cb
+ *
+ * Purpose:	Note a chunk in the chunk index if it's outside the
+ *              dataset's new extent.
+ *
+ * Return:	H5_ITER_CONT/H5_ITER_ERROR
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_prune_find_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
+{
+    H5D_chunk_it_ud7_t *udata = (H5D_chunk_it_ud7_t *)_udata;
+    int ret_value = H5_ITER_CONT;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(H5D__chunk_prune_is_outside(udata->ndims, udata->chunk_dim, chunk_rec->scaled, udata->space_dim))
+        if(H5D__chunk_prune_add(udata, chunk_rec->scaled) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, H5_ITER_ERROR, "can't add chunk to list")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_prune_find_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_free_batch_cmp
+ *
+ * Purpose:	Compare two blocks of file space by address, for sorting
+ *              them from the end of the file to the start.
+ *
+ * Return:	<0, 0 or >0, as for qsort
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_free_batch_cmp(const void *_blk1, const void *_blk2)
+{
+    const H5F_block_t *blk1 = (const H5F_block_t *)_blk1;
+    const H5F_block_t *blk2 = (const H5F_block_t *)_blk2;
+    int ret_value = 0;                  /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(H5F_addr_gt(blk1->offset, blk2->offset))
+        ret_value = -1;
+    else if(H5F_addr_lt(blk1->offset, blk2->offset))
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_free_batch_cmp() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__chunk_prune_remove
+ *
+ * Purpose:	Remove all the chunks which are entirely outside a dataset's
+ *              new extent, from the chunk cache and the chunk index.
+ *
+ *              The cached chunks are evicted with one pass over the cache.
+ *              When much of the dataset was removed, the chunks to remove
+ *              from the index are found with one pass over the index;
+ *              otherwise each chunk position outside the new extent is
+ *              looked up.  The file space of the removed chunks is freed
+ *              once they have all been removed, from the end of the file
+ *              back, so that space at the end of the file can be given
+ *              back to the file.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_prune_remove(H5D_t *dset, hid_t dxpl_id, const H5D_dxpl_cache_t *dxpl_cache,
+    const H5D_chk_idx_info_t *idx_info, const hsize_t *old_dim)
+{
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);    /* Chunked layout info */
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    H5D_rdcc_t          *rdcc = &(dset->shared->cache.chunk);  /* Raw data chunk cache */
+    H5D_rdcc_ent_t      *ent, *next;        /* Cache entries */
+    const hsize_t       *space_dim = dset->shared->curr_dims;   /* New dataset dimensions */
+    unsigned            ndims = dset->shared->ndims;    /* Rank of dataset */
+    H5D_chunk_it_ud7_t  udata;              /* Chunks to remove */
+    H5D_chunk_free_batch_t batch;           /* File space of removed chunks */
+    H5D_chunk_common_ud_t idx_udata;        /* User data for index removal routine */
+    hsize_t             scaled[H5O_LAYOUT_NDIMS];   /* Scaled offset of current chunk */
+    hsize_t             min_sc[H5O_LAYOUT_NDIMS];   /* First chunk outside the new extent in each dimension */
+    hsize_t             max_sc[H5O_LAYOUT_NDIMS];   /* Last chunk in each dimension */
+    double              old_nchunks = 1.0;  /* # of chunk positions in the old extent */
+    double              new_nchunks = 1.0;  /* # of those positions still in the new extent */
+    size_t              v;                  /* Local index variable */
+    unsigned            u;                  /* Local index variable */
+    herr_t              ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDmemset(&udata, 0, sizeof(udata));
+    udata.ndims = ndims;
+    udata.chunk_dim = layout->dim;
+    udata.space_dim = space_dim;
+    HDmemset(&batch, 0, sizeof(batch));
+
+    /* The last dimension in scaled is always 0 */
+    scaled[ndims] = (hsize_t)0;
+
+    /* Evict the chunks outside the new extent from the cache, without
+     * flushing them to the file */
+    for(ent = rdcc->head; ent; ent = next) {
+        next = ent->next;
+        if(H5D__chunk_prune_is_outside(ndims, layout->dim, ent->scaled, space_dim))
+            if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, FALSE) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
+    } /* end for */
+
+    /* Nothing to remove from the index if it has no chunks yet */
+    if(!(sc->ops->is_space_alloc)(sc))
+        HGOTO_DONE(SUCCEED)
+
+    /* Count the chunk positions removed */
+    for(u = 0; u < ndims; u++) {
+        max_sc[u] = (old_dim[u] - 1) / layout->dim[u];
+        min_sc[u] = (space_dim[u] + layout->dim[u] - 1) / layout->dim[u];
+        old_nchunks *= (double)(max_sc[u] + 1);
+        new_nchunks *= (double)MIN(min_sc[u], max_sc[u] + 1);
+    } /* end for */
+
+    /* Find the chunks in the index outside the new extent.  The index is
+     * searched once for each position removed unless those are many, and
+     * a large part of the dataset, and the index's iteration gives the
+     * chunks' offsets (see H5D__chunk_lookup_batch). */
+    if((old_nchunks - new_nchunks) >= (double)H5D_CHUNK_LOOKUP_BATCH_MIN
+            && (old_nchunks - new_nchunks) * H5D_CHUNK_LOOKUP_BATCH_DENSITY >= old_nchunks
+            && layout->idx_type != H5D_CHUNK_IDX_NONE && layout->idx_type != H5D_CHUNK_IDX_SINGLE
+            && !(layout->idx_type == H5D_CHUNK_IDX_EARRAY && layout->u.earray.unlim_dim > 0)
+#ifdef H5_HAVE_PARALLEL
+            && !H5F_HAS_FEATURE(dset->oloc.file, H5FD_FEAT_HAS_MPI)
+#endif /* H5_HAVE_PARALLEL */
+            ) {
+        if((sc->ops->iterate)(idx_info, H5D__chunk_prune_find_cb, &udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to iterate over chunk index")
+    } /* end if */
+    else {
+        for(u = 0; u < ndims; u++) {
+            hbool_t carry;              /* Whether the last dimension wrapped around */
+
+            if(min_sc[u] > max_sc[u])
+                continue;
+
+            /* Visit the chunks in this dimension's slab outside the new
+             * extent, which haven't been visited for a previous dimension */
+            HDmemset(scaled, 0, ndims * sizeof(scaled[0]));
+            scaled[u] = min_sc[u];
+            carry = FALSE;
+            while(!carry) {
+                H5D_chunk_ud_t chk_udata;   /* User data for getting chunk info */
+                int i;                      /* Local index variable */
+
+                if(H5D__chunk_lookup(dset, dxpl_id, scaled, &chk_udata) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk")
+                HDassert(UINT_MAX == chk_udata.idx_hint);
+                if(H5F_addr_defined(chk_udata.chunk_block.offset))
+                    if(H5D__chunk_prune_add(&udata, scaled) < 0)
+                        HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't add chunk to list")
+
+                carry = TRUE;
+                for(i = (int)(ndims - 1); i >= 0; --i) {
+                    scaled[i]++;
+                    if(scaled[i] > max_sc[i])
+                        scaled[i] = ((unsigned)i == u) ? min_sc[i] : 0;
+                    else {
+                        carry = FALSE;
+                        break;
+                    } /* end else */
+                } /* end for */
+            } /* end while */
+
+            /* Don't visit these chunks again for the later dimensions */
+            if(min_sc[u] == 0)
+                break;
+            max_sc[u] = min_sc[u] - 1;
+        } /* end for */
+    } /* end else */
+
+    /* Remove the chunks from the index, keeping their file space to free
+     * afterwards */
+    sc->free_batch = &batch;
+    idx_udata.layout = layout;
+    idx_udata.storage = sc;
+    for(v = 0; v < udata.nused; v++) {
+        idx_udata.scaled = &udata.scaled[v * (ndims + 1)];
+        if((sc->ops->remove)(idx_info, &idx_udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTDELETE, FAIL, "unable to remove chunk entry from index")
+        H5D__chunk_addr_map_set(dset, idx_udata.scaled, HADDR_UNDEF, (hsize_t)0, 0);
+    } /* end for */
+
+done:
+    /* Free the space of the chunks removed, even if not all of them were */
+    sc->free_batch = NULL;
+    if(batch.nused > 0) {
+        HDqsort(batch.blocks, batch.nused, sizeof(H5F_block_t), H5D__chunk_free_batch_cmp);
+        for(v = 0; v < batch.nused; v++)
+            if(H5MF_xfree(idx_info->f, H5FD_MEM_DRAW, dxpl_id, batch.blocks[v].offset, batch.blocks[v].length) < 0)
+                HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
+    } /* end if */
+    H5MM_xfree(batch.blocks);
+    H5MM_xfree(udata.scaled);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_prune_remove() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__chunk_prune_by_extent
@@ -4932,10 +9009,12 @@ done:
  *
  *  For chunks that are no longer necessary:
  *
- *  1. Search in the raw data cache for each chunk
- *  2. If found then preempt it from the cache
- *  3. Search in the B-tree for each chunk
- *  4. If found then remove it from the B-tree and deallocate file storage for the chunk
+ *  1. Preempt them from the raw data cache, with one pass over the cache
+ *  2. Find them in the chunk index, with one pass over the index if many
+ *     chunks were removed, or else by searching for each chunk
+ *  3. Remove them from the index, then deallocate their file storage
+ *
+ *  Then fill the parts of the remaining edge chunks outside the new extent.
  *
  * This example shows a 2d dataset of 90x90 with a chunk size of 20x20.
  *
@@ -5010,8 +9089,10 @@ done:
  * no longer exist. Of those nine chunks, (0,80), (20,80), (40,80),
  * (60,80), (80,80), (80,60), (80,40), (80,20), and (80,0), one is actually allocated
  * that needs to be released.
- * To release the chunks, we traverse the B-tree to obtain a list of unused
- * allocated chunks, and then call H5B_remove() for each chunk.
+ * To release the chunks, we obtain a list of unused allocated chunks, and
+ * then remove each chunk from the index.  The chunks' file storage is freed
+ * after they have all been removed, starting with the chunk at the highest
+ * address, so storage at the end of the file is returned to the file.
  *
  *-------------------------------------------------------------------------
  */
@@ -5030,14 +9111,12 @@ H5D__chunk_prune_by_extent(H5D_t *dset, hid_t dxpl_id, const hsize_t *old_dim)
     H5D_dxpl_cache_t        _dxpl_cache;        /* Data transfer property cache buffer */
     H5D_dxpl_cache_t       *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
     const H5O_layout_t     *layout = &(dset->shared->layout);   /* Dataset's layout */
-    const H5D_rdcc_t       *rdcc = &(dset->shared->cache.chunk);	/*raw data chunk cache */
     unsigned                space_ndims;        /* Dataset's space rank */
     const hsize_t          *space_dim;          /* Current dataspace dimensions */
     unsigned                op_dim;             /* Current operating dimension */
     hbool_t                 shrunk_dim[H5O_LAYOUT_NDIMS]; /* Dimensions which have shrunk */
     H5D_chunk_it_ud1_t      udata;      /* Chunk index iterator user data */
     hbool_t                 udata_init = FALSE; /* Whether the chunk index iterator user data has been initialized */
-    H5D_chunk_common_ud_t   idx_udata;          /* User data for index removal routine */
     H5S_t                  *chunk_space = NULL;         /* Dataspace for a chunk */
     hsize_t                 chunk_dim[H5O_LAYOUT_NDIMS];   /* Chunk dimensions */
     hsize_t                 scaled[H5O_LAYOUT_NDIMS];   /* Scaled offset of current chunk */
@@ -5061,6 +9140,9 @@ H5D__chunk_prune_by_extent(H5D_t *dset, hid_t dxpl_id, const hsize_t *old_dim)
     if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
 
+    /* The file space of the chunks removed may be reused by other chunks */
+    H5D__chunk_image_reset(&dset->shared->cache.chunk);
+
     /* Go get the rank & dimensions (including the element size) */
     space_dim = dset->shared->curr_dims;
     space_ndims = dset->shared->ndims;
@@ -5109,6 +9191,10 @@ H5D__chunk_prune_by_extent(H5D_t *dset, hid_t dxpl_id, const hsize_t *old_dim)
     idx_info.layout = &dset->shared->layout.u.chunk;
     idx_info.storage = &dset->shared->layout.storage.u.chunk;
 
+    /* Count the chunks sharing each block, before any is removed */
+    if(H5D__chunk_dedup_load(&idx_info) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to count chunks in deduplicated blocks")
+
     /* Initialize the user data for the iteration */
     HDmemset(&udata, 0, sizeof udata);
     udata.common.layout = &layout->u.chunk;
@@ -5123,10 +9209,6 @@ H5D__chunk_prune_by_extent(H5D_t *dset, hid_t dxpl_id, const hsize_t *old_dim)
     udata.hyper_start = hyper_start;
     udata_init = TRUE;
 
-    /* Initialize user data for removal */
-    idx_udata.layout = &layout->u.chunk;
-    idx_udata.storage = &layout->storage.u.chunk;
-
     /* Determine if partial edge chunk filters are disabled */
     disable_edge_filters = (layout->u.chunk.flags
                 & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
@@ -5185,133 +9267,71 @@ H5D__chunk_prune_by_extent(H5D_t *dset, hid_t dxpl_id, const hsize_t *old_dim)
             min_partial_chunk_sc[op_dim] = old_dim[op_dim] / chunk_dim[op_dim];
     } /* end for */
 
-    /* Main loop: fill or remove chunks */
+    /* Remove the chunks entirely outside the new extent */
+    if(H5D__chunk_prune_remove(dset, dxpl_id, dxpl_cache, &idx_info, old_dim) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTDELETE, FAIL, "unable to remove chunks outside dataset extent")
+
+    /* Main loop: fill the partial edge chunks in each dimension */
     for(op_dim = 0; op_dim < (unsigned)space_ndims; op_dim++) {
-        hbool_t dims_outside_fill[H5O_LAYOUT_NDIMS]; /* Dimensions in chunk offset outside fill dimensions */
-        int ndims_outside_fill;         /* Number of dimensions in chunk offset outside fill dimensions */
+        hsize_t max_plane_chunk_sc[H5O_LAYOUT_NDIMS]; /* Scaled offset of last chunk in the plane to fill */
         hbool_t carry;                  /* Flag to indicate that chunk increment carrys to higher dimension (sorta) */
 
         /* Check if modification along this dimension is really necessary */
         if(!shrunk_dim[op_dim])
             continue;
-        else {
-            HDassert(max_mod_chunk_sc[op_dim] >= min_mod_chunk_sc[op_dim]);
-
-            /* Reset the chunk offset indices */
-            HDmemset(scaled, 0, (space_ndims * sizeof(scaled[0])));
-            scaled[op_dim] = min_mod_chunk_sc[op_dim];
-
-            /* Initialize "dims_outside_fill" array */
-            ndims_outside_fill = 0;
-            for(u = 0; u < space_ndims; u++)
-                if((hssize_t)scaled[u] > max_fill_chunk_sc[u]) {
-                    dims_outside_fill[u] = TRUE;
-                    ndims_outside_fill++;
-                } /* end if */
-                else
-                    dims_outside_fill[u] = FALSE;
-	    } /* end if */
+        HDassert(max_mod_chunk_sc[op_dim] >= min_mod_chunk_sc[op_dim]);
+
+        /* Set up the plane of edge chunks to fill, skipping the chunks
+         * filled for previous dimensions.  The plane is empty if the
+         * dataset has no elements left in some dimension. */
+        carry = !fill_dim[op_dim];
+        HDmemset(scaled, 0, (space_ndims * sizeof(scaled[0])));
+        scaled[op_dim] = min_mod_chunk_sc[op_dim];
+        for(u = 0; u < space_ndims; u++) {
+            if(max_fill_chunk_sc[u] < 0)
+                carry = TRUE;
+            else
+                max_plane_chunk_sc[u] = MIN((hsize_t)max_fill_chunk_sc[u], max_mod_chunk_sc[u]);
+        } /* end for */
 
-        carry = FALSE;
         while(!carry) {
             int i;	                        /* Local index variable */
 
             udata.common.scaled = scaled;
 
-            if(0 == ndims_outside_fill) {
-                HDassert(fill_dim[op_dim]);
-                HDassert(scaled[op_dim] == min_mod_chunk_sc[op_dim]);
-
-                /* Make sure this is an edge chunk */
-                HDassert(H5D__chunk_is_partial_edge_chunk(space_ndims, layout->u.chunk.dim, scaled, space_dim));
+            /* Make sure this is an edge chunk */
+            HDassert(H5D__chunk_is_partial_edge_chunk(space_ndims, layout->u.chunk.dim, scaled, space_dim));
 
-                /* Determine if the chunk just became an unfiltered chunk */
-                if(new_unfilt_dim[op_dim]) {
-                    new_unfilt_chunk = TRUE;
-                    for(u = 0; u < space_ndims; u++)
-                        if(scaled[u] == min_partial_chunk_sc[u]) {
-                            new_unfilt_chunk = FALSE;
-                            break;
-                        } /* end if */
-                } /* end if */
-
-                /* Make sure that, if we think this is a new unfiltered chunk,
-                 * it was previously not an edge chunk */
-                HDassert(!new_unfilt_dim[op_dim] || (!new_unfilt_chunk !=
-                        !H5D__chunk_is_partial_edge_chunk(space_ndims, layout->u.chunk.dim, scaled, old_dim)));
-                HDassert(!new_unfilt_chunk || new_unfilt_dim[op_dim]);
-
-                /* Fill the unused parts of the chunk */
-                if(H5D__chunk_prune_fill(&udata, new_unfilt_chunk) < 0)
-                    HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write fill value")
+            /* Determine if the chunk just became an unfiltered chunk */
+            if(new_unfilt_dim[op_dim]) {
+                new_unfilt_chunk = TRUE;
+                for(u = 0; u < space_ndims; u++)
+                    if(scaled[u] == min_partial_chunk_sc[u]) {
+                        new_unfilt_chunk = FALSE;
+                        break;
+                    } /* end if */
             } /* end if */
-            else {
-                H5D_chunk_ud_t          chk_udata;          /* User data for getting chunk info */
 
-#ifndef NDEBUG
-                /* Make sure this chunk is really outside the new dimensions */
-                {
-                    hbool_t outside_dim = FALSE;
-
-                    for(u = 0; u < space_ndims; u++)
-                        if((scaled[u] * chunk_dim[u]) >= space_dim[u]) {
-                            outside_dim = TRUE;
-                            break;
-                        } /* end if */
-                    HDassert(outside_dim);
-                } /* end block */
-#endif /* NDEBUG */
-
-                /* Check if the chunk exists in cache or on disk */
-                if(H5D__chunk_lookup(dset, dxpl_id, scaled, &chk_udata) < 0)
-                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk")
-
-                /* Evict the entry from the cache if present, but do not flush
-                 * it to disk */
-                if(UINT_MAX != chk_udata.idx_hint)
-                    if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, rdcc->slot[chk_udata.idx_hint], FALSE) < 0)
-                        HGOTO_ERROR(H5E_DATASET, H5E_CANTREMOVE, FAIL, "unable to evict chunk")
-
-                /* Remove the chunk from disk, if present */
-                if(H5F_addr_defined(chk_udata.chunk_block.offset)) {
-                    /* Update the offset in idx_udata */
-		    idx_udata.scaled = udata.common.scaled;
+            /* Make sure that, if we think this is a new unfiltered chunk,
+             * it was previously not an edge chunk */
+            HDassert(!new_unfilt_dim[op_dim] || (!new_unfilt_chunk !=
+                    !H5D__chunk_is_partial_edge_chunk(space_ndims, layout->u.chunk.dim, scaled, old_dim)));
+            HDassert(!new_unfilt_chunk || new_unfilt_dim[op_dim]);
 
-                    /* Remove the chunk from disk */
-                    if((layout->storage.u.chunk.ops->remove)(&idx_info, &idx_udata) < 0)
-                        HGOTO_ERROR(H5E_DATASET, H5E_CANTDELETE, FAIL, "unable to remove chunk entry from index")
-                } /* end if */
-            } /* end else */
+            /* Fill the unused parts of the chunk */
+            if(H5D__chunk_prune_fill(&udata, new_unfilt_chunk) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write fill value")
 
-            /* Increment indices */
+            /* Increment indices, keeping the offset in the operating
+             * dimension fixed */
             carry = TRUE;
             for(i = (int)(space_ndims - 1); i >= 0; --i) {
+                if((unsigned)i == op_dim)
+                    continue;
                 scaled[i]++;
-                if(scaled[i] > max_mod_chunk_sc[i]) {
-                    /* Left maximum dimensions, "wrap around" and check if this
-                     * dimension is no longer outside the fill dimension */
-                    if((unsigned)i == op_dim) {
-                        scaled[i] = min_mod_chunk_sc[i];
-                        if(dims_outside_fill[i] && fill_dim[i]) {
-                            dims_outside_fill[i] = FALSE;
-                            ndims_outside_fill--;
-                        } /* end if */
-                    } /* end if */
-                    else {
-                        scaled[i] = 0;
-                        if(dims_outside_fill[i] && max_fill_chunk_sc[i] >= 0) {
-                            dims_outside_fill[i] = FALSE;
-                            ndims_outside_fill--;
-                        } /* end if */
-                    } /* end else */
-                } /* end if */
+                if(scaled[i] > max_plane_chunk_sc[i])
+                    scaled[i] = 0;
                 else {
-                    /* Check if we just went outside the fill dimension */
-                    if(!dims_outside_fill[i] && (hssize_t)scaled[i] > max_fill_chunk_sc[i]) {
-                        dims_outside_fill[i] = TRUE;
-                        ndims_outside_fill++;
-                    } /* end if */
-
                     /* We found the next chunk, so leave the loop */
                     carry = FALSE;
                     break;
@@ -5492,11 +9512,19 @@ H5D__chunk_delete(H5F_t *f, hid_t dxpl_id, H5O_t *oh, H5O_storage_t *storage)
     idx_info.layout = &layout.u.chunk;
     idx_info.storage = &storage->u.chunk;
 
+    /* Count the chunks sharing each block, so each block is freed once */
+    if(layout.u.chunk.flags & H5O_LAYOUT_CHUNK_DEDUP_IDENTICAL_CHUNKS)
+        if(H5D__chunk_dedup_create(&idx_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to count chunks in deduplicated blocks")
+
     /* Delete the chunked storage information in the file */
     if((storage->u.chunk.ops->idx_delete)(&idx_info) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTDELETE, FAIL, "unable to delete chunk index")
 
 done:
+    H5D__chunk_dedup_dest(sc);
+
+
     /* Clean up any messages read in */
     if(pline_read)
         if(H5O_msg_reset(H5O_PLINE_ID, &pline) < 0)
@@ -5527,9 +9555,7 @@ herr_t
 H5D__chunk_update_cache(H5D_t *dset, hid_t dxpl_id)
 {
     H5D_rdcc_t         *rdcc = &(dset->shared->cache.chunk);	/*raw data chunk cache */
-    H5D_rdcc_ent_t     *ent, *next;	/*cache entry  */
-    H5D_rdcc_ent_t     tmp_head;        /* Sentinel entry for temporary entry list */
-    H5D_rdcc_ent_t     *tmp_tail;       /* Tail pointer for temporary entry list */
+    H5D_rdcc_ent_t     *ent;            /*cache entry  */
     H5D_dxpl_cache_t _dxpl_cache;       /* Data transfer property cache buffer */
     H5D_dxpl_cache_t *dxpl_cache = &_dxpl_cache;   /* Data transfer property cache */
     herr_t              ret_value = SUCCEED;      /* Return value */
@@ -5547,83 +9573,16 @@ H5D__chunk_update_cache(H5D_t *dset, hid_t dxpl_id)
     if(H5D__get_dxpl_cache(dxpl_id, &dxpl_cache) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't fill dxpl cache")
 
-    /* Add temporary entry list to rdcc */
-    (void)HDmemset(&tmp_head, 0, sizeof(tmp_head));
-    rdcc->tmp_head = &tmp_head;
-    tmp_tail = &tmp_head;
-
-    /* Recompute the index for each cached chunk that is in a dataset */
-    for(ent = rdcc->head; ent; ent = next) {
-        unsigned	    old_idx;	/* Previous index number	*/
-
-        /* Get the pointer to the next cache entry */
-        next = ent->next;
-
-        /* Compute the index for the chunk entry */
-        old_idx = ent->idx;   /* Save for later */
-        ent->idx = H5D__chunk_hash_val(dset->shared, ent->scaled);
-
-        if(old_idx != ent->idx) {
-            H5D_rdcc_ent_t     *old_ent;	/* Old cache entry  */
-
-            /* Check if there is already a chunk at this chunk's new location */
-            old_ent = rdcc->slot[ent->idx];
-            if(old_ent != NULL) {
-                HDassert(old_ent->locked == FALSE);
-                HDassert(old_ent->deleted == FALSE);
-
-                /* Insert the old entry into the temporary list, but do not
-                 * evict (yet).  Make sure we do not make any calls to the index
-                 * until all chunks have updated indices! */
-                HDassert(!old_ent->tmp_next);
-                HDassert(!old_ent->tmp_prev);
-                tmp_tail->tmp_next = old_ent;
-                old_ent->tmp_prev = tmp_tail;
-                tmp_tail = old_ent;
-            } /* end if */
-
-            /* Insert this chunk into correct location in hash table */
-            rdcc->slot[ent->idx] = ent;
-
-            /* If this chunk was previously on the temporary list and therefore
-             * not in the hash table, remove it from the temporary list.
-             * Otherwise clear the old hash table slot. */
-            if(ent->tmp_prev) {
-                HDassert(tmp_head.tmp_next);
-                HDassert(tmp_tail != &tmp_head);
-                ent->tmp_prev->tmp_next = ent->tmp_next;
-                if(ent->tmp_next) {
-                    ent->tmp_next->tmp_prev = ent->tmp_prev;
-                    ent->tmp_next = NULL;
-                } /* end if */
-                else {
-                    HDassert(tmp_tail == ent);
-                    tmp_tail = ent->tmp_prev;
-                } /* end else */
-                ent->tmp_prev = NULL;
-            } /* end if */
-            else
-                rdcc->slot[old_idx] = NULL;
-        } /* end if */
-    } /* end for */
-
-    /* tmp_tail is no longer needed, and will be invalidated by
-     * H5D_chunk_cache_evict anyways. */
-    tmp_tail = NULL;
-
-    /* Evict chunks that are still on the temporary list */
-    while(tmp_head.tmp_next) {
-        ent = tmp_head.tmp_next;
+    /* Take all the cached chunks out of the hash table.  Make sure we do not
+     * make any calls to the index until all chunks have updated indices! */
+    for(ent = rdcc->head; ent; ent = ent->next)
+        rdcc->slot[ent->idx] = NULL;
 
-        /* Remove the old entry from the cache */
-        if(H5D__chunk_cache_evict(dset, dxpl_id, dxpl_cache, ent, TRUE) < 0)
-            HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
-    } /* end while */
+    /* Put each cached chunk back in the set for its new index */
+    if(H5D__chunk_cache_rehash(dset, dxpl_id, dxpl_cache) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to rehash raw data chunk cache")
 
 done:
-    /* Remove temporary list from rdcc */
-    rdcc->tmp_head = NULL;
-
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_update_cache() */
 
@@ -5717,27 +9676,12 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
     } else {
         H5D_rdcc_ent_t *ent = NULL;    /* Cache entry */
         unsigned idx;                   /* Index of chunk in cache, if present */
-        unsigned u;                     /* Counter */
         H5D_shared_t *shared_fo = udata->cpy_info->shared_fo;
 
         /* See if the written chunk is in the chunk cache */
-        if(shared_fo && shared_fo->cache.chunk.nslots > 0) {
-            /* Determine the chunk's location in the hash table */
-            idx = H5D__chunk_hash_val(shared_fo, chunk_rec->scaled);
-
-            /* Get the chunk cache entry for that location */
+        if(shared_fo && UINT_MAX != (idx = H5D__chunk_cache_find(shared_fo, chunk_rec->scaled))) {
             ent = shared_fo->cache.chunk.slot[idx];
-            if(ent) {
-                /* Speculatively set the 'found' flag */
-                udata->chunk_in_cache = TRUE;
-
-                /* Verify that the cache entry is the correct chunk */
-                for(u = 0; u < shared_fo->ndims; u++)
-                    if(chunk_rec->scaled[u] != ent->scaled[u]) {
-                        udata->chunk_in_cache = FALSE;
-                        break;
-                    } /* end if */
-            } /* end if */
+            udata->chunk_in_cache = TRUE;
         } /* end if */
 
         if(udata->chunk_in_cache) {
@@ -6575,42 +10519,35 @@ H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info, const H5F_block_t *old
 
     /* Check for filters on chunks */
     if(idx_info->pline->nused > 0) {
-        /* Sanity/error checking block */
+        /* Sanity/error checking */
 	HDassert(idx_info->storage->idx_type != H5D_CHUNK_IDX_NONE);
-        {
-            unsigned allow_chunk_size_len;          /* Allowed size of encoded chunk size */
-            unsigned new_chunk_size_len;            /* Size of encoded chunk size */
-
-            /* Compute the size required for encoding the size of a chunk, allowing
-             * for an extra byte, in case the filter makes the chunk larger.
-             */
-            allow_chunk_size_len = 1 + ((H5VM_log2_gen((uint64_t)(idx_info->layout->size)) + 8) / 8);
-            if(allow_chunk_size_len > 8)
-                allow_chunk_size_len = 8;
-
-            /* Compute encoded size of chunk */
-            new_chunk_size_len = (H5VM_log2_gen((uint64_t)(new_chunk->length)) + 8) / 8;
-            if(new_chunk_size_len > 8)
-                HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "encoded chunk size is more than 8 bytes?!?")
-
-            /* Check if the chunk became too large to be encoded */
-            if(new_chunk_size_len > allow_chunk_size_len)
-                HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk size can't be encoded")
-        } /* end block */
+        if(H5D__chunk_check_size(idx_info, new_chunk->length) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "invalid chunk size")
 
 	if(old_chunk && H5F_addr_defined(old_chunk->offset)) {
 	    /* Sanity check */
             HDassert(!H5F_addr_defined(new_chunk->offset) || H5F_addr_eq(new_chunk->offset, old_chunk->offset));
 
+            /* Count the chunks sharing each block, before this one's moves */
+            if(H5D__chunk_dedup_load(idx_info) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to count chunks in deduplicated blocks")
+
+            /* A block shared with identical chunks must stay as it is, so
+             * the chunk moves to a block of its own */
+            if(H5D__chunk_dedup_is_shared(idx_info->storage, old_chunk->offset)) {
+                if(H5D__chunk_free_block(idx_info->f, idx_info->dxpl_id, idx_info->storage, old_chunk->offset, old_chunk->length) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
+                alloc_chunk = TRUE;
+            } /* end if */
             /* Check for chunk being same size */
-	    if(new_chunk->length != old_chunk->length) {
+	    else if(new_chunk->length != old_chunk->length) {
 		/* Release previous chunk */
 		/* Only free the old location if not doing SWMR writes - otherwise
                  * we must keep the old chunk around in case a reader has an
                  * outdated version of the B-tree node
                  */
 		if(!(H5F_INTENT(idx_info->f) & H5F_ACC_SWMR_WRITE))
-		    if(H5MF_xfree(idx_info->f, H5FD_MEM_DRAW, idx_info->dxpl_id, old_chunk->offset, old_chunk->length) < 0)
+		    if(H5D__chunk_free_block(idx_info->f, idx_info->dxpl_id, idx_info->storage, old_chunk->offset, old_chunk->length) < 0)
 			HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
 		alloc_chunk = TRUE;
 	    } /* end if */
@@ -6657,6 +10594,10 @@ H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info, const H5F_block_t *old
                 if(!H5F_addr_defined(new_chunk->offset))
                     HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "file allocation failed")
                 *need_insert = TRUE;
+
+                /* Keep track of every block of a deduplicated dataset */
+                if(idx_info->storage->dedup && NULL == H5D__chunk_dedup_add(idx_info->storage->dedup, new_chunk->offset, new_chunk->length))
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't add deduplicated block")
                 break;
 
             case H5D_CHUNK_IDX_NTYPES:
@@ -6673,6 +10614,46 @@ done:
 } /* H5D__chunk_file_alloc() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_check_size
+ *
+ * Purpose:     Check that the size of a filtered chunk can be encoded in
+ *              the chunk index.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_check_size(const H5D_chk_idx_info_t *idx_info, hsize_t length)
+{
+    unsigned allow_chunk_size_len;      /* Allowed size of encoded chunk size */
+    unsigned new_chunk_size_len;        /* Size of encoded chunk size */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Compute the size required for encoding the size of a chunk, allowing
+     * for an extra byte, in case the filter makes the chunk larger.
+     */
+    allow_chunk_size_len = 1 + ((H5VM_log2_gen((uint64_t)(idx_info->layout->size)) + 8) / 8);
+    if(allow_chunk_size_len > 8)
+        allow_chunk_size_len = 8;
+
+    /* Compute encoded size of chunk */
+    new_chunk_size_len = (H5VM_log2_gen((uint64_t)length) + 8) / 8;
+    if(new_chunk_size_len > 8)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "encoded chunk size is more than 8 bytes?!?")
+
+    /* Check if the chunk became too large to be encoded */
+    if(new_chunk_size_len > allow_chunk_size_len)
+        HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk size can't be encoded")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_check_size() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_format_convert_cb
  *
@@ -6800,6 +10781,10 @@ H5D__chunk_format_convert(H5D_t *dset, H5D_chk_idx_info_t *idx_info, H5D_chk_idx
     if((idx_info->storage->ops->iterate)(idx_info, H5D__chunk_format_convert_cb, &udata) < 0)
 	HGOTO_ERROR(H5E_DATASET, H5E_BADITER, FAIL, "unable to iterate over chunk index to chunk info")
 
+    /* Chunks may have moved; the in-memory copy of the index is rebuilt
+     * from the new index when next needed */
+    H5D__chunk_addr_map_reset(&dset->shared->cache.chunk);
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_format_convert() */
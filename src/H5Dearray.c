@@ -69,6 +69,7 @@ typedef struct H5D_earray_ctx_t {
 typedef struct H5D_earray_ud_t {
     H5F_t *f;                   /* File pointer for operation */
     hid_t dxpl_id;              /* DXPL ID for operation */
+    const H5O_storage_chunk_t *storage; /* Chunked storage of the dataset */
 } H5D_earray_ud_t;
 
 /* Extensible Array callback info for iteration over chunks */
@@ -1440,7 +1441,7 @@ H5D__earray_idx_remove(const H5D_chk_idx_info_t *idx_info, H5D_chunk_common_ud_t
         HDassert(H5F_addr_defined(elmt.addr));
         if(!(H5F_INTENT(idx_info->f) & H5F_ACC_SWMR_WRITE)) {
             H5_CHECK_OVERFLOW(elmt.nbytes, /*From: */uint32_t, /*To: */hsize_t);
-            if(H5MF_xfree(idx_info->f, H5FD_MEM_DRAW, idx_info->dxpl_id, elmt.addr, (hsize_t)elmt.nbytes) < 0)
+            if(H5D__chunk_free_block(idx_info->f, idx_info->dxpl_id, idx_info->storage, elmt.addr, (hsize_t)elmt.nbytes) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
         } /* end if */
 
@@ -1462,7 +1463,7 @@ H5D__earray_idx_remove(const H5D_chk_idx_info_t *idx_info, H5D_chunk_common_ud_t
         HDassert(H5F_addr_defined(addr));
         if(!(H5F_INTENT(idx_info->f) & H5F_ACC_SWMR_WRITE)) {
             H5_CHECK_OVERFLOW(idx_info->layout->size, /*From: */uint32_t, /*To: */hsize_t);
-            if(H5MF_xfree(idx_info->f, H5FD_MEM_DRAW, idx_info->dxpl_id, addr, (hsize_t)idx_info->layout->size) < 0)
+            if(H5D__chunk_free_block(idx_info->f, idx_info->dxpl_id, idx_info->storage, addr, (hsize_t)idx_info->layout->size) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "unable to free chunk")
         } /* end if */
 
@@ -1507,7 +1508,7 @@ H5D__earray_idx_delete_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
 
     /* Remove raw data chunk from file */
     H5_CHECK_OVERFLOW(chunk_rec->nbytes, /*From: */uint32_t, /*To: */hsize_t);
-    if(H5MF_xfree(udata->f, H5FD_MEM_DRAW, udata->dxpl_id, chunk_rec->chunk_addr, (hsize_t)chunk_rec->nbytes) < 0)
+    if(H5D__chunk_free_block(udata->f, udata->dxpl_id, udata->storage, chunk_rec->chunk_addr, (hsize_t)chunk_rec->nbytes) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, H5_ITER_ERROR, "unable to free chunk")
 
 done:
@@ -1555,6 +1556,7 @@ H5D__earray_idx_delete(const H5D_chk_idx_info_t *idx_info)
         /* Initialize user data for callback */
         udata.f = idx_info->f;
         udata.dxpl_id = idx_info->dxpl_id;
+        udata.storage = idx_info->storage;
 
         /* Iterate over the chunk addresses in the extensible array, deleting each chunk */
         if(H5D__earray_idx_iterate(idx_info, H5D__earray_idx_delete_cb, &udata) < 0)
@@ -390,6 +390,18 @@ H5D__get_dxpl_cache_real(hid_t dxpl_id, H5D_dxpl_cache_t *cache)
     if(H5P_peek(dx_plist, H5D_XFER_XFORM_NAME, &cache->data_xform_prop) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve data transform info")
 
+    /* Get number of threads for unfiltering chunks */
+    if(H5P_get(dx_plist, H5D_XFER_CHUNK_FILTER_NTHREADS_NAME, &cache->chunk_filter_nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve chunk filter thread count")
+
+    /* Get streaming chunk write flag */
+    if(H5P_get(dx_plist, H5D_XFER_CHUNK_STREAM_WRITE_NAME, &cache->chunk_stream_write) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve chunk stream write flag")
+
+    /* Get pipelined type conversion flag */
+    if(H5P_get(dx_plist, H5D_XFER_TCONV_PIPELINE_NAME, &cache->tconv_pipeline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "Can't retrieve pipelined type conversion flag")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* end H5D__get_dxpl_cache_real() */
@@ -1936,6 +1948,12 @@ H5D_close(H5D_t *dataset)
 
     } /* end if */
     else {
+        /* Preempt the chunks cached through this ID from the file-wide chunk
+         * cache budget, which refers to them by the ID's dataset struct */
+        if(H5D_CHUNKED == dataset->shared->layout.type)
+            if(H5D__chunk_pool_close(dataset, H5AC_ind_read_dxpl_id) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush cached chunks")
+
         /* Decrement the ref. count for this object in the top file */
         if(H5FO_top_decr(dataset->oloc.file, dataset->oloc.addr) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't decrement count for object")
@@ -2803,10 +2821,10 @@ H5D__set_extent(H5D_t *dset, const hsize_t *size, hid_t dxpl_id)
                     dset->shared->cache.chunk.scaled_dims[u] = scaled;
 
                     /* Check if algorithm for computing hash values will change */
-                    if((scaled > dset->shared->cache.chunk.nslots &&
-                                dset->shared->cache.chunk.scaled_dims[u] <= dset->shared->cache.chunk.nslots)
-                            || (scaled <= dset->shared->cache.chunk.nslots &&
-                                dset->shared->cache.chunk.scaled_dims[u] > dset->shared->cache.chunk.nslots))
+                    if((scaled > dset->shared->cache.chunk.nsets &&
+                                dset->shared->cache.chunk.scaled_dims[u] <= dset->shared->cache.chunk.nsets)
+                            || (scaled <= dset->shared->cache.chunk.nsets &&
+                                dset->shared->cache.chunk.scaled_dims[u] > dset->shared->cache.chunk.nsets))
                         update_chunks = TRUE;
 
                     /* Check if the number of bits required to encode the scaled size value changed */
@@ -3019,6 +3037,11 @@ H5D__format_convert(H5D_t *dataset, hid_t dxpl_id)
         case H5D_CHUNKED:
             HDassert(dataset->shared->layout.u.chunk.idx_type != H5D_CHUNK_IDX_BTREE);
 
+            /* The version 1 B-tree layout can't record that chunks share
+             * blocks in the file */
+            if(dataset->shared->layout.u.chunk.flags & H5O_LAYOUT_CHUNK_DEDUP_IDENTICAL_CHUNKS)
+                HGOTO_ERROR(H5E_DATASET, H5E_UNSUPPORTED, FAIL, "can't convert layout of dataset with deduplicated chunks")
+
             if(NULL == (newlayout = (H5O_layout_t *)H5MM_calloc(sizeof(H5O_layout_t))))
                 HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate buffer")
 
@@ -3504,6 +3527,16 @@ H5D_get_access_plist(H5D_t *dset)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache byte size")
         if(H5P_set(new_plist, H5D_ACS_PREEMPT_READ_CHUNKS_NAME, &(dset->shared->cache.chunk.w0)) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set preempt read chunks")
+        if(H5P_set(new_plist, H5D_ACS_CHUNK_READ_AHEAD_NAME, &(dset->shared->cache.chunk.ra.nchunks)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set # of chunks to read ahead")
+        if(H5P_set(new_plist, H5D_ACS_CHUNK_ADDR_MAP_NAME, &(dset->shared->cache.chunk.addr_map.max_nchunks)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set max. # of chunks in address map")
+        if(H5P_set(new_plist, H5D_ACS_CHUNK_CACHE_MIN_NBYTES_NAME, &(dset->shared->cache.chunk.resize.min_nbytes)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set min. size of chunk cache")
+        if(H5P_set(new_plist, H5D_ACS_CHUNK_CACHE_MAX_NBYTES_NAME, &(dset->shared->cache.chunk.resize.max_nbytes)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set max. size of chunk cache")
+        if(H5P_set(new_plist, H5D_ACS_CHUNK_CACHE_IMAGES_NAME, &(dset->shared->cache.chunk.img.nbytes_max)) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set size of filtered chunk images cache")
         if(H5P_set(new_plist, H5D_ACS_APPEND_FLUSH_NAME, &dset->shared->append_flush) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set append flush property")
     } /* end if */
@@ -182,6 +182,7 @@ H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
     if(direct_read) {
         unsigned u;
         hsize_t  internal_offset[H5O_LAYOUT_NDIMS];
+        size_t   direct_nchunks;
 
         if(H5D_CHUNKED != dset->shared->layout.type)
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
@@ -190,6 +191,21 @@ H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
         if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME, &direct_offset) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting direct offset from xfer properties")
 
+        /* Check for reading several chunks */
+        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_NCHUNKS_NAME, &direct_nchunks) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting # of chunks from xfer properties")
+        if(direct_nchunks > 0) {
+            uint32_t *direct_filter_masks;
+
+            if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_READ_FILTER_MASKS_NAME, &direct_filter_masks) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting filter masks from xfer properties")
+
+            /* Read the raw chunks */
+            if(H5D__chunk_direct_read_multi(dset, plist_id, direct_nchunks, direct_offset, direct_filter_masks, (void **)buf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "can't read chunks directly")
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+
         /* The library's chunking code requires the offset terminates with a zero. So transfer the
          * offset array to an internal offset array */
         for(u = 0; u < dset->shared->ndims; u++) {
@@ -350,6 +366,7 @@ H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id,
         uint32_t direct_filters;
         hsize_t *direct_offset;
         uint32_t direct_datasize;
+        size_t   direct_nchunks;
         hsize_t  internal_offset[H5O_LAYOUT_NDIMS];
         unsigned u;                 /* Local index variable */
 
@@ -360,6 +377,26 @@ H5D__pre_write(H5D_t *dset, hbool_t direct_write, hid_t mem_type_id,
         if(H5D_CHUNKED != dset->shared->layout.type)
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
 
+        /* Check for writing several chunks */
+        if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_NCHUNKS_NAME, &direct_nchunks) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting # of chunks for direct chunk write")
+        if(direct_nchunks > 0) {
+            const uint32_t *direct_filter_masks;
+            const size_t *direct_datasizes;
+
+            if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_FILTER_MASKS_NAME, &direct_filter_masks) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting filter info for direct chunk write")
+            if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_NAME, &direct_offset) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting offset info for direct chunk write")
+            if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZES_NAME, &direct_datasizes) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting data sizes for direct chunk write")
+
+            /* Write the raw chunks */
+            if(H5D__chunk_direct_write_multi(dset, dxpl_id, direct_nchunks, direct_filter_masks, direct_offset, direct_datasizes, (const void * const *)buf) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "can't write chunks directly")
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+
         /* Retrieve parameters for direct chunk write */
         if(H5P_get(plist, H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_NAME, &direct_filters) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "error getting filter info for direct chunk write")
@@ -1125,6 +1162,34 @@ H5D__typeinfo_init(const H5D_t *dset, const H5D_dxpl_cache_t *dxpl_cache,
                 HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for background conversion")
             type_info->bkg_buf_allocated = TRUE;
         } /* end if */
+
+        /* Get a second conversion buffer for pipelined reads, which gather
+         * each strip from the file while the one before it is converted.
+         * (Compound subsets are copied straight from the conversion buffer,
+         * so there's nothing to overlap their gathers with.) */
+        if(!do_write && dxpl_cache->tconv_pipeline && !type_info->is_conv_noop
+                && !(type_info->cmpd_subset && H5T_SUBSET_FALSE != type_info->cmpd_subset->subset)) {
+            H5P_genplist_t *dx_plist;       /* Data transfer property list */
+            H5T_conv_cb_t conv_cb;          /* Conversion exception callback */
+            htri_t builtin;                 /* Whether the dataset's filters are all built-in */
+
+            if(NULL == (type_info->tconv_pipe_buf = H5FL_BLK_MALLOC(type_conv, target_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for type conversion")
+
+            /* Strips are only converted on another thread, while this one
+             * gathers the next strip, by the library's own conversions
+             * which keep no state across elements.  Nothing run meanwhile
+             * may call back into the library: neither an exception
+             * callback nor, while gathering, an application's filter. */
+            if(NULL == (dx_plist = H5P_object_verify(dxpl_id, H5P_DATASET_XFER)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset transfer property list")
+            if(H5P_get(dx_plist, H5D_XFER_CONV_CB_NAME, &conv_cb) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get conversion exception callback")
+            if((builtin = H5Z_pipeline_builtin(&(dset->shared->dcpl_cache.pline))) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't check filter pipeline")
+            type_info->tconv_pipe_concurrent = (hbool_t)(NULL == conv_cb.func
+                    && H5T_path_concurrent(type_info->tpath) && builtin);
+        } /* end if */
     } /* end else */
 
 done:
@@ -1307,6 +1372,8 @@ H5D__typeinfo_term(const H5D_type_info_t *type_info)
         HDassert(type_info->bkg_buf);
         (void)H5FL_BLK_FREE(type_conv, type_info->bkg_buf);
     } /* end if */
+    if(type_info->tconv_pipe_buf)
+        (void)H5FL_BLK_FREE(type_conv, type_info->tconv_pipe_buf);
 
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* end H5D__typeinfo_term() */
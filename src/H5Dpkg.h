@@ -114,6 +114,8 @@ typedef struct H5D_type_info_t {
     hbool_t tconv_buf_allocated;        /* Whether the type conversion buffer was allocated */
     uint8_t *bkg_buf;	                /* Background buffer	*/
     hbool_t bkg_buf_allocated;          /* Whether the background buffer was allocated */
+    uint8_t *tconv_pipe_buf;            /* Second datatype conv buffer, for pipelined reads */
+    hbool_t tconv_pipe_concurrent;      /* Whether a strip may be converted on another thread */
 } H5D_type_info_t;
 
 /* Forward declaration of structs used below */
@@ -350,6 +352,9 @@ typedef struct H5D_chunk_info_t {
     hbool_t fspace_shared;      /* Indicate that the file space for a chunk is shared and shouldn't be freed */
     H5S_t *mspace;              /* Dataspace describing selection in memory corresponding to this chunk */
     hbool_t mspace_shared;      /* Indicate that the memory space for a chunk is shared and shouldn't be freed */
+    hbool_t addr_known;         /* Whether the location below is known (only valid when the map's 'addrs_known' flag is set) */
+    H5F_block_t chunk_block;    /* Offset/length of chunk in file, from a batched lookup */
+    unsigned filter_mask;       /* Excluded filters, from a batched lookup */
 } H5D_chunk_info_t;
 
 /* Main structure holding the mapping between file chunks and memory */
@@ -378,6 +383,8 @@ typedef struct H5D_chunk_map_t {
 
     hsize_t chunk_dim[H5O_LAYOUT_NDIMS];    /* Size of chunk in each dimension */
 
+    hbool_t addrs_known;        /* Whether the selected chunks were looked up together */
+
 #ifdef H5_HAVE_PARALLEL
     H5D_chunk_info_t **select_chunk;    /* Store the information about whether this chunk is selected or not */
 #endif /* H5_HAVE_PARALLEL */
@@ -405,16 +412,60 @@ typedef struct H5D_virtual_held_file_t {
 
 /* The raw data chunk cache */
 struct H5D_rdcc_ent_t;  /* Forward declaration of struct used below */
+struct H5D_rdcc_img_t;  /* Forward declaration of struct used below */
+
+/* Budget shared by the raw data chunk caches of all the datasets open in a
+ * file, when a file-wide budget is set in the file access property list */
+typedef struct H5D_rdcc_pool_t {
+    size_t		nbytes_max; /* Maximum cached raw data in bytes	*/
+    size_t		nbytes_used; /* Current cached raw data in bytes */
+    unsigned		nrefs;	/* Number of dataset caches using the pool */
+    struct H5D_rdcc_ent_t *head; /* Least recently used entry, in any dataset */
+    struct H5D_rdcc_ent_t *tail; /* Most recently used entry, in any dataset */
+} H5D_rdcc_pool_t;
+
+/* Location of a chunk, in a dataset's in-memory copy of its chunk index */
+typedef struct H5D_chunk_addr_t {
+    haddr_t     addr;           /* Address of chunk (HADDR_UNDEF if not allocated) */
+    uint32_t    nbytes;         /* Size of (filtered) chunk */
+    unsigned    filter_mask;    /* Excluded filters */
+} H5D_chunk_addr_t;
+
 typedef struct H5D_rdcc_t {
-    struct {
-        unsigned	ninits;	/* Number of chunk creations		*/
-        unsigned	nhits;	/* Number of cache hits			*/
-        unsigned	nmisses;/* Number of cache misses		*/
-        unsigned	nflushes;/* Number of cache flushes		*/
-    } stats;
+    H5D_chunk_cache_stats_t stats; /* Cache statistics (reset by H5Dreset_chunk_cache_stats) */
     size_t		nbytes_max; /* Maximum cached raw data in bytes	*/
-    size_t		nslots;	/* Number of chunk slots allocated	*/
+    size_t		nslots;	/* Number of chunk slots requested	*/
+    size_t		nsets;	/* Number of sets of slots allocated	*/
+    unsigned		nways;	/* Number of slots in each set		*/
+    uint64_t		tick;	/* Incremented on each chunk access	*/
     double		w0;     /* Chunk preemption policy          */
+    unsigned		flush_nthreads; /* # of threads filtering dirty chunks on flush */
+    struct {
+        unsigned	nchunks; /* # of chunks to read ahead (0 if disabled) */
+        unsigned	nseq;	/* # of chunks read in the current sequence */
+        hsize_t		stride;	/* Distance between chunks in the sequence */
+        hsize_t		last;	/* Index of the last chunk read */
+    } ra;                       /* Read-ahead on sequential access */
+    struct {
+        size_t		max_nchunks; /* Max. # of chunks in dataset for keeping the map (0 if disabled) */
+        hsize_t		nchunks; /* # of chunks in the map */
+        struct H5D_chunk_addr_t *addr; /* Location of each chunk, by chunk index (NULL if not built) */
+    } addr_map;                 /* In-memory copy of the chunk index */
+    struct {
+        size_t		min_nbytes; /* Smallest size the cache is shrunk to */
+        size_t		max_nbytes; /* Largest size the cache is grown to (0 if not resized) */
+        size_t		nhits;	/* # of accesses to cached chunks in the current epoch */
+        size_t		nmisses; /* # of chunks brought into the cache in the current epoch */
+        uint64_t	tick;	/* Value of 'tick' when the current epoch began */
+    } resize;                   /* Automatic resizing of the cache */
+    struct {
+        size_t		nbytes_max; /* Maximum size of filtered images (0 if disabled) */
+        size_t		nbytes_used; /* Current size of filtered images */
+        H5SL_t		*sl;	/* Images, by address of chunk in file */
+        struct H5D_rdcc_img_t *head; /* Least recently used image */
+        struct H5D_rdcc_img_t *tail; /* Most recently used image */
+    } img;                      /* Second tier, holding filtered images of chunks */
+    H5D_rdcc_pool_t	*pool;	/* File-wide budget shared with other datasets (NULL if none) */
     struct H5D_rdcc_ent_t *head; /* Head of doubly linked list		*/
     struct H5D_rdcc_ent_t *tail; /* Tail of doubly linked list		*/
     struct H5D_rdcc_ent_t *tmp_head; /* Head of temporary doubly linked list.  Chunks on this list are not in the hash table (slot).  The head entry is a sentinel (does not refer to an actual chunk). */
@@ -665,6 +716,16 @@ H5_DLL hbool_t H5D__chunk_is_space_alloc(const H5O_storage_t *storage);
 H5_DLL herr_t H5D__chunk_lookup(const H5D_t *dset, hid_t dxpl_id,
     const hsize_t *scaled, H5D_chunk_ud_t *udata);
 H5_DLL herr_t H5D__chunk_allocated(H5D_t *dset, hid_t dxpl_id, hsize_t *nbytes);
+H5_DLL herr_t H5D__chunk_free_block(H5F_t *f, hid_t dxpl_id,
+    const H5O_storage_chunk_t *storage, haddr_t addr, hsize_t nbytes);
+H5_DLL herr_t H5D__chunk_iter(H5D_t *dset, hid_t dxpl_id, H5D_chunk_iter_op_t op,
+    void *op_data);
+H5_DLL herr_t H5D__get_num_chunks(H5D_t *dset, hid_t dxpl_id, hsize_t *nchunks);
+H5_DLL herr_t H5D__get_chunk_info(H5D_t *dset, hid_t dxpl_id, hsize_t start,
+    hsize_t nchunks, hsize_t *offsets, unsigned *filter_masks, haddr_t *addrs,
+    hsize_t *sizes);
+H5_DLL herr_t H5D__get_chunk_info_by_coord(H5D_t *dset, hid_t dxpl_id,
+    const hsize_t *offset, unsigned *filter_mask, haddr_t *addr, hsize_t *size);
 H5_DLL herr_t H5D__chunk_allocate(const H5D_io_info_t *io_info, hbool_t full_overwrite, hsize_t old_dim[]);
 H5_DLL herr_t H5D__chunk_update_old_edge_chunks(H5D_t *dset, hid_t dxpl_id,
     hsize_t old_dim[]);
@@ -688,6 +749,12 @@ H5_DLL herr_t H5D__chunk_direct_write(const H5D_t *dset, hid_t dxpl_id, uint32_t
          hsize_t *offset, uint32_t data_size, const void *buf);
 H5_DLL herr_t H5D__chunk_direct_read(const H5D_t *dset, hid_t dxpl_id, hsize_t *offset,
          uint32_t *filters, void *buf);
+H5_DLL herr_t H5D__chunk_direct_write_multi(const H5D_t *dset, hid_t dxpl_id,
+    size_t nchunks, const uint32_t filters[], const hsize_t offsets[],
+    const size_t data_sizes[], const void * const bufs[]);
+H5_DLL herr_t H5D__chunk_direct_read_multi(const H5D_t *dset, hid_t dxpl_id,
+    size_t nchunks, const hsize_t offsets[], uint32_t filters[], void * const bufs[]);
+H5_DLL herr_t H5D__chunk_pool_close(const H5D_t *dset, hid_t dxpl_id);
 #ifdef H5D_CHUNK_DEBUG
 H5_DLL herr_t H5D__chunk_stats(const H5D_t *dset, hbool_t headers);
 #endif /* H5D_CHUNK_DEBUG */
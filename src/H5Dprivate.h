@@ -54,6 +54,12 @@
 #define H5D_ACS_VDS_PRINTF_GAP_NAME         "vds_printf_gap" /* VDS printf gap size */
 #define H5D_ACS_APPEND_FLUSH_NAME    "append_flush"         /* Append flush actions */
 #define H5D_ACS_EFILE_PREFIX_NAME           "external file prefix" /* External file prefix */
+#define H5D_ACS_CHUNK_FLUSH_NTHREADS_NAME   "chunk_flush_nthreads" /* # of threads filtering chunks on flush */
+#define H5D_ACS_CHUNK_READ_AHEAD_NAME       "chunk_read_ahead" /* # of chunks read ahead on sequential access */
+#define H5D_ACS_CHUNK_ADDR_MAP_NAME         "chunk_addr_map" /* Max. # of chunks for keeping the chunks' addresses in memory */
+#define H5D_ACS_CHUNK_CACHE_MIN_NBYTES_NAME "chunk_cache_min_nbytes" /* Smallest size the chunk cache is shrunk to */
+#define H5D_ACS_CHUNK_CACHE_MAX_NBYTES_NAME "chunk_cache_max_nbytes" /* Largest size the chunk cache is grown to (0 if not resized) */
+#define H5D_ACS_CHUNK_CACHE_IMAGES_NAME     "chunk_cache_images" /* Max. size of filtered chunk images kept in the chunk cache */
 
 /* ======== Data transfer properties ======== */
 #define H5D_XFER_MAX_TEMP_BUF_NAME      "max_temp_buf"  /* Maximum temp buffer size */
@@ -65,6 +71,7 @@
 #define H5D_XFER_VLEN_ALLOC_INFO_NAME   "vlen_alloc_info" /* Vlen allocation info */
 #define H5D_XFER_VLEN_FREE_NAME         "vlen_free"     /* Vlen free function */
 #define H5D_XFER_VLEN_FREE_INFO_NAME    "vlen_free_info" /* Vlen free info */
+#define H5D_XFER_VLEN_ARENA_NAME        "vlen_arena"    /* Vlen data arena */
 #define H5D_XFER_VFL_ID_NAME            "vfl_id"        /* File driver ID */
 #define H5D_XFER_VFL_INFO_NAME          "vfl_info"      /* File driver info */
 #define H5D_XFER_HYPER_VECTOR_SIZE_NAME "vec_size"      /* Hyperslab vector size */
@@ -81,6 +88,10 @@
 #define H5D_XFER_FILTER_CB_NAME         "filter_cb"     /* Filter callback function */
 #define H5D_XFER_CONV_CB_NAME           "type_conv_cb"  /* Type conversion callback function */
 #define H5D_XFER_XFORM_NAME             "data_transform" /* Data transform */
+#define H5D_XFER_CHUNK_FILTER_NTHREADS_NAME "chunk_filter_nthreads" /* Threads for unfiltering chunks */
+#define H5D_XFER_CHUNK_STREAM_WRITE_NAME "chunk_stream_write" /* Write whole chunks straight to the file */
+#define H5D_XFER_TCONV_PIPELINE_NAME    "tconv_pipeline" /* Gather each strip while converting the one before */
+#define H5D_XFER_TCONV_NTHREADS_NAME    "tconv_nthreads" /* Threads for converting large numbers of elements */
 #ifdef H5_HAVE_INSTRUMENTED_LIBRARY
 /* Collective chunk instrumentation properties */
 #define H5D_XFER_COLL_CHUNK_LINK_HARD_NAME "coll_chunk_link_hard"
@@ -134,6 +145,9 @@ typedef struct H5D_dxpl_cache_t {
 #endif /*H5_HAVE_PARALLEL*/
     H5Z_cb_t filter_cb;         /* Filter callback function (H5D_XFER_FILTER_CB_NAME) */
     H5Z_data_xform_t *data_xform_prop; /* Data transform prop (H5D_XFER_XFORM_NAME) */
+    unsigned chunk_filter_nthreads; /* Threads for unfiltering chunks (H5D_XFER_CHUNK_FILTER_NTHREADS_NAME) */
+    hbool_t chunk_stream_write; /* Write whole chunks straight to the file (H5D_XFER_CHUNK_STREAM_WRITE_NAME) */
+    hbool_t tconv_pipeline;     /* Gather each strip while converting the one before (H5D_XFER_TCONV_PIPELINE_NAME) */
 } H5D_dxpl_cache_t;
 
 /* Typedef for cached dataset creation property list information */
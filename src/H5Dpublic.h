@@ -34,6 +34,7 @@
 
 /* Bit flags for the H5Pset_chunk_opts() and H5Pget_chunk_opts() */
 #define H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS      (0x0002u)
+#define H5D_CHUNK_DEDUP_IDENTICAL_CHUNKS          (0x0004u)
 
 /* Property names for H5LTDdirect_chunk_write */   
 #define H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME	        "direct_chunk_flag"
@@ -45,6 +46,12 @@
 #define H5D_XFER_DIRECT_CHUNK_READ_FLAG_NAME        "direct_chunk_read_flag"
 #define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_NAME      "direct_chunk_read_offset"
 #define H5D_XFER_DIRECT_CHUNK_READ_FILTERS_NAME     "direct_chunk_read_filters"
+
+/* Property names for H5DOwrite_chunks and H5DOread_chunks */
+#define H5D_XFER_DIRECT_CHUNK_NCHUNKS_NAME          "direct_chunk_nchunks"
+#define H5D_XFER_DIRECT_CHUNK_WRITE_FILTER_MASKS_NAME "direct_chunk_filter_masks"
+#define H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZES_NAME  "direct_chunk_datasizes"
+#define H5D_XFER_DIRECT_CHUNK_READ_FILTER_MASKS_NAME "direct_chunk_read_filter_masks"
  
 /*******************/
 /* Public Typedefs */
@@ -115,6 +122,18 @@ typedef enum H5D_vds_view_t {
 /* Callback for H5Pset_append_flush() in a dataset access property list */
 typedef herr_t (*H5D_append_cb_t)(hid_t dataset_id, hsize_t *cur_dims, void *op_data);
 
+/* Statistics for a dataset's raw data chunk cache, from H5Dget_chunk_cache_stats() */
+typedef struct H5D_chunk_cache_stats_t {
+    unsigned    ninits;         /* Number of chunks created in the cache */
+    unsigned    nhits;          /* Number of chunk accesses found in the cache */
+    unsigned    nmisses;        /* Number of chunk accesses not found in the cache */
+    unsigned    nflushes;       /* Number of chunks written to the file from the cache */
+    unsigned    nevictions;     /* Number of chunks evicted from the cache */
+    hsize_t     nbytes_read;    /* Bytes of chunk data read from the file */
+    hsize_t     nbytes_written; /* Bytes of chunk data written to the file */
+    double      filter_time;    /* Seconds spent filtering and unfiltering chunks */
+} H5D_chunk_cache_stats_t;
+
 /********************/
 /* Public Variables */
 /********************/
@@ -139,6 +158,10 @@ typedef herr_t (*H5D_scatter_func_t)(const void **src_buf/*out*/,
 typedef herr_t (*H5D_gather_func_t)(const void *dst_buf,
                                     size_t dst_buf_bytes_used, void *op_data);
 
+/* Define the operator function pointer for H5Dchunk_iter() */
+typedef int (*H5D_chunk_iter_op_t)(const hsize_t *offset, unsigned filter_mask,
+    haddr_t addr, hsize_t size, void *op_data);
+
 H5_DLL hid_t H5Dcreate2(hid_t loc_id, const char *name, hid_t type_id,
     hid_t space_id, hid_t lcpl_id, hid_t dcpl_id, hid_t dapl_id);
 H5_DLL hid_t H5Dcreate_anon(hid_t file_id, hid_t type_id, hid_t space_id,
@@ -152,6 +175,14 @@ H5_DLL hid_t H5Dget_create_plist(hid_t dset_id);
 H5_DLL hid_t H5Dget_access_plist(hid_t dset_id);
 H5_DLL hsize_t H5Dget_storage_size(hid_t dset_id);
 H5_DLL herr_t H5Dget_chunk_storage_size(hid_t dset_id, const hsize_t *offset, hsize_t *chunk_bytes);
+H5_DLL herr_t H5Dget_num_chunks(hid_t dset_id, hsize_t *nchunks);
+H5_DLL herr_t H5Dget_chunk_info(hid_t dset_id, hsize_t start, hsize_t nchunks,
+    hsize_t *offsets, unsigned *filter_masks, haddr_t *addrs, hsize_t *sizes);
+H5_DLL herr_t H5Dget_chunk_info_by_coord(hid_t dset_id, const hsize_t *offset,
+    unsigned *filter_mask, haddr_t *addr, hsize_t *size);
+H5_DLL herr_t H5Dchunk_iter(hid_t dset_id, H5D_chunk_iter_op_t op, void *op_data);
+H5_DLL herr_t H5Dget_chunk_cache_stats(hid_t dset_id, H5D_chunk_cache_stats_t *stats/*out*/);
+H5_DLL herr_t H5Dreset_chunk_cache_stats(hid_t dset_id);
 H5_DLL haddr_t H5Dget_offset(hid_t dset_id);
 H5_DLL herr_t H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 			hid_t file_space_id, hid_t plist_id, void *buf/*out*/);
@@ -32,11 +32,31 @@
 /* Local Macros */
 /****************/
 
+/* A strip may only be converted while the next one is gathered on another
+ * thread when the library is thread-safe (so that each thread has its own
+ * error stack) and the memory allocator keeps no shared state of its own */
+#if defined(H5_HAVE_THREADSAFE) && !defined(H5_MEMORY_ALLOC_SANITY_CHECK)
+#define H5D_SCATGATH_PIPE_THREADS
+#endif /* H5_HAVE_THREADSAFE && !H5_MEMORY_ALLOC_SANITY_CHECK */
+
 
 /******************/
 /* Local Typedefs */
 /******************/
 
+/* One step of a pipelined read: the conversion of one strip and the
+ * gather of the next */
+typedef struct H5D_scatgath_pipe_t {
+    const H5D_io_info_t *io_info;       /* I/O info for the read */
+    const H5D_type_info_t *type_info;   /* Datatype info for the read */
+    const H5S_t *file_space;            /* File dataspace */
+    H5S_sel_iter_t *file_iter;          /* File selection iterator */
+    uint8_t *conv_buf;                  /* Buffer holding the strip to convert */
+    size_t conv_nelmts;                 /* # of elements to convert */
+    uint8_t *gath_buf;                  /* Buffer to gather the next strip into */
+    size_t gath_nelmts;                 /* # of elements to gather */
+} H5D_scatgath_pipe_t;
+
 
 /********************/
 /* Local Prototypes */
@@ -54,6 +74,11 @@ static herr_t H5D__compound_opt_read(size_t nelmts, const H5S_t *mem_space,
     H5S_sel_iter_t *iter, const H5D_dxpl_cache_t *dxpl_cache,
     const H5D_type_info_t *type_info, void *user_buf/*out*/);
 static herr_t H5D__compound_opt_write(size_t nelmts, const H5D_type_info_t *type_info);
+static herr_t H5D__scatgath_read_pipe(const H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, hsize_t nelmts, const H5S_t *file_space,
+    const H5S_t *mem_space, H5S_sel_iter_t *file_iter, H5S_sel_iter_t *mem_iter,
+    H5S_sel_iter_t *bkg_iter);
+static herr_t H5D__scatgath_read_pipe_step(size_t idx, void *_pipe);
 
 
 /*********************/
@@ -491,6 +516,14 @@ H5D__scatgath_read(const H5D_io_info_t *io_info, const H5D_type_info_t *type_inf
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to initialize background selection information")
     bkg_iter_init = TRUE;	/*file selection iteration info has been initialized */
 
+    /* Gather each strip while the one before it is converted, when set up
+     * to and there's more than one strip */
+    if(type_info->tconv_pipe_buf && nelmts > type_info->request_nelmts) {
+        if(H5D__scatgath_read_pipe(io_info, type_info, nelmts, file_space, mem_space, file_iter, mem_iter, bkg_iter) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "pipelined read failed")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
     /* Start strip mining... */
     for(smine_start = 0; smine_start < nelmts; smine_start += smine_nelmts) {
         size_t n;               /* Elements operated on */
@@ -566,6 +599,138 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__scatgath_read() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__scatgath_read_pipe_step
+ *
+ * Purpose:	Perform one half of a step of a pipelined read: gather the
+ *              next strip from the file (IDX 0) or convert the current
+ *              strip (IDX 1).  The two halves use separate buffers and
+ *              iterators, so the conversion may run on another thread
+ *              while the calling thread gathers.  No error is pushed
+ *              here, since errors can't be pushed from other threads:
+ *              the caller reports the failure.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__scatgath_read_pipe_step(size_t idx, void *_pipe)
+{
+    H5D_scatgath_pipe_t *pipe = (H5D_scatgath_pipe_t *)_pipe;
+    const H5D_type_info_t *type_info = pipe->type_info;
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(idx == 0) {
+        /* Gather the next strip from the file */
+        if(H5D__gather_file(pipe->io_info, pipe->file_space, pipe->file_iter, pipe->gath_nelmts, pipe->gath_buf/*out*/) != pipe->gath_nelmts)
+            ret_value = FAIL;
+    } /* end if */
+    else
+        /* Perform datatype conversion */
+        ret_value = H5T_convert(type_info->tpath, type_info->src_type_id, type_info->dst_type_id,
+                pipe->conv_nelmts, (size_t)0, (size_t)0, pipe->conv_buf,
+                type_info->bkg_buf, pipe->io_info->md_dxpl_id);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__scatgath_read_pipe_step() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5D__scatgath_read_pipe
+ *
+ * Purpose:	Perform a read which needs datatype conversion, strip by
+ *              strip, alternating between the two conversion buffers.
+ *              Each strip is gathered from the file by this thread while
+ *              the one before it is converted, on another thread when the
+ *              conversion doesn't need the library to itself (see
+ *              H5D__typeinfo_init).  The converted strip is then
+ *              transformed and scattered into the application's buffer
+ *              by this thread.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__scatgath_read_pipe(const H5D_io_info_t *io_info,
+    const H5D_type_info_t *type_info, hsize_t nelmts, const H5S_t *file_space,
+    const H5S_t *mem_space, H5S_sel_iter_t *file_iter, H5S_sel_iter_t *mem_iter,
+    H5S_sel_iter_t *bkg_iter)
+{
+    const H5D_dxpl_cache_t *dxpl_cache = io_info->dxpl_cache;     /* Local pointer to dataset transfer info */
+    void        *buf = io_info->u.rbuf; /* Local pointer to application buffer */
+    H5D_scatgath_pipe_t pipe;           /* Current step of the pipeline */
+    hsize_t	smine_start;		/* Strip mine start loc	*/
+    herr_t	ret_value = SUCCEED;	/* Return value		*/
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(type_info->tconv_pipe_buf);
+    HDassert(!type_info->cmpd_subset || H5T_SUBSET_FALSE == type_info->cmpd_subset->subset);
+
+    pipe.io_info = io_info;
+    pipe.type_info = type_info;
+    pipe.file_space = file_space;
+    pipe.file_iter = file_iter;
+
+    /* Gather the first strip */
+    pipe.conv_buf = type_info->tconv_buf;
+    pipe.conv_nelmts = (size_t)MIN(type_info->request_nelmts, nelmts);
+    if(H5D__gather_file(io_info, file_space, file_iter, pipe.conv_nelmts, pipe.conv_buf/*out*/) != pipe.conv_nelmts)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file gather failed")
+
+    smine_start = 0;
+    while(pipe.conv_nelmts > 0) {
+        /* Gather data from application to background buffer if necessary */
+        if(H5T_BKG_YES == type_info->need_bkg)
+            if(H5D__gather_mem(buf, mem_space, bkg_iter, pipe.conv_nelmts, dxpl_cache, type_info->bkg_buf/*out*/) != pipe.conv_nelmts)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "mem gather failed")
+
+        /* Set up the gather of the next strip, into the other buffer */
+        HDassert(H5S_SELECT_ITER_NELMTS(file_iter) == (nelmts - (smine_start + pipe.conv_nelmts)));
+        pipe.gath_buf = (pipe.conv_buf == type_info->tconv_buf) ? type_info->tconv_pipe_buf : type_info->tconv_buf;
+        pipe.gath_nelmts = (size_t)MIN(type_info->request_nelmts, nelmts - (smine_start + pipe.conv_nelmts));
+
+        /* Convert this strip and gather the next */
+#ifdef H5D_SCATGATH_PIPE_THREADS
+        if(type_info->tconv_pipe_concurrent && pipe.gath_nelmts > 0) {
+            /* (The gather, item 0, is always done by this thread) */
+            if(H5TS_parallel_for(2, (size_t)2, H5D__scatgath_read_pipe_step, &pipe) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "pipelined conversion failed")
+        } /* end if */
+        else
+#endif /* H5D_SCATGATH_PIPE_THREADS */
+        {
+            if(H5D__scatgath_read_pipe_step((size_t)1, &pipe) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTCONVERT, FAIL, "datatype conversion failed")
+            if(pipe.gath_nelmts > 0 && H5D__scatgath_read_pipe_step((size_t)0, &pipe) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file gather failed")
+        } /* end else */
+
+        /* Do the data transform after the conversion (since we're using type mem_type) */
+        if(!type_info->is_xform_noop)
+            if(H5Z_xform_eval(dxpl_cache->data_xform_prop, pipe.conv_buf, pipe.conv_nelmts, type_info->mem_type) < 0)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Error performing data transform")
+
+        /* Scatter the data into memory */
+        if(H5D__scatter_mem(pipe.conv_buf, mem_space, mem_iter, pipe.conv_nelmts, dxpl_cache, buf/*out*/) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "scatter failed")
+
+        /* The gathered strip is converted next */
+        smine_start += pipe.conv_nelmts;
+        pipe.conv_buf = pipe.gath_buf;
+        pipe.conv_nelmts = pipe.gath_nelmts;
+    } /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__scatgath_read_pipe() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5D__scatgath_write
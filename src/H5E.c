@@ -207,6 +207,7 @@ H5E__init_package(void)
 
 #ifndef H5_HAVE_THREADSAFE
     H5E_stack_g[0].nused = 0;
+    H5E_stack_g[0].discard = FALSE;
     H5E_set_default_auto(H5E_stack_g);
 #endif /* H5_HAVE_THREADSAFE */
 
@@ -377,6 +378,7 @@ H5E_get_stack(void)
 
         /* Set the thread-specific info */
         estack->nused = 0;
+        estack->discard = FALSE;
         H5E_set_default_auto(estack);
 
         /* (It's not necessary to release this in this API, it is
@@ -987,7 +987,8 @@ END_FUNC(PRIV)  /* end H5EA_delete() */
  * Purpose:	Iterate over the elements of an extensible array
  *		(copied and modified from FA_iterate() in H5FA.c)
  *
- * Return:      SUCCEED/FAIL
+ * Return:      SUCCEED/FAIL, or the positive value returned by the
+ *              callback which stopped the iteration
  *
  * Programmer:  Vailin Choi; Feb 2015
  *
@@ -1025,6 +1026,10 @@ H5EA_iterate(H5EA_t *ea, hid_t dxpl_id, H5EA_operator_t op, void *udata))
             H5E_PRINTF(H5E_BADITER, "iterator function failed");
             H5_LEAVE(cb_ret)
         } /* end if */
+
+        /* Stop, returning the callback's value, if it short-circuits */
+        if(cb_ret > 0)
+            H5_LEAVE(cb_ret)
     } /* end for */
 
 CATCH
@@ -813,11 +813,12 @@ H5E_push_stack(H5E_t *estack, const char *file, const char *func, unsigned line,
         desc = "No description given";
 
     /*
-     * Push the error if there's room.  Otherwise just forget it.
+     * Push the error if there's room and the stack isn't discarding
+     * errors.  Otherwise just forget it.
      */
     HDassert(estack);
 
-    if(estack->nused < H5E_NSLOTS) {
+    if(estack->nused < H5E_NSLOTS && !estack->discard) {
         /* Increment the IDs to indicate that they are used in this stack */
         if(H5I_inc_ref(cls_id, FALSE) < 0)
             HGOTO_DONE(FAIL)
@@ -967,6 +968,37 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5E_pop() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5E_set_discard
+ *
+ * Purpose:	Private function to set whether errors pushed on the
+ *              current thread's error stack are discarded, rather than
+ *              recorded.  Helper threads of the library discard their
+ *              errors, since pushing an error touches the ID reference
+ *              counts, which aren't protected against concurrent access.
+ *
+ * Return:	The previous setting (FALSE if the current thread's error
+ *              stack can't be found)
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5E_set_discard(hbool_t discard)
+{
+    H5E_t       *estack;                /* Current thread's error stack */
+    hbool_t     ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    if(NULL != (estack = H5E_get_my_stack())) { /*lint !e506 !e774 Make lint 'constant value Boolean' in non-threaded case */
+        ret_value = estack->discard;
+        estack->discard = discard;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5E_set_discard() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5E_dump_api_stack
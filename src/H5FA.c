@@ -685,7 +685,8 @@ END_FUNC(PRIV)  /* end H5FA_delete() */
  * Note:        This is not very efficient, we should be iterating directly
  *              over the fixed array's direct block [pages].
  *
- * Return:      SUCCEED/FAIL
+ * Return:      SUCCEED/FAIL, or the positive value returned by the
+ *              callback which stopped the iteration
  *
  * Programmer:  Vailin Choi
  *              Thursday, April 30, 2009
@@ -724,6 +725,10 @@ H5FA_iterate(H5FA_t *fa, hid_t dxpl_id, H5FA_operator_t op, void *udata))
             H5E_PRINTF(H5E_BADITER, "iterator function failed");
             H5_LEAVE(cb_ret)
         } /* end if */
+
+        /* Stop, returning the callback's value, if it short-circuits */
+        if(cb_ret > 0)
+            H5_LEAVE(cb_ret)
     } /* end for */
 
 CATCH
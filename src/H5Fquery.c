@@ -677,6 +677,56 @@ H5F_rdcc_w0(const H5F_t *f)
     FUNC_LEAVE_NOAPI(f->shared->rdcc_w0)
 } /* end H5F_rdcc_w0() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_rdcc_pool_nbytes
+ *
+ * Purpose:	Retrieve the file-wide raw data chunk cache budget for the
+ *              file's open chunked datasets.
+ *
+ * Return:	Success:	Budget in bytes (0 if the pool is disabled)
+ *
+ * 		Failure:	(should not happen)
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5F_rdcc_pool_nbytes(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->rdcc_pool_nbytes)
+} /* end H5F_rdcc_pool_nbytes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5F_rdcc_pool
+ *
+ * Purpose:	Retrieve the raw data chunk cache pool shared by the file's
+ *              open chunked datasets.
+ *
+ * Return:	Success:	Pointer to the pool (NULL if none exists)
+ *
+ * 		Failure:	(should not happen)
+ *
+ *-------------------------------------------------------------------------
+ */
+struct H5D_rdcc_pool_t *
+H5F_rdcc_pool(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->rdcc_pool)
+} /* end H5F_rdcc_pool() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5F_get_base_addr
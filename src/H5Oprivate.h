@@ -379,9 +379,11 @@ typedef struct H5O_efl_t {
 /* Flags for chunked layout feature encoding */
 #define H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS         0x01
 #define H5O_LAYOUT_CHUNK_SINGLE_INDEX_WITH_FILTER		  0x02
+#define H5O_LAYOUT_CHUNK_DEDUP_IDENTICAL_CHUNKS                   0x04
 #define H5O_LAYOUT_ALL_CHUNK_FLAGS                    (                     \
     H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS                       \
     | H5O_LAYOUT_CHUNK_SINGLE_INDEX_WITH_FILTER                             \
+    | H5O_LAYOUT_CHUNK_DEDUP_IDENTICAL_CHUNKS                               \
     )
 
 /* Initial version of the layout information.  Used when space is allocated */
@@ -468,6 +470,8 @@ typedef struct H5O_storage_chunk_t {
         H5O_storage_chunk_farray_t farray; /* Information for fixed array index   */
         H5O_storage_chunk_single_filt_t single; /* Information for single chunk w/ filters index */
     } u;
+    struct H5D_chunk_dedup_t *dedup;    /* Counts of chunks sharing each block (in memory) */
+    struct H5D_chunk_free_batch_t *free_batch; /* Blocks of removed chunks, freed together (in memory) */
 } H5O_storage_chunk_t;
 
 typedef struct H5O_storage_compact_t {
@@ -85,6 +85,35 @@
 #define H5D_ACS_EFILE_PREFIX_COPY               H5P__dapl_efile_pref_copy
 #define H5D_ACS_EFILE_PREFIX_CMP                H5P__dapl_efile_pref_cmp
 #define H5D_ACS_EFILE_PREFIX_CLOSE              H5P__dapl_efile_pref_close
+/* Definitions for # of threads filtering chunks on flush */
+#define H5D_ACS_CHUNK_FLUSH_NTHREADS_SIZE       sizeof(unsigned)
+#define H5D_ACS_CHUNK_FLUSH_NTHREADS_DEF        1
+#define H5D_ACS_CHUNK_FLUSH_NTHREADS_ENC        H5P__encode_unsigned
+#define H5D_ACS_CHUNK_FLUSH_NTHREADS_DEC        H5P__decode_unsigned
+/* Definitions for # of chunks read ahead on sequential access */
+#define H5D_ACS_CHUNK_READ_AHEAD_SIZE           sizeof(unsigned)
+#define H5D_ACS_CHUNK_READ_AHEAD_DEF            0
+#define H5D_ACS_CHUNK_READ_AHEAD_ENC            H5P__encode_unsigned
+#define H5D_ACS_CHUNK_READ_AHEAD_DEC            H5P__decode_unsigned
+/* Definitions for max. # of chunks for keeping the chunks' addresses in memory */
+#define H5D_ACS_CHUNK_ADDR_MAP_SIZE             sizeof(size_t)
+#define H5D_ACS_CHUNK_ADDR_MAP_DEF              0
+#define H5D_ACS_CHUNK_ADDR_MAP_ENC              H5P__encode_size_t
+#define H5D_ACS_CHUNK_ADDR_MAP_DEC              H5P__decode_size_t
+/* Definitions for the range the chunk cache is resized within */
+#define H5D_ACS_CHUNK_CACHE_MIN_NBYTES_SIZE     sizeof(size_t)
+#define H5D_ACS_CHUNK_CACHE_MIN_NBYTES_DEF      0
+#define H5D_ACS_CHUNK_CACHE_MIN_NBYTES_ENC      H5P__encode_size_t
+#define H5D_ACS_CHUNK_CACHE_MIN_NBYTES_DEC      H5P__decode_size_t
+#define H5D_ACS_CHUNK_CACHE_MAX_NBYTES_SIZE     sizeof(size_t)
+#define H5D_ACS_CHUNK_CACHE_MAX_NBYTES_DEF      0
+#define H5D_ACS_CHUNK_CACHE_MAX_NBYTES_ENC      H5P__encode_size_t
+#define H5D_ACS_CHUNK_CACHE_MAX_NBYTES_DEC      H5P__decode_size_t
+/* Definitions for max. size of filtered chunk images kept in the chunk cache */
+#define H5D_ACS_CHUNK_CACHE_IMAGES_SIZE         sizeof(size_t)
+#define H5D_ACS_CHUNK_CACHE_IMAGES_DEF          0
+#define H5D_ACS_CHUNK_CACHE_IMAGES_ENC          H5P__encode_size_t
+#define H5D_ACS_CHUNK_CACHE_IMAGES_DEC          H5P__decode_size_t
 
 /******************/
 /* Local Typedefs */
@@ -182,6 +211,12 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
     double rdcc_w0 = H5D_ACS_PREEMPT_READ_CHUNKS_DEF;           /* Default raw data chunk cache dirty ratio */
     H5D_vds_view_t virtual_view = H5D_ACS_VDS_VIEW_DEF;         /* Default VDS view option */
     hsize_t printf_gap = H5D_ACS_VDS_PRINTF_GAP_DEF;            /* Default VDS printf gap */
+    unsigned flush_nthreads = H5D_ACS_CHUNK_FLUSH_NTHREADS_DEF; /* Default # of threads filtering chunks on flush */
+    unsigned read_ahead = H5D_ACS_CHUNK_READ_AHEAD_DEF;         /* Default # of chunks read ahead */
+    size_t addr_map = H5D_ACS_CHUNK_ADDR_MAP_DEF;               /* Default max. # of chunks in address map */
+    size_t cache_min_nbytes = H5D_ACS_CHUNK_CACHE_MIN_NBYTES_DEF; /* Default smallest size of resized chunk cache */
+    size_t cache_max_nbytes = H5D_ACS_CHUNK_CACHE_MAX_NBYTES_DEF; /* Default largest size of resized chunk cache */
+    size_t cache_images = H5D_ACS_CHUNK_CACHE_IMAGES_DEF;       /* Default max. size of filtered chunk images */
     herr_t ret_value = SUCCEED;         /* Return value */
 
     FUNC_ENTER_STATIC
@@ -225,6 +260,40 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
             H5D_ACS_EFILE_PREFIX_DEL, H5D_ACS_EFILE_PREFIX_COPY, H5D_ACS_EFILE_PREFIX_CMP, H5D_ACS_EFILE_PREFIX_CLOSE) < 0)
          HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the # of threads filtering chunks on flush */
+    if(H5P_register_real(pclass, H5D_ACS_CHUNK_FLUSH_NTHREADS_NAME, H5D_ACS_CHUNK_FLUSH_NTHREADS_SIZE, &flush_nthreads,
+            NULL, NULL, NULL, H5D_ACS_CHUNK_FLUSH_NTHREADS_ENC, H5D_ACS_CHUNK_FLUSH_NTHREADS_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the # of chunks read ahead on sequential access */
+    if(H5P_register_real(pclass, H5D_ACS_CHUNK_READ_AHEAD_NAME, H5D_ACS_CHUNK_READ_AHEAD_SIZE, &read_ahead,
+            NULL, NULL, NULL, H5D_ACS_CHUNK_READ_AHEAD_ENC, H5D_ACS_CHUNK_READ_AHEAD_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the max. # of chunks for keeping the chunks' addresses in memory */
+    if(H5P_register_real(pclass, H5D_ACS_CHUNK_ADDR_MAP_NAME, H5D_ACS_CHUNK_ADDR_MAP_SIZE, &addr_map,
+            NULL, NULL, NULL, H5D_ACS_CHUNK_ADDR_MAP_ENC, H5D_ACS_CHUNK_ADDR_MAP_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the range the chunk cache is resized within */
+    if(H5P_register_real(pclass, H5D_ACS_CHUNK_CACHE_MIN_NBYTES_NAME, H5D_ACS_CHUNK_CACHE_MIN_NBYTES_SIZE, &cache_min_nbytes,
+            NULL, NULL, NULL, H5D_ACS_CHUNK_CACHE_MIN_NBYTES_ENC, H5D_ACS_CHUNK_CACHE_MIN_NBYTES_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+    if(H5P_register_real(pclass, H5D_ACS_CHUNK_CACHE_MAX_NBYTES_NAME, H5D_ACS_CHUNK_CACHE_MAX_NBYTES_SIZE, &cache_max_nbytes,
+            NULL, NULL, NULL, H5D_ACS_CHUNK_CACHE_MAX_NBYTES_ENC, H5D_ACS_CHUNK_CACHE_MAX_NBYTES_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the max. size of filtered chunk images kept in the chunk cache */
+    if(H5P_register_real(pclass, H5D_ACS_CHUNK_CACHE_IMAGES_NAME, H5D_ACS_CHUNK_CACHE_IMAGES_SIZE, &cache_images,
+            NULL, NULL, NULL, H5D_ACS_CHUNK_CACHE_IMAGES_ENC, H5D_ACS_CHUNK_CACHE_IMAGES_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dacc_reg_prop() */
@@ -613,6 +682,382 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_chunk_cache() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_flush_nthreads
+ *
+ * Purpose:	Sets the number of threads which apply the I/O filters to
+ *		the dirty chunks of a dataset's raw data chunk cache when
+ *		they are flushed or preempted.  Dirty chunks are then
+ *		filtered in batches before they are written; allocating
+ *		space for them and writing them to the file is still done
+ *		one chunk at a time, in the same order as before, so the
+ *		file produced is the same.  A value of one (the default)
+ *		filters each chunk as it is written.  Threads are only
+ *		used when the library is built thread-safe.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_flush_nthreads(hid_t dapl_id, unsigned nthreads)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", dapl_id, nthreads);
+
+    /* Check argument */
+    if(nthreads < 1)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of threads must be at least one")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_CHUNK_FLUSH_NTHREADS_NAME, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_flush_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_flush_nthreads
+ *
+ * Purpose:	Retrieves the number of threads which filter dirty chunks
+ *		when they are flushed from the raw data chunk cache.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_flush_nthreads(hid_t dapl_id, unsigned *nthreads/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, nthreads);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(nthreads)
+        if(H5P_get(plist, H5D_ACS_CHUNK_FLUSH_NTHREADS_NAME, nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_flush_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_read_ahead
+ *
+ * Purpose:	Sets the number of chunks read ahead into a dataset's raw
+ *		data chunk cache when the dataset's chunks are being read in
+ *		order, or with a constant stride between the chunk indices.
+ *		Once H5Dread has read three chunks in such a sequence, the
+ *		next NCHUNKS chunks in the sequence which are stored in the
+ *		file, but not cached, are read (in order of their file
+ *		addresses) and unfiltered before H5Dread returns, so later
+ *		reads find them in the cache.  The chunks read ahead are
+ *		limited to what fits in the chunk cache.  A value of zero
+ *		(the default) disables reading ahead.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_read_ahead(hid_t dapl_id, unsigned nchunks)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", dapl_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_CHUNK_READ_AHEAD_NAME, &nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_read_ahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_read_ahead
+ *
+ * Purpose:	Retrieves the number of chunks read ahead on sequential
+ *		access to a dataset's chunks.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_read_ahead(hid_t dapl_id, unsigned *nchunks/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(nchunks)
+        if(H5P_get(plist, H5D_ACS_CHUNK_READ_AHEAD_NAME, nchunks) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_read_ahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_addr_map
+ *
+ * Purpose:	Sets the maximum number of chunks a dataset may have for
+ *		the locations of all its chunks to be kept in memory while
+ *		the dataset is open.  The chunk index is read into an array
+ *		when the dataset is opened, and the location of a chunk is
+ *		then found without searching the index.  The array takes
+ *		16 bytes per chunk.  A value of zero (the default) disables
+ *		the array.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_addr_map(hid_t dapl_id, size_t max_nchunks)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", dapl_id, max_nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_CHUNK_ADDR_MAP_NAME, &max_nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_addr_map() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_addr_map
+ *
+ * Purpose:	Retrieves the maximum number of chunks a dataset may have
+ *		for the locations of its chunks to be kept in memory.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_addr_map(hid_t dapl_id, size_t *max_nchunks/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, max_nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(max_nchunks)
+        if(H5P_get(plist, H5D_ACS_CHUNK_ADDR_MAP_NAME, max_nchunks) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_addr_map() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_cache_resize
+ *
+ * Purpose:	Lets the raw data chunk cache of a dataset be resized
+ *		while the dataset is open, between MIN_NBYTES and
+ *		MAX_NBYTES.  After every few hundred chunk accesses, the
+ *		cache is doubled if most of the accesses missed and the
+ *		cache was full, or shrunk to twice the size of the chunks
+ *		accessed if they filled less than a quarter of it.  The
+ *		number of slots is scaled with the size.  A MAX_NBYTES of
+ *		zero (the default) keeps the size set with
+ *		H5Pset_chunk_cache.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_cache_resize(hid_t dapl_id, size_t min_nbytes, size_t max_nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "izz", dapl_id, min_nbytes, max_nbytes);
+
+    /* Check arguments */
+    if(max_nbytes > 0 && min_nbytes > max_nbytes)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "minimum size of chunk cache larger than maximum")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_CHUNK_CACHE_MIN_NBYTES_NAME, &min_nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+    if(H5P_set(plist, H5D_ACS_CHUNK_CACHE_MAX_NBYTES_NAME, &max_nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_cache_resize() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_cache_resize
+ *
+ * Purpose:	Retrieves the range the raw data chunk cache of a dataset
+ *		is resized within.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_cache_resize(hid_t dapl_id, size_t *min_nbytes/*out*/,
+    size_t *max_nbytes/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "ixx", dapl_id, min_nbytes, max_nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get values from property list */
+    if(min_nbytes)
+        if(H5P_get(plist, H5D_ACS_CHUNK_CACHE_MIN_NBYTES_NAME, min_nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+    if(max_nbytes)
+        if(H5P_get(plist, H5D_ACS_CHUNK_CACHE_MAX_NBYTES_NAME, max_nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_cache_resize() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_cache_images
+ *
+ * Purpose:	Sets the maximum size of the second tier of the raw data
+ *		chunk cache, which keeps the filtered (e.g. compressed)
+ *		images of the chunks of a dataset with filters, as they
+ *		are stored in the file.  The image of a chunk is moved to
+ *		the second tier when the chunk is evicted from the cache,
+ *		and a chunk whose image is there is brought back by running
+ *		the image through the filters, without reading it from the
+ *		file.  The images of chunks still in the cache, kept for
+ *		when they're evicted, count against the same size.  A size
+ *		of zero (the default) disables the second tier.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_cache_images(hid_t dapl_id, size_t nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", dapl_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_CHUNK_CACHE_IMAGES_NAME, &nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_cache_images() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_cache_images
+ *
+ * Purpose:	Retrieves the maximum size of the filtered chunk images
+ *		kept in the second tier of the raw data chunk cache.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_cache_images(hid_t dapl_id, size_t *nbytes/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(nbytes)
+        if(H5P_get(plist, H5D_ACS_CHUNK_CACHE_IMAGES_NAME, nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_cache_images() */
+
 
 /*-------------------------------------------------------------------------
  * Function:       H5P__encode_chunk_cache_nslots
@@ -2607,6 +2607,12 @@ done:
  * Purpose:     Sets the options related to chunked storage for a dataset.
  *              The storage must already be set to chunked.
  *
+ *              H5D_CHUNK_DEDUP_IDENTICAL_CHUNKS stores filtered chunks
+ *              whose contents are identical once in the file, with the
+ *              chunk index pointing each of them at the same block.
+ *              Such datasets can only be created in files whose low
+ *              bound for format versions is H5F_LIBVER_LATEST.
+ *
  * Return:      Non-negative on success/Negative on failure
  *
  * Programmer:  Neil Fortner
@@ -2626,7 +2632,7 @@ H5Pset_chunk_opts(hid_t plist_id, unsigned options)
     H5TRACE2("e", "iIu", plist_id, options);
 
     /* Check arguments */
-    if(options & ~(H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS))
+    if(options & ~(H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS | H5D_CHUNK_DEDUP_IDENTICAL_CHUNKS))
         HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "unknown chunk options")
 
 #ifndef H5_HAVE_C99_DESIGNATED_INITIALIZER
@@ -2651,6 +2657,8 @@ H5Pset_chunk_opts(hid_t plist_id, unsigned options)
     /* Translate options into flags that can be used with the layout message */
     if(options & H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS)
         layout_flags |= H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS;
+    if(options & H5D_CHUNK_DEDUP_IDENTICAL_CHUNKS)
+        layout_flags |= H5O_LAYOUT_CHUNK_DEDUP_IDENTICAL_CHUNKS;
 
     /* Update the layout message, including the version (if necessary) */
     /* This probably isn't the right way to do this, and should be changed once
@@ -2715,6 +2723,8 @@ H5Pget_chunk_opts(hid_t plist_id, unsigned *options)
         *options = 0;
         if(layout.u.chunk.flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
             *options |= H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS;
+        if(layout.u.chunk.flags & H5O_LAYOUT_CHUNK_DEDUP_IDENTICAL_CHUNKS)
+            *options |= H5D_CHUNK_DEDUP_IDENTICAL_CHUNKS;
     } /* end if */
 
 done:
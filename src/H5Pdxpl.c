@@ -83,6 +83,12 @@
 /* Definitions for vlen free info property */
 #define H5D_XFER_VLEN_FREE_INFO_SIZE    sizeof(void *)
 #define H5D_XFER_VLEN_FREE_INFO_DEF     H5D_VLEN_FREE_INFO
+/* Definitions for vlen data arena property */
+#define H5D_XFER_VLEN_ARENA_SIZE        sizeof(H5T_vlen_arena_t *)
+#define H5D_XFER_VLEN_ARENA_DEF         NULL
+#define H5D_XFER_VLEN_ARENA_DEL         H5P__dxfr_vlen_arena_del
+#define H5D_XFER_VLEN_ARENA_COPY        H5P__dxfr_vlen_arena_copy
+#define H5D_XFER_VLEN_ARENA_CLOSE       H5P__dxfr_vlen_arena_close
 /* Definitions for hyperslab vector size property */
 /* (Be cautious about increasing the default size, there are arrays allocated
  *      on the stack which depend on it - QAK)
@@ -158,6 +164,26 @@
 #define H5D_XFER_XFORM_DEC          H5P__dxfr_xform_dec
 #define H5D_XFER_XFORM_DEL          H5P__dxfr_xform_del
 #define H5D_XFER_XFORM_COPY         H5P__dxfr_xform_copy
+/* Definitions for chunk filter thread count property */
+#define H5D_XFER_CHUNK_FILTER_NTHREADS_SIZE sizeof(unsigned)
+#define H5D_XFER_CHUNK_FILTER_NTHREADS_DEF  1
+#define H5D_XFER_CHUNK_FILTER_NTHREADS_ENC  H5P__encode_unsigned
+#define H5D_XFER_CHUNK_FILTER_NTHREADS_DEC  H5P__decode_unsigned
+/* Definitions for streaming chunk write property */
+#define H5D_XFER_CHUNK_STREAM_WRITE_SIZE    sizeof(hbool_t)
+#define H5D_XFER_CHUNK_STREAM_WRITE_DEF     FALSE
+#define H5D_XFER_CHUNK_STREAM_WRITE_ENC     H5P__encode_hbool_t
+#define H5D_XFER_CHUNK_STREAM_WRITE_DEC     H5P__decode_hbool_t
+/* Definitions for pipelined type conversion property */
+#define H5D_XFER_TCONV_PIPELINE_SIZE        sizeof(hbool_t)
+#define H5D_XFER_TCONV_PIPELINE_DEF         FALSE
+#define H5D_XFER_TCONV_PIPELINE_ENC         H5P__encode_hbool_t
+#define H5D_XFER_TCONV_PIPELINE_DEC         H5P__decode_hbool_t
+/* Definitions for datatype conversion thread count property */
+#define H5D_XFER_TCONV_NTHREADS_SIZE        sizeof(unsigned)
+#define H5D_XFER_TCONV_NTHREADS_DEF         1
+#define H5D_XFER_TCONV_NTHREADS_ENC         H5P__encode_unsigned
+#define H5D_XFER_TCONV_NTHREADS_DEC         H5P__decode_unsigned
 #define H5D_XFER_XFORM_CMP          H5P__dxfr_xform_cmp
 #define H5D_XFER_XFORM_CLOSE        H5P__dxfr_xform_close
 /* Definitions for properties of direct chunk write */
@@ -176,6 +202,15 @@
 #define H5D_XFER_DIRECT_CHUNK_READ_FILTERS_DEF      0
 #define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_SIZE      sizeof(hsize_t *)
 #define H5D_XFER_DIRECT_CHUNK_READ_OFFSET_DEF       NULL
+/* Definitions for properties of direct reads/writes of several chunks */
+#define H5D_XFER_DIRECT_CHUNK_NCHUNKS_SIZE          sizeof(size_t)
+#define H5D_XFER_DIRECT_CHUNK_NCHUNKS_DEF           0
+#define H5D_XFER_DIRECT_CHUNK_WRITE_FILTER_MASKS_SIZE sizeof(uint32_t *)
+#define H5D_XFER_DIRECT_CHUNK_WRITE_FILTER_MASKS_DEF NULL
+#define H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZES_SIZE  sizeof(size_t *)
+#define H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZES_DEF   NULL
+#define H5D_XFER_DIRECT_CHUNK_READ_FILTER_MASKS_SIZE sizeof(uint32_t *)
+#define H5D_XFER_DIRECT_CHUNK_READ_FILTER_MASKS_DEF NULL
 /* Ring type - private property */
 #define H5AC_XFER_RING_SIZE      sizeof(unsigned)
 #define H5AC_XFER_RING_DEF       H5AC_RING_USER
@@ -224,6 +259,9 @@ static herr_t H5P__dxfr_mpio_chunk_opt_hard_enc(const void *value, void **pp, si
 static herr_t H5P__dxfr_mpio_chunk_opt_hard_dec(const void **pp, void *value);
 static herr_t H5P__dxfr_edc_enc(const void *value, void **pp, size_t *size);
 static herr_t H5P__dxfr_edc_dec(const void **pp, void *value);
+static herr_t H5P__dxfr_vlen_arena_del(hid_t prop_id, const char* name, size_t size, void* value);
+static herr_t H5P__dxfr_vlen_arena_copy(const char* name, size_t size, void* value);
+static herr_t H5P__dxfr_vlen_arena_close(const char* name, size_t size, void* value);
 static herr_t H5P__dxfr_xform_set(hid_t prop_id, const char* name, size_t size, void* value);
 static herr_t H5P__dxfr_xform_get(hid_t prop_id, const char* name, size_t size, void* value);
 static herr_t H5P__dxfr_xform_enc(const void *value, void **pp, size_t *size);
@@ -277,6 +315,7 @@ static const H5MM_allocate_t H5D_def_vlen_alloc_g = H5D_XFER_VLEN_ALLOC_DEF;   /
 static const void *H5D_def_vlen_alloc_info_g = H5D_XFER_VLEN_ALLOC_INFO_DEF;   /* Default value for vlen allocation information */
 static const H5MM_free_t H5D_def_vlen_free_g = H5D_XFER_VLEN_FREE_DEF;         /* Default value for vlen free function */
 static const void *H5D_def_vlen_free_info_g = H5D_XFER_VLEN_FREE_INFO_DEF;     /* Default value for vlen free information */
+static const H5T_vlen_arena_t *H5D_def_vlen_arena_g = H5D_XFER_VLEN_ARENA_DEF;  /* Default value for vlen data arena */
 static const size_t H5D_def_hyp_vec_size_g = H5D_XFER_HYPER_VECTOR_SIZE_DEF;   /* Default value for vector size */
 static const haddr_t H5D_def_tag_g = H5AC_TAG_DEF;                              /* Default value for cache entry tag */
 static const H5FD_mpio_xfer_t H5D_def_io_xfer_mode_g = H5D_XFER_IO_XFER_MODE_DEF;      /* Default value for I/O transfer mode */
@@ -298,11 +337,19 @@ static const H5T_conv_cb_t H5D_def_conv_cb_g = H5D_XFER_CONV_CB_DEF;       /* De
 static const void *H5D_def_xfer_xform_g = H5D_XFER_XFORM_DEF;          /* Default value for data transform */
 static const hbool_t H5D_def_direct_chunk_flag_g = H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_DEF; 	/* Default value for the flag of direct chunk write */
 static const uint32_t H5D_def_direct_chunk_filters_g = H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_DEF;	/* Default value for the filters of direct chunk write */
+static const unsigned H5D_def_chunk_filter_nthreads_g = H5D_XFER_CHUNK_FILTER_NTHREADS_DEF;	/* Default value for the chunk filter thread count */
+static const hbool_t H5D_def_chunk_stream_write_g = H5D_XFER_CHUNK_STREAM_WRITE_DEF;	/* Default value for the streaming chunk write flag */
+static const hbool_t H5D_def_tconv_pipeline_g = H5D_XFER_TCONV_PIPELINE_DEF;	/* Default value for the pipelined type conversion flag */
+static const unsigned H5D_def_tconv_nthreads_g = H5D_XFER_TCONV_NTHREADS_DEF;	/* Default value for the type conversion thread count */
 static const hsize_t *H5D_def_direct_chunk_offset_g = H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_DEF; 	/* Default value for the offset of direct chunk write */
 static const uint32_t H5D_def_direct_chunk_datasize_g = H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_DEF; /* Default value for the datasize of direct chunk write */
 static const hbool_t direct_chunk_read_flag = H5D_XFER_DIRECT_CHUNK_READ_FLAG_DEF;         /* Default value for the flag of direct chunk read */
 static const hsize_t *direct_chunk_read_offset = H5D_XFER_DIRECT_CHUNK_READ_OFFSET_DEF;    /* Default value for the offset of direct chunk read */
 static const uint32_t direct_chunk_read_filters = H5D_XFER_DIRECT_CHUNK_READ_FILTERS_DEF;    /* Default value for the filters of direct chunk read */
+static const size_t direct_chunk_nchunks = H5D_XFER_DIRECT_CHUNK_NCHUNKS_DEF;               /* Default value for the # of chunks read or written directly */
+static const uint32_t *direct_chunk_filter_masks = H5D_XFER_DIRECT_CHUNK_WRITE_FILTER_MASKS_DEF;   /* Default value for the filters of direct chunk writes */
+static const size_t *direct_chunk_datasizes = H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZES_DEF;   /* Default value for the datasizes of direct chunk writes */
+static const uint32_t *direct_chunk_read_filter_masks = H5D_XFER_DIRECT_CHUNK_READ_FILTER_MASKS_DEF;   /* Default value for the filters of direct chunk reads */
 static const H5AC_ring_t H5D_ring_g = H5AC_XFER_RING_DEF; /* Default value for the cache entry ring type */
 #ifdef H5_DEBUG_BUILD
 static const H5FD_dxpl_type_t H5D_dxpl_type_g = H5FD_NOIO_DXPL; /* Default value for the dxpl type */
@@ -386,6 +433,12 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the vlen data arena property */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_VLEN_ARENA_NAME, H5D_XFER_VLEN_ARENA_SIZE, &H5D_def_vlen_arena_g,
+            NULL, NULL, NULL, NULL, NULL, H5D_XFER_VLEN_ARENA_DEL, H5D_XFER_VLEN_ARENA_COPY, NULL, H5D_XFER_VLEN_ARENA_CLOSE) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the vector size property */
     if(H5P_register_real(pclass, H5D_XFER_HYPER_VECTOR_SIZE_NAME, H5D_XFER_HYPER_VECTOR_SIZE_SIZE, &H5D_def_hyp_vec_size_g, 
             NULL, NULL, NULL, H5D_XFER_HYPER_VECTOR_SIZE_ENC, H5D_XFER_HYPER_VECTOR_SIZE_DEC,
@@ -483,6 +536,30 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
             H5D_XFER_XFORM_DEL, H5D_XFER_XFORM_COPY, H5D_XFER_XFORM_CMP, H5D_XFER_XFORM_CLOSE) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the chunk filter thread count property */
+    if(H5P_register_real(pclass, H5D_XFER_CHUNK_FILTER_NTHREADS_NAME, H5D_XFER_CHUNK_FILTER_NTHREADS_SIZE, &H5D_def_chunk_filter_nthreads_g,
+            NULL, NULL, NULL, H5D_XFER_CHUNK_FILTER_NTHREADS_ENC, H5D_XFER_CHUNK_FILTER_NTHREADS_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the streaming chunk write property */
+    if(H5P_register_real(pclass, H5D_XFER_CHUNK_STREAM_WRITE_NAME, H5D_XFER_CHUNK_STREAM_WRITE_SIZE, &H5D_def_chunk_stream_write_g,
+            NULL, NULL, NULL, H5D_XFER_CHUNK_STREAM_WRITE_ENC, H5D_XFER_CHUNK_STREAM_WRITE_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the pipelined type conversion property */
+    if(H5P_register_real(pclass, H5D_XFER_TCONV_PIPELINE_NAME, H5D_XFER_TCONV_PIPELINE_SIZE, &H5D_def_tconv_pipeline_g,
+            NULL, NULL, NULL, H5D_XFER_TCONV_PIPELINE_ENC, H5D_XFER_TCONV_PIPELINE_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the type conversion thread count property */
+    if(H5P_register_real(pclass, H5D_XFER_TCONV_NTHREADS_NAME, H5D_XFER_TCONV_NTHREADS_SIZE, &H5D_def_tconv_nthreads_g,
+            NULL, NULL, NULL, H5D_XFER_TCONV_NTHREADS_ENC, H5D_XFER_TCONV_NTHREADS_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the property of flag for direct chunk write */
     /* (Note: this property should not have an encode/decode callback -QAK) */
     if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_SIZE, &H5D_def_direct_chunk_flag_g,
@@ -525,6 +602,30 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the property of # of chunks for direct chunk reads and writes */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_NCHUNKS_NAME, H5D_XFER_DIRECT_CHUNK_NCHUNKS_SIZE, &direct_chunk_nchunks,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of filters for direct chunk writes */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_WRITE_FILTER_MASKS_NAME, H5D_XFER_DIRECT_CHUNK_WRITE_FILTER_MASKS_SIZE, &direct_chunk_filter_masks,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of datasizes for direct chunk writes */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZES_NAME, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZES_SIZE, &direct_chunk_datasizes,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the property of filters for direct chunk reads */
+    /* (Note: this property should not have an encode/decode callback) */
+    if(H5P_register_real(pclass, H5D_XFER_DIRECT_CHUNK_READ_FILTER_MASKS_NAME, H5D_XFER_DIRECT_CHUNK_READ_FILTER_MASKS_SIZE, &direct_chunk_read_filter_masks,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the ring property (private) */
     if(H5P_register_real(pclass, H5AC_RING_NAME, H5AC_XFER_RING_SIZE, &H5D_ring_g,
             NULL, NULL, NULL, H5AC_XFER_RING_ENC, H5AC_XFER_RING_DEC, 
@@ -1047,6 +1148,86 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dxfr_xform_close() */
 
+
+/*-------------------------------------------------------------------------
+ * Function: H5P__dxfr_vlen_arena_del
+ *
+ * Purpose: Drops the property list's reference to its VL data arena
+ *          when the property is overwritten or deleted.
+ *
+ * Return: Success: SUCCEED, Failure: FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5P__dxfr_vlen_arena_del(hid_t H5_ATTR_UNUSED prop_id, const char H5_ATTR_UNUSED *name, size_t H5_ATTR_UNUSED size, void *value)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(value);
+
+    if(*(H5T_vlen_arena_t **)value)
+        if(H5T_vlen_arena_decr_ref(*(H5T_vlen_arena_t **)value) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTFREE, FAIL, "can't release VL arena")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5P__dxfr_vlen_arena_del() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5P__dxfr_vlen_arena_copy
+ *
+ * Purpose: Shares the VL data arena with the copy of a property list, so
+ *          VL data read through either list lands in the same arena.
+ *
+ * Return: Success: SUCCEED, Failure: FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5P__dxfr_vlen_arena_copy(const char H5_ATTR_UNUSED *name, size_t H5_ATTR_UNUSED size, void *value)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(value);
+
+    if(*(H5T_vlen_arena_t **)value)
+        H5T_vlen_arena_incr_ref(*(H5T_vlen_arena_t **)value);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5P__dxfr_vlen_arena_copy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5P__dxfr_vlen_arena_close
+ *
+ * Purpose: Drops the property list's reference to its VL data arena
+ *          when the property list is closed.
+ *
+ * Return: Success: SUCCEED, Failure: FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5P__dxfr_vlen_arena_close(const char H5_ATTR_UNUSED *name, size_t H5_ATTR_UNUSED size, void *value)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(value);
+
+    if(*(H5T_vlen_arena_t **)value)
+        if(H5T_vlen_arena_decr_ref(*(H5T_vlen_arena_t **)value) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTFREE, FAIL, "can't release VL arena")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5P__dxfr_vlen_arena_close() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_data_transform
@@ -1782,6 +1963,143 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_vlen_mem_manager() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_vlen_arena
+ *
+ * Purpose:	Places all VL data read through this property list into an
+ *		arena of contiguous blocks of BLOCK_SIZE bytes, instead of
+ *		allocating each VL element with the VL memory manager.
+ *		The data is freed all at once with H5Pfree_vlen_arena or
+ *		when the property list is closed; H5Dvlen_reclaim leaves
+ *		it alone.  Copies of the property list share the arena.
+ *		A BLOCK_SIZE of zero removes the arena, freeing its data.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_vlen_arena(hid_t plist_id, size_t block_size)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    H5T_vlen_arena_t *arena = NULL;     /* New VL data arena */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", plist_id, block_size);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Create the arena */
+    if(block_size > 0)
+        if(NULL == (arena = H5T_vlen_arena_create(block_size)))
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTCREATE, FAIL, "can't create VL arena")
+
+    /* Update property list (drops the reference to any previous arena) */
+    if(H5P_set(plist, H5D_XFER_VLEN_ARENA_NAME, &arena) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+    arena = NULL;
+
+done:
+    if(arena && H5T_vlen_arena_decr_ref(arena) < 0)
+        HDONE_ERROR(H5E_PLIST, H5E_CANTFREE, FAIL, "can't release VL arena")
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_vlen_arena() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_vlen_arena
+ *
+ * Purpose:	Retrieves the block size of the VL data arena set with
+ *		H5Pset_vlen_arena, along with the number of blocks and
+ *		bytes of VL data currently held in it.  All three are zero
+ *		when no arena is set.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_vlen_arena(hid_t plist_id, size_t *block_size/*out*/,
+    size_t *nblocks/*out*/, size_t *nbytes/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    H5T_vlen_arena_t *arena;    /* VL data arena */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE4("e", "ixxx", plist_id, block_size, nblocks, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Retrieve the arena */
+    if(H5P_get(plist, H5D_XFER_VLEN_ARENA_NAME, &arena) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+    if(arena) {
+        if(H5T_vlen_arena_get_info(arena, block_size, nblocks, nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get VL arena info")
+    } /* end if */
+    else {
+        if(block_size)
+            *block_size = 0;
+        if(nblocks)
+            *nblocks = 0;
+        if(nbytes)
+            *nbytes = 0;
+    } /* end else */
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_vlen_arena() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pfree_vlen_arena
+ *
+ * Purpose:	Frees all the VL data placed in the property list's arena
+ *		in one call.  Every VL pointer read through the property
+ *		list (or a copy of it) since the arena was set or last freed
+ *		becomes invalid.  The arena stays set for later reads.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pfree_vlen_arena(hid_t plist_id)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    H5T_vlen_arena_t *arena;    /* VL data arena */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", plist_id);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Retrieve the arena */
+    if(H5P_get(plist, H5D_XFER_VLEN_ARENA_NAME, &arena) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+    if(NULL == arena)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "no VL arena set")
+
+    /* Free the VL data */
+    if(H5T_vlen_arena_release(arena) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTFREE, FAIL, "can't release VL arena")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pfree_vlen_arena() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_hyper_vector_size
@@ -1864,6 +2182,323 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_hyper_vector_size() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_filter_nthreads
+ *
+ * Purpose:	Given a dataset transfer property list, set the number of
+ *              threads used to unfilter (e.g. decompress) the chunks of a
+ *              filtered dataset that are read by a single H5Dread call.
+ *
+ *              When the number is greater than one, the chunks selected for
+ *              reading which are not in the chunk cache are fetched from
+ *              the file in batches, in file address order, and the filter
+ *              pipeline is applied to the chunks of a batch concurrently
+ *              before their elements are scattered into the application's
+ *              buffer.  Threads are only used when the library is built
+ *              to be thread-safe; otherwise the batches are unfiltered by
+ *              the calling thread.
+ *
+ *		The default is to use one thread, reading and unfiltering
+ *              each chunk in turn.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_filter_nthreads(hid_t plist_id, unsigned nthreads)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, nthreads);
+
+    /* Check arguments */
+    if(nthreads < 1)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of threads must be positive")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_XFER_CHUNK_FILTER_NTHREADS_NAME, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_filter_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_filter_nthreads
+ *
+ * Purpose:	Reads values previously set with H5Pset_chunk_filter_nthreads().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_filter_nthreads(hid_t plist_id, unsigned *nthreads/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nthreads);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return values */
+    if(nthreads)
+        if(H5P_get(plist, H5D_XFER_CHUNK_FILTER_NTHREADS_NAME, nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_filter_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_stream_write
+ *
+ * Purpose:	Given a dataset transfer property list, set whether whole
+ *              chunks written by H5Dwrite are streamed straight from the
+ *              application's buffer to the file.
+ *
+ *              When set, a chunk that is entirely covered by the file
+ *              selection and by one contiguous run of the memory buffer
+ *              is written to the file driver directly, without being
+ *              copied into the chunk cache or the type conversion buffer.
+ *              This only applies to datasets without filters, when no
+ *              type conversion or data transform is needed; other chunks
+ *              are written as usual.  A copy of the chunk held in the
+ *              chunk cache is discarded.
+ *
+ *		The default is not to stream chunks.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_stream_write(hid_t plist_id, hbool_t stream)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ib", plist_id, stream);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_XFER_CHUNK_STREAM_WRITE_NAME, &stream) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_stream_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_stream_write
+ *
+ * Purpose:	Reads the value previously set with H5Pset_chunk_stream_write().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_stream_write(hid_t plist_id, hbool_t *stream/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, stream);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return value */
+    if(stream)
+        if(H5P_get(plist, H5D_XFER_CHUNK_STREAM_WRITE_NAME, stream) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_stream_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_tconv_pipeline
+ *
+ * Purpose:	Given a dataset transfer property list, set whether reads
+ *              which convert datatypes gather each strip of elements from
+ *              the file while the strip before it is being converted.
+ *
+ *              A selection larger than the type conversion buffer (see
+ *              H5Pset_buffer) is read in strips, each gathered from the
+ *              file, converted and scattered into the application's
+ *              buffer in turn.  When set, a second conversion buffer of
+ *              the same size is used so that the gather for the next
+ *              strip can proceed during the conversion.  The two overlap
+ *              only when the library is built to be thread-safe, for the
+ *              library's integer, floating-point, bitfield and byte order
+ *              conversions and compounds of them, on datasets with none
+ *              but the library's own filters, and with no conversion
+ *              exception callback set; otherwise they are done in turn.
+ *
+ *		The default is to use one conversion buffer.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_tconv_pipeline(hid_t plist_id, hbool_t pipeline)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ib", plist_id, pipeline);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_XFER_TCONV_PIPELINE_NAME, &pipeline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_tconv_pipeline() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_tconv_pipeline
+ *
+ * Purpose:	Reads the value previously set with H5Pset_tconv_pipeline().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_tconv_pipeline(hid_t plist_id, hbool_t *pipeline/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, pipeline);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return value */
+    if(pipeline)
+        if(H5P_get(plist, H5D_XFER_TCONV_PIPELINE_NAME, pipeline) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_tconv_pipeline() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_tconv_nthreads
+ *
+ * Purpose:	Given a dataset transfer property list, set the number of
+ *              threads used to convert the elements of a single datatype
+ *              conversion, whether done by H5Tconvert or when reading or
+ *              writing a dataset or attribute.
+ *
+ *              When the number is greater than one, a conversion of many
+ *              elements is split into contiguous ranges of elements which
+ *              are converted concurrently.  Only the library's own
+ *              conversions between integer, floating-point and bitfield
+ *              types and between compound types of those are split, and
+ *              not when a conversion exception callback is set.  Threads
+ *              are only used when the library is built to be thread-safe;
+ *              otherwise the conversion is done by the calling thread.
+ *
+ *		The default is to use one thread.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_tconv_nthreads(hid_t plist_id, unsigned nthreads)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, nthreads);
+
+    /* Check arguments */
+    if(nthreads < 1)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of threads must be positive")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_XFER_TCONV_NTHREADS_NAME, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_tconv_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_tconv_nthreads
+ *
+ * Purpose:	Reads the value previously set with H5Pset_tconv_nthreads().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_tconv_nthreads(hid_t plist_id, unsigned *nthreads/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nthreads);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return value */
+    if(nthreads)
+        if(H5P_get(plist, H5D_XFER_TCONV_NTHREADS_NAME, nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_tconv_nthreads() */
+
 
 /*-------------------------------------------------------------------------
  * Function:       H5P__dxfr_io_xfer_mode_enc
@@ -244,6 +244,11 @@
 #define H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_DEF            0
 #define H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_ENC            H5P__encode_unsigned
 #define H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_DEC            H5P__decode_unsigned
+/* Definition for size of file-wide raw data chunk cache budget(bytes) */
+#define H5F_ACS_DATA_CACHE_POOL_SIZE_SIZE       sizeof(size_t)
+#define H5F_ACS_DATA_CACHE_POOL_SIZE_DEF        0
+#define H5F_ACS_DATA_CACHE_POOL_SIZE_ENC        H5P__encode_size_t
+#define H5F_ACS_DATA_CACHE_POOL_SIZE_DEC        H5P__decode_size_t
 
 
 /******************/
@@ -375,6 +380,7 @@ static const H5AC_cache_image_config_t H5F_def_mdc_initCacheImageCfg_g = H5F_ACS
 static const size_t H5F_def_page_buf_size_g = H5F_ACS_PAGE_BUFFER_SIZE_DEF;      /* Default page buffer size */
 static const unsigned H5F_def_page_buf_min_meta_perc_g = H5F_ACS_PAGE_BUFFER_MIN_META_PERC_DEF;      /* Default page buffer minimum metadata size */
 static const unsigned H5F_def_page_buf_min_raw_perc_g = H5F_ACS_PAGE_BUFFER_MIN_RAW_PERC_DEF;      /* Default page buffer minumum raw data size */
+static const size_t H5F_def_rdcc_pool_nbytes_g = H5F_ACS_DATA_CACHE_POOL_SIZE_DEF;      /* Default file-wide raw data chunk cache budget */
 
 
 /*-------------------------------------------------------------------------
@@ -606,6 +612,12 @@ H5P__facc_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the size of the file-wide raw data chunk cache budget */
+    if(H5P_register_real(pclass, H5F_ACS_DATA_CACHE_POOL_SIZE_NAME, H5F_ACS_DATA_CACHE_POOL_SIZE_SIZE, &H5F_def_rdcc_pool_nbytes_g, 
+            NULL, NULL, NULL, H5F_ACS_DATA_CACHE_POOL_SIZE_ENC, H5F_ACS_DATA_CACHE_POOL_SIZE_DEC, 
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__facc_reg_prop() */
@@ -1592,6 +1604,77 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_cache() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_cache_pool
+ *
+ * Purpose:	Set the file-wide raw data chunk cache budget, in bytes.
+ *		When non-zero, all chunked datasets open in the file share
+ *		this budget: the raw data chunk caches of the datasets are
+ *		kept on a single least-recently-used list and chunks are
+ *		preempted from whichever dataset used them least recently
+ *		once the total size of the cached chunks exceeds NBYTES.
+ *		A value of zero (the default) disables the shared budget,
+ *		leaving each dataset to its own chunk cache size.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_cache_pool(hid_t fapl_id, size_t nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", fapl_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set the value */
+    if(H5P_set(plist, H5F_ACS_DATA_CACHE_POOL_SIZE_NAME, &nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set data cache pool byte size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_cache_pool() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_cache_pool
+ *
+ * Purpose:	Retrieve the file-wide raw data chunk cache budget set
+ *		with H5Pset_chunk_cache_pool.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_cache_pool(hid_t fapl_id, size_t *nbytes/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", fapl_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get the value */
+    if(nbytes)
+        if(H5P_get(plist, H5F_ACS_DATA_CACHE_POOL_SIZE_NAME, nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get data cache pool byte size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_cache_pool() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_mdc_image_config
@@ -323,6 +323,8 @@ H5_DLL herr_t H5Pget_cache(hid_t plist_id,
        int *mdc_nelmts, /* out */
        size_t *rdcc_nslots/*out*/,
        size_t *rdcc_nbytes/*out*/, double *rdcc_w0);
+H5_DLL herr_t H5Pset_chunk_cache_pool(hid_t fapl_id, size_t nbytes);
+H5_DLL herr_t H5Pget_chunk_cache_pool(hid_t fapl_id, size_t *nbytes/*out*/);
 H5_DLL herr_t H5Pset_mdc_config(hid_t    plist_id,
        H5AC_cache_config_t * config_ptr);
 H5_DLL herr_t H5Pget_mdc_config(hid_t     plist_id,
@@ -416,6 +418,18 @@ H5_DLL herr_t H5Pget_chunk_cache(hid_t dapl_id,
        size_t *rdcc_nslots/*out*/,
        size_t *rdcc_nbytes/*out*/,
        double *rdcc_w0/*out*/);
+H5_DLL herr_t H5Pset_chunk_flush_nthreads(hid_t dapl_id, unsigned nthreads);
+H5_DLL herr_t H5Pget_chunk_flush_nthreads(hid_t dapl_id, unsigned *nthreads/*out*/);
+H5_DLL herr_t H5Pset_chunk_read_ahead(hid_t dapl_id, unsigned nchunks);
+H5_DLL herr_t H5Pget_chunk_read_ahead(hid_t dapl_id, unsigned *nchunks/*out*/);
+H5_DLL herr_t H5Pset_chunk_addr_map(hid_t dapl_id, size_t max_nchunks);
+H5_DLL herr_t H5Pget_chunk_addr_map(hid_t dapl_id, size_t *max_nchunks/*out*/);
+H5_DLL herr_t H5Pset_chunk_cache_resize(hid_t dapl_id, size_t min_nbytes,
+    size_t max_nbytes);
+H5_DLL herr_t H5Pget_chunk_cache_resize(hid_t dapl_id, size_t *min_nbytes/*out*/,
+    size_t *max_nbytes/*out*/);
+H5_DLL herr_t H5Pset_chunk_cache_images(hid_t dapl_id, size_t nbytes);
+H5_DLL herr_t H5Pget_chunk_cache_images(hid_t dapl_id, size_t *nbytes/*out*/);
 H5_DLL herr_t H5Pset_virtual_view(hid_t plist_id, H5D_vds_view_t view);
 H5_DLL herr_t H5Pget_virtual_view(hid_t plist_id, H5D_vds_view_t *view);
 H5_DLL herr_t H5Pset_virtual_printf_gap(hid_t plist_id, hsize_t gap_size);
@@ -456,6 +470,18 @@ H5_DLL herr_t H5Pget_vlen_mem_manager(hid_t plist_id,
                                        void **free_info);
 H5_DLL herr_t H5Pset_hyper_vector_size(hid_t fapl_id, size_t size);
 H5_DLL herr_t H5Pget_hyper_vector_size(hid_t fapl_id, size_t *size/*out*/);
+H5_DLL herr_t H5Pset_chunk_filter_nthreads(hid_t plist_id, unsigned nthreads);
+H5_DLL herr_t H5Pget_chunk_filter_nthreads(hid_t plist_id, unsigned *nthreads/*out*/);
+H5_DLL herr_t H5Pset_vlen_arena(hid_t plist_id, size_t block_size);
+H5_DLL herr_t H5Pget_vlen_arena(hid_t plist_id, size_t *block_size/*out*/,
+    size_t *nblocks/*out*/, size_t *nbytes/*out*/);
+H5_DLL herr_t H5Pfree_vlen_arena(hid_t plist_id);
+H5_DLL herr_t H5Pset_chunk_stream_write(hid_t plist_id, hbool_t stream);
+H5_DLL herr_t H5Pget_chunk_stream_write(hid_t plist_id, hbool_t *stream/*out*/);
+H5_DLL herr_t H5Pset_tconv_pipeline(hid_t plist_id, hbool_t pipeline);
+H5_DLL herr_t H5Pget_tconv_pipeline(hid_t plist_id, hbool_t *pipeline/*out*/);
+H5_DLL herr_t H5Pset_tconv_nthreads(hid_t plist_id, unsigned nthreads);
+H5_DLL herr_t H5Pget_tconv_nthreads(hid_t plist_id, unsigned *nthreads/*out*/);
 H5_DLL herr_t H5Pset_type_conv_cb(hid_t dxpl_id, H5T_conv_except_func_t op, void* operate_data);
 H5_DLL herr_t H5Pget_type_conv_cb(hid_t dxpl_id, H5T_conv_except_func_t *op, void** operate_data);
 #ifdef H5_HAVE_PARALLEL
@@ -25,11 +25,18 @@
 #include "H5Eprivate.h"		/* Error handling			*/
 #include "H5FLprivate.h"	/* Free Lists				*/
 #include "H5Iprivate.h"		/* ID Functions				*/
+#include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Spkg.h"		/* Dataspace functions			*/
 #include "H5VMprivate.h"         /* Vector functions			*/
 
 /* Local datatypes */
 
+/* Extent of one block in one dimension, while building a selection from blocks */
+typedef struct H5S_hyper_block_bound_t {
+    hsize_t low, high;          /* Bounds of the block in the dimension */
+    size_t blk;                 /* Index of the block */
+} H5S_hyper_block_bound_t;
+
 /* Static function prototypes */
 static herr_t H5S_hyper_free_span_info(H5S_hyper_span_info_t *span_info);
 static herr_t H5S_hyper_free_span(H5S_hyper_span_t *span);
@@ -39,6 +46,11 @@ static herr_t H5S_hyper_span_precompute(H5S_hyper_span_info_t *spans, size_t elm
 static herr_t H5S_generate_hyperslab(H5S_t *space, H5S_seloper_t op,
     const hsize_t start[], const hsize_t stride[], const hsize_t count[], const hsize_t block[]);
 static herr_t H5S_hyper_generate_spans(H5S_t *space);
+static herr_t H5S_hyper_combine_spans(H5S_t *space, H5S_seloper_t op,
+    H5S_hyper_span_info_t *new_spans);
+static H5S_hyper_span_info_t *H5S_hyper_blocks_make_spans(unsigned rank,
+    unsigned dim, const hsize_t *start, const hsize_t *count,
+    H5S_hyper_block_bound_t *bounds, size_t nbounds);
 /* Needed for use in hyperslab code (H5Shyper.c) */
 #ifdef NEW_HYPERSLAB_API
 static herr_t H5S_select_select (H5S_t *space1, H5S_seloper_t op, H5S_t *space2);
@@ -6250,27 +6262,20 @@ done:
 #ifndef NEW_HYPERSLAB_API
 
 /*-------------------------------------------------------------------------
- * Function:	H5S_generate_hyperlab
+ * Function:	H5S_hyper_combine_spans
  *
- * Purpose:	Generate hyperslab information from H5S_select_hyperslab()
+ * Purpose:	Combine a span tree with the current hyperslab selection of
+ *              a dataspace, with operation OP.  The span tree is released
+ *              (or becomes part of the selection) whether or not this
+ *              succeeds.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Quincey Koziol (split from HS_select_hyperslab()).
- *              Tuesday, September 12, 2000
- *
- * Modifications:
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5S_generate_hyperslab (H5S_t *space, H5S_seloper_t op,
-		      const hsize_t start[],
-		      const hsize_t stride[],
-		      const hsize_t count[],
-		      const hsize_t block[])
+H5S_hyper_combine_spans(H5S_t *space, H5S_seloper_t op, H5S_hyper_span_info_t *new_spans)
 {
-    H5S_hyper_span_info_t *new_spans=NULL;  /* Span tree for new hyperslab */
     H5S_hyper_span_info_t *a_not_b=NULL;    /* Span tree for hyperslab spans in old span tree and not in new span tree */
     H5S_hyper_span_info_t *a_and_b=NULL;    /* Span tree for hyperslab spans in both old and new span trees */
     H5S_hyper_span_info_t *b_not_a=NULL;    /* Span tree for hyperslab spans in new span tree and not in old span tree */
@@ -6281,14 +6286,7 @@ H5S_generate_hyperslab (H5S_t *space, H5S_seloper_t op,
     /* Check args */
     HDassert(space);
     HDassert(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID);
-    HDassert(start);
-    HDassert(stride);
-    HDassert(count);
-    HDassert(block);
-
-    /* Generate span tree for new hyperslab information */
-    if((new_spans=H5S_hyper_make_spans(space->extent.rank,start,stride,count,block))==NULL)
-        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't create hyperslab information")
+    HDassert(new_spans);
 
     /* Generate list of blocks to add/remove based on selection operation */
     if(op==H5S_SELECT_SET) {
@@ -6490,6 +6488,53 @@ done:
         if(H5S_hyper_free_span_info(new_spans) < 0)
             HDONE_ERROR(H5E_INTERNAL, H5E_CANTFREE, FAIL, "failed to release temporary hyperslab spans")
 
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S_hyper_combine_spans() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5S_generate_hyperlab
+ *
+ * Purpose:	Generate hyperslab information from H5S_select_hyperslab()
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Quincey Koziol (split from HS_select_hyperslab()).
+ *              Tuesday, September 12, 2000
+ *
+ * Modifications:
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5S_generate_hyperslab (H5S_t *space, H5S_seloper_t op,
+		      const hsize_t start[],
+		      const hsize_t stride[],
+		      const hsize_t count[],
+		      const hsize_t block[])
+{
+    H5S_hyper_span_info_t *new_spans;       /* Span tree for new hyperslab */
+    herr_t      ret_value=SUCCEED;       /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Check args */
+    HDassert(space);
+    HDassert(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID);
+    HDassert(start);
+    HDassert(stride);
+    HDassert(count);
+    HDassert(block);
+
+    /* Generate span tree for new hyperslab information */
+    if((new_spans=H5S_hyper_make_spans(space->extent.rank,start,stride,count,block))==NULL)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't create hyperslab information")
+
+    /* Combine it with the current selection */
+    if(H5S_hyper_combine_spans(space, op, new_spans) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't insert hyperslabs")
+
+done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5S_generate_hyperslab() */
 
@@ -7117,27 +7162,20 @@ done:
 
 
 /*-------------------------------------------------------------------------
- * Function:	H5S_generate_hyperlab
+ * Function:	H5S_hyper_combine_spans
  *
- * Purpose:	Generate hyperslab information from H5S_select_hyperslab()
+ * Purpose:	Combine a span tree with the current hyperslab selection of
+ *              a dataspace, with operation OP.  The span tree is released
+ *              (or becomes part of the selection) whether or not this
+ *              succeeds.
  *
  * Return:	Non-negative on success/Negative on failure
  *
- * Programmer:	Quincey Koziol (split from HS_select_hyperslab()).
- *              Tuesday, September 12, 2000
- *
- * Modifications:
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5S_generate_hyperslab (H5S_t *space, H5S_seloper_t op,
-		      const hsize_t start[],
-		      const hsize_t stride[],
-		      const hsize_t count[],
-		      const hsize_t block[])
+H5S_hyper_combine_spans(H5S_t *space, H5S_seloper_t op, H5S_hyper_span_info_t *new_spans)
 {
-    H5S_hyper_span_info_t *new_spans=NULL;   /* Span tree for new hyperslab */
     H5S_hyper_span_info_t *tmp_spans=NULL;   /* Temporary copy of selection */
     hbool_t span2_owned=FALSE;          /* Flag to indicate that span2 was used in H5S_operate_hyperslab() */
     herr_t      ret_value=SUCCEED;       /* Return value */
@@ -7147,14 +7185,7 @@ H5S_generate_hyperslab (H5S_t *space, H5S_seloper_t op,
     /* Check args */
     HDassert(space);
     HDassert(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID);
-    HDassert(start);
-    HDassert(stride);
-    HDassert(count);
-    HDassert(block);
-
-    /* Generate span tree for new hyperslab information */
-    if((new_spans=H5S_hyper_make_spans(space->extent.rank,start,stride,count,block))==NULL)
-        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't create hyperslab information")
+    HDassert(new_spans);
 
     /* Copy the original dataspace */
     if(space->select.sel_info.hslab->span_lst!=NULL) {
@@ -7188,6 +7219,53 @@ done:
         if(H5S_hyper_free_span_info(new_spans)<0)
             HDONE_ERROR(H5E_INTERNAL, H5E_CANTFREE, FAIL, "failed to release temporary hyperslab spans")
 
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S_hyper_combine_spans() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5S_generate_hyperlab
+ *
+ * Purpose:	Generate hyperslab information from H5S_select_hyperslab()
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ * Programmer:	Quincey Koziol (split from HS_select_hyperslab()).
+ *              Tuesday, September 12, 2000
+ *
+ * Modifications:
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5S_generate_hyperslab (H5S_t *space, H5S_seloper_t op,
+		      const hsize_t start[],
+		      const hsize_t stride[],
+		      const hsize_t count[],
+		      const hsize_t block[])
+{
+    H5S_hyper_span_info_t *new_spans;       /* Span tree for new hyperslab */
+    herr_t      ret_value=SUCCEED;       /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Check args */
+    HDassert(space);
+    HDassert(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID);
+    HDassert(start);
+    HDassert(stride);
+    HDassert(count);
+    HDassert(block);
+
+    /* Generate span tree for new hyperslab information */
+    if((new_spans=H5S_hyper_make_spans(space->extent.rank,start,stride,count,block))==NULL)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't create hyperslab information")
+
+    /* Combine it with the current selection */
+    if(H5S_hyper_combine_spans(space, op, new_spans) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't insert hyperslabs")
+
+done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5S_generate_hyperslab() */
 
@@ -7920,6 +7998,442 @@ done:
 } /* end H5Sselect_select() */
 #endif /* NEW_HYPERSLAB_API */ /* Works */
 
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_hyper_cmp_block_bound
+ PURPOSE
+    Compare the extents of two blocks in a dimension, for sorting
+ USAGE
+    int H5S_hyper_cmp_block_bound(_bound1, _bound2)
+        const void *_bound1, *_bound2;  IN: H5S_hyper_block_bound_t's to compare
+ RETURNS
+    Negative, zero or positive as the first block starts before, at the same
+    place as, or after the second
+--------------------------------------------------------------------------*/
+static int
+H5S_hyper_cmp_block_bound(const void *_bound1, const void *_bound2)
+{
+    const H5S_hyper_block_bound_t *bound1 = (const H5S_hyper_block_bound_t *)_bound1;
+    const H5S_hyper_block_bound_t *bound2 = (const H5S_hyper_block_bound_t *)_bound2;
+
+    if(bound1->low < bound2->low)
+        return(-1);
+    if(bound1->low > bound2->low)
+        return(1);
+    return(0);
+}   /* H5S_hyper_cmp_block_bound() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_hyper_cmp_coord
+ PURPOSE
+    Compare two coordinates, for sorting
+ USAGE
+    int H5S_hyper_cmp_coord(_coord1, _coord2)
+        const void *_coord1, *_coord2;  IN: hsize_t's to compare
+ RETURNS
+    Negative, zero or positive as the first coordinate is less than, equal
+    to or greater than the second
+--------------------------------------------------------------------------*/
+static int
+H5S_hyper_cmp_coord(const void *_coord1, const void *_coord2)
+{
+    hsize_t coord1 = *(const hsize_t *)_coord1;
+    hsize_t coord2 = *(const hsize_t *)_coord2;
+
+    if(coord1 < coord2)
+        return(-1);
+    if(coord1 > coord2)
+        return(1);
+    return(0);
+}   /* H5S_hyper_cmp_coord() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_hyper_blocks_make_spans
+ PURPOSE
+    Create a span tree for the union of a set of blocks
+ USAGE
+    H5S_hyper_span_info_t *H5S_hyper_blocks_make_spans(rank, dim, start, count, bounds, nbounds)
+        unsigned rank;          IN: # of dimensions of the space
+        unsigned dim;           IN: Dimension to create the spans from
+        const hsize_t *start;   IN: Starting coordinates of all the blocks
+        const hsize_t *count;   IN: Sizes of all the blocks
+        H5S_hyper_block_bound_t *bounds;  IN/OUT: Extents in dimension DIM
+                                    of the blocks to join (sorted on return)
+        size_t nbounds;         IN: # of blocks to join
+ RETURNS
+    Pointer to new span tree on success, NULL on failure
+ DESCRIPTION
+    Generates the span tree, from dimension DIM down, for the union of the
+    blocks listed in BOUNDS.  The blocks are sorted by their start in the
+    dimension, which is then cut into pieces wherever a block starts or
+    ends.  The spans below each piece are made from the blocks covering
+    it, and neighbouring pieces with the same spans below are joined, so
+    the whole tree is built in one pass instead of merging the span tree
+    of each block into the union of the ones before it.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    All blocks have at least one element in every dimension.
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static H5S_hyper_span_info_t *
+H5S_hyper_blocks_make_spans(unsigned rank, unsigned dim, const hsize_t *start,
+    const hsize_t *count, H5S_hyper_block_bound_t *bounds, size_t nbounds)
+{
+    H5S_hyper_span_info_t *spans = NULL;    /* Span tree for this dimension */
+    H5S_hyper_span_t *last_span = NULL;     /* Last span in the tree */
+    H5S_hyper_span_info_t *down = NULL;     /* Span tree below a piece */
+    H5S_hyper_block_bound_t *active = NULL; /* Blocks covering the current piece */
+    H5S_hyper_block_bound_t *down_bounds = NULL;    /* Their extents in the next dimension */
+    hsize_t *cuts = NULL;                   /* Where blocks start or end */
+    size_t ncuts;                           /* # of distinct cuts */
+    size_t nactive = 0;                     /* # of blocks covering the current piece */
+    size_t next = 0;                        /* Next block to start covering a piece */
+    size_t u, v, w;                         /* Local index variables */
+    H5S_hyper_span_info_t *ret_value = NULL;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(rank > 0);
+    HDassert(dim < rank);
+    HDassert(bounds);
+    HDassert(nbounds > 0);
+
+    /* Sort the blocks by their start in this dimension */
+    HDqsort(bounds, nbounds, sizeof(H5S_hyper_block_bound_t), H5S_hyper_cmp_block_bound);
+
+    /* In the fastest changing dimension, join blocks which overlap or touch */
+    if(dim == (rank - 1)) {
+        u = 0;
+        while(u < nbounds) {
+            hsize_t low = bounds[u].low;
+            hsize_t high = bounds[u].high;
+
+            for(u++; u < nbounds && bounds[u].low <= (high + 1); u++)
+                high = MAX(high, bounds[u].high);
+
+            if(H5S_hyper_append_span(&last_span, &spans, low, high, NULL, NULL) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTAPPEND, NULL, "can't allocate hyperslab span")
+        } /* end while */
+    } /* end if */
+    else {
+        /* Find the pieces of this dimension */
+        if(NULL == (cuts = (hsize_t *)H5MM_malloc(2 * nbounds * sizeof(hsize_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "can't allocate block cuts")
+        for(u = 0; u < nbounds; u++) {
+            cuts[2 * u] = bounds[u].low;
+            cuts[(2 * u) + 1] = bounds[u].high + 1;
+        } /* end for */
+        HDqsort(cuts, 2 * nbounds, sizeof(hsize_t), H5S_hyper_cmp_coord);
+        for(u = 1, ncuts = 1; u < (2 * nbounds); u++)
+            if(cuts[u] != cuts[ncuts - 1])
+                cuts[ncuts++] = cuts[u];
+
+        if(NULL == (active = (H5S_hyper_block_bound_t *)H5MM_malloc(nbounds * sizeof(H5S_hyper_block_bound_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "can't allocate block list")
+        if(NULL == (down_bounds = (H5S_hyper_block_bound_t *)H5MM_malloc(nbounds * sizeof(H5S_hyper_block_bound_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "can't allocate block list")
+
+        for(u = 0; (u + 1) < ncuts; u++) {
+            hsize_t low = cuts[u];
+            hsize_t high = cuts[u + 1] - 1;
+
+            /* Drop the blocks ending before this piece and add the ones
+             * starting at it */
+            for(v = 0, w = 0; v < nactive; v++)
+                if(active[v].high >= low)
+                    active[w++] = active[v];
+            nactive = w;
+            while(next < nbounds && bounds[next].low == low)
+                active[nactive++] = bounds[next++];
+
+            /* Skip gaps between blocks */
+            if(nactive == 0)
+                continue;
+
+            /* Build the spans below from the blocks covering the piece */
+            for(v = 0; v < nactive; v++) {
+                size_t off = (active[v].blk * rank) + dim + 1;
+
+                down_bounds[v].low = start[off];
+                down_bounds[v].high = start[off] + count[off] - 1;
+                down_bounds[v].blk = active[v].blk;
+            } /* end for */
+            if(NULL == (down = H5S_hyper_blocks_make_spans(rank, dim + 1, start, count, down_bounds, nactive)))
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCREATE, NULL, "can't create hyperslab spans")
+
+            if(H5S_hyper_append_span(&last_span, &spans, low, high, down, NULL) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTAPPEND, NULL, "can't allocate hyperslab span")
+
+            /* The span (or the one it joined) holds its own reference */
+            if(H5S_hyper_free_span_info(down) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTFREE, NULL, "can't release hyperslab spans")
+            down = NULL;
+        } /* end for */
+    } /* end else */
+
+    /* Set return value */
+    ret_value = spans;
+
+done:
+    if(ret_value == NULL) {
+        if(down && H5S_hyper_free_span_info(down) < 0)
+            HDONE_ERROR(H5E_DATASPACE, H5E_CANTFREE, NULL, "can't release hyperslab spans")
+        if(spans && H5S_hyper_free_span_info(spans) < 0)
+            HDONE_ERROR(H5E_DATASPACE, H5E_CANTFREE, NULL, "can't release hyperslab spans")
+    } /* end if */
+    H5MM_xfree(cuts);
+    H5MM_xfree(active);
+    H5MM_xfree(down_bounds);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5S_hyper_blocks_make_spans() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_select_hyperslab_blocks
+ PURPOSE
+    Internal version of H5Sselect_hyperslab_blocks()
+ USAGE
+    herr_t H5S_select_hyperslab_blocks(space, op, num_blocks, start, count)
+        H5S_t *space;           IN/OUT: Dataspace to modify selection of
+        H5S_seloper_t op;       IN: Operation to perform on current selection
+        size_t num_blocks;      IN: Number of blocks
+        const hsize_t *start;   IN: Starting coordinates of the blocks
+        const hsize_t *count;   IN: Sizes of the blocks
+ RETURNS
+    Non-negative on success/Negative on failure
+ DESCRIPTION
+    Builds the span tree for the union of the blocks and combines it with
+    the current selection, as H5S_select_hyperslab() does with the span tree
+    for a single hyperslab.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static herr_t
+H5S_select_hyperslab_blocks(H5S_t *space, H5S_seloper_t op, size_t num_blocks,
+    const hsize_t *start, const hsize_t *count)
+{
+    H5S_hyper_block_bound_t *bounds = NULL; /* Extents of the blocks in the slowest dimension */
+    H5S_hyper_span_info_t *new_spans = NULL;    /* Span tree for the blocks */
+    unsigned rank = space->extent.rank;     /* Rank of the dataspace */
+    size_t nbounds = 0;                     /* # of non-empty blocks */
+    size_t u;                               /* Local index variable */
+    unsigned v;                             /* Local index variable */
+    herr_t ret_value = SUCCEED;             /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    /* Check args */
+    HDassert(space);
+    HDassert(rank > 0);
+    HDassert(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID);
+    HDassert(num_blocks == 0 || (start && count));
+
+    /* Collect the blocks which aren't empty */
+    if(num_blocks > 0 && NULL == (bounds = (H5S_hyper_block_bound_t *)H5MM_malloc(num_blocks * sizeof(H5S_hyper_block_bound_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate block list")
+    for(u = 0; u < num_blocks; u++) {
+        for(v = 0; v < rank; v++) {
+            if(count[(u * rank) + v] == H5S_UNLIMITED)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "blocks can't be unlimited")
+            if(count[(u * rank) + v] == 0)
+                break;
+        } /* end for */
+        if(v == rank) {
+            bounds[nbounds].low = start[u * rank];
+            bounds[nbounds].high = start[u * rank] + count[u * rank] - 1;
+            bounds[nbounds].blk = u;
+            nbounds++;
+        } /* end if */
+    } /* end for */
+
+    /* Handle selecting nothing */
+    if(nbounds == 0) {
+        switch(op) {
+            case H5S_SELECT_SET:   /* Select "set" operation */
+            case H5S_SELECT_AND:   /* Binary "and" operation for hyperslabs */
+            case H5S_SELECT_NOTA:  /* Binary "B not A" operation for hyperslabs */
+                /* Convert to "none" selection */
+                if(H5S_select_none(space) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDELETE, FAIL, "can't convert selection")
+                HGOTO_DONE(SUCCEED);
+
+            case H5S_SELECT_OR:    /* Binary "or" operation for hyperslabs */
+            case H5S_SELECT_XOR:   /* Binary "xor" operation for hyperslabs */
+            case H5S_SELECT_NOTB:  /* Binary "A not B" operation for hyperslabs */
+                HGOTO_DONE(SUCCEED);        /* Selection stays same */
+
+            case H5S_SELECT_NOOP:
+            case H5S_SELECT_APPEND:
+            case H5S_SELECT_PREPEND:
+            case H5S_SELECT_INVALID:
+            default:
+                HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+        } /* end switch */
+    } /* end if */
+
+    /* Fixup operation for non-hyperslab selections, as H5S_select_hyperslab() does */
+    switch(H5S_GET_SELECT_TYPE(space)) {
+        case H5S_SEL_NONE:   /* No elements selected in dataspace */
+            if(op == H5S_SELECT_AND || op == H5S_SELECT_NOTB)
+                HGOTO_DONE(SUCCEED);        /* Selection stays "none" */
+            op = H5S_SELECT_SET;
+            break;
+
+        case H5S_SEL_ALL:    /* All elements selected in dataspace */
+            if(op == H5S_SELECT_OR)
+                HGOTO_DONE(SUCCEED);        /* Selection stays "all" */
+            if(op == H5S_SELECT_NOTA) {
+                if(H5S_select_none(space) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDELETE, FAIL, "can't convert selection")
+                HGOTO_DONE(SUCCEED);
+            } /* end if */
+            if(op == H5S_SELECT_AND)
+                op = H5S_SELECT_SET;
+            else if(op != H5S_SELECT_SET) {
+                hsize_t tmp_start[H5O_LAYOUT_NDIMS];   /* Temporary start information */
+
+                /* Convert current "all" selection to "real" hyperslab selection */
+                HDmemset(tmp_start, 0, sizeof(tmp_start));
+                if(H5S_select_hyperslab(space, H5S_SELECT_SET, tmp_start, NULL, space->extent.size, NULL) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDELETE, FAIL, "can't convert selection")
+            } /* end else-if */
+            break;
+
+        case H5S_SEL_HYPERSLABS:
+            if(op != H5S_SELECT_SET && space->select.sel_info.hslab->unlim_dim >= 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_UNSUPPORTED, FAIL, "unsupported operation on unlimited selection")
+            break;
+
+        case H5S_SEL_POINTS: /* Can't combine hyperslab operations and point selections currently */
+            if(op == H5S_SELECT_SET)
+                break;
+            /* Else fall through to error */
+
+        case H5S_SEL_ERROR:
+        case H5S_SEL_N:
+        default:
+            HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+    } /* end switch */
+
+    /* Build the span tree for the blocks */
+    if(NULL == (new_spans = H5S_hyper_blocks_make_spans(rank, 0, start, count, bounds, nbounds)))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCREATE, FAIL, "can't create hyperslab spans")
+
+    if(op == H5S_SELECT_SET) {
+        /* If we are setting a new selection, remove current selection first */
+        if(H5S_SELECT_RELEASE(space) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDELETE, FAIL, "can't release selection")
+
+        /* Allocate space for the hyperslab selection information */
+        if(NULL == (space->select.sel_info.hslab = H5FL_MALLOC(H5S_hyper_sel_t)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate hyperslab info")
+        space->select.sel_info.hslab->unlim_dim = -1;
+        space->select.sel_info.hslab->span_lst = NULL;
+        space->select.num_elem = 0;
+    } /* end if */
+    else {
+        /* Check if there's no hyperslab span information currently */
+        if(NULL == space->select.sel_info.hslab->span_lst)
+            if(H5S_hyper_generate_spans(space) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_UNINITIALIZED, FAIL, "dataspace does not have span tree")
+    } /* end else */
+
+    /* Indicate that the regular dimensions are not valid (yet) */
+    space->select.sel_info.hslab->diminfo_valid = FALSE;
+
+    /* Add in the new blocks (the span tree is handed over) */
+    ret_value = H5S_hyper_combine_spans(space, op, new_spans);
+    new_spans = NULL;
+    if(ret_value < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't insert hyperslabs")
+
+    /* Look for a regular pattern in a new selection */
+    if(op == H5S_SELECT_SET && H5S_hyper_rebuild(space) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOUNT, FAIL, "can't rebuild hyperslab info")
+
+    /* Set selection type */
+    space->select.type = H5S_sel_hyper;
+
+done:
+    if(new_spans && H5S_hyper_free_span_info(new_spans) < 0)
+        HDONE_ERROR(H5E_DATASPACE, H5E_CANTFREE, FAIL, "can't release hyperslab spans")
+    H5MM_xfree(bounds);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5S_select_hyperslab_blocks() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5Sselect_hyperslab_blocks
+ PURPOSE
+    Specify a list of blocks to combine with the current selection
+ USAGE
+    herr_t H5Sselect_hyperslab_blocks(dsid, op, num_blocks, start, count)
+        hid_t dsid;             IN: Dataspace ID of selection to modify
+        H5S_seloper_t op;       IN: Operation to perform on current selection
+        size_t num_blocks;      IN: Number of blocks
+        const hsize_t *start;   IN: Starting coordinates of the blocks
+        const hsize_t *count;   IN: Sizes of the blocks
+ RETURNS
+    Non-negative on success/Negative on failure
+ DESCRIPTION
+    Combines the union of NUM_BLOCKS blocks with the current selection for a
+    dataspace, as if the union had been selected by one call to
+    H5Sselect_hyperslab().  START and COUNT are arrays of NUM_BLOCKS
+    coordinates, each with a value for every dimension of the dataspace, and
+    block I is the same as the hyperslab selected by calling
+    H5Sselect_hyperslab() with START and COUNT pointing to the I'th
+    coordinates and NULL stride and block.  The blocks may be given in any
+    order and may overlap.
+
+    This is much faster than selecting each block in turn with the
+    H5S_SELECT_OR operation when there are many blocks, since the span tree
+    for the union of all the blocks is built at once.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5Sselect_hyperslab_blocks(hid_t space_id, H5S_seloper_t op, size_t num_blocks,
+    const hsize_t start[], const hsize_t count[])
+{
+    H5S_t *space;               /* Dataspace to modify selection of */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE5("e", "iSsz*h*h", space_id, op, num_blocks, start, count);
+
+    /* Check args */
+    if(NULL == (space = (H5S_t *)H5I_object_verify(space_id, H5I_DATASPACE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a data space")
+    if(H5S_SCALAR == H5S_GET_EXTENT_TYPE(space))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "hyperslab doesn't support H5S_SCALAR space")
+    if(H5S_NULL == H5S_GET_EXTENT_TYPE(space))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "hyperslab doesn't support H5S_NULL space")
+    if(num_blocks > 0 && (start == NULL || count == NULL))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "blocks not specified")
+    if(!(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID))
+        HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+
+    if(H5S_select_hyperslab_blocks(space, op, num_blocks, start, count) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to set hyperslab selection")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Sselect_hyperslab_blocks() */
+
 
 /*--------------------------------------------------------------------------
  NAME
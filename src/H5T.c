@@ -53,6 +53,31 @@
 
 #define H5T_ENCODE_VERSION      0
 
+/* Number of slots in the cache of conversion paths in front of the path
+ * table and the slot for a pair of datatype hashes, taken from the high
+ * bits of their product since the low bits of the hashes mix poorly */
+#define H5T_PATH_CACHE_BITS     8
+#define H5T_PATH_CACHE_NSLOTS   (1 << H5T_PATH_CACHE_BITS)
+#define H5T_PATH_CACHE_SLOT(SRC_HASH, DST_HASH)                               \
+    (((((SRC_HASH) * 0x9e3779b1u) ^ (DST_HASH)) * 0x9e3779b1u) >> (32 - H5T_PATH_CACHE_BITS))
+
+/* Fold a datatype field into a hash (32-bit FNV-1a, a field at a time) */
+#define H5T_HASH_INIT           2166136261u
+#define H5T_HASH_MIX(H, V)      ((H) = ((H) ^ (uint32_t)(V)) * 16777619u)
+
+/* Fewest elements given to each thread when a conversion is split between
+ * threads, and the first element of range K of a split conversion */
+#define H5T_CONV_SPLIT_MIN_NELMTS   32768
+#define H5T_CONV_SPLIT_START(S, K)                                            \
+    ((K) * ((S)->nelmts / (S)->nparts) + MIN((K), (S)->nelmts % (S)->nparts))
+
+/* Conversions are only split between threads in thread-safe builds, where
+ * each thread has its own error stack, and when the memory allocator keeps
+ * no bookkeeping of its own */
+#if defined(H5_HAVE_THREADSAFE) && !defined(H5_MEMORY_ALLOC_SANITY_CHECK)
+#define H5T_CONV_THREADS
+#endif /* H5_HAVE_THREADSAFE && !H5_MEMORY_ALLOC_SANITY_CHECK */
+
 /*
  * Type initialization macros
  *
@@ -119,6 +144,48 @@
     H5T_INIT_TYPE_FLOAT_COMMON(H5T_ORDER_BE)                \
 }
 
+/* Define the code templates for IEEE half-precision floats for the "GUTS" in the H5T_INIT_TYPE macro */
+#define H5T_INIT_TYPE_HALF_COMMON(ENDIANNESS) {             \
+    H5T_INIT_TYPE_NUM_COMMON(ENDIANNESS)                    \
+    dt->shared->u.atomic.u.f.sign = 15;                     \
+    dt->shared->u.atomic.u.f.epos = 10;                     \
+    dt->shared->u.atomic.u.f.esize = 5;                     \
+    dt->shared->u.atomic.u.f.ebias = 0x0f;                  \
+    dt->shared->u.atomic.u.f.mpos = 0;                      \
+    dt->shared->u.atomic.u.f.msize = 10;                    \
+    dt->shared->u.atomic.u.f.norm = H5T_NORM_IMPLIED;       \
+    dt->shared->u.atomic.u.f.pad = H5T_PAD_ZERO;            \
+}
+
+#define H5T_INIT_TYPE_HALFLE_CORE {                         \
+    H5T_INIT_TYPE_HALF_COMMON(H5T_ORDER_LE)                 \
+}
+
+#define H5T_INIT_TYPE_HALFBE_CORE {                         \
+    H5T_INIT_TYPE_HALF_COMMON(H5T_ORDER_BE)                 \
+}
+
+/* Define the code templates for bfloat16 floats for the "GUTS" in the H5T_INIT_TYPE macro */
+#define H5T_INIT_TYPE_BFLOAT16_COMMON(ENDIANNESS) {         \
+    H5T_INIT_TYPE_NUM_COMMON(ENDIANNESS)                    \
+    dt->shared->u.atomic.u.f.sign = 15;                     \
+    dt->shared->u.atomic.u.f.epos = 7;                      \
+    dt->shared->u.atomic.u.f.esize = 8;                     \
+    dt->shared->u.atomic.u.f.ebias = 0x7f;                  \
+    dt->shared->u.atomic.u.f.mpos = 0;                      \
+    dt->shared->u.atomic.u.f.msize = 7;                     \
+    dt->shared->u.atomic.u.f.norm = H5T_NORM_IMPLIED;       \
+    dt->shared->u.atomic.u.f.pad = H5T_PAD_ZERO;            \
+}
+
+#define H5T_INIT_TYPE_BFLOAT16LE_CORE {                     \
+    H5T_INIT_TYPE_BFLOAT16_COMMON(H5T_ORDER_LE)             \
+}
+
+#define H5T_INIT_TYPE_BFLOAT16BE_CORE {                     \
+    H5T_INIT_TYPE_BFLOAT16_COMMON(H5T_ORDER_BE)             \
+}
+
 /* Define the code templates for standard doubles for the "GUTS" in the H5T_INIT_TYPE macro */
 #define H5T_INIT_TYPE_DOUBLE_COMMON(ENDIANNESS) {           \
     H5T_INIT_TYPE_NUM_COMMON(ENDIANNESS)                    \
@@ -287,6 +354,23 @@
 /* Local Typedefs */
 /******************/
 
+#ifdef H5T_CONV_THREADS
+/* A conversion split into ranges of elements, converted by several threads */
+typedef struct H5T_conv_split_t {
+    H5T_path_t  *tpath;         /* Conversion path */
+    hid_t       src_id;         /* Source datatype */
+    hid_t       dst_id;         /* Destination datatype */
+    size_t      nelmts;         /* Number of elements converted */
+    size_t      nparts;         /* Number of ranges */
+    size_t      buf_stride;     /* Stride passed to the conversion function */
+    size_t      bkg_stride;     /* Background stride passed to the function */
+    size_t      buf_step;       /* Bytes per element between ranges in BUF */
+    size_t      bkg_step;       /* Bytes per element between ranges in BKG */
+    uint8_t     *buf;           /* Conversion buffer */
+    uint8_t     *bkg;           /* Background buffer, or NULL */
+} H5T_conv_split_t;
+#endif /* H5T_CONV_THREADS */
+
 
 /********************/
 /* Local Prototypes */
@@ -297,6 +381,15 @@ static herr_t H5T_register(H5T_pers_t pers, const char *name, H5T_t *src,
             H5T_t *dst, H5T_conv_t func, hid_t dxpl_id, hbool_t api_call);
 static htri_t H5T_compiler_conv(H5T_t *src, H5T_t *dst);
 static herr_t H5T_set_size(H5T_t *dt, size_t size);
+static uint32_t H5T__hash(const H5T_t *dt);
+static hbool_t H5T__path_cache_match(const H5T_t *dt, const H5T_t *path_dt);
+static hbool_t H5T__conv_can_split(const H5T_path_t *tpath);
+#ifdef H5T_CONV_THREADS
+static herr_t H5T__conv_split(H5T_path_t *tpath, hid_t src_id, hid_t dst_id,
+    unsigned nthreads, size_t nelmts, size_t buf_stride, size_t bkg_stride,
+    void *buf, void *bkg, hid_t dxpl_id);
+static herr_t H5T__conv_split_part(size_t idx, void *_split);
+#endif /* H5T_CONV_THREADS */
 
 
 /*****************************/
@@ -321,11 +414,16 @@ hbool_t H5_PKG_INIT_VAR = FALSE;
  * If more of these are added, the new ones must be added to the list of
  * types to reset in H5T_term_package().
  */
+hid_t H5T_IEEE_F16BE_g          = FAIL;
+hid_t H5T_IEEE_F16LE_g          = FAIL;
 hid_t H5T_IEEE_F32BE_g          = FAIL;
 hid_t H5T_IEEE_F32LE_g          = FAIL;
 hid_t H5T_IEEE_F64BE_g          = FAIL;
 hid_t H5T_IEEE_F64LE_g          = FAIL;
 
+hid_t H5T_FLOAT_BFLOAT16BE_g    = FAIL;
+hid_t H5T_FLOAT_BFLOAT16LE_g    = FAIL;
+
 hid_t H5T_VAX_F32_g             = FAIL;
 hid_t H5T_VAX_F64_g             = FAIL;
 
@@ -526,6 +624,7 @@ static struct {
     int            nsoft;         /*number of soft conversions defined    */
     size_t         asoft;         /*number of soft conversions allocated  */
     H5T_soft_t    *soft;          /*unsorted array of soft conversions    */
+    H5T_path_t    *cache[H5T_PATH_CACHE_NSLOTS]; /*recently found paths, by hash*/
 } H5T_g;
 
 /* Declare the free list for H5T_path_t's */
@@ -712,6 +811,12 @@ H5T__init_package(void)
 #if H5_SIZEOF_LONG_DOUBLE !=0
     H5T_t       *native_ldouble=NULL;   /* Datatype structure for native long double */
 #endif
+    H5T_t       *ieee_f16le=NULL;       /* Datatype structure for IEEE 2-byte little-endian float */
+    H5T_t       *ieee_f16be=NULL;       /* Datatype structure for IEEE 2-byte big-endian float */
+    H5T_t       *bfloat16le=NULL;       /* Datatype structure for little-endian bfloat16 */
+    H5T_t       *bfloat16be=NULL;       /* Datatype structure for big-endian bfloat16 */
+    H5T_t       *native_half=NULL;      /* Datatype structure for IEEE 2-byte float in native order */
+    H5T_t       *native_bfloat16=NULL;  /* Datatype structure for bfloat16 in native order */
     H5T_t       *std_u8le=NULL;         /* Datatype structure for unsigned 8-bit little-endian integer */
     H5T_t       *std_u8be=NULL;         /* Datatype structure for unsigned 8-bit big-endian integer */
     H5T_t       *std_u16le=NULL;        /* Datatype structure for unsigned 16-bit little-endian integer */
@@ -819,6 +924,14 @@ H5T__init_package(void)
      *------------------------------------------------------------
      */
 
+    /* IEEE 2-byte little-endian float */
+    H5T_INIT_TYPE(HALFLE,H5T_IEEE_F16LE_g,COPY,native_double,SET,2)
+    ieee_f16le = dt;    /* Keep type for later */
+
+    /* IEEE 2-byte big-endian float */
+    H5T_INIT_TYPE(HALFBE,H5T_IEEE_F16BE_g,COPY,native_double,SET,2)
+    ieee_f16be = dt;    /* Keep type for later */
+
     /* IEEE 4-byte little-endian float */
     H5T_INIT_TYPE(FLOATLE,H5T_IEEE_F32LE_g,COPY,native_double,SET,4)
 
@@ -831,6 +944,19 @@ H5T__init_package(void)
     /* IEEE 8-byte big-endian float */
     H5T_INIT_TYPE(DOUBLEBE,H5T_IEEE_F64BE_g,COPY,native_double,SET,8)
 
+    /*------------------------------------------------------------
+     * bfloat16 Types
+     *------------------------------------------------------------
+     */
+
+    /* 2-byte little-endian bfloat16 */
+    H5T_INIT_TYPE(BFLOAT16LE,H5T_FLOAT_BFLOAT16LE_g,COPY,native_double,SET,2)
+    bfloat16le = dt;    /* Keep type for later */
+
+    /* 2-byte big-endian bfloat16 */
+    H5T_INIT_TYPE(BFLOAT16BE,H5T_FLOAT_BFLOAT16BE_g,COPY,native_double,SET,2)
+    bfloat16be = dt;    /* Keep type for later */
+
     /*------------------------------------------------------------
      * VAX Types
      *------------------------------------------------------------
@@ -1041,6 +1167,18 @@ H5T__init_package(void)
     status |= H5T_register(H5T_PERS_HARD, "ldbl_dbl", native_ldouble, native_double, H5T__conv_ldouble_double, H5AC_noio_dxpl_id, FALSE);
 #endif /* H5_SIZEOF_LONG_DOUBLE != 0 */
 
+    /* 16-bit floating point, in the native byte order */
+    native_half = (H5T_native_order_g == H5T_ORDER_BE) ? ieee_f16be : ieee_f16le;
+    native_bfloat16 = (H5T_native_order_g == H5T_ORDER_BE) ? bfloat16be : bfloat16le;
+    status |= H5T_register(H5T_PERS_HARD, "half_flt", native_half, native_float, H5T__conv_half_float, H5AC_noio_dxpl_id, FALSE);
+    status |= H5T_register(H5T_PERS_HARD, "half_dbl", native_half, native_double, H5T__conv_half_double, H5AC_noio_dxpl_id, FALSE);
+    status |= H5T_register(H5T_PERS_HARD, "flt_half", native_float, native_half, H5T__conv_float_half, H5AC_noio_dxpl_id, FALSE);
+    status |= H5T_register(H5T_PERS_HARD, "dbl_half", native_double, native_half, H5T__conv_double_half, H5AC_noio_dxpl_id, FALSE);
+    status |= H5T_register(H5T_PERS_HARD, "bf16_flt", native_bfloat16, native_float, H5T__conv_bfloat16_float, H5AC_noio_dxpl_id, FALSE);
+    status |= H5T_register(H5T_PERS_HARD, "bf16_dbl", native_bfloat16, native_double, H5T__conv_bfloat16_double, H5AC_noio_dxpl_id, FALSE);
+    status |= H5T_register(H5T_PERS_HARD, "flt_bf16", native_float, native_bfloat16, H5T__conv_float_bfloat16, H5AC_noio_dxpl_id, FALSE);
+    status |= H5T_register(H5T_PERS_HARD, "dbl_bf16", native_double, native_bfloat16, H5T__conv_double_bfloat16, H5AC_noio_dxpl_id, FALSE);
+
     /* from long long */
     status |= H5T_register(H5T_PERS_HARD, "llong_ullong", native_llong, native_ullong, H5T__conv_llong_ullong, H5AC_noio_dxpl_id, FALSE);
     status |= H5T_register(H5T_PERS_HARD, "ullong_llong", native_ullong, native_llong, H5T__conv_ullong_llong, H5AC_noio_dxpl_id, FALSE);
@@ -1403,6 +1541,7 @@ H5T_top_term_package(void)
             H5T_g.soft = (H5T_soft_t *)H5MM_xfree(H5T_g.soft);
             H5T_g.nsoft = 0;
             H5T_g.asoft = 0;
+            HDmemset(H5T_g.cache, 0, sizeof(H5T_g.cache));
 
             n++;
         } /* end if */
@@ -1420,11 +1559,16 @@ H5T_top_term_package(void)
 
         /* Reset all the datatype IDs */
         if(H5T_IEEE_F32BE_g > 0) {
+            H5T_IEEE_F16BE_g            = FAIL;
+            H5T_IEEE_F16LE_g            = FAIL;
             H5T_IEEE_F32BE_g            = FAIL;
             H5T_IEEE_F32LE_g            = FAIL;
             H5T_IEEE_F64BE_g            = FAIL;
             H5T_IEEE_F64LE_g            = FAIL;
 
+            H5T_FLOAT_BFLOAT16BE_g      = FAIL;
+            H5T_FLOAT_BFLOAT16LE_g      = FAIL;
+
             H5T_STD_I8BE_g              = FAIL;
             H5T_STD_I8LE_g              = FAIL;
             H5T_STD_I16BE_g             = FAIL;
@@ -2357,10 +2501,13 @@ H5T_register(H5T_pers_t pers, const char *name, H5T_t *src, H5T_t *dst,
             new_path->func = func;
             new_path->is_hard = FALSE;
             new_path->cdata = cdata;
+            new_path->src_hash = old_path->src_hash;
+            new_path->dst_hash = old_path->dst_hash;
 
             /* Replace previous path */
             H5T_g.path[i] = new_path;
             new_path = NULL; /*so we don't free it on error*/
+            HDmemset(H5T_g.cache, 0, sizeof(H5T_g.cache));
 
             /* Free old path */
             H5T__print_stats(old_path, &nprint);
@@ -2533,6 +2680,7 @@ H5T_unregister(H5T_pers_t pers, const char *name, H5T_t *src, H5T_t *dst,
             /* Remove from table */
             HDmemmove(H5T_g.path + i, H5T_g.path + i + 1, (size_t)(H5T_g.npaths - (i + 1)) * sizeof(H5T_path_t*));
             --H5T_g.npaths;
+            HDmemset(H5T_g.cache, 0, sizeof(H5T_g.cache));
 
             /* Shut down path */
             H5T__print_stats(path, &nprint);
@@ -3915,8 +4063,8 @@ H5T_cmp(const H5T_t *dt1, const H5T_t *dt2, hbool_t superset)
     HDassert(dt1);
     HDassert(dt2);
 
-    /* the easy case */
-    if(dt1 == dt2)
+    /* the easy cases */
+    if(dt1 == dt2 || dt1->shared == dt2->shared)
         HGOTO_DONE(0);
 
     /* compare */
@@ -4344,6 +4492,159 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T_cmp() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:  H5T__hash
+ *
+ * Purpose:   Computes a hash of a datatype from the fields which H5T_cmp()
+ *            compares, so that datatypes which compare as equal (or as a
+ *            superset) have the same hash.  Compound members are combined
+ *            without regard to their order, enumeration members and opaque
+ *            tags aren't hashed, since H5T_cmp() may ignore them.
+ *
+ * Return:    The hash (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static uint32_t
+H5T__hash(const H5T_t *dt)
+{
+    const H5T_shared_t *sh;             /* Shared datatype info */
+    unsigned    u;
+    uint32_t    ret_value = H5T_HASH_INIT;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(dt);
+    sh = dt->shared;
+
+    H5T_HASH_MIX(ret_value, sh->type);
+    H5T_HASH_MIX(ret_value, sh->size);
+    if(sh->parent)
+        H5T_HASH_MIX(ret_value, H5T__hash(sh->parent));
+
+    switch(sh->type) {
+        case H5T_COMPOUND:
+            {
+                uint32_t memb_sum = 0;  /* Sum of the member hashes */
+
+                for(u = 0; u < sh->u.compnd.nmembs; u++) {
+                    const H5T_cmemb_t *memb = sh->u.compnd.memb + u;
+                    const char *c;
+                    uint32_t memb_hash = H5T_HASH_INIT;
+
+                    for(c = memb->name; *c; c++)
+                        H5T_HASH_MIX(memb_hash, (unsigned char)*c);
+                    H5T_HASH_MIX(memb_hash, memb->offset);
+                    H5T_HASH_MIX(memb_hash, memb->size);
+                    H5T_HASH_MIX(memb_hash, H5T__hash(memb->type));
+                    memb_sum += memb_hash;
+                } /* end for */
+                H5T_HASH_MIX(ret_value, sh->u.compnd.nmembs);
+                H5T_HASH_MIX(ret_value, memb_sum);
+            }
+            break;
+
+        case H5T_VLEN:
+            H5T_HASH_MIX(ret_value, sh->u.vlen.type);
+            break;
+
+        case H5T_ARRAY:
+            H5T_HASH_MIX(ret_value, sh->u.array.ndims);
+            for(u = 0; u < sh->u.array.ndims; u++)
+                H5T_HASH_MIX(ret_value, sh->u.array.dim[u]);
+            break;
+
+        case H5T_ENUM:
+        case H5T_OPAQUE:
+            break;
+
+        case H5T_NO_CLASS:
+        case H5T_INTEGER:
+        case H5T_FLOAT:
+        case H5T_TIME:
+        case H5T_STRING:
+        case H5T_BITFIELD:
+        case H5T_REFERENCE:
+        case H5T_NCLASSES:
+        default:
+            H5T_HASH_MIX(ret_value, sh->u.atomic.order);
+            H5T_HASH_MIX(ret_value, sh->u.atomic.prec);
+            H5T_HASH_MIX(ret_value, sh->u.atomic.offset);
+            H5T_HASH_MIX(ret_value, sh->u.atomic.lsb_pad);
+            H5T_HASH_MIX(ret_value, sh->u.atomic.msb_pad);
+            if(H5T_INTEGER == sh->type)
+                H5T_HASH_MIX(ret_value, sh->u.atomic.u.i.sign);
+            else if(H5T_FLOAT == sh->type) {
+                H5T_HASH_MIX(ret_value, sh->u.atomic.u.f.sign);
+                H5T_HASH_MIX(ret_value, sh->u.atomic.u.f.epos);
+                H5T_HASH_MIX(ret_value, sh->u.atomic.u.f.esize);
+                H5T_HASH_MIX(ret_value, sh->u.atomic.u.f.ebias);
+                H5T_HASH_MIX(ret_value, sh->u.atomic.u.f.mpos);
+                H5T_HASH_MIX(ret_value, sh->u.atomic.u.f.msize);
+                H5T_HASH_MIX(ret_value, sh->u.atomic.u.f.norm);
+                H5T_HASH_MIX(ret_value, sh->u.atomic.u.f.pad);
+            } /* end if */
+            else if(H5T_STRING == sh->type) {
+                H5T_HASH_MIX(ret_value, sh->u.atomic.u.s.cset);
+                H5T_HASH_MIX(ret_value, sh->u.atomic.u.s.pad);
+            } /* end if */
+            else if(H5T_REFERENCE == sh->type) {
+                H5T_HASH_MIX(ret_value, sh->u.atomic.u.r.rtype);
+                if(H5R_OBJECT == sh->u.atomic.u.r.rtype)
+                    H5T_HASH_MIX(ret_value, sh->u.atomic.u.r.loc);
+            } /* end if */
+            break;
+    } /* end switch */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__hash() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:  H5T__path_cache_match
+ *
+ * Purpose:   Checks whether datatype DT equals the datatype PATH_DT of a
+ *            cached conversion path, as H5T_cmp() would.  Compounds whose
+ *            members are in the same order are compared member by member,
+ *            which avoids sorting the members by name; anything else is
+ *            left to H5T_cmp().
+ *
+ * Return:    TRUE/FALSE (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5T__path_cache_match(const H5T_t *dt, const H5T_t *path_dt)
+{
+    const H5T_shared_t *sh1 = dt->shared;       /* Shared info of DT */
+    const H5T_shared_t *sh2 = path_dt->shared;  /* Shared info of PATH_DT */
+    unsigned    u;
+    hbool_t     ret_value = TRUE;               /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(sh1 == sh2)
+        HGOTO_DONE(TRUE)
+    if(H5T_COMPOUND != sh1->type || H5T_COMPOUND != sh2->type ||
+            sh1->size != sh2->size || sh1->u.compnd.nmembs != sh2->u.compnd.nmembs)
+        HGOTO_DONE(0 == H5T_cmp(dt, path_dt, FALSE))
+
+    for(u = 0; u < sh1->u.compnd.nmembs; u++)
+        if(HDstrcmp(sh1->u.compnd.memb[u].name, sh2->u.compnd.memb[u].name))
+            HGOTO_DONE(0 == H5T_cmp(dt, path_dt, FALSE))
+    for(u = 0; u < sh1->u.compnd.nmembs; u++)
+        if(sh1->u.compnd.memb[u].offset != sh2->u.compnd.memb[u].offset ||
+                sh1->u.compnd.memb[u].size != sh2->u.compnd.memb[u].size ||
+                !H5T__path_cache_match(sh1->u.compnd.memb[u].type, sh2->u.compnd.memb[u].type))
+            HGOTO_DONE(FALSE)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__path_cache_match() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5T_path_find
@@ -4393,6 +4694,8 @@ H5T_path_find(const H5T_t *src, const H5T_t *dst, const char *name,
     H5T_path_t    *table = NULL;               /* path existing in the table */
     H5T_path_t    *path = NULL;                /* new path */
     hid_t         src_id = -1, dst_id = -1;    /* src and dst type identifiers */
+    uint32_t      src_hash, dst_hash;          /* hashes of src and dst types */
+    H5T_path_t    **slot;                      /* cache slot for the path */
     int           i;                           /* counter */
     int           nprint = 0;                  /* lines of output printed */
     H5T_path_t    *ret_value = NULL;           /* Return value */
@@ -4405,6 +4708,10 @@ H5T_path_find(const H5T_t *src, const H5T_t *dst, const char *name,
     HDassert(dst);
     HDassert(dst->shared);
 
+    src_hash = H5T__hash(src);
+    dst_hash = H5T__hash(dst);
+    slot = &H5T_g.cache[H5T_PATH_CACHE_SLOT(src_hash, dst_hash)];
+
     /*
      * Make sure the first entry in the table is the no-op conversion path.
      */
@@ -4437,11 +4744,18 @@ H5T_path_find(const H5T_t *src, const H5T_t *dst, const char *name,
      * Only allow the no-op conversion to occur if no "force conversion" flags
      * are set
      */
-    if(src->shared->force_conv == FALSE && dst->shared->force_conv == FALSE && 0 == H5T_cmp(src, dst, TRUE)) {
+    if(src->shared->force_conv == FALSE && dst->shared->force_conv == FALSE &&
+            src_hash == dst_hash && 0 == H5T_cmp(src, dst, TRUE)) {
         table = H5T_g.path[0];
         cmp = 0;
         md = 0;
     } /* end if */
+    else if(!func && *slot && (*slot)->src_hash == src_hash && (*slot)->dst_hash == dst_hash &&
+            H5T__path_cache_match(src, (*slot)->src) && H5T__path_cache_match(dst, (*slot)->dst)) {
+        /* A path found recently, whose position in the table isn't needed
+         * since it won't be replaced */
+        HGOTO_DONE(*slot)
+    } /* end if */
     else {
         lt = md = 1;
         rt = H5T_g.npaths;
@@ -4514,6 +4828,7 @@ H5T_path_find(const H5T_t *src, const H5T_t *dst, const char *name,
         src_id = dst_id = -1;
         path->func = func;
         path->is_hard = TRUE;
+        path->is_lib = !is_api;
     } /* end if */
 
     /*
@@ -4593,6 +4908,9 @@ H5T_path_find(const H5T_t *src, const H5T_t *dst, const char *name,
         table = H5FL_FREE(H5T_path_t, table);
         table = path;
         H5T_g.path[md] = path;
+
+        /* The old path may be in the cache */
+        HDmemset(H5T_g.cache, 0, sizeof(H5T_g.cache));
     }
     else if(path != table) {
         HDassert(cmp);
@@ -4618,6 +4936,13 @@ H5T_path_find(const H5T_t *src, const H5T_t *dst, const char *name,
     if(H5T_COMPOUND == H5T_get_class(src, TRUE) && H5T_COMPOUND == H5T_get_class(dst, TRUE))
         path->are_compounds = TRUE;
 
+    /* Remember the path for the next lookup of these datatypes */
+    if(path != H5T_g.path[0]) {
+        path->src_hash = src_hash;
+        path->dst_hash = dst_hash;
+        *slot = path;
+    } /* end if */
+
     /* Set return value */
     ret_value = path;
 
@@ -4728,6 +5053,29 @@ H5T_path_bkg(const H5T_path_t *p)
     FUNC_LEAVE_NOAPI(p->cdata.need_bkg)
 } /* end H5T_path_bkg() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:  H5T_path_concurrent
+ *
+ * Purpose:   Check whether the conversion path may convert elements on
+ *            another thread, concurrently with other library operations.
+ *            This is so for the library's own conversions which keep no
+ *            state across elements (see H5T__conv_can_split).
+ *
+ * Return:    TRUE/FALSE (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5T_path_concurrent(const H5T_path_t *p)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(p);
+
+    FUNC_LEAVE_NOAPI(H5T__conv_can_split(p))
+} /* end H5T_path_concurrent() */
+
 
 /*-------------------------------------------------------------------------
  * Function:  H5T_compiler_conv
@@ -4812,6 +5160,9 @@ H5T_convert(H5T_path_t *tpath, hid_t src_id, hid_t dst_id, size_t nelmts,
 #ifdef H5T_DEBUG
     H5_timer_t        timer;
 #endif
+#ifdef H5T_CONV_THREADS
+    unsigned    nthreads = 1;            /* Threads to convert with */
+#endif /* H5T_CONV_THREADS */
     herr_t      ret_value=SUCCEED;       /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
@@ -4819,7 +5170,38 @@ H5T_convert(H5T_path_t *tpath, hid_t src_id, hid_t dst_id, size_t nelmts,
 #ifdef H5T_DEBUG
     if (H5DEBUG(T)) H5_timer_begin(&timer);
 #endif
-    tpath->cdata.command = H5T_CONV_CONV;
+    /* (Only stored when it changes, since the members of a compound may be
+     * converted by several threads at once) */
+    if(tpath->cdata.command != H5T_CONV_CONV)
+        tpath->cdata.command = H5T_CONV_CONV;
+
+#ifdef H5T_CONV_THREADS
+    /* Check whether a large conversion should be split between threads */
+    if(nelmts >= 2 * H5T_CONV_SPLIT_MIN_NELMTS && H5T__conv_can_split(tpath)) {
+        H5P_genplist_t *plist;          /* Data transfer property list */
+        H5T_conv_cb_t cb_struct;        /* Conversion exception callback */
+
+        if(NULL == (plist = (H5P_genplist_t *)H5P_object_verify(dset_xfer_plist, H5P_DATASET_XFER)))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset transfer property list")
+        if(H5P_get(plist, H5D_XFER_TCONV_NTHREADS_NAME, &nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get type conversion thread count")
+
+        /* The exception callback must see exceptions in element order */
+        if(nthreads > 1) {
+            if(H5P_get(plist, H5D_XFER_CONV_CB_NAME, &cb_struct) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get conversion exception callback")
+            if(cb_struct.func)
+                nthreads = 1;
+        } /* end if */
+    } /* end if */
+
+    if(nthreads > 1) {
+        if(H5T__conv_split(tpath, src_id, dst_id, nthreads, nelmts, buf_stride,
+                bkg_stride, buf, bkg, dset_xfer_plist) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "data type conversion failed")
+    } /* end if */
+    else
+#endif /* H5T_CONV_THREADS */
     if ((tpath->func)(src_id, dst_id, &(tpath->cdata), nelmts, buf_stride,
                       bkg_stride, buf, bkg, dset_xfer_plist)<0)
         HGOTO_ERROR(H5E_ATTR, H5E_CANTENCODE, FAIL, "data type conversion failed");
@@ -4836,6 +5218,188 @@ done:
 }
 
 
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_can_split
+ *
+ * Purpose:	Check whether the elements converted by a conversion path
+ *              may be split into ranges converted concurrently.  This is
+ *              so for the library's hard conversions and its soft integer,
+ *              floating-point, bitfield and byte order conversions, none
+ *              of which keep any state across elements, and for its
+ *              compound conversions when all members are of those kinds.
+ *
+ * Return:	TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5T__conv_can_split(const H5T_path_t *tpath)
+{
+    static const H5T_class_t no_split[] = {H5T_STRING, H5T_OPAQUE, H5T_REFERENCE,
+            H5T_ENUM, H5T_VLEN, H5T_ARRAY};
+    size_t u;                           /* Local index variable */
+    hbool_t ret_value = FALSE;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(tpath->is_noop)
+        HGOTO_DONE(FALSE)
+    if(tpath->is_hard)
+        HGOTO_DONE(tpath->is_lib)
+    if(tpath->func == H5T__conv_order || tpath->func == H5T__conv_order_opt
+            || tpath->func == H5T__conv_i_i || tpath->func == H5T__conv_i_f
+            || tpath->func == H5T__conv_f_f || tpath->func == H5T__conv_f_i
+            || tpath->func == H5T__conv_b_b)
+        HGOTO_DONE(TRUE)
+    if(tpath->func == H5T__conv_struct || tpath->func == H5T__conv_struct_opt) {
+        for(u = 0; u < NELMTS(no_split); u++)
+            if(H5T_detect_class(tpath->src, no_split[u], FALSE) != FALSE
+                    || H5T_detect_class(tpath->dst, no_split[u], FALSE) != FALSE)
+                HGOTO_DONE(FALSE)
+        ret_value = TRUE;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_can_split() */
+
+
+#ifdef H5T_CONV_THREADS
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_split
+ *
+ * Purpose:	Convert NELMTS elements as contiguous ranges of elements,
+ *              each converted by one of NTHREADS threads.
+ *
+ *              Packed elements converted in place between datatypes of
+ *              different sizes are moved so that no range overwrites
+ *              another's elements: before widening, the source elements
+ *              of each range are moved to the start of the range's
+ *              destination; after narrowing, the converted elements of
+ *              each range are moved down to their destination.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__conv_split(H5T_path_t *tpath, hid_t src_id, hid_t dst_id, unsigned nthreads,
+    size_t nelmts, size_t buf_stride, size_t bkg_stride, void *buf, void *bkg,
+    hid_t dxpl_id)
+{
+    H5T_conv_split_t split;             /* Description of the split conversion */
+    size_t      src_size, dst_size;     /* Datatype sizes */
+    uint8_t     *tmp_buf = NULL;        /* Copy of the first element */
+    uint8_t     *tmp_bkg = NULL;        /* Background for the copy */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(tpath->src && tpath->dst);
+    HDassert(nthreads > 1);
+
+    src_size = tpath->src->shared->size;
+    dst_size = tpath->dst->shared->size;
+
+    /* Compound conversions bring their private data (and that of the paths
+     * for their members) up to date and sort the members of the datatypes
+     * on first use.  Convert a copy of the first element here first, so the
+     * threads find nothing left to update. */
+    if(tpath->func == H5T__conv_struct || tpath->func == H5T__conv_struct_opt) {
+        if(NULL == (tmp_buf = (uint8_t *)H5MM_malloc(MAX(src_size, dst_size))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for conversion buffer")
+        if(NULL == (tmp_bkg = (uint8_t *)H5MM_calloc(dst_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for background buffer")
+        HDmemcpy(tmp_buf, buf, src_size);
+        if(bkg)
+            HDmemcpy(tmp_bkg, bkg, dst_size);
+        if((tpath->func)(src_id, dst_id, &(tpath->cdata), (size_t)1, (size_t)0,
+                (size_t)0, tmp_buf, tmp_bkg, dxpl_id) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "data type conversion failed")
+    } /* end if */
+
+    split.tpath = tpath;
+    split.src_id = src_id;
+    split.dst_id = dst_id;
+    split.nelmts = nelmts;
+    split.nparts = MIN(nthreads, nelmts / H5T_CONV_SPLIT_MIN_NELMTS);
+    split.buf_stride = buf_stride;
+    split.bkg_stride = bkg_stride;
+    split.buf_step = buf_stride ? buf_stride : MAX(src_size, dst_size);
+    split.bkg_step = (buf_stride && bkg_stride) ? bkg_stride : dst_size;
+    split.buf = (uint8_t *)buf;
+    split.bkg = (uint8_t *)bkg;
+
+    /* Spread out packed source elements for widening */
+    if(!buf_stride && dst_size > src_size)
+        for(u = split.nparts - 1; u > 0; u--) {
+            size_t start = H5T_CONV_SPLIT_START(&split, u);
+
+            HDmemmove(split.buf + start * dst_size, split.buf + start * src_size,
+                    (H5T_CONV_SPLIT_START(&split, u + 1) - start) * src_size);
+        } /* end for */
+
+    if(H5TS_parallel_for((unsigned)split.nparts, split.nparts, H5T__conv_split_part, &split) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "data type conversion failed")
+
+    /* Close up packed destination elements after narrowing */
+    if(!buf_stride && dst_size < src_size)
+        for(u = 1; u < split.nparts; u++) {
+            size_t start = H5T_CONV_SPLIT_START(&split, u);
+
+            HDmemmove(split.buf + start * dst_size, split.buf + start * src_size,
+                    (H5T_CONV_SPLIT_START(&split, u + 1) - start) * dst_size);
+        } /* end for */
+
+done:
+    H5MM_xfree(tmp_buf);
+    H5MM_xfree(tmp_bkg);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_split() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_split_part
+ *
+ * Purpose:	Convert range IDX of a split conversion.  Called on one of
+ *              the threads used by H5T__conv_split(), so no error is
+ *              pushed here: H5T__conv_split() reports the failure.
+ *
+ *              The conversion function is given the default transfer
+ *              property list, which differs from the caller's only in
+ *              properties that prevent splitting, so that conversions of
+ *              compound members aren't split again.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__conv_split_part(size_t idx, void *_split)
+{
+    H5T_conv_split_t *split = (H5T_conv_split_t *)_split;
+    size_t      start, end;             /* Range of elements converted */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    start = H5T_CONV_SPLIT_START(split, idx);
+    end = H5T_CONV_SPLIT_START(split, idx + 1);
+
+    ret_value = (split->tpath->func)(split->src_id, split->dst_id, &(split->tpath->cdata),
+            end - start, split->buf_stride, split->bkg_stride,
+            split->buf + start * split->buf_step,
+            split->bkg ? split->bkg + start * split->bkg_step : NULL,
+            H5P_DATASET_XFER_DEFAULT);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_split_part() */
+#endif /* H5T_CONV_THREADS */
+
+
 /*-------------------------------------------------------------------------
  * Function:  H5T_oloc
  *
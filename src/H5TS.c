@@ -26,6 +26,38 @@ typedef struct H5TS_cancel_struct {
     unsigned int cancel_count;
 } H5TS_cancel_t;
 
+/* Description of the work shared by the threads in H5TS_parallel_for */
+typedef struct H5TS_work_t {
+    H5TS_work_func_t func;          /* Callback to invoke on each item */
+    void *udata;                    /* User data for callback */
+    size_t nitems;                  /* Number of items */
+    size_t next;                    /* Index of next unclaimed item */
+    hbool_t failed;                 /* Whether any callback failed */
+    unsigned nwanted;               /* Number of helper threads still wanted */
+    unsigned nbusy;                 /* Number of helper threads working on the items */
+    struct H5TS_work_t *next_work;  /* Next work in the pool's list */
+} H5TS_work_t;
+
+/* Condition variables for the helper thread pool */
+#ifdef H5_HAVE_WIN_THREADS
+typedef CONDITION_VARIABLE H5TS_cond_t;
+#else /* H5_HAVE_WIN_THREADS */
+typedef pthread_cond_t H5TS_cond_t;
+#endif /* H5_HAVE_WIN_THREADS */
+
+/* Pool of helper threads, shared by all calls to H5TS_parallel_for */
+typedef struct H5TS_pool_t {
+    H5TS_mutex_simple_t lock;       /* Protects the pool & the work in it */
+    H5TS_cond_t work_cond;          /* Signalled when work is posted */
+    H5TS_cond_t done_cond;          /* Signalled when helper threads finish work */
+    unsigned nthreads;              /* Number of helper threads started */
+    unsigned nidle;                 /* Number of helper threads not working on items */
+    H5TS_work_t *work;              /* List of work still wanting helper threads */
+} H5TS_pool_t;
+
+/* Upper limit on the number of helper threads in the pool */
+#define H5TS_POOL_MAX_THREADS   64
+
 /* Global variable definitions */
 #ifdef H5_HAVE_WIN_THREADS
 H5TS_once_t H5TS_first_init_g;
@@ -36,6 +68,9 @@ H5TS_key_t H5TS_errstk_key_g;
 H5TS_key_t H5TS_funcstk_key_g;
 H5TS_key_t H5TS_cancel_key_g;
 
+/* Helper threads for H5TS_parallel_for */
+static H5TS_pool_t H5TS_pool_g;
+
 
 /*--------------------------------------------------------------------------
  * NAME
@@ -111,6 +146,11 @@ H5TS_pthread_first_thread_init(void)
 
     /* initialize key for thread cancellability mechanism */
     pthread_key_create(&H5TS_cancel_key_g, H5TS_key_destructor);
+
+    /* initialize the pool of helper threads for H5TS_parallel_for */
+    pthread_mutex_init(&H5TS_pool_g.lock, NULL);
+    pthread_cond_init(&H5TS_pool_g.work_cond, NULL);
+    pthread_cond_init(&H5TS_pool_g.done_cond, NULL);
 }
 #endif /* H5_HAVE_WIN_THREADS */
 
@@ -347,6 +387,11 @@ H5TS_win32_process_enter(PINIT_ONCE InitOnce, PVOID Parameter, PVOID *lpContex)
     /* Initialize the critical section (can't fail) */
     InitializeCriticalSection(&H5_g.init_lock.CriticalSection);
 
+    /* Initialize the pool of helper threads for H5TS_parallel_for (can't fail) */
+    InitializeCriticalSection(&H5TS_pool_g.lock);
+    InitializeConditionVariable(&H5TS_pool_g.work_cond);
+    InitializeConditionVariable(&H5TS_pool_g.done_cond);
+
     /* Set up thread local storage */
     if(TLS_OUT_OF_INDEXES == (H5TS_errstk_key_g = TlsAlloc()))
         ret_value = FALSE;
@@ -518,4 +563,216 @@ H5TS_create_thread(void *(*func)(void *), H5TS_attr_t *attr, void *udata)
 
 } /* H5TS_create_thread */
 
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_work_items
+ *
+ * RETURNS
+ *    Nothing.
+ *
+ * DESCRIPTION
+ *    Repeatedly claims the next unprocessed item and invokes the work
+ *    callback on it, until all items have been claimed.
+ *
+ *--------------------------------------------------------------------------
+ */
+static void
+H5TS_work_items(H5TS_work_t *work)
+{
+    while(1) {
+        size_t idx;
+
+        /* Claim the next item */
+        H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+        idx = work->next++;
+        H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+        if(idx >= work->nitems)
+            break;
+
+        /* Process it, remembering any failure */
+        if((work->func)(idx, work->udata) < 0) {
+            H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+            work->failed = TRUE;
+            H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+        } /* end if */
+    } /* end while */
+} /* H5TS_work_items */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_pool_thread
+ *
+ * RETURNS
+ *    NULL
+ *
+ * DESCRIPTION
+ *    Body of each helper thread in the pool used by H5TS_parallel_for.
+ *    The thread waits for work wanting helpers, joins in on its items and
+ *    goes back to waiting, until the process exits.  (Threads are counted
+ *    as idle from when they're started, except while working on items)
+ *
+ *    Errors pushed while processing items are discarded: pushing an error
+ *    touches the ID reference counts, which aren't protected against
+ *    concurrent access.
+ *
+ *--------------------------------------------------------------------------
+ */
+static void *
+H5TS_pool_thread(void H5_ATTR_UNUSED *udata)
+{
+    (void)H5E_set_discard(TRUE);
+
+    H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+    while(1) {
+        H5TS_work_t *work = H5TS_pool_g.work;
+
+        /* Wait for work */
+        if(NULL == work) {
+#ifdef  H5_HAVE_WIN_THREADS
+            SleepConditionVariableCS(&H5TS_pool_g.work_cond, &H5TS_pool_g.lock, INFINITE);
+#else /* H5_HAVE_WIN_THREADS */
+            pthread_cond_wait(&H5TS_pool_g.work_cond, &H5TS_pool_g.lock);
+#endif /* H5_HAVE_WIN_THREADS */
+            continue;
+        } /* end if */
+
+        /* Join in, taking the work off the list once it has all the
+         * helpers it wants */
+        if(0 == --work->nwanted)
+            H5TS_pool_g.work = work->next_work;
+        work->nbusy++;
+        H5TS_pool_g.nidle--;
+        H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+
+        H5TS_work_items(work);
+
+        /* Let the thread waiting for the work know when it's done */
+        H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+        H5TS_pool_g.nidle++;
+        if(0 == --work->nbusy)
+#ifdef  H5_HAVE_WIN_THREADS
+            WakeAllConditionVariable(&H5TS_pool_g.done_cond);
+#else /* H5_HAVE_WIN_THREADS */
+            pthread_cond_broadcast(&H5TS_pool_g.done_cond);
+#endif /* H5_HAVE_WIN_THREADS */
+    } /* end while */
+
+    return(NULL);
+} /* H5TS_pool_thread */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_parallel_for
+ *
+ * RETURNS
+ *    Non-negative on success / Negative if any item failed.
+ *
+ * DESCRIPTION
+ *    Invoke 'func' on each of the 'nitems' indices, using up to 'nthreads'
+ *    threads (the calling thread included).  The calling thread always
+ *    processes item 0 itself; the other items are handed out dynamically,
+ *    so callers need not balance their cost.  Returns after all items
+ *    have been processed.
+ *
+ *    The callback must only touch state private to its item, or state that
+ *    is read-only for the duration of the call: the library's internal data
+ *    structures are not protected against concurrent access.
+ *
+ *    Errors pushed by callbacks on helper threads are discarded, so the
+ *    callback should record how its item fared where the caller can find
+ *    it, and the caller should push any error once this returns.
+ *
+ *    The helper threads come from a pool which is shared by all calls and
+ *    grows as needed, up to H5TS_POOL_MAX_THREADS threads.  If a thread
+ *    can't be started, or all the threads are busy, the work is taken up
+ *    by the threads available, the calling thread included.
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5TS_parallel_for(unsigned nthreads, size_t nitems, H5TS_work_func_t func,
+    void *udata)
+{
+    H5TS_work_t work;
+
+    /* Never use more threads than there are items */
+    if((size_t)nthreads > nitems)
+        nthreads = (unsigned)nitems;
+    if(0 == nitems)
+        return(SUCCEED);
+
+    /* Initialize the shared work description, keeping item 0 for this thread */
+    work.func = func;
+    work.udata = udata;
+    work.nitems = nitems;
+    work.next = 1;
+    work.failed = FALSE;
+    work.nwanted = nthreads - 1;
+    work.nbusy = 0;
+    work.next_work = NULL;
+
+    /* Post the work for the helper threads, starting more if too few are idle */
+    if(work.nwanted > 0) {
+        H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+        work.next_work = H5TS_pool_g.work;
+        H5TS_pool_g.work = &work;
+        while(H5TS_pool_g.nidle < work.nwanted && H5TS_pool_g.nthreads < H5TS_POOL_MAX_THREADS) {
+#ifdef  H5_HAVE_WIN_THREADS
+            HANDLE thread;
+
+            if(NULL == (thread = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)H5TS_pool_thread, NULL, 0, NULL)))
+                break;
+            CloseHandle(thread);
+#else /* H5_HAVE_WIN_THREADS */
+            pthread_t thread;
+
+            if(pthread_create(&thread, NULL, H5TS_pool_thread, NULL))
+                break;
+            pthread_detach(thread);
+#endif /* H5_HAVE_WIN_THREADS */
+            H5TS_pool_g.nthreads++;
+            H5TS_pool_g.nidle++;
+        } /* end while */
+#ifdef  H5_HAVE_WIN_THREADS
+        WakeAllConditionVariable(&H5TS_pool_g.work_cond);
+#else /* H5_HAVE_WIN_THREADS */
+        pthread_cond_broadcast(&H5TS_pool_g.work_cond);
+#endif /* H5_HAVE_WIN_THREADS */
+        H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+    } /* end if */
+
+    /* Work on items from this thread also */
+    if((func)((size_t)0, udata) < 0) {
+        H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+        work.failed = TRUE;
+        H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+    } /* end if */
+    H5TS_work_items(&work);
+
+    /* Take the work off the pool's list, if it's still there, and wait for
+     * the helper threads working on it to finish */
+    if(nthreads > 1) {
+        H5TS_work_t **prev;
+
+        H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+        for(prev = &H5TS_pool_g.work; *prev; prev = &(*prev)->next_work)
+            if(*prev == &work) {
+                *prev = work.next_work;
+                break;
+            } /* end if */
+        while(work.nbusy > 0)
+#ifdef  H5_HAVE_WIN_THREADS
+            SleepConditionVariableCS(&H5TS_pool_g.done_cond, &H5TS_pool_g.lock, INFINITE);
+#else /* H5_HAVE_WIN_THREADS */
+            pthread_cond_wait(&H5TS_pool_g.done_cond, &H5TS_pool_g.lock);
+#endif /* H5_HAVE_WIN_THREADS */
+        H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+    } /* end if */
+
+    return(work.failed ? FAIL : SUCCEED);
+} /* H5TS_parallel_for */
+
 #endif  /* H5_HAVE_THREADSAFE */
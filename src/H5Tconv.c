@@ -35,6 +35,15 @@
 #include "H5Pprivate.h"		/* Property lists			*/
 #include "H5Tpkg.h"		/* Datatypes				*/
 
+/* SSE2 kernels for byte swapping and the most common narrowing conversions */
+#ifdef __SSE2__
+#include <emmintrin.h>
+#define H5T_HAVE_SSE2
+#if defined(H5_WANT_DCONV_EXCEPTION)
+#define H5T_CONV_HAVE_SSE2
+#endif
+#endif
+
 
 /****************/
 /* Local Macros */
@@ -781,6 +790,17 @@
                 /* Alignment is required only for destination */	      \
                 H5T_CONV_LOOP_OUTER(PRE_SNOALIGN,PRE_DALIGN,POST_SNOALIGN,POST_DALIGN,GUTS,STYPE,DTYPE,src,d,ST,DT,D_MIN,D_MAX) \
             } else {							      \
+                /* Convert packed elements with a SIMD kernel first, if */    \
+                /* there's one and no exception handling routine */          \
+                if(!cb_struct.func && s_stride == (ssize_t)sizeof(ST) && d_stride == (ssize_t)sizeof(DT)) { \
+                    size_t nconv = H5_GLUE(GUTS,_NOEX_PACKED)(ST,DT,src,dst,safe); \
+                                                                              \
+                    src = (ST *)(src_buf += nconv * sizeof(ST));              \
+                    dst = (DT *)(dst_buf += nconv * sizeof(DT));              \
+                    nelmts -= nconv;                                          \
+                    safe -= nconv;                                            \
+                }                                                             \
+                                                                              \
                 /* Alignment is not required for both source and destination */ \
                 H5T_CONV_LOOP_OUTER(PRE_SNOALIGN,PRE_DNOALIGN,POST_SNOALIGN,POST_DNOALIGN,GUTS,STYPE,DTYPE,src,dst,ST,DT,D_MIN,D_MAX) \
             }	 	 	 	 	 	 	 	      \
@@ -899,6 +919,32 @@ done:                                                                         \
         dst = (DT *)dst_buf;						      \
     }
 
+/* Convert the first of a run of packed elements in place with a SIMD
+ * kernel, for the conversions which have one.  Evaluates to the number of
+ * elements converted.  The kernels apply the "no exception" rules, and
+ * only narrow the elements, so they can walk the buffer forwards.
+ */
+#ifdef H5T_CONV_HAVE_SSE2
+#define H5T_CONV_Ff_NOEX_PACKED(ST,DT,S,D,N)                                  \
+    ((sizeof(ST) == sizeof(double) && sizeof(DT) == sizeof(float)) ?          \
+        H5T__conv_double_float_sse2((const double *)(S), (float *)(D), N) : (size_t)0)
+#define H5T_CONV_Xx_NOEX_PACKED(ST,DT,S,D,N)                                  \
+    ((sizeof(ST) == sizeof(int64_t) && sizeof(DT) == sizeof(int32_t)) ?       \
+        H5T__conv_int64_int32_sse2((const int64_t *)(S), (int32_t *)(D), N) : (size_t)0)
+#else /* H5T_CONV_HAVE_SSE2 */
+#define H5T_CONV_Ff_NOEX_PACKED(ST,DT,S,D,N)    (size_t)0
+#define H5T_CONV_Xx_NOEX_PACKED(ST,DT,S,D,N)    (size_t)0
+#endif /* H5T_CONV_HAVE_SSE2 */
+#define H5T_CONV_xX_NOEX_PACKED(ST,DT,S,D,N)    (size_t)0
+#define H5T_CONV_Ux_NOEX_PACKED(ST,DT,S,D,N)    (size_t)0
+#define H5T_CONV_sU_NOEX_PACKED(ST,DT,S,D,N)    (size_t)0
+#define H5T_CONV_uS_NOEX_PACKED(ST,DT,S,D,N)    (size_t)0
+#define H5T_CONV_Su_NOEX_PACKED(ST,DT,S,D,N)    (size_t)0
+#define H5T_CONV_su_NOEX_PACKED(ST,DT,S,D,N)    (size_t)0
+#define H5T_CONV_us_NOEX_PACKED(ST,DT,S,D,N)    (size_t)0
+#define H5T_CONV_xF_NOEX_PACKED(ST,DT,S,D,N)    (size_t)0
+#define H5T_CONV_Fx_NOEX_PACKED(ST,DT,S,D,N)    (size_t)0
+
 /* Macro to call the actual "guts" of the type conversion, or call the "no exception" guts */
 #ifdef H5_WANT_DCONV_EXCEPTION
 #define H5T_CONV_LOOP_GUTS(GUTS,STYPE,DTYPE,S,D,ST,DT,D_MIN,D_MAX)			      \
@@ -963,6 +1009,14 @@ done:                                                                         \
 /* Local Typedefs */
 /******************/
 
+/* A run of adjacent compound members which need no conversion, copied
+ * with one memcpy for each element */
+typedef struct H5T_conv_struct_run_t {
+    size_t      src_offset;             /*offset of the run in the source    */
+    size_t      dst_offset;             /*offset of the run in the dest      */
+    size_t      len;                    /*number of bytes in the run         */
+} H5T_conv_struct_run_t;
+
 /* Conversion data for H5T__conv_struct() */
 typedef struct H5T_conv_struct_t {
     int	*src2dst;		/*mapping from src to dst member num */
@@ -971,6 +1025,10 @@ typedef struct H5T_conv_struct_t {
     H5T_path_t	**memb_path;		/*conversion path for each member    */
     H5T_subset_info_t   subset_info;    /*info related to compound subsets   */
     unsigned            src_nmembs;     /*needed by free function            */
+    hbool_t             swap_only;      /*members only need bytes swapped    */
+    size_t              swap_size;      /*member size if they tile the struct*/
+    H5T_conv_struct_run_t *copy_run;    /*runs of members copied unconverted */
+    unsigned            ncopy_runs;     /*number of runs of copied members   */
 } H5T_conv_struct_t;
 
 /* Conversion data for H5T__conv_enum() */
@@ -986,6 +1044,19 @@ typedef struct H5T_conv_hw_t {
     size_t	d_aligned;		/*number destination elements aligned*/
 } H5T_conv_hw_t;
 
+/* 16-bit floating-point formats with hard conversions */
+typedef enum H5T_conv_f16_t {
+    H5T_CONV_F16_HALF,                  /*IEEE 754 half precision            */
+    H5T_CONV_F16_BFLOAT16               /*bfloat16: a float's upper 16 bits  */
+} H5T_conv_f16_t;
+
+/* One element of a 16-bit floating-point conversion */
+typedef union H5T_conv_f16_val_t {
+    uint16_t    h;                      /*16-bit floating-point bits         */
+    float       f;                      /*native float                       */
+    double      d;                      /*native double                      */
+} H5T_conv_f16_val_t;
+
 /********************/
 /* Package Typedefs */
 /********************/
@@ -996,6 +1067,25 @@ typedef struct H5T_conv_hw_t {
 /********************/
 
 static herr_t H5T_reverse_order(uint8_t *rev, uint8_t *s, size_t size, H5T_order_t order);
+static size_t H5T__conv_swap_packed(uint8_t *buf, size_t size, size_t nelmts);
+static void H5T__conv_swap(uint8_t *buf, size_t size, size_t nelmts, size_t buf_stride);
+#ifdef H5T_CONV_HAVE_SSE2
+static size_t H5T__conv_double_float_sse2(const double *src, float *dst, size_t nelmts);
+static size_t H5T__conv_int64_int32_sse2(const int64_t *src, int32_t *dst, size_t nelmts);
+#endif /* H5T_CONV_HAVE_SSE2 */
+static herr_t H5T__conv_f16(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
+    size_t nelmts, size_t buf_stride, void *buf, hid_t dxpl_id, H5T_conv_f16_t fmt);
+static hbool_t H5T__conv_f16_elmt(const H5T_conv_f16_val_t *src, size_t src_size,
+    H5T_conv_f16_val_t *dst, size_t dst_size, H5T_conv_f16_t fmt,
+    H5T_conv_except_t *except);
+static uint32_t H5T__conv_f16_widen(uint16_t h, H5T_conv_f16_t fmt);
+static uint16_t H5T__conv_f16_narrow(uint64_t bits, H5T_conv_f16_t fmt);
+#ifdef H5T_HAVE_SSE2
+static size_t H5T__conv_f16_float_sse2(const uint16_t *src, float *dst,
+    size_t nelmts, H5T_conv_f16_t fmt);
+static size_t H5T__conv_float_f16_sse2(const float *src, uint16_t *dst,
+    size_t nelmts, H5T_conv_f16_t fmt);
+#endif /* H5T_HAVE_SSE2 */
 
 
 /*********************/
@@ -1178,6 +1268,15 @@ H5T__conv_order_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
             } /* end if */
 
             buf_stride = buf_stride ? buf_stride : src->shared->size;
+
+            /* Swap a packed run with SIMD instructions, leaving the loops
+             * below to finish the elements it doesn't cover */
+            if(buf_stride == src->shared->size) {
+                i = H5T__conv_swap_packed(buf, buf_stride, nelmts);
+                buf += i * buf_stride;
+                nelmts -= i;
+            } /* end if */
+
             switch(src->shared->size) {
                 case 1:
                     /*no-op*/
@@ -1514,8 +1613,6 @@ H5T__conv_order(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
     uint8_t	*buf = (uint8_t*)_buf;
     H5T_t	*src = NULL;
     H5T_t	*dst = NULL;
-    size_t	i;
-    size_t	j, md;
     herr_t      ret_value = SUCCEED;       /* Return value */
 
     FUNC_ENTER_PACKAGE
@@ -1574,10 +1671,7 @@ H5T__conv_order(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
                 HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
 
             buf_stride = buf_stride ? buf_stride : src->shared->size;
-            md = src->shared->size / 2;
-            for(i = 0; i < nelmts; i++, buf += buf_stride)
-                for(j = 0; j < md; j++)
-                    H5_SWAP_BYTES(buf, j, src->shared->size - (j + 1));
+            H5T__conv_swap(buf, src->shared->size, nelmts, buf_stride);
             break;
 
         case H5T_CONV_FREE:
@@ -1592,6 +1686,117 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__conv_order() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_swap_packed
+ *
+ * Purpose:	Reverse the byte order of a run of packed 2, 4, 8 or 16 byte
+ *              elements with SIMD shuffles, sixteen bytes at a time.  SSE2
+ *              has no byte shuffle, so the bytes of each 16-bit word are
+ *              swapped with shifts and then the words are reversed within
+ *              each element.
+ *
+ * Return:	The number of elements swapped, which is zero when there is
+ *              no kernel for this element size or platform.
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_swap_packed(uint8_t *buf, size_t size, size_t nelmts)
+{
+    size_t nbytes = 0;          /* Number of bytes swapped */
+
+    FUNC_ENTER_STATIC_NOERR
+
+#ifdef H5T_HAVE_SSE2
+    {
+        size_t total = (nelmts * size) & ~(size_t)15;
+        __m128i v;
+
+        switch(size) {
+            case 2:
+                for(/*void*/; nbytes < total; nbytes += 16) {
+                    v = _mm_loadu_si128((const __m128i *)(buf + nbytes));
+                    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+                    _mm_storeu_si128((__m128i *)(buf + nbytes), v);
+                } /* end for */
+                break;
+
+            case 4:
+                for(/*void*/; nbytes < total; nbytes += 16) {
+                    v = _mm_loadu_si128((const __m128i *)(buf + nbytes));
+                    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+                    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+                    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+                    _mm_storeu_si128((__m128i *)(buf + nbytes), v);
+                } /* end for */
+                break;
+
+            case 8:
+                for(/*void*/; nbytes < total; nbytes += 16) {
+                    v = _mm_loadu_si128((const __m128i *)(buf + nbytes));
+                    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+                    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+                    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+                    _mm_storeu_si128((__m128i *)(buf + nbytes), v);
+                } /* end for */
+                break;
+
+            case 16:
+                for(/*void*/; nbytes < total; nbytes += 16) {
+                    v = _mm_loadu_si128((const __m128i *)(buf + nbytes));
+                    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+                    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+                    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+                    v = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+                    _mm_storeu_si128((__m128i *)(buf + nbytes), v);
+                } /* end for */
+                break;
+
+            default:
+                break;
+        } /* end switch */
+    }
+#endif /* H5T_HAVE_SSE2 */
+
+    FUNC_LEAVE_NOAPI(nbytes ? nbytes / size : 0)
+} /* end H5T__conv_swap_packed() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_swap
+ *
+ * Purpose:	Reverse the byte order of NELMTS elements of SIZE bytes
+ *              found every BUF_STRIDE bytes in BUF, using the SIMD kernel
+ *              when the elements are packed.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__conv_swap(uint8_t *buf, size_t size, size_t nelmts, size_t buf_stride)
+{
+    size_t	md = size / 2;
+    size_t	i, j;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(buf_stride == size) {
+        i = H5T__conv_swap_packed(buf, size, nelmts);
+        buf += i * size;
+        nelmts -= i;
+    } /* end if */
+
+    for(i = 0; i < nelmts; i++, buf += buf_stride)
+        for(j = 0; j < md; j++)
+            H5_SWAP_BYTES(buf, j, size - (j + 1));
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__conv_swap() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5T__conv_b_b
@@ -1885,6 +2090,7 @@ H5T_conv_struct_free(H5T_conv_struct_t *priv)
     H5MM_xfree(src_memb_id);
     H5MM_xfree(dst_memb_id);
     H5MM_xfree(priv->memb_path);
+    H5MM_xfree(priv->copy_run);
 
     FUNC_LEAVE_NOAPI((H5T_conv_struct_t *)H5MM_xfree(priv))
 } /* end H5T_conv_struct_free() */
@@ -2076,6 +2282,75 @@ H5T_conv_struct_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata, hid_t dxpl_id)
             * the case should have been handled as noop earlier in H5Dio.c. */
         {;}
 
+    /*
+     * Build the copy plan: the members which need no conversion, merged
+     * into runs where they are adjacent in both the source and the
+     * destination, so each run is one memcpy for each element.
+     */
+    H5MM_xfree(priv->copy_run);
+    priv->copy_run = NULL;
+    priv->ncopy_runs = 0;
+    for(i = 0; i < src_nmembs; i++) {
+        H5T_cmemb_t *src_memb = src->shared->u.compnd.memb + i;
+        H5T_cmemb_t *dst_memb;
+        H5T_conv_struct_run_t *run;
+
+        if(src2dst[i] < 0 || !priv->memb_path[i]->is_noop)
+            continue;
+        dst_memb = dst->shared->u.compnd.memb + src2dst[i];
+        HDassert(src_memb->size == dst_memb->size);
+        if(NULL == priv->copy_run &&
+                NULL == (priv->copy_run = (H5T_conv_struct_run_t *)H5MM_malloc(src_nmembs * sizeof(H5T_conv_struct_run_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+
+        /* Extend the last run if this member follows it in both types */
+        if(priv->ncopy_runs > 0) {
+            run = priv->copy_run + priv->ncopy_runs - 1;
+            if(run->src_offset + run->len == src_memb->offset &&
+                    run->dst_offset + run->len == dst_memb->offset) {
+                run->len += src_memb->size;
+                continue;
+            } /* end if */
+        } /* end if */
+        run = priv->copy_run + priv->ncopy_runs++;
+        run->src_offset = src_memb->offset;
+        run->dst_offset = dst_memb->offset;
+        run->len = src_memb->size;
+    } /* end for */
+
+    /* Check for structs with the same layout whose members only differ in
+     * byte order, which can be converted by swapping bytes in place.  When
+     * all the members have the same size and fill the struct, the whole
+     * buffer can be swapped as one array of members.
+     */
+    priv->swap_only = (hbool_t)(src_nmembs == dst_nmembs && src->shared->size == dst->shared->size);
+    priv->swap_size = 0;
+    if(priv->swap_only) {
+        size_t tile_end = 0;    /* End of the members tiling the struct */
+
+        for(i = 0; i < src_nmembs; i++) {
+            H5T_cmemb_t *src_memb = src->shared->u.compnd.memb + i;
+            H5T_cmemb_t *dst_memb = dst->shared->u.compnd.memb + i;
+            H5T_class_t memb_class = src_memb->type->shared->type;
+
+            if(src2dst[i] != (int)i || src_memb->offset != dst_memb->offset ||
+                    src_memb->size != dst_memb->size ||
+                    !(priv->memb_path[i]->is_noop ||
+                      ((memb_class == H5T_INTEGER || memb_class == H5T_FLOAT ||
+                              memb_class == H5T_BITFIELD) &&
+                       (priv->memb_path[i]->func == H5T__conv_order_opt ||
+                        priv->memb_path[i]->func == H5T__conv_order)))) {
+                priv->swap_only = FALSE;
+                break;
+            } /* end if */
+            if(src_memb->offset == tile_end && src_memb->size == src->shared->u.compnd.memb[0].size &&
+                    (!priv->memb_path[i]->is_noop || 1 == src_memb->size))
+                tile_end += src_memb->size;
+        } /* end for */
+        if(priv->swap_only && tile_end == src->shared->size)
+            priv->swap_size = src->shared->u.compnd.memb[0].size;
+    } /* end if */
+
     cdata->recalc = FALSE;
 
 done:
@@ -2258,7 +2533,8 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
                     dst_memb = dst->shared->u.compnd.memb + src2dst[u];
 
                     if(dst_memb->size <= src_memb->size) {
-                        if(H5T_convert(priv->memb_path[u], priv->src_memb_id[u],
+                        if(!priv->memb_path[u]->is_noop &&
+                                H5T_convert(priv->memb_path[u], priv->src_memb_id[u],
                                 priv->dst_memb_id[src2dst[u]],
                                 (size_t)1, (size_t)0, (size_t)0, /*no striding (packed array)*/
                                 xbuf + src_memb->offset, xbkg + dst_memb->offset,
@@ -2449,6 +2725,12 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
             priv = (H5T_conv_struct_t *)(cdata->priv);
             src2dst = priv->src2dst;
 
+            /* Structs which only need their bytes swapped are converted in
+             * place, so the padding between members is kept from the source
+             * rather than taken from a background buffer */
+            if(priv->swap_only)
+                cdata->need_bkg = H5T_BKG_NO;
+
             /*
              * If the destination type is not larger than the source type then
              * this conversion function is guaranteed to work (provided all
@@ -2505,7 +2787,6 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
             priv = (H5T_conv_struct_t *)(cdata->priv);
             HDassert(priv);
             src2dst = priv->src2dst;
-            HDassert(bkg && cdata->need_bkg);
 
             /*
              * Insure that members are sorted.
@@ -2513,6 +2794,29 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
             H5T__sort_value(src, NULL);
             H5T__sort_value(dst, NULL);
 
+            /*
+             * Swap the bytes of structs whose members only differ in byte
+             * order in place, as one array of members when they fill the
+             * struct and are packed, otherwise one member at a time.
+             */
+            if(priv->swap_only) {
+                if(priv->swap_size && (!buf_stride || buf_stride == src->shared->size))
+                    H5T__conv_swap(buf, priv->swap_size, nelmts * (src->shared->size / priv->swap_size), priv->swap_size);
+                else {
+                    if(!buf_stride)
+                        buf_stride = src->shared->size;
+                    for(u = 0; u < src->shared->u.compnd.nmembs; u++) {
+                        src_memb = src->shared->u.compnd.memb + u;
+                        if(!priv->memb_path[u]->is_noop)
+                            H5T__conv_swap(buf + src_memb->offset, src_memb->size, nelmts, buf_stride);
+                    } /* end for */
+                } /* end else */
+                break;
+            } /* end if */
+            if(NULL == bkg)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_BADVALUE, FAIL, "no background buffer")
+            HDassert(cdata->need_bkg);
+
             /*
              * Calculate strides. If BUF_STRIDE is non-zero then convert one
              * data element at every BUF_STRIDE bytes through the main buffer
@@ -2547,6 +2851,20 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
                 } /* end for */
             } /* end if */
             else {
+                /*
+                 * Copy the members which need no conversion to the bkg buffer
+                 * first, in runs of adjacent members, before the members moved
+                 * below overwrite them in the buffer.
+                 */
+                if(priv->ncopy_runs > 0)
+                    for(xbuf = buf, xbkg = bkg, elmtno = 0; elmtno < nelmts; elmtno++) {
+                        for(u = 0; u < priv->ncopy_runs; u++)
+                            HDmemmove(xbkg + priv->copy_run[u].dst_offset,
+                                    xbuf + priv->copy_run[u].src_offset, priv->copy_run[u].len);
+                        xbuf += buf_stride;
+                        xbkg += bkg_stride;
+                    } /* end for */
+
                 /*
                  * For each member where the destination is not larger than the
                  * source, stride through all the elements converting only that member
@@ -2555,8 +2873,8 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
                  * left as possible in the buffer.
                  */
                 for(u = 0, offset = 0; u < src->shared->u.compnd.nmembs; u++) {
-                    if(src2dst[u] < 0)
-                        continue; /*subsetting*/
+                    if(src2dst[u] < 0 || priv->memb_path[u]->is_noop)
+                        continue; /*subsetting or copied above*/
                     src_memb = src->shared->u.compnd.memb + u;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[u];
 
@@ -2616,11 +2934,14 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
                 buf_stride = dst->shared->size;
 
             /* Move background buffer into result buffer */
-            for(xbuf = buf, xbkg = bkg, elmtno = 0; elmtno < nelmts; elmtno++) {
-                HDmemmove(xbuf, xbkg, dst->shared->size);
-                xbuf += buf_stride;
-                xbkg += bkg_stride;
-            } /* end for */
+            if(buf_stride == dst->shared->size && bkg_stride == dst->shared->size)
+                HDmemmove(buf, bkg, nelmts * dst->shared->size);
+            else
+                for(xbuf = buf, xbkg = bkg, elmtno = 0; elmtno < nelmts; elmtno++) {
+                    HDmemmove(xbuf, xbkg, dst->shared->size);
+                    xbuf += buf_stride;
+                    xbkg += bkg_stride;
+                } /* end for */
             break;
 
         default:
@@ -7272,6 +7593,539 @@ H5T__conv_ldouble_double (hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
 }
 #endif /* H5_SIZEOF_LONG_DOUBLE != 0 */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_f16_widen
+ *
+ * Purpose:	Widen the bits of a 16-bit floating-point value to the
+ *              bits of the float with the same value.  Every 16-bit value
+ *              is exact as a float.  Half-precision denormalized values
+ *              are normalized and NaN payloads are kept.
+ *
+ * Return:	The float's bits
+ *
+ *-------------------------------------------------------------------------
+ */
+static uint32_t
+H5T__conv_f16_widen(uint16_t h, H5T_conv_f16_t fmt)
+{
+    uint32_t    sign;                   /* Sign bit, in place for a float */
+    uint32_t    mant;                   /* Half-precision mantissa */
+    int         expo;                   /* Half-precision biased exponent */
+    uint32_t    ret_value;              /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* A bfloat16 is a float with the low 16 bits of its mantissa dropped */
+    if(fmt == H5T_CONV_F16_BFLOAT16)
+        HGOTO_DONE((uint32_t)h << 16)
+
+    sign = (uint32_t)(h & 0x8000) << 16;
+    expo = (h >> 10) & 0x1f;
+    mant = h & 0x3ffu;
+    if(expo == 0x1f)
+        ret_value = sign | 0x7f800000u | (mant << 13);
+    else if(expo == 0 && mant == 0)
+        ret_value = sign;
+    else {
+        if(expo == 0) {
+            /* Normalize the denormalized value */
+            expo = 1;
+            while(!(mant & 0x400)) {
+                mant <<= 1;
+                expo--;
+            } /* end while */
+            mant &= 0x3ffu;
+        } /* end if */
+        ret_value = sign | ((uint32_t)(expo + 127 - 15) << 23) | (mant << 13);
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_f16_widen() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_f16_narrow
+ *
+ * Purpose:	Narrow the bits of a double to a 16-bit floating-point
+ *              value, rounding to nearest with ties to even.  Values too
+ *              large become infinities and NaNs become quiet NaNs.
+ *
+ *              Floats are narrowed through the double of the same value,
+ *              so they're rounded only once.
+ *
+ * Return:	The 16-bit value's bits
+ *
+ *-------------------------------------------------------------------------
+ */
+static uint16_t
+H5T__conv_f16_narrow(uint64_t bits, H5T_conv_f16_t fmt)
+{
+    unsigned    msize = (fmt == H5T_CONV_F16_HALF) ? 10 : 7;    /* Mantissa bits */
+    int         emax = (fmt == H5T_CONV_F16_HALF) ? 0x1f : 0xff;  /* All-ones exponent */
+    int         ebias = emax >> 1;      /* Exponent bias */
+    uint32_t    sign = (uint32_t)(bits >> 48) & 0x8000;
+    int         dexp = (int)((bits >> 52) & 0x7ff);
+    uint64_t    mant = bits & (((uint64_t)1 << 52) - 1);
+    uint64_t    rest, half;             /* Bits rounded off and half an ulp */
+    unsigned    shift;                  /* Number of mantissa bits dropped */
+    int         expo;                   /* Biased exponent of the result */
+    uint32_t    r;                      /* Result without the sign */
+    uint16_t    ret_value;              /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Infinity, or NaN made quiet */
+    if(dexp == 0x7ff)
+        HGOTO_DONE((uint16_t)(sign | ((uint32_t)emax << msize) | (mant ? (1u << (msize - 1)) : 0)))
+
+    expo = dexp - 1023 + ebias;
+    if(expo >= emax)
+        HGOTO_DONE((uint16_t)(sign | ((uint32_t)emax << msize)))
+    if(expo > 0) {
+        shift = 52 - msize;
+        r = ((uint32_t)expo << msize) | (uint32_t)(mant >> shift);
+    } /* end if */
+    else {
+        /* Less than half the smallest denormalized value rounds to zero */
+        if(dexp == 0 || expo < -(int)msize)
+            HGOTO_DONE((uint16_t)sign)
+
+        /* Denormalized result: shift the implied bit into the mantissa */
+        mant |= (uint64_t)1 << 52;
+        shift = 52 - msize + (unsigned)(1 - expo);
+        r = (uint32_t)(mant >> shift);
+    } /* end else */
+
+    /* Round to nearest even.  A carry out of the mantissa increments the
+     * exponent, turning the largest denormalized value into the smallest
+     * normalized one and the largest finite value into infinity. */
+    rest = mant & (((uint64_t)1 << shift) - 1);
+    half = (uint64_t)1 << (shift - 1);
+    if(rest > half || (rest == half && (r & 1)))
+        r++;
+    ret_value = (uint16_t)(sign | r);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_f16_narrow() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_f16_elmt
+ *
+ * Purpose:	Convert one element between a 16-bit floating-point format
+ *              and a native float or double, writing the default result
+ *              to DST.  Sources which are infinities or NaNs raise the
+ *              exceptions H5T__conv_f_f raises, and finite values too
+ *              large for a 16-bit destination raise
+ *              H5T_CONV_EXCEPT_RANGE_HI, whatever their sign, as they do
+ *              there.
+ *
+ * Return:	TRUE if the element raised an exception, stored in EXCEPT
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5T__conv_f16_elmt(const H5T_conv_f16_val_t *src, size_t src_size,
+    H5T_conv_f16_val_t *dst, size_t dst_size, H5T_conv_f16_t fmt,
+    H5T_conv_except_t *except)
+{
+    uint16_t    emask = (fmt == H5T_CONV_F16_HALF) ? 0x7c00 : 0x7f80;    /* 16-bit exponent bits */
+    hbool_t     ret_value = FALSE;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(src_size == 2) {
+        uint32_t bits = H5T__conv_f16_widen(src->h, fmt);
+        float f;
+
+        HDmemcpy(&f, &bits, sizeof(f));
+        if(dst_size == sizeof(float))
+            dst->f = f;
+        else
+            dst->d = (double)f;
+
+        if((src->h & emask) == emask) {
+            if(src->h & 0x7fff & ~emask)
+                *except = H5T_CONV_EXCEPT_NAN;
+            else
+                *except = (src->h & 0x8000) ? H5T_CONV_EXCEPT_NINF : H5T_CONV_EXCEPT_PINF;
+            ret_value = TRUE;
+        } /* end if */
+    } /* end if */
+    else {
+        double d = (src_size == sizeof(float)) ? (double)src->f : src->d;
+        uint64_t bits;
+
+        HDmemcpy(&bits, &d, sizeof(bits));
+        dst->h = H5T__conv_f16_narrow(bits, fmt);
+
+        if((bits & 0x7ff0000000000000ULL) == 0x7ff0000000000000ULL) {
+            if(bits & 0x000fffffffffffffULL)
+                *except = H5T_CONV_EXCEPT_NAN;
+            else
+                *except = (bits >> 63) ? H5T_CONV_EXCEPT_NINF : H5T_CONV_EXCEPT_PINF;
+            ret_value = TRUE;
+        } /* end if */
+        else if((dst->h & emask) == emask) {
+            *except = H5T_CONV_EXCEPT_RANGE_HI;
+            ret_value = TRUE;
+        } /* end if */
+    } /* end else */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_f16_elmt() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_f16
+ *
+ * Purpose:	Convert between a 16-bit floating-point format, IEEE half
+ *              precision or bfloat16, and native `float' or `double',
+ *              all in native byte order.  The hard conversions of both
+ *              formats share this.
+ *
+ *              Packed elements with no exception callback on the DXPL
+ *              are converted to and from floats with SSE2 where it's
+ *              available, and one at a time otherwise.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__conv_f16(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
+    size_t buf_stride, void *buf, hid_t dxpl_id, H5T_conv_f16_t fmt)
+{
+    H5T_t	*st, *dt;               /* Source and destination datatypes */
+    H5P_genplist_t *plist;              /* Property list pointer */
+    H5T_conv_cb_t cb_struct;            /* Conversion exception callback */
+    H5T_conv_f16_val_t src_val, dst_val, tmp_val;   /* Converted element */
+    H5T_conv_except_t except;           /* Exception raised by an element */
+    size_t      src_size, dst_size;     /* Sizes of the datatypes */
+    size_t      s_stride, d_stride;     /* Source and destination strides */
+    size_t      nsimd = 0;              /* Number of elements converted with SSE2 */
+    size_t      elmtno;                 /* Element number */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    switch(cdata->command) {
+        case H5T_CONV_INIT:
+            if(NULL == (st = (H5T_t *)H5I_object(src_id)) || NULL == (dt = (H5T_t *)H5I_object(dst_id)))
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "unable to dereference datatype object ID")
+            if(!(st->shared->size == 2 && (dt->shared->size == sizeof(float) || dt->shared->size == sizeof(double)))
+                    && !(dt->shared->size == 2 && (st->shared->size == sizeof(float) || st->shared->size == sizeof(double))))
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "disagreement about datatype size")
+            cdata->need_bkg = H5T_BKG_NO;
+            break;
+
+        case H5T_CONV_FREE:
+            break;
+
+        case H5T_CONV_CONV:
+            if(NULL == (st = (H5T_t *)H5I_object(src_id)) || NULL == (dt = (H5T_t *)H5I_object(dst_id)))
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "unable to dereference datatype object ID")
+            src_size = st->shared->size;
+            dst_size = dt->shared->size;
+
+            /* Get the plist structure */
+            if(NULL == (plist = H5P_object_verify(dxpl_id, H5P_DATASET_XFER)))
+                HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find property list for ID")
+
+            /* Get conversion exception callback property */
+            if(H5P_get(plist, H5D_XFER_CONV_CB_NAME, &cb_struct) < 0)
+                HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get conversion exception callback")
+#ifndef H5_WANT_DCONV_EXCEPTION
+            cb_struct.func = NULL;
+#endif /* H5_WANT_DCONV_EXCEPTION */
+
+            if(buf_stride)
+                s_stride = d_stride = buf_stride;
+            else {
+                s_stride = src_size;
+                d_stride = dst_size;
+            } /* end else */
+
+#ifdef H5T_HAVE_SSE2
+            if(!cb_struct.func && !buf_stride && (src_size == sizeof(float) || dst_size == sizeof(float)))
+                nsimd = nelmts & ~(size_t)7;
+#endif /* H5T_HAVE_SSE2 */
+
+            /* Widening packed elements in place overwrites the sources
+             * following each one, so walk the buffer from its end, with
+             * the SSE2 part (at the buffer's start) last.  Otherwise walk
+             * forward, with the SSE2 part first. */
+            if(d_stride > s_stride)
+                elmtno = nelmts;
+            else {
+#ifdef H5T_HAVE_SSE2
+                if(nsimd)
+                    H5T__conv_float_f16_sse2((const float *)buf, (uint16_t *)buf, nsimd, fmt);
+#endif /* H5T_HAVE_SSE2 */
+                elmtno = nsimd;
+            } /* end else */
+
+            while(d_stride > s_stride ? elmtno > nsimd : elmtno < nelmts) {
+                size_t u = (d_stride > s_stride) ? --elmtno : elmtno++;
+
+                HDmemcpy(&src_val, (uint8_t *)buf + u * s_stride, src_size);
+                if(H5T__conv_f16_elmt(&src_val, src_size, &dst_val, dst_size, fmt, &except) && cb_struct.func) {
+                    H5T_conv_ret_t except_ret;  /* Return of callback function */
+
+                    except_ret = (cb_struct.func)(except, src_id, dst_id, &src_val, &tmp_val, cb_struct.user_data);
+                    if(except_ret == H5T_CONV_ABORT)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "can't handle conversion exception")
+                    else if(except_ret == H5T_CONV_HANDLED)
+                        dst_val = tmp_val;
+                } /* end if */
+                HDmemcpy((uint8_t *)buf + u * d_stride, &dst_val, dst_size);
+            } /* end while */
+
+#ifdef H5T_HAVE_SSE2
+            if(d_stride > s_stride && nsimd)
+                H5T__conv_f16_float_sse2((const uint16_t *)buf, (float *)buf, nsimd, fmt);
+#endif /* H5T_HAVE_SSE2 */
+            break;
+
+        default:
+            HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, FAIL, "unknown conversion command")
+    } /* end switch */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_f16() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_half_float
+ *
+ * Purpose:	Convert IEEE half-precision floating-point to native `float'
+ *		in native byte order.  This is a fast special case.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__conv_half_float(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
+    size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
+    void *buf, void H5_ATTR_UNUSED *bkg, hid_t dxpl_id)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if(H5T__conv_f16(src_id, dst_id, cdata, nelmts, buf_stride, buf, dxpl_id, H5T_CONV_F16_HALF) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "unable to convert data")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_half_float() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_half_double
+ *
+ * Purpose:	Convert IEEE half-precision floating-point to native `double'
+ *		in native byte order.  This is a fast special case.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__conv_half_double(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
+    size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
+    void *buf, void H5_ATTR_UNUSED *bkg, hid_t dxpl_id)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if(H5T__conv_f16(src_id, dst_id, cdata, nelmts, buf_stride, buf, dxpl_id, H5T_CONV_F16_HALF) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "unable to convert data")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_half_double() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_float_half
+ *
+ * Purpose:	Convert native `float' to IEEE half-precision floating-point
+ *		in native byte order.  This is a fast special case.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__conv_float_half(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
+    size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
+    void *buf, void H5_ATTR_UNUSED *bkg, hid_t dxpl_id)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if(H5T__conv_f16(src_id, dst_id, cdata, nelmts, buf_stride, buf, dxpl_id, H5T_CONV_F16_HALF) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "unable to convert data")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_float_half() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_double_half
+ *
+ * Purpose:	Convert native `double' to IEEE half-precision floating-point
+ *		in native byte order.  This is a fast special case.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__conv_double_half(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
+    size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
+    void *buf, void H5_ATTR_UNUSED *bkg, hid_t dxpl_id)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if(H5T__conv_f16(src_id, dst_id, cdata, nelmts, buf_stride, buf, dxpl_id, H5T_CONV_F16_HALF) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "unable to convert data")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_double_half() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_bfloat16_float
+ *
+ * Purpose:	Convert bfloat16 to native `float'
+ *		in native byte order.  This is a fast special case.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__conv_bfloat16_float(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
+    size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
+    void *buf, void H5_ATTR_UNUSED *bkg, hid_t dxpl_id)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if(H5T__conv_f16(src_id, dst_id, cdata, nelmts, buf_stride, buf, dxpl_id, H5T_CONV_F16_BFLOAT16) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "unable to convert data")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_bfloat16_float() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_bfloat16_double
+ *
+ * Purpose:	Convert bfloat16 to native `double'
+ *		in native byte order.  This is a fast special case.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__conv_bfloat16_double(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
+    size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
+    void *buf, void H5_ATTR_UNUSED *bkg, hid_t dxpl_id)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if(H5T__conv_f16(src_id, dst_id, cdata, nelmts, buf_stride, buf, dxpl_id, H5T_CONV_F16_BFLOAT16) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "unable to convert data")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_bfloat16_double() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_float_bfloat16
+ *
+ * Purpose:	Convert native `float' to bfloat16
+ *		in native byte order.  This is a fast special case.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__conv_float_bfloat16(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
+    size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
+    void *buf, void H5_ATTR_UNUSED *bkg, hid_t dxpl_id)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if(H5T__conv_f16(src_id, dst_id, cdata, nelmts, buf_stride, buf, dxpl_id, H5T_CONV_F16_BFLOAT16) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "unable to convert data")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_float_bfloat16() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_double_bfloat16
+ *
+ * Purpose:	Convert native `double' to bfloat16
+ *		in native byte order.  This is a fast special case.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__conv_double_bfloat16(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
+    size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
+    void *buf, void H5_ATTR_UNUSED *bkg, hid_t dxpl_id)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if(H5T__conv_f16(src_id, dst_id, cdata, nelmts, buf_stride, buf, dxpl_id, H5T_CONV_F16_BFLOAT16) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "unable to convert data")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_double_bfloat16() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5T__conv_schar_float
@@ -9855,6 +10709,244 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__conv_i_f() */
 
+#ifdef H5T_CONV_HAVE_SSE2
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_double_float_sse2
+ *
+ * Purpose:	Convert packed doubles to floats with SSE2, four at a time,
+ *              with values out of range for a float becoming infinities,
+ *              as H5T_CONV_Ff_NOEX_CORE does.  The buffers may be the
+ *              same.
+ *
+ * Return:	The number of elements converted (a multiple of 4)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_double_float_sse2(const double *src, float *dst, size_t nelmts)
+{
+    const __m128d max = _mm_set1_pd((double)FLT_MAX);
+    const __m128d min = _mm_set1_pd(-(double)FLT_MAX);
+    const __m128 pos_inf = _mm_set1_ps(H5T_NATIVE_FLOAT_POS_INF_g);
+    const __m128 neg_inf = _mm_set1_ps(H5T_NATIVE_FLOAT_NEG_INF_g);
+    size_t u;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u + 4 <= nelmts; u += 4) {
+        __m128d s0 = _mm_loadu_pd(src + u);
+        __m128d s1 = _mm_loadu_pd(src + u + 2);
+        __m128 d = _mm_movelh_ps(_mm_cvtpd_ps(s0), _mm_cvtpd_ps(s1));
+        __m128 hi, lo;
+
+        /* (Masks for pairs of doubles, narrowed to masks for floats) */
+        hi = _mm_shuffle_ps(_mm_castpd_ps(_mm_cmpgt_pd(s0, max)),
+                _mm_castpd_ps(_mm_cmpgt_pd(s1, max)), _MM_SHUFFLE(2, 0, 2, 0));
+        lo = _mm_shuffle_ps(_mm_castpd_ps(_mm_cmplt_pd(s0, min)),
+                _mm_castpd_ps(_mm_cmplt_pd(s1, min)), _MM_SHUFFLE(2, 0, 2, 0));
+        d = _mm_or_ps(_mm_and_ps(hi, pos_inf), _mm_andnot_ps(hi, d));
+        d = _mm_or_ps(_mm_and_ps(lo, neg_inf), _mm_andnot_ps(lo, d));
+        _mm_storeu_ps(dst + u, d);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__conv_double_float_sse2() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_int64_int32_sse2
+ *
+ * Purpose:	Convert packed 64-bit integers to 32-bit integers with SSE2,
+ *              four at a time, with values out of range clamped to the
+ *              smallest or largest 32-bit integer, as
+ *              H5T_CONV_Xx_NOEX_CORE does.  The buffers may be the same.
+ *
+ * Return:	The number of elements converted (a multiple of 4)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_int64_int32_sse2(const int64_t *src, int32_t *dst, size_t nelmts)
+{
+    const __m128i max = _mm_set1_epi32(0x7fffffff);
+    size_t u;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u + 4 <= nelmts; u += 4) {
+        __m128i s[2], d[2];
+        unsigned v;
+
+        s[0] = _mm_loadu_si128((const __m128i *)(src + u));
+        s[1] = _mm_loadu_si128((const __m128i *)(src + u + 2));
+        for(v = 0; v < 2; v++) {
+            __m128i sign = _mm_srai_epi32(s[v], 31);
+            __m128i in_range, clamped;
+
+            /* A value fits in 32 bits when its high half is the sign
+             * extension of its low half.  Otherwise its high half's sign
+             * picks the limit it's clamped to. */
+            in_range = _mm_cmpeq_epi32(_mm_slli_epi64(sign, 32), s[v]);
+            in_range = _mm_shuffle_epi32(in_range, _MM_SHUFFLE(3, 3, 1, 1));
+            clamped = _mm_xor_si128(_mm_shuffle_epi32(sign, _MM_SHUFFLE(3, 3, 1, 1)), max);
+            d[v] = _mm_or_si128(_mm_and_si128(in_range, s[v]), _mm_andnot_si128(in_range, clamped));
+            d[v] = _mm_shuffle_epi32(d[v], _MM_SHUFFLE(3, 1, 2, 0));
+        } /* end for */
+        _mm_storeu_si128((__m128i *)(dst + u), _mm_unpacklo_epi64(d[0], d[1]));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__conv_int64_int32_sse2() */
+#endif /* H5T_CONV_HAVE_SSE2 */
+
+#ifdef H5T_HAVE_SSE2
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_f16_float_sse2
+ *
+ * Purpose:	Widen packed 16-bit floating-point values to floats with
+ *              SSE2, eight at a time.  Half-precision values are scaled
+ *              by a power of two, which normalizes denormalized values
+ *              exactly, with the exponents of infinities and NaNs fixed
+ *              up afterward.  NELMTS must be a multiple of 8.  The
+ *              buffers may be the same, so this walks them backward.
+ *
+ * Return:	The number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_f16_float_sse2(const uint16_t *src, float *dst, size_t nelmts,
+    H5T_conv_f16_t fmt)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i nosign = _mm_set1_epi32(0x7fff);
+    const __m128i max_finite = _mm_set1_epi32(0x7bff);
+    const __m128 scale = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+    const __m128 infnan_exp = _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+    size_t u;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(nelmts % 8 == 0);
+
+    for(u = nelmts; u > 0; u -= 8) {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + u - 8));
+        __m128i h[2];
+        __m128 d[2];
+        unsigned v;
+
+        if(fmt == H5T_CONV_F16_BFLOAT16) {
+            d[0] = _mm_castsi128_ps(_mm_unpacklo_epi16(zero, s));
+            d[1] = _mm_castsi128_ps(_mm_unpackhi_epi16(zero, s));
+        } /* end if */
+        else {
+            h[0] = _mm_unpacklo_epi16(s, zero);
+            h[1] = _mm_unpackhi_epi16(s, zero);
+            for(v = 0; v < 2; v++) {
+                __m128i expmant = _mm_and_si128(h[v], nosign);
+                __m128i sign = _mm_slli_epi32(_mm_xor_si128(h[v], expmant), 16);
+                __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expmant, 13)), scale);
+                __m128 infnan = _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(expmant, max_finite)), infnan_exp);
+
+                d[v] = _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(sign), infnan));
+            } /* end for */
+        } /* end else */
+
+        _mm_storeu_ps(dst + u - 8, d[0]);
+        _mm_storeu_ps(dst + u - 4, d[1]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nelmts)
+} /* end H5T__conv_f16_float_sse2() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_float_f16_sse2
+ *
+ * Purpose:	Narrow packed floats to a 16-bit floating-point format with
+ *              SSE2, eight at a time, rounding to nearest even as
+ *              H5T__conv_f16_narrow does.  The buffers may be the same.
+ *
+ * Return:	The number of elements converted (a multiple of 8)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_float_f16_sse2(const float *src, uint16_t *dst, size_t nelmts,
+    H5T_conv_f16_t fmt)
+{
+    const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i bf16_round = _mm_set1_epi32(0x7fff);
+    const __m128i bf16_qnan = _mm_set1_epi32(0x7fc0);
+    const __m128i half_overflow = _mm_set1_epi32((127 + 16) << 23);
+    const __m128i half_min_normal = _mm_set1_epi32((127 - 14) << 23);
+    const __m128i half_denorm_magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i half_round = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+    const __m128i half_inf = _mm_set1_epi32(0x7c00);
+    const __m128i half_qnan_bit = _mm_set1_epi32(0x200);
+    size_t u;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u + 8 <= nelmts; u += 8) {
+        __m128i r[2];
+        unsigned v;
+
+        for(v = 0; v < 2; v++) {
+            __m128 f = _mm_loadu_ps(src + u + 4 * v);
+            __m128 nan = _mm_cmpunord_ps(f, f);
+            __m128i sign = _mm_srli_epi32(_mm_castps_si128(_mm_and_ps(f, sign_mask)), 16);
+
+            if(fmt == H5T_CONV_F16_BFLOAT16) {
+                __m128i bits = _mm_castps_si128(f);
+                __m128i odd = _mm_and_si128(_mm_srli_epi32(bits, 16), one);
+
+                r[v] = _mm_srli_epi32(_mm_add_epi32(bits, _mm_add_epi32(bf16_round, odd)), 16);
+                r[v] = _mm_or_si128(_mm_andnot_si128(_mm_castps_si128(nan), r[v]),
+                        _mm_and_si128(_mm_castps_si128(nan), _mm_or_si128(sign, bf16_qnan)));
+            } /* end if */
+            else {
+                __m128 absf = _mm_andnot_ps(sign_mask, f);
+                __m128i abs_bits = _mm_castps_si128(absf);
+                __m128i finite = _mm_cmpgt_epi32(half_overflow, abs_bits);
+                __m128i denorm = _mm_cmpgt_epi32(half_min_normal, abs_bits);
+                __m128i special, denorm_r, norm_r, odd;
+
+                /* Values too large and NaNs */
+                special = _mm_or_si128(half_inf, _mm_and_si128(_mm_castps_si128(nan), half_qnan_bit));
+
+                /* Denormalized results: adding a power of two makes the
+                 * FPU round the mantissa */
+                denorm_r = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absf,
+                        _mm_castsi128_ps(half_denorm_magic))), half_denorm_magic);
+
+                /* Normalized results: rebias the exponent and round the
+                 * mantissa, up on ties when its last kept bit is odd */
+                odd = _mm_and_si128(_mm_srli_epi32(abs_bits, 13), one);
+                norm_r = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(abs_bits, half_round), odd), 13);
+
+                r[v] = _mm_or_si128(_mm_and_si128(denorm, denorm_r), _mm_andnot_si128(denorm, norm_r));
+                r[v] = _mm_or_si128(_mm_and_si128(finite, r[v]), _mm_andnot_si128(finite, special));
+                r[v] = _mm_or_si128(r[v], sign);
+            } /* end else */
+
+            /* Sign-extend the 16-bit results so they pack unsaturated */
+            r[v] = _mm_srai_epi32(_mm_slli_epi32(r[v], 16), 16);
+        } /* end for */
+        _mm_storeu_si128((__m128i *)(dst + u), _mm_packs_epi32(r[0], r[1]));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(u)
+} /* end H5T__conv_float_f16_sse2() */
+#endif /* H5T_HAVE_SSE2 */
+
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5T_reverse_order
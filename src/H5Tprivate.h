@@ -48,6 +48,7 @@
 typedef struct H5T_t H5T_t;
 typedef struct H5T_stats_t H5T_stats_t;
 typedef struct H5T_path_t H5T_path_t;
+typedef struct H5T_vlen_arena_t H5T_vlen_arena_t;
 
 /* How to copy a datatype */
 typedef enum H5T_copy_t {
@@ -124,6 +125,7 @@ H5_DLL H5T_path_t *H5T_path_find(const H5T_t *src, const H5T_t *dst,
     const char *name, H5T_conv_t func, hid_t dxpl_id, hbool_t is_api);
 H5_DLL hbool_t H5T_path_noop(const H5T_path_t *p);
 H5_DLL H5T_bkg_t H5T_path_bkg(const H5T_path_t *p);
+H5_DLL hbool_t H5T_path_concurrent(const H5T_path_t *p);
 H5_DLL H5T_subset_info_t *H5T_path_compound_subset(const H5T_path_t *p);
 H5_DLL herr_t H5T_convert(H5T_path_t *tpath, hid_t src_id, hid_t dst_id,
     size_t nelmts, size_t buf_stride, size_t bkg_stride, void *buf, void *bkg,
@@ -131,6 +133,12 @@ H5_DLL herr_t H5T_convert(H5T_path_t *tpath, hid_t src_id, hid_t dst_id,
 H5_DLL herr_t H5T_vlen_reclaim(void *elem, hid_t type_id, unsigned ndim, const hsize_t *point, void *_op_data);
 H5_DLL herr_t H5T_vlen_reclaim_elmt(void *elem, H5T_t *dt, hid_t dxpl_id);
 H5_DLL herr_t H5T_vlen_get_alloc_info(hid_t dxpl_id, H5T_vlen_alloc_info_t **vl_alloc_info);
+H5_DLL H5T_vlen_arena_t *H5T_vlen_arena_create(size_t block_size);
+H5_DLL H5T_vlen_arena_t *H5T_vlen_arena_incr_ref(H5T_vlen_arena_t *arena);
+H5_DLL herr_t H5T_vlen_arena_decr_ref(H5T_vlen_arena_t *arena);
+H5_DLL herr_t H5T_vlen_arena_release(H5T_vlen_arena_t *arena);
+H5_DLL herr_t H5T_vlen_arena_get_info(const H5T_vlen_arena_t *arena,
+    size_t *block_size, size_t *nblocks, size_t *nbytes);
 H5_DLL htri_t H5T_set_loc(H5T_t *dt, H5F_t *f, H5T_loc_t loc);
 H5_DLL htri_t H5T_is_sensible(const H5T_t *dt);
 H5_DLL uint32_t H5T_hash(H5F_t * file, const H5T_t *dt);
@@ -225,15 +225,28 @@ typedef H5T_conv_ret_t (*H5T_conv_except_func_t)(H5T_conv_except_t except_type,
 /*
  * The IEEE floating point types in various byte orders.
  */
+#define H5T_IEEE_F16BE		(H5OPEN H5T_IEEE_F16BE_g)
+#define H5T_IEEE_F16LE		(H5OPEN H5T_IEEE_F16LE_g)
 #define H5T_IEEE_F32BE		(H5OPEN H5T_IEEE_F32BE_g)
 #define H5T_IEEE_F32LE		(H5OPEN H5T_IEEE_F32LE_g)
 #define H5T_IEEE_F64BE		(H5OPEN H5T_IEEE_F64BE_g)
 #define H5T_IEEE_F64LE		(H5OPEN H5T_IEEE_F64LE_g)
+H5_DLLVAR hid_t H5T_IEEE_F16BE_g;
+H5_DLLVAR hid_t H5T_IEEE_F16LE_g;
 H5_DLLVAR hid_t H5T_IEEE_F32BE_g;
 H5_DLLVAR hid_t H5T_IEEE_F32LE_g;
 H5_DLLVAR hid_t H5T_IEEE_F64BE_g;
 H5_DLLVAR hid_t H5T_IEEE_F64LE_g;
 
+/*
+ * The bfloat16 floating point types (the upper half of an IEEE 4-byte
+ * float) in various byte orders.
+ */
+#define H5T_FLOAT_BFLOAT16BE	(H5OPEN H5T_FLOAT_BFLOAT16BE_g)
+#define H5T_FLOAT_BFLOAT16LE	(H5OPEN H5T_FLOAT_BFLOAT16LE_g)
+H5_DLLVAR hid_t H5T_FLOAT_BFLOAT16BE_g;
+H5_DLLVAR hid_t H5T_FLOAT_BFLOAT16LE_g;
+
 /*
  * These are "standard" types.  For instance, signed (2's complement) and
  * unsigned integers of various sizes and byte orders.
@@ -22,13 +22,43 @@
 #include "H5private.h"		/* Generic Functions			*/
 #include "H5Dprivate.h"		/* Dataset functions			*/
 #include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5FLprivate.h"	/* Free Lists				*/
 #include "H5HGprivate.h"	/* Global Heaps				*/
 #include "H5Iprivate.h"		/* IDs			  		*/
 #include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Pprivate.h"		/* Property lists			*/
 #include "H5Tpkg.h"		/* Datatypes				*/
 
+/* Local macros */
+
+/* Alignment of VL data placed in an arena */
+#define H5T_VLEN_ARENA_ALIGN        16
+#define H5T_VLEN_ARENA_ALIGNED(S)   (((S) + (H5T_VLEN_ARENA_ALIGN - 1)) & ~((size_t)H5T_VLEN_ARENA_ALIGN - 1))
+
+/* Local typedefs */
+
+/* One contiguous block of VL data in an arena.  The data follows the header. */
+typedef struct H5T_vlen_arena_blk_t {
+    struct H5T_vlen_arena_blk_t *next;  /* Next (older) block in the arena */
+    size_t size;                /* Bytes of data the block can hold */
+    size_t used;                /* Bytes of data handed out so far */
+} H5T_vlen_arena_blk_t;
+
+/* Size of a block header, padded so the block data stays aligned */
+#define H5T_VLEN_ARENA_HDR_SIZE     H5T_VLEN_ARENA_ALIGNED(sizeof(H5T_vlen_arena_blk_t))
+
+/* Arena that holds the VL data read through one dataset transfer property list */
+struct H5T_vlen_arena_t {
+    unsigned nrefs;             /* Number of property lists sharing the arena */
+    size_t block_size;          /* Data size of a regular block */
+    size_t nblocks;             /* Number of blocks allocated */
+    size_t nbytes;              /* Bytes of VL data placed in the arena */
+    H5T_vlen_arena_blk_t *head; /* Block currently being filled */
+};
+
 /* Local functions */
+static void *H5T_vlen_arena_alloc(size_t size, void *info);
+static void H5T_vlen_arena_free(void *mem, void *info);
 static herr_t H5T_vlen_reclaim_recurse(void *elem, const H5T_t *dt, H5MM_free_t free_func, void *free_info);
 static ssize_t H5T_vlen_seq_mem_getlen(const void *_vl);
 static void * H5T_vlen_seq_mem_getptr(void *_vl);
@@ -59,6 +89,9 @@ static H5T_vlen_alloc_info_t H5T_vlen_def_vl_alloc_info ={
     H5D_VLEN_FREE_INFO
 };
 
+/* Declare a free list to manage the H5T_vlen_arena_t struct */
+H5FL_DEFINE_STATIC(H5T_vlen_arena_t);
+
 
 
 /*-------------------------------------------------------------------------
@@ -1179,6 +1212,8 @@ done:
     The VL_ALLOC_INFO pointer should point at already allocated memory to place
     non-default property list info.  If a default property list is used, the
     VL_ALLOC_INFO pointer will be changed to point at the default information.
+    If the property list has a VL data arena, the arena's allocation routines
+    are used instead of the VL memory manager.
  EXAMPLES
  REVISION LOG
 --------------------------------------------------------------------------*/
@@ -1186,6 +1221,7 @@ herr_t
 H5T_vlen_get_alloc_info(hid_t dxpl_id, H5T_vlen_alloc_info_t **vl_alloc_info)
 {
     H5P_genplist_t *plist;              /* DX property list */
+    H5T_vlen_arena_t *arena = NULL;     /* VL data arena */
     herr_t ret_value=SUCCEED;
 
     FUNC_ENTER_NOAPI(FAIL)
@@ -1210,6 +1246,16 @@ H5T_vlen_get_alloc_info(hid_t dxpl_id, H5T_vlen_alloc_info_t **vl_alloc_info)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
         if (H5P_get(plist,H5D_XFER_VLEN_FREE_INFO_NAME,&(*vl_alloc_info)->free_info) < 0)
             HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+        /* Place all VL data in the arena, if one is set */
+        if (H5P_get(plist,H5D_XFER_VLEN_ARENA_NAME,&arena) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+        if(arena) {
+            (*vl_alloc_info)->alloc_func = H5T_vlen_arena_alloc;
+            (*vl_alloc_info)->alloc_info = arena;
+            (*vl_alloc_info)->free_func = H5T_vlen_arena_free;
+            (*vl_alloc_info)->free_info = arena;
+        } /* end if */
     } /* end else */
 
 done:
@@ -1257,3 +1303,224 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5T_vlen_reclaim_elmt */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_create
+ *
+ * Purpose:	Create an empty arena for VL data, which grows in blocks
+ *		of BLOCK_SIZE bytes.  The arena starts with one reference.
+ *
+ * Return:	Success:	Pointer to the new arena
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+H5T_vlen_arena_t *
+H5T_vlen_arena_create(size_t block_size)
+{
+    H5T_vlen_arena_t *arena = NULL;     /* New arena */
+    H5T_vlen_arena_t *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_NOAPI(NULL)
+
+    HDassert(block_size > 0);
+
+    if(NULL == (arena = H5FL_CALLOC(H5T_vlen_arena_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for VL arena")
+    arena->nrefs = 1;
+    arena->block_size = H5T_VLEN_ARENA_ALIGNED(block_size);
+
+    ret_value = arena;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_vlen_arena_create() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_incr_ref
+ *
+ * Purpose:	Add a reference to an arena, when a property list holding
+ *		it is copied.
+ *
+ * Return:	The arena (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+H5T_vlen_arena_t *
+H5T_vlen_arena_incr_ref(H5T_vlen_arena_t *arena)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(arena);
+    HDassert(arena->nrefs > 0);
+
+    arena->nrefs++;
+
+    FUNC_LEAVE_NOAPI(arena)
+} /* end H5T_vlen_arena_incr_ref() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_decr_ref
+ *
+ * Purpose:	Drop a reference to an arena.  The last reference frees
+ *		the arena along with all the VL data placed in it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T_vlen_arena_decr_ref(H5T_vlen_arena_t *arena)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(arena);
+    HDassert(arena->nrefs > 0);
+
+    if(--arena->nrefs == 0) {
+        if(H5T_vlen_arena_release(arena) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTFREE, FAIL, "can't release VL arena")
+        arena = H5FL_FREE(H5T_vlen_arena_t, arena);
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_vlen_arena_decr_ref() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_release
+ *
+ * Purpose:	Free all the VL data placed in an arena at once.  The
+ *		arena stays usable for later reads.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T_vlen_arena_release(H5T_vlen_arena_t *arena)
+{
+    H5T_vlen_arena_blk_t *blk;          /* Block to free */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(arena);
+
+    while(arena->head) {
+        blk = arena->head;
+        arena->head = blk->next;
+        H5MM_xfree(blk);
+    } /* end while */
+    arena->nblocks = 0;
+    arena->nbytes = 0;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T_vlen_arena_release() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_get_info
+ *
+ * Purpose:	Retrieve the block size of an arena and how much VL data
+ *		it currently holds.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T_vlen_arena_get_info(const H5T_vlen_arena_t *arena, size_t *block_size,
+    size_t *nblocks, size_t *nbytes)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(arena);
+
+    if(block_size)
+        *block_size = arena->block_size;
+    if(nblocks)
+        *nblocks = arena->nblocks;
+    if(nbytes)
+        *nbytes = arena->nbytes;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T_vlen_arena_get_info() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_alloc
+ *
+ * Purpose:	VL allocation routine that carves the data out of the
+ *		arena's current block.  A new block is started when the
+ *		current one is full; a request larger than a block gets a
+ *		block of its own, behind the current one so the space left
+ *		there is still used.
+ *
+ * Return:	Success:	Pointer to the VL data
+ *		Failure:	NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5T_vlen_arena_alloc(size_t size, void *info)
+{
+    H5T_vlen_arena_t *arena = (H5T_vlen_arena_t *)info; /* Arena to allocate from */
+    H5T_vlen_arena_blk_t *blk = arena->head;    /* Block to allocate from */
+    void *ret_value = NULL;             /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    size = H5T_VLEN_ARENA_ALIGNED(size);
+
+    /* Start a new block if the current one can't hold the data */
+    if(NULL == blk || (blk->size - blk->used) < size) {
+        size_t blk_size = MAX(size, arena->block_size);
+
+        if(NULL == (blk = (H5T_vlen_arena_blk_t *)H5MM_malloc(H5T_VLEN_ARENA_HDR_SIZE + blk_size)))
+            HGOTO_DONE(NULL)
+        blk->size = blk_size;
+        blk->used = 0;
+
+        if(size >= arena->block_size && arena->head) {
+            blk->next = arena->head->next;
+            arena->head->next = blk;
+        } /* end if */
+        else {
+            blk->next = arena->head;
+            arena->head = blk;
+        } /* end else */
+        arena->nblocks++;
+    } /* end if */
+
+    ret_value = (uint8_t *)blk + H5T_VLEN_ARENA_HDR_SIZE + blk->used;
+    blk->used += size;
+    arena->nbytes += size;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_vlen_arena_alloc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T_vlen_arena_free
+ *
+ * Purpose:	VL free routine for arena data.  Does nothing: the data is
+ *		only freed when the whole arena is released.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T_vlen_arena_free(void H5_ATTR_UNUSED *mem, void H5_ATTR_UNUSED *info)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T_vlen_arena_free() */
+
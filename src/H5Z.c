@@ -1560,6 +1560,68 @@ done:
 } /* end H5Z_all_filters_avail() */
 
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_pipeline_builtin
+ *
+ * Purpose:	Check whether every filter in a pipeline is one of the
+ *              library's own filters (and hasn't been replaced by an
+ *              application or plugin filter with the same ID).
+ *
+ *              Only these filters are known not to call back into the
+ *              library, so only pipelines made of them may be run on
+ *              several threads at once.
+ *
+ * Return:	Non-negative (TRUE/FALSE) on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+htri_t
+H5Z_pipeline_builtin(const H5O_pline_t *pline)
+{
+    const H5Z_class2_t *builtin[] = {   /* The library's own filters */
+        H5Z_SHUFFLE,
+        H5Z_FLETCHER32,
+        H5Z_NBIT,
+        H5Z_SCALEOFFSET,
+#ifdef H5_HAVE_FILTER_DEFLATE
+        H5Z_DEFLATE,
+#endif /* H5_HAVE_FILTER_DEFLATE */
+#ifdef H5_HAVE_FILTER_SZIP
+        H5Z_SZIP,
+#endif /* H5_HAVE_FILTER_SZIP */
+    };
+    size_t i, j, k;             /* Local index variables */
+    htri_t ret_value = TRUE;    /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Check args */
+    HDassert(pline);
+
+    /* Iterate through all the filters in pipeline */
+    for(i = 0; i < pline->nused; i++) {
+
+        /* Look for the filter in the list of registered filters */
+        for(j = 0; j < H5Z_table_used_g; j++)
+            if(H5Z_table_g[j].id == pline->filter[i].id)
+                break;
+        if(j == H5Z_table_used_g)
+            HGOTO_DONE(FALSE)
+
+        /* Check that the registered filter is the library's own */
+        for(k = 0; k < NELMTS(builtin); k++)
+            if(builtin[k]->id == H5Z_table_g[j].id && builtin[k]->filter == H5Z_table_g[j].filter)
+                break;
+        if(k == NELMTS(builtin))
+            HGOTO_DONE(FALSE)
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_pipeline_builtin() */
+
+
 
 /*-------------------------------------------------------------------------
  * Function: H5Z_delete
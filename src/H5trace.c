@@ -1235,6 +1235,10 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
                                 else if(obj == H5T_NATIVE_LDOUBLE_g)
                                     fprintf(out, "H5T_NATIVE_LDOUBLE");
 #endif
+                                else if(obj == H5T_IEEE_F16BE_g)
+                                    fprintf(out, "H5T_IEEE_F16BE");
+                                else if(obj == H5T_IEEE_F16LE_g)
+                                    fprintf(out, "H5T_IEEE_F16LE");
                                 else if(obj == H5T_IEEE_F32BE_g)
                                     fprintf(out, "H5T_IEEE_F32BE");
                                 else if(obj == H5T_IEEE_F32LE_g)
@@ -1243,6 +1247,10 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
                                     fprintf(out, "H5T_IEEE_F64BE");
                                 else if(obj == H5T_IEEE_F64LE_g)
                                     fprintf(out, "H5T_IEEE_F64LE");
+                                else if(obj == H5T_FLOAT_BFLOAT16BE_g)
+                                    fprintf(out, "H5T_FLOAT_BFLOAT16BE");
+                                else if(obj == H5T_FLOAT_BFLOAT16LE_g)
+                                    fprintf(out, "H5T_FLOAT_BFLOAT16LE");
                                 else if(obj == H5T_STD_I8BE_g)
                                     fprintf(out, "H5T_STD_I8BE");
                                 else if(obj == H5T_STD_I8LE_g)
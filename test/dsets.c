@@ -59,6 +59,23 @@ const char *FILENAME[] = {
     "bt2_hdr_fd",       /* 21 */
     "storage_size",	/* 22 */
     "dls_01_strings",   /* 23 */
+    "chunk_filter_threads", /* 24 */
+    "chunk_flush_threads1", /* 25 */
+    "chunk_flush_threadsn", /* 26 */
+    "chunk_cache_sets",     /* 27 */
+    "chunk_cache_pool",     /* 28 */
+    "chunk_read_ahead",     /* 29 */
+    "chunk_lookup_batch",   /* 30 */
+    "chunk_addr_map",       /* 31 */
+    "chunk_info",           /* 32 */
+    "chunk_stream_write",   /* 33 */
+    "chunk_cache_stats",    /* 34 */
+    "chunk_cache_resize",   /* 35 */
+    "chunk_cache_images",   /* 36 */
+    "chunk_read_fill",      /* 37 */
+    "chunk_dedup",          /* 38 */
+    "chunk_prune",          /* 39 */
+    "tconv_pipeline",       /* 40 */
     NULL
 };
 #define FILENAME_BUF_SIZE       1024
@@ -136,6 +153,10 @@ const char *FILENAME[] = {
 #define DSET_EARRAY_HDR_FD  "earray_hdr_fd"
 #define DSET_FARRAY_HDR_FD  "farray_hdr_fd"
 #define DSET_BT2_HDR_FD  "bt2_hdr_fd"
+#define DSET_FILTER_THREADS "filter_threads"
+#define DSET_FILTER_THREADS_PARTIAL "filter_threads_partial"
+#define DSET_FILTER_THREADS_CORRUPT "filter_threads_corrupt"
+#define DSET_FLUSH_THREADS  "flush_threads"
 
 /* Dataset names for testing Implicit Indexing */
 #define DSET_SINGLE_MAX         "DSET_SINGLE_MAX"
@@ -10151,6 +10172,2590 @@ error:
     return -1;
 } /* test_unfiltered_edge_chunks */
 
+
+/*-------------------------------------------------------------------------
+ * Function: filter_threads_walk_cb
+ *
+ * Purpose: Error stack walk callback for test_chunk_filter_threads,
+ *          counting the Fletcher32 checksum errors.
+ *
+ * Return:      0
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+filter_threads_walk_cb(unsigned H5_ATTR_UNUSED n, const H5E_error2_t *err_desc, void *client_data)
+{
+    if(err_desc->desc && HDstrstr(err_desc->desc, "Fletcher32"))
+        (*(unsigned *)client_data)++;
+
+    return 0;
+} /* end filter_threads_walk_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_filter_threads
+ *
+ * Purpose: Tests reading filtered chunks in batches, unfiltering them
+ *          with several threads (H5Pset_chunk_filter_nthreads).  Reads
+ *          a dataset with edge chunks, unallocated chunks and (optionally)
+ *          unfiltered partial edge chunks, with & without the chunk
+ *          cache, and checks the data against what was written.  Also
+ *          checks that a checksum error detected while unfiltering is
+ *          reported on the error stack.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_filter_threads(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dxpl = -1;              /* Dataset transfer property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dim[2] = {50, 37};      /* Dataset dimensions */
+    hsize_t     chunk_dim[2] = {8, 6};  /* Chunk dimensions */
+    hsize_t     start[2], count[2];     /* Hyperslab selection */
+    int         fill = -1;              /* Fill value */
+    int         *wbuf = NULL;           /* Write buffer */
+    int         *rbuf = NULL;           /* Read buffer */
+    unsigned    nthreads;               /* # of threads */
+    unsigned    opts;                   /* Chunk options */
+    hsize_t     corrupt_dim = 64;       /* Dimension of corrupted dataset */
+    hsize_t     corrupt_chunk_dim = 8;  /* Chunk dimension of corrupted dataset */
+    hsize_t     offset;                 /* Chunk offset for direct write */
+    hsize_t     *offset_ptr = &offset;  /* Pointer to chunk offset, for property */
+    hbool_t     direct_write;           /* Direct chunk write flag */
+    uint32_t    filter_mask = 0;        /* Direct chunk write filter mask */
+    uint32_t    chunk_nbytes;           /* Direct chunk write size */
+    int         chunk[8 + 1];           /* Chunk data & (bad) checksum */
+    unsigned    nerrors;                /* # of checksum errors on stack */
+    unsigned    i, j, u;                /* Local index variables */
+    herr_t      ret;                    /* Generic return value */
+
+    TESTING("reading filtered chunks with multiple threads");
+
+    h5_fixname(FILENAME[24], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(sizeof(int) * dim[0] * dim[1])))
+        TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(sizeof(int) * dim[0] * dim[1])))
+        TEST_ERROR
+
+    /* Check the property's default, setting & invalid values */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_filter_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 1) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_filter_nthreads(dxpl, 0);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Pset_chunk_filter_nthreads(dxpl, 4) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_filter_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 4) TEST_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dim, NULL)) < 0) FAIL_STACK_ERROR
+
+    /* Create datasets with shuffle & fletcher32 filters, with filtered and
+     * with unfiltered partial edge chunks */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, DSET_FILTER_THREADS, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_opts(dcpl, &opts) < 0) FAIL_STACK_ERROR
+    opts |= H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS;
+    if(H5Pset_chunk_opts(dcpl, opts) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, DSET_FILTER_THREADS_PARTIAL, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* Write all but the first rows of the datasets, leaving some chunks
+     * unallocated */
+    for(i = 0; i < dim[0]; i++)
+        for(j = 0; j < dim[1]; j++)
+            wbuf[i * dim[1] + j] = (i < 20) ? fill : (int)(i * 1000 + j);
+    start[0] = 20; start[1] = 0;
+    count[0] = dim[0] - 20; count[1] = dim[1];
+    if((msid = H5Screate_simple(2, dim, NULL)) < 0) FAIL_STACK_ERROR
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+    if(H5Sselect_hyperslab(msid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, DSET_FILTER_THREADS, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, DSET_FILTER_THREADS_PARTIAL, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+
+    /* Use a chunk cache which holds some of the chunks, for the second pass */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)101, (size_t)(8 * chunk_dim[0] * chunk_dim[1] * sizeof(int)), 0.75F) < 0)
+        FAIL_STACK_ERROR
+
+    for(u = 0; u < 4; u++) {
+        const char *dset_name = (u % 2) ? DSET_FILTER_THREADS_PARTIAL : DSET_FILTER_THREADS;
+
+        if((dsid = H5Dopen2(fid, dset_name, (u < 2) ? H5P_DEFAULT : dapl)) < 0) FAIL_STACK_ERROR
+
+        /* Read a strided selection first, so some chunks are in the cache */
+        start[0] = 3; start[1] = 5;
+        count[0] = 40; count[1] = 20;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, sizeof(int) * dim[0] * dim[1]);
+        if(H5Dread(dsid, H5T_NATIVE_INT, sid, sid, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < dim[0]; i++)
+            for(j = 0; j < dim[1]; j++) {
+                int expect = (i >= start[0] && i < start[0] + count[0] && j >= start[1] && j < start[1] + count[1]) ? wbuf[i * dim[1] + j] : 0;
+
+                if(rbuf[i * dim[1] + j] != expect) {
+                    H5_FAILED();
+                    HDprintf("    Read different values than written in %s.\n", dset_name);
+                    HDprintf("    At index %u,%u: expected %d, got %d\n", i, j, expect, rbuf[i * dim[1] + j]);
+                    goto error;
+                } /* end if */
+            } /* end for */
+
+        /* Read the whole dataset */
+        if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, sizeof(int) * dim[0] * dim[1]);
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < dim[0] * dim[1]; i++)
+            if(rbuf[i] != wbuf[i]) {
+                H5_FAILED();
+                HDprintf("    Read different values than written in %s.\n", dset_name);
+                HDprintf("    At index %u: expected %d, got %d\n", i, wbuf[i], rbuf[i]);
+                goto error;
+            } /* end if */
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+
+    /* Write chunks with bad checksums to a fletcher32-only dataset */
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &corrupt_chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &corrupt_dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, DSET_FILTER_THREADS_CORRUPT, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    direct_write = TRUE;
+    chunk_nbytes = (uint32_t)sizeof(chunk);
+    if(H5Pset(dxpl, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, &direct_write) < 0) FAIL_STACK_ERROR
+    if(H5Pset(dxpl, H5D_XFER_DIRECT_CHUNK_WRITE_FILTERS_NAME, &filter_mask) < 0) FAIL_STACK_ERROR
+    if(H5Pset(dxpl, H5D_XFER_DIRECT_CHUNK_WRITE_DATASIZE_NAME, &chunk_nbytes) < 0) FAIL_STACK_ERROR
+    if(H5Pset(dxpl, H5D_XFER_DIRECT_CHUNK_WRITE_OFFSET_NAME, &offset_ptr) < 0) FAIL_STACK_ERROR
+    for(u = 0; u < (unsigned)(corrupt_dim / corrupt_chunk_dim); u++) {
+        for(i = 0; i < 8; i++)
+            chunk[i] = (int)(u * 8 + i);
+        chunk[8] = 0;
+        offset = u * corrupt_chunk_dim;
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, chunk) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    direct_write = FALSE;
+    if(H5Pset(dxpl, H5D_XFER_DIRECT_CHUNK_WRITE_FLAG_NAME, &direct_write) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* Reading must fail, with the checksum error of the chunk unfiltered
+     * by the calling thread on the error stack (those of the helper
+     * threads are discarded) */
+    if((dsid = H5Dopen2(fid, DSET_FILTER_THREADS_CORRUPT, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    nerrors = 0;
+    H5E_BEGIN_TRY {
+        ret = H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf);
+        if(ret < 0)
+            H5Ewalk2(H5E_DEFAULT, H5E_WALK_DOWNWARD, filter_threads_walk_cb, &nerrors);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(nerrors == 0) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Pclose(dapl);
+        H5Pclose(dxpl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* end test_chunk_filter_threads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_flush_threads
+ *
+ * Purpose: Tests filtering dirty chunks in batches when they're flushed
+ *          from the chunk cache or preempted from it, with several
+ *          threads (H5Pset_chunk_flush_nthreads).  Writes the same
+ *          dataset to two files, with one thread and with several, and
+ *          checks that the files have the same data and (with the sec2
+ *          driver) the same bytes.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_flush_threads(hid_t fapl)
+{
+    char        filename[2][FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    FILE        *fp[2] = {NULL, NULL};  /* File pointers, for comparing files */
+    hsize_t     dim[2] = {64, 60};      /* Dataset dimensions */
+    hsize_t     chunk_dim[2] = {8, 6};  /* Chunk dimensions */
+    hsize_t     start[2], count[2];     /* Hyperslab selection */
+    int         *wbuf = NULL;           /* Write buffer */
+    int         *rbuf = NULL;           /* Read buffer */
+    unsigned    nthreads;               /* # of threads */
+    unsigned    i, j, u;                /* Local index variables */
+    herr_t      ret;                    /* Generic return value */
+
+    TESTING("flushing filtered chunks with multiple threads");
+
+    h5_fixname(FILENAME[25], fapl, filename[0], sizeof filename[0]);
+    h5_fixname(FILENAME[26], fapl, filename[1], sizeof filename[1]);
+
+    if(NULL == (wbuf = (int *)HDmalloc(sizeof(int) * dim[0] * dim[1])))
+        TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(sizeof(int) * dim[0] * dim[1])))
+        TEST_ERROR
+
+    /* Check the property's default, setting & invalid values */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_flush_nthreads(dapl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 1) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_flush_nthreads(dapl, 0);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Pset_chunk_flush_nthreads(dapl, 4) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_flush_nthreads(dapl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 4) TEST_ERROR
+
+    /* Use a chunk cache which holds only some of the chunks, so chunks are
+     * preempted while the dataset is written */
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(16 * chunk_dim[0] * chunk_dim[1] * sizeof(int)), 0.75F) < 0)
+        FAIL_STACK_ERROR
+
+    /* Filters which change the size of the chunks, so the file space
+     * allocated depends on the order the chunks are written in */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pset_obj_track_times(dcpl, FALSE) < 0) FAIL_STACK_ERROR
+
+    if((sid = H5Screate_simple(2, dim, NULL)) < 0) FAIL_STACK_ERROR
+
+    for(u = 0; u < 2; u++) {
+        if(H5Pset_chunk_flush_nthreads(dapl, u ? 4 : 1) < 0) FAIL_STACK_ERROR
+
+        if((fid = H5Fcreate(filename[u], H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dcreate2(fid, DSET_FLUSH_THREADS, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+
+        /* Write the whole dataset, preempting dirty chunks */
+        for(i = 0; i < dim[0]; i++)
+            for(j = 0; j < dim[1]; j++)
+                wbuf[i * dim[1] + j] = (int)((i * j) % 97 + (j % 5) * 1000);
+        if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+
+        /* Flush the chunks left in the cache */
+        if(H5Fflush(fid, H5F_SCOPE_LOCAL) < 0) FAIL_STACK_ERROR
+
+        /* Overwrite part of the dataset, leaving the chunks dirty in the
+         * cache when the dataset is closed */
+        start[0] = 10; start[1] = 5;
+        count[0] = 20; count[1] = 25;
+        for(i = (unsigned)start[0]; i < start[0] + count[0]; i++)
+            for(j = (unsigned)start[1]; j < start[1] + count[1]; j++)
+                wbuf[i * dim[1] + j] = -(int)(i * 100 + j);
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+        /* Check the data written */
+        if((fid = H5Fopen(filename[u], H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dopen2(fid, DSET_FLUSH_THREADS, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, sizeof(int) * dim[0] * dim[1]);
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < dim[0] * dim[1]; i++)
+            if(rbuf[i] != wbuf[i]) {
+                H5_FAILED();
+                HDprintf("    Read different values than written with %u thread(s).\n", u ? 4 : 1);
+                HDprintf("    At index %u: expected %d, got %d\n", i, wbuf[i], rbuf[i]);
+                goto error;
+            } /* end if */
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Compare the bytes of the two files, when they're single files */
+    if(H5FD_SEC2 == H5Pget_driver(fapl)) {
+        size_t nread[2];
+
+        if(NULL == (fp[0] = HDfopen(filename[0], "rb"))) TEST_ERROR
+        if(NULL == (fp[1] = HDfopen(filename[1], "rb"))) TEST_ERROR
+        do {
+            nread[0] = HDfread(wbuf, (size_t)1, sizeof(int) * dim[0] * dim[1], fp[0]);
+            nread[1] = HDfread(rbuf, (size_t)1, sizeof(int) * dim[0] * dim[1], fp[1]);
+            if(nread[0] != nread[1] || HDmemcmp(wbuf, rbuf, nread[0])) {
+                H5_FAILED();
+                HDputs("    Files written with one and with several threads differ.");
+                goto error;
+            } /* end if */
+        } while(nread[0] > 0);
+        HDfclose(fp[0]);
+        fp[0] = NULL;
+        HDfclose(fp[1]);
+        fp[1] = NULL;
+    } /* end if */
+
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(sid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(fp[0])
+        HDfclose(fp[0]);
+    if(fp[1])
+        HDfclose(fp[1]);
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return -1;
+} /* end test_chunk_flush_threads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_cache_sets
+ *
+ * Purpose: Tests that chunks whose coordinates hash to the same place in
+ *          the chunk cache are cached together, as long as the cache
+ *          has room for them.  Reads two chunks which a direct-mapped
+ *          cache of the same number of slots would keep preempting,
+ *          back and forth, and counts the bytes read through a filter.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_cache_sets(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dim = 64;               /* Dataset dimensions */
+    hsize_t     chunk_dim = 4;          /* Chunk dimensions */
+    hsize_t     start, count;           /* Hyperslab selection */
+    int         wbuf[64];               /* Write buffer */
+    int         rbuf[4];                /* Read buffer */
+    unsigned    i, u;                   /* Local index variables */
+
+    TESTING("chunk cache with colliding chunks");
+
+    h5_fixname(FILENAME[27], fapl, filename, sizeof filename);
+
+    /* Register byte-counting filter */
+    if(H5Zregister(H5Z_COUNT) < 0) FAIL_STACK_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0u, (size_t)0, NULL) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, DSET_CHUNKED_NAME, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < dim; i++)
+        wbuf[i] = (int)(i * 3 + 1);
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* Reopen the dataset with a cache of 8 slots, which has plenty of room
+     * for both chunks 0 & 8 */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)8, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, DSET_CHUNKED_NAME, dapl)) < 0) FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, &chunk_dim, NULL)) < 0) FAIL_STACK_ERROR
+
+    /* Read the chunks alternately; each should only be read from the file
+     * (and through the filter) once */
+    count_nbytes_read = (size_t)0;
+    count = chunk_dim;
+    for(u = 0; u < 8; u++) {
+        start = (u % 2) ? 8 * chunk_dim : 0;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < chunk_dim; i++)
+            if(rbuf[i] != wbuf[start + i]) {
+                H5_FAILED();
+                HDprintf("    Read different values than written.\n");
+                HDprintf("    At index %u: expected %d, got %d\n", (unsigned)(start + i), wbuf[start + i], rbuf[i]);
+                goto error;
+            } /* end if */
+    } /* end for */
+    if(count_nbytes_read != (size_t)(2 * chunk_dim * sizeof(int))) {
+        H5_FAILED();
+        HDprintf("    Read %lu bytes through the filter, expected %lu.\n",
+                (unsigned long)count_nbytes_read, (unsigned long)(2 * chunk_dim * sizeof(int)));
+        goto error;
+    } /* end if */
+
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_cache_sets() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_cache_pool
+ *
+ * Purpose: Tests the file-wide chunk cache budget: the chunk caches of the
+ *          datasets open in a file share the budget, so reading from one
+ *          dataset preempts chunks cached (or dirty) in the others, also
+ *          after the ID they were written through was closed.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_cache_pool(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       my_fapl = -1;           /* File access property list ID */
+    hid_t       fapl2 = -1;             /* File access property list from file */
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       dsid[2] = {-1, -1};     /* Dataset IDs */
+    hid_t       dsid2 = -1;             /* Second ID of a dataset */
+    const char *dname[2] = {"pool_a", "pool_b"};  /* Dataset names */
+    hsize_t     dim = 64;               /* Dataset dimensions */
+    hsize_t     chunk_dim = 4;          /* Chunk dimensions */
+    hsize_t     start, count;           /* Hyperslab selection */
+    size_t      pool_nbytes;            /* File-wide chunk cache budget */
+    size_t      chunk_nbytes = 4 * sizeof(int);  /* Size of a chunk */
+    size_t      expected;               /* Bytes expected through the filter */
+    int         wbuf[2][64];            /* Write buffers */
+    int         rbuf[4];                /* Read buffer */
+    unsigned    pass, i, u, v;          /* Local index variables */
+
+    TESTING("file-wide chunk cache budget");
+
+    /* Set a budget with room for 4 chunks, for all the datasets together */
+    if((my_fapl = H5Pcopy(fapl)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache_pool(my_fapl, 4 * chunk_nbytes) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_pool(my_fapl, &pool_nbytes) < 0) FAIL_STACK_ERROR
+    if(pool_nbytes != 4 * chunk_nbytes) TEST_ERROR
+
+    h5_fixname(FILENAME[28], fapl, filename, sizeof filename);
+
+    /* Register byte-counting filter */
+    if(H5Zregister(H5Z_COUNT) < 0) FAIL_STACK_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, my_fapl)) < 0) FAIL_STACK_ERROR
+    if((fapl2 = H5Fget_access_plist(fid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_pool(fapl2, &pool_nbytes) < 0) FAIL_STACK_ERROR
+    if(pool_nbytes != 4 * chunk_nbytes) TEST_ERROR
+    if(H5Pclose(fapl2) < 0) FAIL_STACK_ERROR
+
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, &chunk_dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0u, (size_t)0, NULL) < 0) FAIL_STACK_ERROR
+
+    /* Write both datasets, with both open, so the dirty chunks of the first
+     * are preempted by writes to the second */
+    for(v = 0; v < 2; v++) {
+        for(i = 0; i < dim; i++)
+            wbuf[v][i] = (int)(i * 3 + 1 + v * 1000);
+        if((dsid[v] = H5Dcreate2(fid, dname[v], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+    count = chunk_dim;
+    for(v = 0; v < 2; v++)
+        for(u = 0; u < dim / chunk_dim; u++) {
+            start = u * chunk_dim;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dwrite(dsid[v], H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, &wbuf[v][start]) < 0) FAIL_STACK_ERROR
+        } /* end for */
+    for(v = 0; v < 2; v++) {
+        if(H5Dclose(dsid[v]) < 0) FAIL_STACK_ERROR
+        dsid[v] = -1;
+    } /* end for */
+
+    /* Reopen both datasets and read the first 4 chunks of the first dataset
+     * twice, then of the second, then of the first again.  The first dataset's
+     * chunks are cached for the second pass, but are preempted by reading the
+     * second dataset, since the budget only has room for 4 chunks. */
+    for(v = 0; v < 2; v++)
+        if((dsid[v] = H5Dopen2(fid, dname[v], H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    count_nbytes_read = (size_t)0;
+    for(pass = 0; pass < 4; pass++) {
+        v = (pass == 2) ? 1 : 0;
+        for(u = 0; u < 4; u++) {
+            start = u * chunk_dim;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dread(dsid[v], H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            for(i = 0; i < chunk_dim; i++)
+                if(rbuf[i] != wbuf[v][start + i]) {
+                    H5_FAILED();
+                    HDprintf("    Read different values than written.\n");
+                    HDprintf("    Dataset %u, at index %u: expected %d, got %d\n", v, (unsigned)(start + i), wbuf[v][start + i], rbuf[i]);
+                    goto error;
+                } /* end if */
+        } /* end for */
+    } /* end for */
+    expected = 3 * 4 * chunk_nbytes;
+    if(count_nbytes_read != expected) {
+        H5_FAILED();
+        HDprintf("    Read %lu bytes through the filter, expected %lu.\n",
+                (unsigned long)count_nbytes_read, (unsigned long)expected);
+        goto error;
+    } /* end if */
+
+    /* Check the rest of the data in both datasets */
+    for(v = 0; v < 2; v++)
+        for(u = 4; u < dim / chunk_dim; u++) {
+            start = u * chunk_dim;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dread(dsid[v], H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            for(i = 0; i < chunk_dim; i++)
+                if(rbuf[i] != wbuf[v][start + i]) {
+                    H5_FAILED();
+                    HDprintf("    Read different values than written.\n");
+                    HDprintf("    Dataset %u, at index %u: expected %d, got %d\n", v, (unsigned)(start + i), wbuf[v][start + i], rbuf[i]);
+                    goto error;
+                } /* end if */
+        } /* end for */
+
+    /* Rewrite the first 2 chunks of the first dataset through a second ID,
+     * and close it while the first ID stays open.  Then read the second
+     * dataset, which preempts everything else in the budget. */
+    if((dsid2 = H5Dopen2(fid, dname[0], H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 2 * chunk_dim; i++)
+        wbuf[0][i] = -wbuf[0][i];
+    start = 0;
+    count = 2 * chunk_dim;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid2, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wbuf[0]) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid2) < 0) FAIL_STACK_ERROR
+    dsid2 = -1;
+    count = chunk_dim;
+    for(u = 0; u < 4; u++) {
+        start = u * chunk_dim;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid[1], H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    } /* end for */
+    for(u = 0; u < dim / chunk_dim; u++) {
+        start = u * chunk_dim;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid[0], H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < chunk_dim; i++)
+            if(rbuf[i] != wbuf[0][start + i]) {
+                H5_FAILED();
+                HDprintf("    Read different values than written.\n");
+                HDprintf("    Dataset 0, at index %u: expected %d, got %d\n", (unsigned)(start + i), wbuf[0][start + i], rbuf[i]);
+                goto error;
+            } /* end if */
+    } /* end for */
+
+    for(v = 0; v < 2; v++)
+        if(H5Dclose(dsid[v]) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(my_fapl) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid2);
+        H5Dclose(dsid[0]);
+        H5Dclose(dsid[1]);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Pclose(dcpl);
+        H5Pclose(fapl2);
+        H5Fclose(fid);
+        H5Pclose(my_fapl);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_cache_pool() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_read_ahead
+ *
+ * Purpose: Tests reading chunks ahead into the chunk cache, when the
+ *          chunks of a dataset are read in sequence.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_read_ahead(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dapl2 = -1;             /* Dataset access property list from dataset */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dim = 64;               /* Dataset dimensions */
+    hsize_t     chunk_dim = 4;          /* Chunk dimensions */
+    hsize_t     start, count;           /* Hyperslab selection */
+    size_t      chunk_nbytes = 4 * sizeof(int);  /* Size of a chunk */
+    const unsigned strided[] = {0, 2, 4, 1};    /* Chunks read with a stride */
+    unsigned    read_ahead;             /* # of chunks read ahead */
+    int         wbuf[64];               /* Write buffer */
+    int         rbuf[4];                /* Read buffer */
+    unsigned    i, u;                   /* Local index variables */
+
+    TESTING("reading chunks ahead on sequential access");
+
+    h5_fixname(FILENAME[29], fapl, filename, sizeof filename);
+
+    /* Register byte-counting filter */
+    if(H5Zregister(H5Z_COUNT) < 0) FAIL_STACK_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, &chunk_dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0u, (size_t)0, NULL) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, DSET_CHUNKED_NAME, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < dim; i++)
+        wbuf[i] = (int)(i * 3 + 1);
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* Reopen the dataset with a chunk cache, reading 4 chunks ahead */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pset_chunk_read_ahead(dapl, 4) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_read_ahead(dapl, &read_ahead) < 0) FAIL_STACK_ERROR
+    if(read_ahead != 4) TEST_ERROR
+    if((dsid = H5Dopen2(fid, DSET_CHUNKED_NAME, dapl)) < 0) FAIL_STACK_ERROR
+    if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_read_ahead(dapl2, &read_ahead) < 0) FAIL_STACK_ERROR
+    if(read_ahead != 4) TEST_ERROR
+    if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+
+    /* Read the chunks in order, one at a time.  Reading the third chunk
+     * reads the next 4 chunks ahead, and every chunk is read from the file
+     * (and through the filter) once. */
+    count_nbytes_read = (size_t)0;
+    count = chunk_dim;
+    for(u = 0; u < dim / chunk_dim; u++) {
+        start = u * chunk_dim;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < chunk_dim; i++)
+            if(rbuf[i] != wbuf[start + i]) {
+                H5_FAILED();
+                HDprintf("    Read different values than written.\n");
+                HDprintf("    At index %u: expected %d, got %d\n", (unsigned)(start + i), wbuf[start + i], rbuf[i]);
+                goto error;
+            } /* end if */
+        if(2 == u && count_nbytes_read != 7 * chunk_nbytes) {
+            H5_FAILED();
+            HDprintf("    Read %lu bytes through the filter after 3 chunks, expected %lu.\n",
+                    (unsigned long)count_nbytes_read, (unsigned long)(7 * chunk_nbytes));
+            goto error;
+        } /* end if */
+    } /* end for */
+    if(count_nbytes_read != (dim / chunk_dim) * chunk_nbytes) {
+        H5_FAILED();
+        HDprintf("    Read %lu bytes through the filter, expected %lu.\n",
+                (unsigned long)count_nbytes_read, (unsigned long)((dim / chunk_dim) * chunk_nbytes));
+        goto error;
+    } /* end if */
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* Reopen the dataset and read every other chunk: the 4 chunks after the
+     * third one in the sequence are read ahead, but not the ones skipped */
+    if((dsid = H5Dopen2(fid, DSET_CHUNKED_NAME, dapl)) < 0) FAIL_STACK_ERROR
+    count_nbytes_read = (size_t)0;
+    for(u = 0; u < sizeof(strided) / sizeof(strided[0]); u++) {
+        start = strided[u] * chunk_dim;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < chunk_dim; i++)
+            if(rbuf[i] != wbuf[start + i]) {
+                H5_FAILED();
+                HDprintf("    Read different values than written.\n");
+                HDprintf("    At index %u: expected %d, got %d\n", (unsigned)(start + i), wbuf[start + i], rbuf[i]);
+                goto error;
+            } /* end if */
+    } /* end for */
+    if(count_nbytes_read != 8 * chunk_nbytes) {
+        H5_FAILED();
+        HDprintf("    Read %lu bytes through the filter, expected %lu.\n",
+                (unsigned long)count_nbytes_read, (unsigned long)(8 * chunk_nbytes));
+        goto error;
+    } /* end if */
+
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Pclose(dapl2);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_read_ahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_lookup_batch
+ *
+ * Purpose: Tests reading many chunks of a dataset, whose locations are
+ *          looked up together, with each kind of chunk index.  Some of
+ *          the chunks aren't allocated and some are dirty in the chunk
+ *          cache.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_lookup_batch(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dims[2] = {16, 16};     /* Dataset dimensions */
+    hsize_t     max_dims[4][2] = {{16, 16}, {H5S_UNLIMITED, 16},
+            {H5S_UNLIMITED, H5S_UNLIMITED}, {16, H5S_UNLIMITED}};  /* Dataset maximum dimensions */
+    hsize_t     chunk_dims[2] = {2, 2}; /* Chunk dimensions */
+    hsize_t     start[2], count[2];     /* Hyperslab selection */
+    hsize_t     half_dims[2] = {8, 16}; /* Dimensions of half the dataset */
+    int         fill = -1;              /* Fill value */
+    int         wbuf[16][16];           /* Expected data */
+    int         rbuf[16][16];           /* Read buffer */
+    int         cbuf[2][2];             /* Chunk buffer */
+    unsigned    i, j, n;                /* Local index variables */
+
+    TESTING("looking up the chunks read together");
+
+    h5_fixname(FILENAME[30], fapl, filename, sizeof filename);
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0) FAIL_STACK_ERROR
+    if(H5Pset_alloc_time(dcpl, H5D_ALLOC_TIME_INCR) < 0) FAIL_STACK_ERROR
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(1024 * 1024), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(2, chunk_dims, NULL)) < 0) FAIL_STACK_ERROR
+    count[0] = chunk_dims[0];
+    count[1] = chunk_dims[1];
+
+    /* One dataset for each maximum dimension, using each kind of index */
+    for(n = 0; n < 4; n++) {
+        char dset_name[16];
+
+        HDsnprintf(dset_name, sizeof(dset_name), "dset%u", n);
+        if((sid = H5Screate_simple(2, dims, max_dims[n])) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dcreate2(fid, dset_name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+
+        for(i = 0; i < dims[0]; i++)
+            for(j = 0; j < dims[1]; j++)
+                wbuf[i][j] = fill;
+
+        /* Write every third chunk, flushing them to the file, then write
+         * one more chunk, which stays in the chunk cache */
+        for(i = 0; i < 64; i += 3) {
+            start[0] = (i / 8) * chunk_dims[0];
+            start[1] = (i % 8) * chunk_dims[1];
+            for(j = 0; j < 4; j++) {
+                cbuf[j / 2][j % 2] = (int)(n * 1000 + i + j * 100);
+                wbuf[start[0] + j / 2][start[1] + j % 2] = cbuf[j / 2][j % 2];
+            } /* end for */
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, cbuf) < 0) FAIL_STACK_ERROR
+        } /* end for */
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dopen2(fid, dset_name, dapl)) < 0) FAIL_STACK_ERROR
+        start[0] = 6;
+        start[1] = 4;
+        for(j = 0; j < 4; j++) {
+            cbuf[j / 2][j % 2] = (int)(n * 1000 + 999);
+            wbuf[start[0] + j / 2][start[1] + j % 2] = cbuf[j / 2][j % 2];
+        } /* end for */
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, cbuf) < 0) FAIL_STACK_ERROR
+
+        /* Read the whole dataset */
+        HDmemset(rbuf, 0, sizeof(rbuf));
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < dims[0]; i++)
+            for(j = 0; j < dims[1]; j++)
+                if(rbuf[i][j] != wbuf[i][j]) {
+                    H5_FAILED();
+                    HDprintf("    Read different values than written in %s.\n", dset_name);
+                    HDprintf("    At index %u,%u: expected %d, got %d\n", i, j, wbuf[i][j], rbuf[i][j]);
+                    goto error;
+                } /* end if */
+
+        /* Read the second half of the dataset */
+        if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+        if((sid = H5Dget_space(dsid)) < 0) FAIL_STACK_ERROR
+        start[0] = 8;
+        start[1] = 0;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, half_dims, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Sset_extent_simple(msid, 2, half_dims, NULL) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, sizeof(rbuf));
+        if(H5Dread(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < half_dims[0]; i++)
+            for(j = 0; j < half_dims[1]; j++)
+                if(rbuf[i][j] != wbuf[i + 8][j]) {
+                    H5_FAILED();
+                    HDprintf("    Read different values than written in %s.\n", dset_name);
+                    HDprintf("    At index %u,%u: expected %d, got %d\n", i + 8, j, wbuf[i + 8][j], rbuf[i][j]);
+                    goto error;
+                } /* end if */
+        if(H5Sset_extent_simple(msid, 2, chunk_dims, NULL) < 0) FAIL_STACK_ERROR
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_lookup_batch() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_addr_map
+ *
+ * Purpose: Tests keeping the locations of a dataset's chunks in memory,
+ *          as chunks are written, the dataset is extended and shrunk,
+ *          and with more chunks than the map is allowed.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_addr_map(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dapl2 = -1;             /* Dataset access property list from dataset */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dim = 32;               /* Dataset dimensions */
+    hsize_t     max_dim[2] = {32, H5S_UNLIMITED};   /* Dataset maximum dimensions */
+    hsize_t     chunk_dim = 4;          /* Chunk dimensions */
+    hsize_t     start, count;           /* Hyperslab selection */
+    size_t      max_nchunks[2] = {16, 4};   /* Max. # of chunks in map */
+    size_t      map_nchunks;            /* Max. # of chunks in map, from property list */
+    int         fill = -1;              /* Fill value */
+    int         wbuf[64];               /* Expected data */
+    int         rbuf[64];               /* Read buffer */
+    unsigned    i, m, n;                /* Local index variables */
+
+    TESTING("keeping chunk addresses in memory");
+
+    h5_fixname(FILENAME[31], fapl, filename, sizeof filename);
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0) FAIL_STACK_ERROR
+    if(H5Pset_alloc_time(dcpl, H5D_ALLOC_TIME_INCR) < 0) FAIL_STACK_ERROR
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, &chunk_dim, NULL)) < 0) FAIL_STACK_ERROR
+    count = chunk_dim;
+
+    /* A fixed size dataset and an extendible one, each with a map which
+     * holds all their chunks, and one which doesn't */
+    for(n = 0; n < 2; n++)
+        for(m = 0; m < 2; m++) {
+            char dset_name[16];
+
+            if(H5Pset_chunk_addr_map(dapl, max_nchunks[m]) < 0) FAIL_STACK_ERROR
+            if(H5Pget_chunk_addr_map(dapl, &map_nchunks) < 0) FAIL_STACK_ERROR
+            if(map_nchunks != max_nchunks[m]) TEST_ERROR
+
+            dim = 32;
+            HDsnprintf(dset_name, sizeof(dset_name), "dset%u_%u", n, m);
+            if((sid = H5Screate_simple(1, &dim, &max_dim[n])) < 0) FAIL_STACK_ERROR
+            if((dsid = H5Dcreate2(fid, dset_name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+                FAIL_STACK_ERROR
+            if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+            if(H5Pget_chunk_addr_map(dapl2, &map_nchunks) < 0) FAIL_STACK_ERROR
+            if(map_nchunks != max_nchunks[m]) TEST_ERROR
+            if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+
+            /* Write every other chunk, then reopen the dataset and write
+             * the chunks in between */
+            for(i = 0; i < 64; i++)
+                wbuf[i] = fill;
+            for(i = 0; i < 8; i += 2) {
+                start = i * chunk_dim;
+                wbuf[start] = wbuf[start + 1] = wbuf[start + 2] = wbuf[start + 3] = (int)(n * 1000 + m * 100 + i);
+                if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+                if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, &wbuf[start]) < 0) FAIL_STACK_ERROR
+            } /* end for */
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            if((dsid = H5Dopen2(fid, dset_name, dapl)) < 0) FAIL_STACK_ERROR
+            if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            for(i = 0; i < dim; i++)
+                if(rbuf[i] != wbuf[i]) {
+                    H5_FAILED();
+                    HDprintf("    Read different values than written in %s.\n", dset_name);
+                    HDprintf("    At index %u: expected %d, got %d\n", i, wbuf[i], rbuf[i]);
+                    goto error;
+                } /* end if */
+            for(i = 1; i < 8; i += 2) {
+                start = i * chunk_dim;
+                wbuf[start] = wbuf[start + 1] = wbuf[start + 2] = wbuf[start + 3] = (int)(n * 1000 + m * 100 + i);
+                if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+                if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, &wbuf[start]) < 0) FAIL_STACK_ERROR
+            } /* end for */
+
+            /* Extend the dataset, writing one new chunk, and shrink it */
+            if(n == 1) {
+                dim = 64;
+                if(H5Dset_extent(dsid, &dim) < 0) FAIL_STACK_ERROR
+                if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+                if((sid = H5Dget_space(dsid)) < 0) FAIL_STACK_ERROR
+                start = 12 * chunk_dim;
+                wbuf[start] = wbuf[start + 1] = wbuf[start + 2] = wbuf[start + 3] = (int)(n * 1000 + m * 100 + 12);
+                if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+                if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, &wbuf[start]) < 0) FAIL_STACK_ERROR
+                if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+                for(i = 0; i < dim; i++)
+                    if(rbuf[i] != wbuf[i]) {
+                        H5_FAILED();
+                        HDprintf("    Read different values than written in %s.\n", dset_name);
+                        HDprintf("    At index %u: expected %d, got %d\n", i, wbuf[i], rbuf[i]);
+                        goto error;
+                    } /* end if */
+
+                /* (Chunks removed when shrinking read back as fill values) */
+                dim = 24;
+                if(H5Dset_extent(dsid, &dim) < 0) FAIL_STACK_ERROR
+                dim = 64;
+                if(H5Dset_extent(dsid, &dim) < 0) FAIL_STACK_ERROR
+                for(i = 24; i < 64; i++)
+                    wbuf[i] = fill;
+            } /* end if */
+
+            /* Read the dataset, before and after reopening it */
+            for(i = 0; i < 2; i++) {
+                unsigned j;
+
+                HDmemset(rbuf, 0, sizeof(rbuf));
+                if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+                for(j = 0; j < dim; j++)
+                    if(rbuf[j] != wbuf[j]) {
+                        H5_FAILED();
+                        HDprintf("    Read different values than written in %s.\n", dset_name);
+                        HDprintf("    At index %u: expected %d, got %d\n", j, wbuf[j], rbuf[j]);
+                        goto error;
+                    } /* end if */
+                if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+                if((dsid = H5Dopen2(fid, dset_name, dapl)) < 0) FAIL_STACK_ERROR
+            } /* end for */
+
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+        } /* end for */
+
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Pclose(dapl2);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_addr_map() */
+
+/* Chunks found by H5Dchunk_iter, for test_chunk_info() */
+typedef struct chunk_info_t {
+    unsigned    nchunks;                /* # of chunks found */
+    unsigned    stop;                   /* # of chunks to stop after, or 0 */
+    hsize_t     offsets[16][2];         /* Offsets of chunks */
+    unsigned    filter_masks[16];       /* Filter masks of chunks */
+    haddr_t     addrs[16];              /* Addresses of chunks */
+    hsize_t     sizes[16];              /* Sizes of chunks */
+} chunk_info_t;
+
+
+/*-------------------------------------------------------------------------
+ * Function: chunk_info_cb
+ *
+ * Purpose: H5Dchunk_iter callback for test_chunk_info(), recording the
+ *          chunks found.
+ *
+ * Return:  0, or 1 to stop the iteration
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+chunk_info_cb(const hsize_t *offset, unsigned filter_mask, haddr_t addr,
+    hsize_t size, void *op_data)
+{
+    chunk_info_t *info = (chunk_info_t *)op_data;
+
+    if(info->nchunks >= 16)
+        return -1;
+    info->offsets[info->nchunks][0] = offset[0];
+    info->offsets[info->nchunks][1] = offset[1];
+    info->filter_masks[info->nchunks] = filter_mask;
+    info->addrs[info->nchunks] = addr;
+    info->sizes[info->nchunks] = size;
+    info->nchunks++;
+
+    return (info->stop && info->nchunks == info->stop) ? 1 : 0;
+} /* end chunk_info_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_info
+ *
+ * Purpose: Tests H5Dget_num_chunks, H5Dget_chunk_info,
+ *          H5Dget_chunk_info_by_coord and H5Dchunk_iter with each kind
+ *          of chunk index, including chunks which are still in the
+ *          chunk cache.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_info(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dims[2] = {16, 16};     /* Dataset dimensions */
+    hsize_t     max_dims[2];            /* Dataset maximum dimensions */
+    hsize_t     chunk_dims[2] = {4, 4}; /* Chunk dimensions */
+    hsize_t     start[2];               /* Hyperslab selection */
+    hsize_t     nchunks;                /* # of chunks */
+    hsize_t     offsets[16][2];         /* Offsets from H5Dget_chunk_info */
+    unsigned    filter_masks[16];       /* Filter masks from H5Dget_chunk_info */
+    haddr_t     addrs[16];              /* Addresses from H5Dget_chunk_info */
+    hsize_t     sizes[16];              /* Sizes from H5Dget_chunk_info */
+    unsigned    filter_mask;            /* Filter mask of one chunk */
+    haddr_t     addr;                   /* Address of one chunk */
+    hsize_t     size;                   /* Size of one chunk */
+    chunk_info_t info;                  /* Chunks found by H5Dchunk_iter */
+    int         buf[4][4];              /* Data for one chunk */
+    herr_t      ret;                    /* Generic return value */
+    unsigned    n, i, j;                /* Local index variables */
+
+    TESTING("querying chunk locations");
+
+    h5_fixname(FILENAME[32], fapl, filename, sizeof filename);
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(2, chunk_dims, NULL)) < 0) FAIL_STACK_ERROR
+
+    /* Keep the chunks written in the chunk cache */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(1024 * 1024), 0.75F) < 0) FAIL_STACK_ERROR
+
+    /* Fixed size, one unlimited dimension, two unlimited dimensions, one
+     * chunk and early allocation; with the latest format these use each
+     * kind of chunk index */
+    for(n = 0; n < 5; n++) {
+        char dset_name[16];
+        unsigned expect_nchunks = (n == 3) ? 1 : 8;
+
+        max_dims[0] = (n == 1 || n == 2) ? H5S_UNLIMITED : dims[0];
+        max_dims[1] = (n == 2) ? H5S_UNLIMITED : dims[1];
+        if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+        if(H5Pset_chunk(dcpl, 2, (n == 3) ? dims : chunk_dims) < 0) FAIL_STACK_ERROR
+        if(n == 4) {
+            if(H5Pset_alloc_time(dcpl, H5D_ALLOC_TIME_EARLY) < 0) FAIL_STACK_ERROR
+            expect_nchunks = 16;
+        } /* end if */
+
+        HDsnprintf(dset_name, sizeof(dset_name), "dset%u", n);
+        if((sid = H5Screate_simple(2, dims, max_dims)) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dcreate2(fid, dset_name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+
+        /* No chunks yet, unless allocated early */
+        if(H5Dget_num_chunks(dsid, &nchunks) < 0) FAIL_STACK_ERROR
+        if(nchunks != (hsize_t)(n == 4 ? 16 : 0)) TEST_ERROR
+
+        /* Write the chunks on a checkerboard, which stay in the cache */
+        for(i = 0; i < 4; i++)
+            for(j = (i % 2); j < 4; j += 2) {
+                unsigned k;
+
+                for(k = 0; k < 16; k++)
+                    buf[k / 4][k % 4] = (int)(i * 4 + j);
+                start[0] = i * chunk_dims[0];
+                start[1] = j * chunk_dims[1];
+                if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, chunk_dims, NULL) < 0) FAIL_STACK_ERROR
+                if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+            } /* end for */
+
+        /* Look up one chunk, which is still dirty in the chunk cache */
+        start[0] = start[1] = (n == 3) ? 0 : 4;
+        if(H5Dget_chunk_info_by_coord(dsid, start, &filter_mask, &addr, &size) < 0) FAIL_STACK_ERROR
+        if(addr == HADDR_UNDEF || size != (n == 3 ? 16 * sizeof(buf) : sizeof(buf)) || filter_mask != 0) TEST_ERROR
+
+        /* Iterate over the chunks */
+        HDmemset(&info, 0, sizeof(info));
+        if(H5Dchunk_iter(dsid, chunk_info_cb, &info) != 0) FAIL_STACK_ERROR
+        if(H5Dget_num_chunks(dsid, &nchunks) < 0) FAIL_STACK_ERROR
+        if(info.nchunks != expect_nchunks || nchunks != expect_nchunks) TEST_ERROR
+        for(i = 0; i < info.nchunks; i++) {
+            if(info.offsets[i][0] % chunk_dims[0] || info.offsets[i][1] % chunk_dims[1]) TEST_ERROR
+            if(n < 3 && (info.offsets[i][0] / chunk_dims[0] + info.offsets[i][1] / chunk_dims[1]) % 2) TEST_ERROR
+            if(info.addrs[i] == HADDR_UNDEF || info.filter_masks[i] != 0) TEST_ERROR
+            if(info.sizes[i] != (n == 3 ? 16 * sizeof(buf) : sizeof(buf))) TEST_ERROR
+
+            /* Each chunk must be found again by its offset */
+            if(H5Dget_chunk_info_by_coord(dsid, info.offsets[i], &filter_mask, &addr, &size) < 0) FAIL_STACK_ERROR
+            if(addr != info.addrs[i] || size != info.sizes[i] || filter_mask != 0) TEST_ERROR
+            for(j = 0; j < i; j++)
+                if(info.addrs[j] == info.addrs[i]) TEST_ERROR
+        } /* end for */
+
+        /* The same chunks are returned all together, and from the middle */
+        if(H5Dget_chunk_info(dsid, (hsize_t)0, nchunks, &offsets[0][0], filter_masks, addrs, sizes) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < info.nchunks; i++)
+            if(offsets[i][0] != info.offsets[i][0] || offsets[i][1] != info.offsets[i][1]
+                    || filter_masks[i] != info.filter_masks[i] || addrs[i] != info.addrs[i]
+                    || sizes[i] != info.sizes[i])
+                TEST_ERROR
+        if(nchunks > 1) {
+            HDmemset(addrs, 0, sizeof(addrs));
+            if(H5Dget_chunk_info(dsid, nchunks - 2, (hsize_t)2, NULL, NULL, addrs, NULL) < 0) FAIL_STACK_ERROR
+            if(addrs[0] != info.addrs[nchunks - 2] || addrs[1] != info.addrs[nchunks - 1]) TEST_ERROR
+        } /* end if */
+        H5E_BEGIN_TRY {
+            ret = H5Dget_chunk_info(dsid, nchunks - 1, (hsize_t)2, NULL, NULL, addrs, NULL);
+        } H5E_END_TRY;
+        if(ret >= 0) TEST_ERROR
+
+        /* Stop the iteration early */
+        if(nchunks > 3) {
+            HDmemset(&info, 0, sizeof(info));
+            info.stop = 3;
+            if(H5Dchunk_iter(dsid, chunk_info_cb, &info) != 1) TEST_ERROR
+            if(info.nchunks != 3) TEST_ERROR
+        } /* end if */
+
+        /* A chunk never written isn't stored, unless allocated early */
+        start[0] = 0;
+        start[1] = 4;
+        if(n != 3) {
+            if(H5Dget_chunk_info_by_coord(dsid, start, &filter_mask, &addr, &size) < 0) FAIL_STACK_ERROR
+            if(n == 4 ? addr == HADDR_UNDEF : (addr != HADDR_UNDEF || size != 0)) TEST_ERROR
+        } /* end if */
+
+        /* Offsets off the chunks' boundaries or outside the dataset fail */
+        start[0] = 1;
+        H5E_BEGIN_TRY {
+            ret = H5Dget_chunk_info_by_coord(dsid, start, &filter_mask, &addr, &size);
+        } H5E_END_TRY;
+        if(ret >= 0) TEST_ERROR
+        start[0] = 16;
+        H5E_BEGIN_TRY {
+            ret = H5Dget_chunk_info_by_coord(dsid, start, &filter_mask, &addr, &size);
+        } H5E_END_TRY;
+        if(ret >= 0) TEST_ERROR
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+        if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_info() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_stream_write
+ *
+ * Purpose: Tests writing whole chunks straight from the application's
+ *          buffer with H5Pset_chunk_stream_write, with and without the
+ *          chunk cache, and that chunks which can't be streamed are
+ *          still written correctly.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_stream_write(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dxpl = -1;              /* Dataset transfer property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dim[2] = {16, 16};      /* Dataset dimensions */
+    hsize_t     chunk_dim[2] = {4, 4};  /* Chunk dimensions */
+    hsize_t     start[2], count[2];     /* Hyperslab selection */
+    hbool_t     stream;                 /* Streaming flag, from property list */
+    int         fill = -1;              /* Fill value */
+    int         wbuf[64];               /* Write buffer */
+    int         expect[16][16];         /* Expected data */
+    int         rbuf[16][16];           /* Read buffer */
+    unsigned    i, j, m;                /* Local index variables */
+
+    TESTING("streaming whole chunks to the file");
+
+    h5_fixname(FILENAME[33], fapl, filename, sizeof filename);
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0) FAIL_STACK_ERROR
+    if(H5Pset_alloc_time(dcpl, H5D_ALLOC_TIME_INCR) < 0) FAIL_STACK_ERROR
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dim, NULL)) < 0) FAIL_STACK_ERROR
+
+    /* Check the default and setting the property */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_stream_write(dxpl, &stream) < 0) FAIL_STACK_ERROR
+    if(stream) TEST_ERROR
+    if(H5Pset_chunk_stream_write(dxpl, TRUE) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_stream_write(dxpl, &stream) < 0) FAIL_STACK_ERROR
+    if(!stream) TEST_ERROR
+
+    /* A dataset without and with a chunk cache (when there is no cache,
+     * partial writes to allocated chunks go straight to the file) */
+    for(m = 0; m < 2; m++) {
+        char dset_name[16];
+
+        if(H5Pset_chunk_cache(dapl, (size_t)521, m ? (size_t)(1024 * 1024) : (size_t)0, 0.75F) < 0) FAIL_STACK_ERROR
+        HDsnprintf(dset_name, sizeof(dset_name), "dset%u", m);
+        if((dsid = H5Dcreate2(fid, dset_name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+        for(i = 0; i < 16; i++)
+            for(j = 0; j < 16; j++)
+                expect[i][j] = fill;
+
+        /* Stream the first chunk, overwrite one element of it without
+         * streaming, then stream it again */
+        start[0] = start[1] = 0;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, chunk_dim, NULL) < 0) FAIL_STACK_ERROR
+        if((msid = H5Screate_simple(2, chunk_dim, NULL)) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 16; i++)
+            wbuf[i] = (int)i;
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+        count[0] = count[1] = 1;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if((msid = H5Screate_simple(2, count, NULL)) < 0) FAIL_STACK_ERROR
+        wbuf[0] = 1000;
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, chunk_dim, NULL) < 0) FAIL_STACK_ERROR
+        if((msid = H5Screate_simple(2, chunk_dim, NULL)) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 16; i++) {
+            wbuf[i] = (int)(100 + i);
+            expect[i / 4][i % 4] = wbuf[i];
+        } /* end for */
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+
+        /* A row of chunks, which aren't contiguous in memory */
+        start[0] = 4;
+        count[0] = 4;
+        count[1] = 16;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if((msid = H5Screate_simple(2, count, NULL)) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 64; i++) {
+            wbuf[i] = (int)(200 + i);
+            expect[4 + i / 16][i % 16] = wbuf[i];
+        } /* end for */
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+
+        /* A column of chunks, which are */
+        start[0] = 8;
+        count[0] = 8;
+        count[1] = 4;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if((msid = H5Screate_simple(2, count, NULL)) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 32; i++) {
+            wbuf[i] = (int)(300 + i);
+            expect[8 + i / 4][i % 4] = wbuf[i];
+        } /* end for */
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+
+        /* Part of a chunk */
+        start[0] = 1;
+        start[1] = 5;
+        count[0] = count[1] = 2;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if((msid = H5Screate_simple(2, count, NULL)) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 4; i++) {
+            wbuf[i] = (int)(400 + i);
+            expect[1 + i / 2][5 + i % 2] = wbuf[i];
+        } /* end for */
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, msid, sid, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+
+        /* Read the dataset, before and after reopening it */
+        for(i = 0; i < 2; i++) {
+            unsigned k;
+
+            HDmemset(rbuf, 0, sizeof(rbuf));
+            if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            for(j = 0; j < 16; j++)
+                for(k = 0; k < 16; k++)
+                    if(rbuf[j][k] != expect[j][k]) {
+                        H5_FAILED();
+                        HDprintf("    Read different values than written in %s.\n", dset_name);
+                        HDprintf("    At index (%u, %u): expected %d, got %d\n", j, k, expect[j][k], rbuf[j][k]);
+                        goto error;
+                    } /* end if */
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            if((dsid = H5Dopen2(fid, dset_name, dapl)) < 0) FAIL_STACK_ERROR
+        } /* end for */
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Pclose(dxpl);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_stream_write() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_cache_stats
+ *
+ * Purpose: Tests H5Dget_chunk_cache_stats and H5Dreset_chunk_cache_stats,
+ *          for chunks which go through the chunk cache, chunks which are
+ *          too large for it and filtered chunks.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_cache_stats(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dim = 64;               /* Dataset dimensions */
+    hsize_t     chunk_dim;              /* Chunk dimensions */
+    hsize_t     start, count;           /* Hyperslab selection */
+    H5D_chunk_cache_stats_t stats;      /* Chunk cache statistics */
+    int         wbuf[64];               /* Write buffer */
+    int         rbuf[64];               /* Read buffer */
+    int         *big_buf = NULL;        /* Buffer for filtered dataset */
+    herr_t      ret;                    /* Generic return value */
+    unsigned    i;                      /* Local index variable */
+
+    TESTING("chunk cache statistics");
+
+    h5_fixname(FILENAME[34], fapl, filename, sizeof filename);
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 64; i++)
+        wbuf[i] = (int)i;
+
+    /* Datasets which aren't chunked have no chunk cache */
+    if((dsid = H5Dcreate2(fid, "contig", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dget_chunk_cache_stats(dsid, &stats);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dreset_chunk_cache_stats(dsid);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* A dataset with 8 chunks of 32 bytes, and a cache holding 2 of them */
+    chunk_dim = 8;
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)64, 1.0F) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "cached", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.ninits != 0 || stats.nhits != 0 || stats.nmisses != 0 || stats.nflushes != 0
+            || stats.nevictions != 0 || stats.nbytes_read != 0 || stats.nbytes_written != 0
+            || stats.filter_time != 0.0)
+        TEST_ERROR
+
+    /* Writing all the chunks evicts all but 2, and flushing writes them */
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dflush(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nflushes != 8 || stats.nevictions != 6 || stats.nbytes_read != 0
+            || stats.nbytes_written != 8 * chunk_dim * sizeof(int) || stats.filter_time != 0.0)
+        TEST_ERROR
+
+    /* Reset, then read the last 2 chunks, which are in the cache */
+    if(H5Dreset_chunk_cache_stats(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.ninits != 0 || stats.nhits != 0 || stats.nmisses != 0 || stats.nflushes != 0
+            || stats.nevictions != 0 || stats.nbytes_read != 0 || stats.nbytes_written != 0)
+        TEST_ERROR
+    start = 48;
+    count = 16;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, &count, NULL)) < 0) FAIL_STACK_ERROR
+    if(H5Dread(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 16; i++)
+        if(rbuf[i] != wbuf[48 + i]) TEST_ERROR
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nhits != 2 || stats.nmisses != 0 || stats.nevictions != 0 || stats.nbytes_read != 0)
+        TEST_ERROR
+
+    /* Read all the chunks: each one read evicts another */
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 64; i++)
+        if(rbuf[i] != wbuf[i]) TEST_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nhits != 2 || stats.nmisses != 8 || stats.nflushes != 0 || stats.nevictions != 8
+            || stats.nbytes_read != 8 * chunk_dim * sizeof(int) || stats.nbytes_written != 0)
+        TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* A dataset with chunks too large to be kept in the cache */
+    chunk_dim = 32;
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "bypass", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 64; i++)
+        if(rbuf[i] != wbuf[i]) TEST_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nmisses != 0 || stats.nevictions != 0 || stats.nbytes_read != sizeof(wbuf)
+            || stats.nbytes_written != sizeof(wbuf))
+        TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* A filtered dataset, with time spent in the filters */
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    dim = chunk_dim = 256 * 1024;
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(2 * 1024 * 1024), 1.0F) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "filtered", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(NULL == (big_buf = (int *)HDmalloc((size_t)dim * sizeof(int)))) TEST_ERROR
+    for(i = 0; i < dim; i++)
+        big_buf[i] = (int)(i % 1000);
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, big_buf) < 0) FAIL_STACK_ERROR
+    if(H5Dflush(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nflushes != 1 || stats.nbytes_written != dim * sizeof(int) + 4
+            || stats.filter_time <= 0.0)
+        TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    HDfree(big_buf);
+    big_buf = NULL;
+
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(big_buf)
+        HDfree(big_buf);
+    return -1;
+} /* end test_chunk_cache_stats() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_cache_resize
+ *
+ * Purpose:  Tests that the chunk cache of a dataset grows while the
+ *           chunks being accessed don't fit in it, up to the maximum
+ *           size set with H5Pset_chunk_cache_resize, and shrinks when
+ *           few chunks are accessed, down to the minimum size.  Also
+ *           tests that it grows to hold chunks larger than itself.
+ *
+ * Return:   Success: 0
+ *           Failure: -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_cache_resize(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dapl2 = -1;             /* Dataset's access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dim = 4096;             /* Dataset dimensions */
+    hsize_t     chunk_dim = 64;         /* Chunk dimensions */
+    hsize_t     big_chunk_dim = 256;    /* Dimensions of chunks larger than the cache */
+    hsize_t     start;                  /* Hyperslab selection */
+    size_t      nslots, nbytes;         /* Chunk cache parameters */
+    size_t      min_nbytes, max_nbytes; /* Range the chunk cache is resized within */
+    double      w0;                     /* Chunk cache preemption policy */
+    int         *buf = NULL;            /* Data buffer */
+    int         rbuf[64];               /* Read buffer */
+    int         big_rbuf[256];          /* Read buffer for chunks larger than the cache */
+    herr_t      ret;                    /* Generic return value */
+    unsigned    i, j;                   /* Local index variables */
+
+    TESTING("chunk cache resizing");
+
+    h5_fixname(FILENAME[35], fapl, filename, sizeof filename);
+
+    /* Check the property */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_resize(dapl, &min_nbytes, &max_nbytes) < 0) FAIL_STACK_ERROR
+    if(min_nbytes != 0 || max_nbytes != 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_cache_resize(dapl, (size_t)1024, (size_t)512);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+
+    /* A dataset with 64 chunks of 256 bytes, and a cache holding 2 of them
+     * which may grow to hold 32 */
+    if(H5Pset_chunk_cache(dapl, (size_t)64, (size_t)512, 1.0F) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache_resize(dapl, (size_t)512, (size_t)8192) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_resize(dapl, &min_nbytes, &max_nbytes) < 0) FAIL_STACK_ERROR
+    if(min_nbytes != 512 || max_nbytes != 8192) TEST_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, &chunk_dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+        FAIL_STACK_ERROR
+    if(NULL == (buf = (int *)HDmalloc((size_t)dim * sizeof(int)))) TEST_ERROR
+    for(i = 0; i < dim; i++)
+        buf[i] = (int)i;
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+
+    /* Reading the chunks one at a time over and over misses every time, so
+     * the cache grows to its maximum size */
+    for(i = 0; i < 2048; i++) {
+        start = (i % 64) * chunk_dim;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &chunk_dim, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < chunk_dim; j++)
+            if(rbuf[j] != buf[start + j]) TEST_ERROR
+    } /* end for */
+    if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache(dapl2, &nslots, &nbytes, &w0) < 0) FAIL_STACK_ERROR
+    if(nbytes != 8192 || nslots != 1024) TEST_ERROR
+    if(H5Pget_chunk_cache_resize(dapl2, &min_nbytes, &max_nbytes) < 0) FAIL_STACK_ERROR
+    if(min_nbytes != 512 || max_nbytes != 8192) TEST_ERROR
+    if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+
+    /* Reading one chunk over and over shrinks the cache to its minimum size */
+    start = 0;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &chunk_dim, NULL) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 768; i++) {
+        if(H5Dread(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < chunk_dim; j++)
+            if(rbuf[j] != buf[j]) TEST_ERROR
+    } /* end for */
+    if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache(dapl2, &nslots, &nbytes, &w0) < 0) FAIL_STACK_ERROR
+    if(nbytes != 512 || nslots != 64) TEST_ERROR
+    if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+
+    /* Check all the data, after the chunks were moved between caches */
+    if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+    HDmemset(buf, 0, (size_t)dim * sizeof(int));
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < dim; i++)
+        if(buf[i] != (int)i) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+
+    /* A dataset with 16 chunks of 1KB, larger than the 512 byte cache.
+     * Accesses to them bypass the cache at first, and count as misses, so
+     * the cache grows until it holds the 4 chunks being read */
+    if(H5Pset_chunk_cache_resize(dapl, (size_t)512, (size_t)16384) < 0) FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(1, &big_chunk_dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &big_chunk_dim) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "big", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 1024; i++) {
+        start = (i % 4) * big_chunk_dim;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &big_chunk_dim, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, big_rbuf) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < big_chunk_dim; j++)
+            if(big_rbuf[j] != buf[start + j]) TEST_ERROR
+    } /* end for */
+    if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache(dapl2, &nslots, &nbytes, &w0) < 0) FAIL_STACK_ERROR
+    if(nbytes != 4096) TEST_ERROR
+    if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(buf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Pclose(dapl2);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(buf)
+        HDfree(buf);
+    return -1;
+} /* end test_chunk_cache_resize() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_cache_images
+ *
+ * Purpose:  Tests that chunks of a filtered dataset which were evicted
+ *           from the chunk cache are brought back from their filtered
+ *           images kept with H5Pset_chunk_cache_images, without reading
+ *           the file, and that the images are replaced when the chunks
+ *           are written again.  Also checks that chunks read in batches
+ *           are brought back from their images.
+ *
+ * Return:   Success: 0
+ *           Failure: -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_cache_images(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dxpl = -1;              /* Dataset transfer property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dim = 4096;             /* Dataset dimensions */
+    hsize_t     chunk_dim = 256;        /* Chunk dimensions */
+    size_t      nbytes;                 /* Size of filtered chunk images */
+    H5D_chunk_cache_stats_t stats;      /* Chunk cache statistics */
+    int         *buf = NULL;            /* Data buffer */
+    unsigned    i;                      /* Local index variable */
+
+    TESTING("filtered chunk images in chunk cache");
+
+    h5_fixname(FILENAME[36], fapl, filename, sizeof filename);
+
+    /* Check the property */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_images(dapl, &nbytes) < 0) FAIL_STACK_ERROR
+    if(nbytes != 0) TEST_ERROR
+    if(H5Pset_chunk_cache_images(dapl, (size_t)(64 * 1024)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_images(dapl, &nbytes) < 0) FAIL_STACK_ERROR
+    if(nbytes != 64 * 1024) TEST_ERROR
+
+    /* A filtered dataset with 16 chunks of 1KB, and a cache holding 2 of
+     * them */
+    if(H5Pset_chunk_cache(dapl, (size_t)64, (size_t)2048, 1.0F) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+        FAIL_STACK_ERROR
+    if(NULL == (buf = (int *)HDmalloc((size_t)dim * sizeof(int)))) TEST_ERROR
+    for(i = 0; i < dim; i++)
+        buf[i] = (int)i;
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    if(H5Dflush(dsid) < 0) FAIL_STACK_ERROR
+
+    /* The chunks written are read back without reading the file */
+    if(H5Dreset_chunk_cache_stats(dsid) < 0) FAIL_STACK_ERROR
+    HDmemset(buf, 0, (size_t)dim * sizeof(int));
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < dim; i++)
+        if(buf[i] != (int)i) TEST_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nmisses == 0 || stats.nbytes_read != 0) TEST_ERROR
+
+    /* Writing the chunks again replaces their images */
+    for(i = 0; i < dim; i++)
+        buf[i] = (int)(dim - i);
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    HDmemset(buf, 0, (size_t)dim * sizeof(int));
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < dim; i++)
+        if(buf[i] != (int)(dim - i)) TEST_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nbytes_read != 0) TEST_ERROR
+
+    /* Chunks read in batches are also brought back from their images */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_filter_nthreads(dxpl, 4) < 0) FAIL_STACK_ERROR
+    HDmemset(buf, 0, (size_t)dim * sizeof(int));
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, buf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < dim; i++)
+        if(buf[i] != (int)(dim - i)) TEST_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nbytes_read != 0) TEST_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* Without the images, the chunks are read from the file */
+    if(H5Pset_chunk_cache_images(dapl, (size_t)0) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+    HDmemset(buf, 0, (size_t)dim * sizeof(int));
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < dim; i++)
+        if(buf[i] != (int)(dim - i)) TEST_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nbytes_read < 2 * dim * sizeof(int)) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(buf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(sid);
+        H5Pclose(dxpl);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(buf)
+        HDfree(buf);
+    return -1;
+} /* end test_chunk_cache_images() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_read_fill
+ *
+ * Purpose:  Tests reading selections which span chunks that were never
+ *           written, whose elements are filled with the fill value
+ *           without bringing the chunks into the chunk cache.
+ *
+ * Return:   Success: 0
+ *           Failure: -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_read_fill(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       msid = -1;              /* Memory dataspace ID */
+    hid_t       wsid = -1;              /* Memory dataspace ID for writing */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dims[2] = {40, 40};     /* Dataset dimensions */
+    hsize_t     chunk_dims[2] = {10, 10};       /* Chunk dimensions */
+    hsize_t     mdims[2] = {40, 80};    /* Memory dataspace dimensions */
+    hsize_t     start[2], stride[2], count[2];  /* Hyperslab selection */
+    int         fillval = 42;           /* Fill value */
+    int         wbuf[10][10];           /* Write buffer */
+    int         ibuf[40][80];           /* Read buffer */
+    double      dbuf[40][80];           /* Read buffer */
+    H5D_chunk_cache_stats_t stats;      /* Chunk cache statistics */
+    const char  *dset_name[2] = {"fill", "default"};   /* Dataset names */
+    unsigned    i, j, n;                /* Local index variables */
+
+    TESTING("reading unallocated chunks");
+
+    h5_fixname(FILENAME[37], fapl, filename, sizeof filename);
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((msid = H5Screate_simple(2, mdims, NULL)) < 0) FAIL_STACK_ERROR
+    if((wsid = H5Screate_simple(2, chunk_dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)521, (size_t)(1024 * 1024), 0.75F) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 10; i++)
+        for(j = 0; j < 10; j++)
+            wbuf[i][j] = (int)(i * 10 + j);
+
+    /* A dataset with a fill value, and one with the default fill value */
+    for(n = 0; n < 2; n++) {
+        int expect_fill = (n == 0 ? fillval : 0);       /* Fill value read */
+
+        if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+        if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+        if(n == 0 && H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fillval) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dcreate2(fid, dset_name[n], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+
+        /* Write only the chunk at (10, 10) */
+        start[0] = start[1] = 10;
+        count[0] = count[1] = 10;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, wsid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dflush(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Dreset_chunk_cache_stats(dsid) < 0) FAIL_STACK_ERROR
+
+        /* Read the whole dataset into every other column of memory, leaving
+         * the other columns untouched */
+        if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+        start[0] = start[1] = 0;
+        stride[0] = 1;
+        stride[1] = 2;
+        count[0] = count[1] = 40;
+        if(H5Sselect_hyperslab(msid, H5S_SELECT_SET, start, stride, count, NULL) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 40; i++)
+            for(j = 0; j < 80; j++)
+                ibuf[i][j] = -1;
+        if(H5Dread(dsid, H5T_NATIVE_INT, msid, sid, H5P_DEFAULT, ibuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 40; i++)
+            for(j = 0; j < 80; j++) {
+                int expect = -1;        /* Value expected */
+
+                if(0 == j % 2) {
+                    if(i >= 10 && i < 20 && j / 2 >= 10 && j / 2 < 20)
+                        expect = wbuf[i - 10][j / 2 - 10];
+                    else
+                        expect = expect_fill;
+                } /* end if */
+                if(ibuf[i][j] != expect) TEST_ERROR
+            } /* end for */
+
+        /* Only the chunk which was written was brought into the cache */
+        if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+        if(stats.ninits != 0 || stats.nhits + stats.nmisses != 1) TEST_ERROR
+
+        /* Read again with type conversion */
+        for(i = 0; i < 40; i++)
+            for(j = 0; j < 80; j++)
+                dbuf[i][j] = -1.0;
+        if(H5Dread(dsid, H5T_NATIVE_DOUBLE, msid, sid, H5P_DEFAULT, dbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 40; i++)
+            for(j = 0; j < 80; j++) {
+                double expect = -1.0;   /* Value expected */
+
+                if(0 == j % 2) {
+                    if(i >= 10 && i < 20 && j / 2 >= 10 && j / 2 < 20)
+                        expect = (double)wbuf[i - 10][j / 2 - 10];
+                    else
+                        expect = (double)expect_fill;
+                } /* end if */
+                if(!H5_DBL_ABS_EQUAL(dbuf[i][j], expect)) TEST_ERROR
+            } /* end for */
+        if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+        if(stats.ninits != 0) TEST_ERROR
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    if(H5Sclose(wsid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(msid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(wsid);
+        H5Sclose(msid);
+        H5Sclose(sid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_read_fill() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_dedup
+ *
+ * Purpose:  Tests that identical filtered chunks of a dataset created with
+ *           H5D_CHUNK_DEDUP_IDENTICAL_CHUNKS are stored once in the file,
+ *           and that chunks sharing a block keep their contents when the
+ *           others are rewritten, pruned or deleted.  Such datasets can
+ *           only be created in files using the latest format.
+ *
+ * Return:   Success: 0
+ *           Failure: -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_dedup(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       fapl2 = -1;             /* File access property list ID for latest format */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    H5F_libver_t low;                   /* Low bound of file format versions */
+    hsize_t     dim = 4096;             /* Dataset dimensions */
+    hsize_t     max_dim = H5S_UNLIMITED;        /* Maximum dataset dimensions */
+    hsize_t     chunk_dim = 256;        /* Chunk dimensions */
+    hsize_t     start, count;           /* Hyperslab selection */
+    hsize_t     block_size = 256 * sizeof(int) + 4;     /* Size of a filtered chunk */
+    unsigned    opts;                   /* Chunk options */
+    int         *buf = NULL;            /* Data buffer */
+    int         *rbuf = NULL;           /* Read buffer */
+    unsigned    i;                      /* Local index variable */
+
+    TESTING("deduplicating identical chunks");
+
+    h5_fixname(FILENAME[38], fapl, filename, sizeof filename);
+
+    if((sid = H5Screate_simple(1, &dim, &max_dim)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_opts(dcpl, H5D_CHUNK_DEDUP_IDENTICAL_CHUNKS) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_opts(dcpl, &opts) < 0) FAIL_STACK_ERROR
+    if(opts != H5D_CHUNK_DEDUP_IDENTICAL_CHUNKS) TEST_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+
+    /* Deduplicated chunks can't be created unless the file is restricted
+     * to the latest format */
+    if(H5Pget_libver_bounds(fapl, &low, NULL) < 0) FAIL_STACK_ERROR
+    if(low != H5F_LIBVER_LATEST) {
+        if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+        H5E_BEGIN_TRY {
+            dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+        } H5E_END_TRY;
+        if(dsid >= 0) TEST_ERROR
+        if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    } /* end if */
+    if((fapl2 = H5Pcopy(fapl)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_libver_bounds(fapl2, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0) FAIL_STACK_ERROR
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl2)) < 0) FAIL_STACK_ERROR
+
+    /* Only filtered chunks can be deduplicated */
+    if(H5Premove_filter(dcpl, H5Z_FILTER_ALL) < 0) FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        dsid = H5Dcreate2(fid, "unfiltered", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    } H5E_END_TRY;
+    if(dsid >= 0) TEST_ERROR
+
+    /* The first 8 of the 16 chunks are identical */
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(NULL == (buf = (int *)HDmalloc((size_t)dim * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc((size_t)dim * sizeof(int)))) TEST_ERROR
+    for(i = 0; i < dim; i++)
+        buf[i] = (i < dim / 2 ? (int)(i % chunk_dim) : (int)i);
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    if(H5Dflush(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Dget_storage_size(dsid) != 9 * block_size) TEST_ERROR
+
+    /* Rewriting one of the identical chunks gives it a block of its own */
+    for(i = 0; i < chunk_dim; i++)
+        buf[i] = -(int)i;
+    start = 0;
+    count = chunk_dim;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+    if(H5Dflush(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Dget_storage_size(dsid) != 10 * block_size) TEST_ERROR
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < dim; i++)
+        if(rbuf[i] != buf[i]) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    /* After reopening, a chunk sharing a block and a chunk with a block of
+     * its own are both rewritten with the same contents, and share a new
+     * block */
+    if((dsid = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < chunk_dim; i++) {
+        buf[chunk_dim + i] = (int)(i * 3);
+        buf[9 * chunk_dim + i] = (int)(i * 3);
+    } /* end for */
+    start = chunk_dim;
+    count = chunk_dim;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+    start = 9 * chunk_dim;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_OR, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+    if(H5Dflush(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Dget_storage_size(dsid) != 10 * block_size) TEST_ERROR
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < dim; i++)
+        if(rbuf[i] != buf[i]) TEST_ERROR
+
+    /* Removing chunks which share a block with the remaining ones leaves
+     * the block in place */
+    dim = 4 * chunk_dim;
+    if(H5Dset_extent(dsid, &dim) < 0) FAIL_STACK_ERROR
+    if(H5Dget_storage_size(dsid) != 3 * block_size) TEST_ERROR
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < dim; i++)
+        if(rbuf[i] != buf[i]) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    /* The chunks are intact when the file is opened again, and the
+     * dataset can be deleted */
+    if((fid = H5Fopen(filename, H5F_ACC_RDWR, fapl2)) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if(H5Dget_storage_size(dsid) != 3 * block_size) TEST_ERROR
+    HDmemset(rbuf, 0, (size_t)dim * sizeof(int));
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < dim; i++)
+        if(rbuf[i] != buf[i]) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Ldelete(fid, "dset", H5P_DEFAULT) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(fapl2) < 0) FAIL_STACK_ERROR
+    HDfree(rbuf);
+    HDfree(buf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(sid);
+        H5Pclose(dcpl);
+        H5Pclose(fapl2);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(rbuf)
+        HDfree(rbuf);
+    if(buf)
+        HDfree(buf);
+    return -1;
+} /* end test_chunk_dedup() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_chunk_prune
+ *
+ * Purpose:  Tests shrinking datasets with chunk indices of each kind, by
+ *           a few chunks and by most of the dataset, with chunks both in
+ *           the chunk cache and only in the file.
+ *
+ * Return:   Success: 0
+ *           Failure: -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_chunk_prune(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dim[2] = {64, 64};      /* Dataset dimensions */
+    hsize_t     max_dim[3][2] = {{H5S_UNLIMITED, 64}, {64, H5S_UNLIMITED},
+                    {H5S_UNLIMITED, H5S_UNLIMITED}};    /* Maximum dataset dimensions */
+    hsize_t     chunk_dim[2] = {8, 8};  /* Chunk dimensions */
+    hsize_t     start[2], count[2];     /* Hyperslab selection */
+    hsize_t     chunk_size = 8 * 8 * sizeof(int);   /* Size of a chunk */
+    int         fill = -1;              /* Fill value */
+    int         buf[64][64];            /* Data buffer */
+    int         rbuf[64][64];           /* Read buffer */
+    unsigned    n, i, j;                /* Local index variables */
+
+    TESTING("pruning chunks when shrinking datasets");
+
+    h5_fixname(FILENAME[39], fapl, filename, sizeof filename);
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 64; i++)
+        for(j = 0; j < 64; j++)
+            buf[i][j] = (int)(i * 64 + j);
+
+    for(n = 0; n < 3; n++) {
+        char dset_name[16];             /* Dataset name */
+
+        HDsnprintf(dset_name, sizeof(dset_name), "dset%u", n);
+        dim[0] = dim[1] = 64;
+        if((sid = H5Screate_simple(2, dim, max_dim[n])) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dcreate2(fid, dset_name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+
+        /* Write the whole dataset, then rewrite its last rows, so that some
+         * of the chunks are only in the file and some are in the cache */
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+        if(H5Dflush(dsid) < 0) FAIL_STACK_ERROR
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dopen2(fid, dset_name, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        start[0] = 32;
+        start[1] = 0;
+        count[0] = 32;
+        count[1] = 64;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+        if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+        if(H5Dget_storage_size(dsid) != 64 * chunk_size) TEST_ERROR
+
+        /* Removing one column of chunks, and leaving a partial edge chunk */
+        dim[1] = 52;
+        if(H5Dset_extent(dsid, dim) < 0) FAIL_STACK_ERROR
+        if(H5Dget_storage_size(dsid) != 56 * chunk_size) TEST_ERROR
+
+        /* Removing most of the chunks */
+        dim[0] = 20;
+        if(H5Dset_extent(dsid, dim) < 0) FAIL_STACK_ERROR
+        if(H5Dget_storage_size(dsid) != 21 * chunk_size) TEST_ERROR
+
+        /* The data left is intact, and the rest reads as the fill value
+         * when the dataset is extended again */
+        dim[0] = dim[1] = 64;
+        if(H5Dset_extent(dsid, dim) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 64; i++)
+            for(j = 0; j < 64; j++)
+                if(rbuf[i][j] != ((i < 20 && j < 52) ? buf[i][j] : fill)) TEST_ERROR
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+        /* Removing all of the chunks */
+        if((dsid = H5Dopen2(fid, dset_name, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        dim[0] = 0;
+        if(H5Dset_extent(dsid, dim) < 0) FAIL_STACK_ERROR
+        if(H5Dget_storage_size(dsid) != 0) TEST_ERROR
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Sclose(sid);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return -1;
+} /* end test_chunk_prune() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: test_tconv_pipeline
+ *
+ * Purpose:  Tests reads which gather each strip of elements while the
+ *           one before it is converted (H5Pset_tconv_pipeline), from
+ *           contiguous and chunked datasets, with a data transform and
+ *           with compound members kept from the background buffer.
+ *
+ * Return:   Success: 0
+ *           Failure: -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_tconv_pipeline(hid_t fapl)
+{
+    typedef struct {
+        int a;
+        float b;
+    } file_cmpd_t;
+    typedef struct {
+        double b;
+        long long a;
+        int c;
+    } mem_cmpd_t;
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dxpl = -1;              /* Dataset transfer property list ID */
+    hid_t       xform_dxpl = -1;        /* Transfer property list with a data transform */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hid_t       ftid = -1, mtid = -1;   /* Compound datatype IDs */
+    hsize_t     dim[2] = {40, 50};      /* Dataset dimensions */
+    hsize_t     chunk_dim[2] = {16, 20};    /* Chunk dimensions */
+    hsize_t     start[2], stride[2], count[2];  /* Hyperslab selection */
+    int         buf[40][50];            /* Data buffer */
+    double      rbuf[40][50];           /* Read buffer */
+    file_cmpd_t *fcmpd = NULL;          /* Compound data buffer */
+    mem_cmpd_t  *mcmpd = NULL;          /* Compound read buffer */
+    hbool_t     pipeline;               /* Pipelined conversion flag */
+    unsigned    n, i, j;                /* Local index variables */
+
+    TESTING("pipelined datatype conversion on read");
+
+    h5_fixname(FILENAME[40], fapl, filename, sizeof filename);
+
+    if(NULL == (fcmpd = (file_cmpd_t *)HDmalloc(sizeof(file_cmpd_t) * 40 * 50)))
+        TEST_ERROR
+    if(NULL == (mcmpd = (mem_cmpd_t *)HDmalloc(sizeof(mem_cmpd_t) * 40 * 50)))
+        TEST_ERROR
+    for(i = 0; i < 40; i++)
+        for(j = 0; j < 50; j++) {
+            buf[i][j] = (int)(i * 50 + j) - 1000;
+            fcmpd[i * 50 + j].a = buf[i][j];
+            fcmpd[i * 50 + j].b = (float)buf[i][j] / 4.0f;
+        } /* end for */
+
+    /* Check the property's default & setting */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_tconv_pipeline(dxpl, &pipeline) < 0) FAIL_STACK_ERROR
+    if(pipeline) TEST_ERROR
+    if(H5Pset_tconv_pipeline(dxpl, TRUE) < 0) FAIL_STACK_ERROR
+    if(H5Pget_tconv_pipeline(dxpl, &pipeline) < 0) FAIL_STACK_ERROR
+    if(!pipeline) TEST_ERROR
+
+    /* Make the conversion buffer hold 96 doubles, so that reads are done
+     * in many strips, the last of them partial */
+    if(H5Pset_buffer(dxpl, (size_t)(96 * sizeof(double)), NULL, NULL) < 0) FAIL_STACK_ERROR
+    if((xform_dxpl = H5Pcopy(dxpl)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_data_transform(xform_dxpl, "2*x+1") < 0) FAIL_STACK_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dim) < 0) FAIL_STACK_ERROR
+
+    /* Read contiguous and chunked datasets of integers as doubles */
+    for(n = 0; n < 2; n++) {
+        char dset_name[16];             /* Dataset name */
+
+        HDsnprintf(dset_name, sizeof(dset_name), "dset%u", n);
+        if((dsid = H5Dcreate2(fid, dset_name, H5T_STD_I32BE, sid, H5P_DEFAULT, n ? dcpl : H5P_DEFAULT, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+
+        /* The whole dataset */
+        if(H5Dread(dsid, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 40; i++)
+            for(j = 0; j < 50; j++)
+                if(rbuf[i][j] != (double)buf[i][j]) TEST_ERROR
+
+        /* Every third column, with a data transform */
+        HDmemset(rbuf, 0, sizeof(rbuf));
+        start[0] = 0;
+        start[1] = 1;
+        stride[0] = 1;
+        stride[1] = 3;
+        count[0] = 40;
+        count[1] = 17;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, stride, count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dread(dsid, H5T_NATIVE_DOUBLE, sid, sid, xform_dxpl, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < 40; i++)
+            for(j = 0; j < 50; j++)
+                if(rbuf[i][j] != ((j % 3) == 1 ? 2.0 * buf[i][j] + 1.0 : 0.0)) TEST_ERROR
+        if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Read compound data into a type with an extra member, which is kept
+     * from the background buffer */
+    if((ftid = H5Tcreate(H5T_COMPOUND, sizeof(file_cmpd_t))) < 0) FAIL_STACK_ERROR
+    if(H5Tinsert(ftid, "a", HOFFSET(file_cmpd_t, a), H5T_NATIVE_INT) < 0) FAIL_STACK_ERROR
+    if(H5Tinsert(ftid, "b", HOFFSET(file_cmpd_t, b), H5T_NATIVE_FLOAT) < 0) FAIL_STACK_ERROR
+    if((mtid = H5Tcreate(H5T_COMPOUND, sizeof(mem_cmpd_t))) < 0) FAIL_STACK_ERROR
+    if(H5Tinsert(mtid, "b", HOFFSET(mem_cmpd_t, b), H5T_NATIVE_DOUBLE) < 0) FAIL_STACK_ERROR
+    if(H5Tinsert(mtid, "a", HOFFSET(mem_cmpd_t, a), H5T_NATIVE_LLONG) < 0) FAIL_STACK_ERROR
+    if(H5Tinsert(mtid, "c", HOFFSET(mem_cmpd_t, c), H5T_NATIVE_INT) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "cmpd", ftid, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, ftid, H5S_ALL, H5S_ALL, H5P_DEFAULT, fcmpd) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 40 * 50; i++)
+        mcmpd[i].c = (int)i;
+    if(H5Pset_preserve(dxpl, TRUE) < 0) FAIL_STACK_ERROR
+    if(H5Dread(dsid, mtid, H5S_ALL, H5S_ALL, dxpl, mcmpd) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 40 * 50; i++)
+        if(mcmpd[i].a != (long long)fcmpd[i].a || mcmpd[i].b != (double)fcmpd[i].b || mcmpd[i].c != (int)i)
+            TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+
+    if(H5Tclose(ftid) < 0) FAIL_STACK_ERROR
+    if(H5Tclose(mtid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(xform_dxpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(fcmpd);
+    HDfree(mcmpd);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Tclose(ftid);
+        H5Tclose(mtid);
+        H5Sclose(sid);
+        H5Pclose(dxpl);
+        H5Pclose(xform_dxpl);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(fcmpd)
+        HDfree(fcmpd);
+    if(mcmpd)
+        HDfree(mcmpd);
+    return -1;
+} /* end test_tconv_pipeline() */
+
 
 /*-------------------------------------------------------------------------
  * Function: test_large_chunk_shrink
@@ -12924,6 +15529,22 @@ main(void)
             nerrors += (test_fixed_array(my_fapl) < 0		? 1 : 0);
             nerrors += (test_idx_compatible() < 0			? 1 : 0);
             nerrors += (test_unfiltered_edge_chunks(my_fapl) < 0    ? 1 : 0);
+            nerrors += (test_chunk_filter_threads(my_fapl) < 0      ? 1 : 0);
+            nerrors += (test_chunk_flush_threads(my_fapl) < 0       ? 1 : 0);
+            nerrors += (test_chunk_cache_sets(my_fapl) < 0          ? 1 : 0);
+            nerrors += (test_chunk_cache_pool(my_fapl) < 0          ? 1 : 0);
+            nerrors += (test_chunk_read_ahead(my_fapl) < 0          ? 1 : 0);
+            nerrors += (test_chunk_lookup_batch(my_fapl) < 0        ? 1 : 0);
+            nerrors += (test_chunk_addr_map(my_fapl) < 0            ? 1 : 0);
+            nerrors += (test_chunk_info(my_fapl) < 0                ? 1 : 0);
+            nerrors += (test_chunk_stream_write(my_fapl) < 0        ? 1 : 0);
+            nerrors += (test_chunk_cache_stats(my_fapl) < 0         ? 1 : 0);
+            nerrors += (test_chunk_cache_resize(my_fapl) < 0        ? 1 : 0);
+            nerrors += (test_chunk_cache_images(my_fapl) < 0        ? 1 : 0);
+            nerrors += (test_chunk_read_fill(my_fapl) < 0           ? 1 : 0);
+            nerrors += (test_chunk_dedup(my_fapl) < 0               ? 1 : 0);
+            nerrors += (test_chunk_prune(my_fapl) < 0               ? 1 : 0);
+            nerrors += (test_tconv_pipeline(my_fapl) < 0            ? 1 : 0);
             nerrors += (test_single_chunk(my_fapl) < 0              ? 1 : 0);	
             nerrors += (test_large_chunk_shrink(my_fapl) < 0        ? 1 : 0);
             nerrors += (test_zero_dim_dset(my_fapl) < 0             ? 1 : 0);
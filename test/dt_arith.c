@@ -885,7 +885,645 @@ error:
     return MAX((int)fails_this_test, 1);
 }
 
+
 
+/*-------------------------------------------------------------------------
+ * Function:    test_hard_packed_overflow
+ *
+ * Purpose:     Tests hard conversions of aligned, packed buffers, which may
+ *              be converted several elements at a time, from double to
+ *              float and from long long to int.  Values out of range for
+ *              the destination become infinities or are clamped when no
+ *              exception handling routine is registered.
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_hard_packed_overflow(void)
+{
+    double      *buf_d = NULL;          /* Buffer for double -> float */
+    long long   *buf_ll = NULL;         /* Buffer for long long -> int */
+    size_t      nelmts = 1003;          /* Not a multiple of the number converted at a time */
+    size_t      j;
+
+    TESTING("hard packed double -> float and long long -> int overflows");
+
+    if(NULL == (buf_d = (double *)HDmalloc(nelmts * sizeof(double))))
+        goto error;
+    if(NULL == (buf_ll = (long long *)HDmalloc(nelmts * sizeof(long long))))
+        goto error;
+    for(j = 0; j < nelmts; j++) {
+        switch(j % 5) {
+            case 0:
+                buf_d[j] = (double)FLT_MAX * 2.0;
+                buf_ll[j] = (long long)INT_MAX + (long long)j + 1;
+                break;
+            case 1:
+                buf_d[j] = -(double)FLT_MAX * 2.0;
+                buf_ll[j] = (long long)INT_MIN - (long long)j - 1;
+                break;
+            case 2:
+                buf_d[j] = (double)FLT_MAX;
+                buf_ll[j] = (long long)INT_MAX;
+                break;
+            case 3:
+                buf_d[j] = -(double)FLT_MAX;
+                buf_ll[j] = (long long)INT_MIN;
+                break;
+            default:
+                buf_d[j] = (double)j * 0.5;
+                buf_ll[j] = -(long long)j;
+                break;
+        } /* end switch */
+    } /* end for */
+
+    if(H5Tconvert(H5T_NATIVE_DOUBLE, H5T_NATIVE_FLOAT, nelmts, buf_d, NULL, H5P_DEFAULT) < 0)
+        goto error;
+    if(H5Tconvert(H5T_NATIVE_LLONG, H5T_NATIVE_INT, nelmts, buf_ll, NULL, H5P_DEFAULT) < 0)
+        goto error;
+
+    for(j = 0; j < nelmts; j++) {
+        float f = ((float *)buf_d)[j];
+        int i = ((int *)buf_ll)[j];
+
+        switch(j % 5) {
+            case 0:
+                if(!(f > FLT_MAX) || i != INT_MAX)
+                    goto error;
+                break;
+            case 1:
+                if(!(f < -FLT_MAX) || i != INT_MIN)
+                    goto error;
+                break;
+            case 2:
+                if(f != FLT_MAX || i != INT_MAX)
+                    goto error;
+                break;
+            case 3:
+                if(f != -FLT_MAX || i != INT_MIN)
+                    goto error;
+                break;
+            default:
+                if(f != (float)((double)j * 0.5) || i != -(int)j)
+                    goto error;
+                break;
+        } /* end switch */
+    } /* end for */
+
+    HDfree(buf_d);
+    HDfree(buf_ll);
+
+    PASSED();
+    return 0;
+
+error:
+    H5_FAILED();
+    if(buf_d)
+        HDfree(buf_d);
+    if(buf_ll)
+        HDfree(buf_ll);
+    return 1;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    flt16_value
+ *
+ * Purpose:     Computes the value of the bits of a half-precision or
+ *              bfloat16 number.  Infinities are valued as the power of two
+ *              past the largest finite value, which is what rounding
+ *              compares against.
+ *
+ * Return:      The value, as a double
+ *
+ *-------------------------------------------------------------------------
+ */
+static double
+flt16_value(unsigned h, hbool_t is_half)
+{
+    unsigned msize = is_half ? 10 : 7;
+    int ebias = is_half ? 15 : 127;
+    unsigned expo = (h & 0x7fff) >> msize;
+    unsigned mant = h & ((1u << msize) - 1);
+    double v;
+
+    if(expo == 0)
+        v = HDldexp((double)mant, 1 - ebias - (int)msize);
+    else
+        v = HDldexp((double)((1u << msize) + mant), (int)expo - ebias - (int)msize);
+
+    return (h & 0x8000) ? -v : v;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_flt16_1
+ *
+ * Purpose:     Tests the hard conversions between one 16-bit
+ *              floating-point format, half precision or bfloat16, and
+ *              native floats and doubles.  Every 16-bit value is widened
+ *              and checked, and values on, between and just beside
+ *              consecutive 16-bit values are narrowed, which must round
+ *              once, to nearest even.
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_conv_flt16_1(hid_t tid, hbool_t is_half)
+{
+    unsigned    emask = is_half ? 0x7c00 : 0x7f80;  /* Exponent bits */
+    size_t      nelmts = 0x10000;       /* Every 16-bit pattern */
+    uint16_t    *buf16 = NULL;          /* 16-bit values */
+    float       *buf_f = NULL;          /* Buffer for float conversions */
+    double      *buf_d = NULL;          /* Buffer for double conversions */
+    hid_t       user_tid = -1;          /* The same format, built by hand */
+    size_t      j;
+
+    if(NULL == (buf16 = (uint16_t *)HDmalloc(nelmts * sizeof(uint16_t))))
+        goto error;
+    if(NULL == (buf_f = (float *)HDmalloc(3 * nelmts * sizeof(float))))
+        goto error;
+    if(NULL == (buf_d = (double *)HDmalloc(3 * nelmts * sizeof(double))))
+        goto error;
+
+    /* The conversions are hard, even for an equivalent type built by hand */
+    if(H5Tcompiler_conv(tid, H5T_NATIVE_FLOAT) != TRUE || H5Tcompiler_conv(H5T_NATIVE_DOUBLE, tid) != TRUE)
+        goto error;
+    if((user_tid = H5Tcopy(H5T_NATIVE_FLOAT)) < 0)
+        goto error;
+    if(H5Tset_fields(user_tid, (size_t)15, is_half ? (size_t)10 : (size_t)7, is_half ? (size_t)5 : (size_t)8,
+            (size_t)0, is_half ? (size_t)10 : (size_t)7) < 0)
+        goto error;
+    if(H5Tset_precision(user_tid, (size_t)16) < 0)
+        goto error;
+    if(H5Tset_size(user_tid, (size_t)2) < 0)
+        goto error;
+    if(H5Tset_ebias(user_tid, is_half ? (size_t)15 : (size_t)127) < 0)
+        goto error;
+    if(H5Tcompiler_conv(user_tid, H5T_NATIVE_FLOAT) != TRUE)
+        goto error;
+    if(H5Tclose(user_tid) < 0)
+        goto error;
+    user_tid = -1;
+
+    /* Widen every value, in place */
+    for(j = 0; j < nelmts; j++)
+        ((uint16_t *)buf_f)[j] = ((uint16_t *)buf_d)[j] = buf16[j] = (uint16_t)j;
+    if(H5Tconvert(tid, H5T_NATIVE_FLOAT, nelmts, buf_f, NULL, H5P_DEFAULT) < 0)
+        goto error;
+    if(H5Tconvert(tid, H5T_NATIVE_DOUBLE, nelmts, buf_d, NULL, H5P_DEFAULT) < 0)
+        goto error;
+    for(j = 0; j < nelmts; j++) {
+        if((j & emask) == emask) {
+            if(j & 0x7fff & ~emask) {
+                if(!my_isnan(FLT_FLOAT, &buf_f[j]) || !my_isnan(FLT_DOUBLE, &buf_d[j]))
+                    goto error;
+            } /* end if */
+            else if(buf_f[j] != ((j & 0x8000) ? -HUGE_VAL : HUGE_VAL) || buf_d[j] != (double)buf_f[j])
+                goto error;
+        } /* end if */
+        else if((double)buf_f[j] != flt16_value((unsigned)j, is_half) || buf_d[j] != flt16_value((unsigned)j, is_half))
+            goto error;
+    } /* end for */
+
+    /* Narrow each finite value, the midpoint between it and the next value
+     * away from zero, and a value just beside the midpoint on the side of
+     * the odd one of the two, which mustn't be taken for a tie.  Doubles
+     * beside a midpoint round to a float on it, so are narrowed from
+     * doubles only. */
+    for(j = 0; j < nelmts; j++) {
+        unsigned h = (unsigned)j;
+        double v, mid, step;
+
+        if((h & emask) == emask)
+            continue;
+        v = flt16_value(h, is_half);
+        mid = (v + flt16_value(h + 1, is_half)) / 2.0;
+        step = (flt16_value(h + 1, is_half) - v) / 1048576.0;
+        buf_d[3 * j] = v;
+        buf_d[3 * j + 1] = mid;
+        buf_d[3 * j + 2] = (h % 2) ? mid - step : mid + step;
+        buf_f[3 * j] = (float)v;
+        buf_f[3 * j + 1] = (float)mid;
+        buf_f[3 * j + 2] = (float)v;
+    } /* end for */
+    if(H5Tconvert(H5T_NATIVE_FLOAT, tid, 3 * nelmts, buf_f, NULL, H5P_DEFAULT) < 0)
+        goto error;
+    if(H5Tconvert(H5T_NATIVE_DOUBLE, tid, 3 * nelmts, buf_d, NULL, H5P_DEFAULT) < 0)
+        goto error;
+    for(j = 0; j < nelmts; j++) {
+        unsigned h = (unsigned)j;
+        unsigned even = (h % 2) ? h + 1 : h;
+        unsigned odd = (h % 2) ? h : h + 1;
+        float mid_f;
+
+        if((h & emask) == emask)
+            continue;
+
+        /* Midpoints too large for a float were infinite to start with */
+        mid_f = (float)((flt16_value(h, is_half) + flt16_value(h + 1, is_half)) / 2.0);
+        if(((uint16_t *)buf_d)[3 * j] != h || ((uint16_t *)buf_d)[3 * j + 1] != even
+                || ((uint16_t *)buf_d)[3 * j + 2] != odd)
+            goto error;
+        if(((uint16_t *)buf_f)[3 * j] != h || ((uint16_t *)buf_f)[3 * j + 2] != h)
+            goto error;
+        if(HDfabs(mid_f) <= FLT_MAX && ((uint16_t *)buf_f)[3 * j + 1] != even)
+            goto error;
+    } /* end for */
+
+    /* NaNs narrow to NaNs */
+    buf_f[0] = (float)HDsqrt(-1.0);
+    buf_d[0] = HDsqrt(-1.0);
+    if(H5Tconvert(H5T_NATIVE_FLOAT, tid, (size_t)1, buf_f, NULL, H5P_DEFAULT) < 0)
+        goto error;
+    if(H5Tconvert(H5T_NATIVE_DOUBLE, tid, (size_t)1, buf_d, NULL, H5P_DEFAULT) < 0)
+        goto error;
+    if((((uint16_t *)buf_f)[0] & 0x7fff) <= emask || (((uint16_t *)buf_d)[0] & 0x7fff) <= emask)
+        goto error;
+
+    HDfree(buf16);
+    HDfree(buf_f);
+    HDfree(buf_d);
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Tclose(user_tid);
+    } H5E_END_TRY;
+    if(buf16)
+        HDfree(buf16);
+    if(buf_f)
+        HDfree(buf_f);
+    if(buf_d)
+        HDfree(buf_d);
+    return 1;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_flt16
+ *
+ * Purpose:     Tests the hard conversions of half-precision and bfloat16
+ *              numbers, including members of compound types and, when
+ *              exceptions are handled, overflows reported to the
+ *              exception callback.
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_conv_flt16(void)
+{
+    typedef struct {
+        uint16_t h;
+        double d;
+    } src_t;
+    typedef struct {
+        float h;
+        uint16_t d;
+    } dst_t;
+    hbool_t     le = (H5Tget_order(H5T_NATIVE_FLOAT) == H5T_ORDER_LE);
+    hid_t       half = le ? H5T_IEEE_F16LE : H5T_IEEE_F16BE;
+    hid_t       bf16 = le ? H5T_FLOAT_BFLOAT16LE : H5T_FLOAT_BFLOAT16BE;
+    hid_t       src_tid = -1, dst_tid = -1; /* Compound types */
+    hid_t       dxpl_id = -1;           /* Transfer property list */
+    src_t       cmpd[4];                /* Compound elements */
+    dst_t       bkg[4];                 /* Background buffer */
+    uint16_t    neg_quarters[4] = {0x8000, 0xb400, 0xb800, 0xba00};    /* Halves -0.0 to -0.75 */
+    double      big[2];                 /* Doubles around the largest half */
+    uint16_t    h[2];                   /* Half-precision values */
+#ifdef H5_WANT_DCONV_EXCEPTION
+    int         fill_value = 0x7bff;    /* Written for exceptions */
+    double      d[4];                   /* Doubles overflowing halves */
+#endif /* H5_WANT_DCONV_EXCEPTION */
+    unsigned    j;
+
+    TESTING("hard half-precision and bfloat16 conversions");
+
+    if(test_conv_flt16_1(half, TRUE))
+        goto error;
+    if(test_conv_flt16_1(bf16, FALSE))
+        goto error;
+
+    /* The largest half is 65504, and rounding turns larger values into
+     * infinity only from 65520, halfway to 65536 */
+    big[0] = 65519.99;
+    big[1] = 65520.0;
+    if(H5Tconvert(H5T_NATIVE_DOUBLE, half, (size_t)2, big, NULL, H5P_DEFAULT) < 0)
+        goto error;
+    HDmemcpy(h, big, sizeof(h));
+    if(h[0] != 0x7bff || h[1] != 0x7c00)
+        goto error;
+
+    /* Members of compound types are converted with a stride */
+    if((src_tid = H5Tcreate(H5T_COMPOUND, sizeof(src_t))) < 0)
+        goto error;
+    if(H5Tinsert(src_tid, "h", HOFFSET(src_t, h), half) < 0)
+        goto error;
+    if(H5Tinsert(src_tid, "d", HOFFSET(src_t, d), H5T_NATIVE_DOUBLE) < 0)
+        goto error;
+    if((dst_tid = H5Tcreate(H5T_COMPOUND, sizeof(dst_t))) < 0)
+        goto error;
+    if(H5Tinsert(dst_tid, "h", HOFFSET(dst_t, h), H5T_NATIVE_FLOAT) < 0)
+        goto error;
+    if(H5Tinsert(dst_tid, "d", HOFFSET(dst_t, d), half) < 0)
+        goto error;
+    for(j = 0; j < 4; j++) {
+        cmpd[j].h = (uint16_t)(0x3c00 + j);     /* 1 + j/1024 */
+        cmpd[j].d = -(double)j / 4.0;
+    } /* end for */
+    if(H5Tconvert(src_tid, dst_tid, (size_t)4, cmpd, bkg, H5P_DEFAULT) < 0)
+        goto error;
+    for(j = 0; j < 4; j++) {
+        dst_t *dst = (dst_t *)cmpd + j;
+
+        if(dst->h != 1.0f + (float)j / 1024.0f)
+            goto error;
+        if(dst->d != neg_quarters[j])
+            goto error;
+    } /* end for */
+    if(H5Tclose(src_tid) < 0)
+        goto error;
+    src_tid = -1;
+    if(H5Tclose(dst_tid) < 0)
+        goto error;
+    dst_tid = -1;
+
+#ifdef H5_WANT_DCONV_EXCEPTION
+    /* Overflows and infinities are passed to the exception callback,
+     * which replaces them with the largest half */
+    if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        goto error;
+    if(H5Pset_type_conv_cb(dxpl_id, except_func, &fill_value) < 0)
+        goto error;
+    d[0] = 1.0e6;
+    d[1] = -1.0e6;
+    d[2] = HUGE_VAL;
+    d[3] = 2.0;
+    if(H5Tconvert(H5T_NATIVE_DOUBLE, half, (size_t)4, d, NULL, dxpl_id) < 0)
+        goto error;
+    for(j = 0; j < 3; j++)
+        if(((uint16_t *)d)[j] != 0x7bff)
+            goto error;
+    if(((uint16_t *)d)[3] != 0x4000)
+        goto error;
+    if(H5Pclose(dxpl_id) < 0)
+        goto error;
+    dxpl_id = -1;
+#endif /* H5_WANT_DCONV_EXCEPTION */
+
+    PASSED();
+    return 0;
+
+error:
+    H5_FAILED();
+    H5E_BEGIN_TRY {
+        H5Tclose(src_tid);
+        H5Tclose(dst_tid);
+        H5Pclose(dxpl_id);
+    } H5E_END_TRY;
+    return 1;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_nthreads_1
+ *
+ * Purpose:     Converts NELMTS elements from SRC with the transfer
+ *              property list DXPL_ID, and checks that the result is the
+ *              same as with the default property list.
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_conv_nthreads_1(hid_t src_tid, hid_t dst_tid, const void *src, size_t nelmts,
+    hid_t dxpl_id)
+{
+    size_t      src_size = H5Tget_size(src_tid);
+    size_t      dst_size = H5Tget_size(dst_tid);
+    size_t      buf_size = nelmts * MAX(src_size, dst_size);
+    unsigned char *buf = NULL, *buf_mt = NULL;  /* Conversion buffers */
+    unsigned char *bkg = NULL, *bkg_mt = NULL;  /* Background buffers */
+
+    if(NULL == (buf = (unsigned char *)HDmalloc(buf_size)))
+        goto error;
+    if(NULL == (buf_mt = (unsigned char *)HDmalloc(buf_size)))
+        goto error;
+    if(NULL == (bkg = (unsigned char *)HDcalloc(nelmts, dst_size)))
+        goto error;
+    if(NULL == (bkg_mt = (unsigned char *)HDcalloc(nelmts, dst_size)))
+        goto error;
+    HDmemcpy(buf, src, nelmts * src_size);
+    HDmemcpy(buf_mt, src, nelmts * src_size);
+
+    if(H5Tconvert(src_tid, dst_tid, nelmts, buf, bkg, H5P_DEFAULT) < 0)
+        goto error;
+    if(H5Tconvert(src_tid, dst_tid, nelmts, buf_mt, bkg_mt, dxpl_id) < 0)
+        goto error;
+    if(HDmemcmp(buf, buf_mt, nelmts * dst_size))
+        goto error;
+
+    HDfree(buf);
+    HDfree(buf_mt);
+    HDfree(bkg);
+    HDfree(bkg_mt);
+    return 0;
+
+error:
+    if(buf)
+        HDfree(buf);
+    if(buf_mt)
+        HDfree(buf_mt);
+    if(bkg)
+        HDfree(bkg);
+    if(bkg_mt)
+        HDfree(bkg_mt);
+    return 1;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_nthreads
+ *
+ * Purpose:     Tests conversions split between threads by
+ *              H5Pset_tconv_nthreads: widening and narrowing hard
+ *              conversions of packed buffers, byte order conversions and
+ *              compound conversions.  When the library isn't
+ *              thread-safe, only the property and the conversions with
+ *              one thread are checked and the test reports it skipped
+ *              the split.
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_conv_nthreads(void)
+{
+    typedef struct {
+        int a;
+        double b;
+    } wide_t;
+    typedef struct {
+        short a;
+        float b;
+    } narrow_t;
+    size_t      nelmts = 300007;        /* Not a multiple of the thread count */
+    hid_t       dxpl_id = -1;           /* Transfer property list */
+    hid_t       wide_tid = -1, narrow_tid = -1; /* Compound types */
+    hid_t       swapped_tid;            /* Non-native integer type */
+    double      *d = NULL;              /* Doubles */
+    float       *f = NULL;              /* Floats */
+    int         *i = NULL;              /* Integers */
+    wide_t      *wide = NULL;           /* Wide compounds */
+    narrow_t    *narrow = NULL;         /* Narrow compounds */
+    unsigned    nthreads;
+    hbool_t     is_ts;                  /* Whether conversions can be split */
+    herr_t      ret;
+    size_t      j;
+
+    TESTING("conversions split between threads");
+
+    /* Conversions are only split by thread-safe libraries */
+    if(H5is_library_threadsafe(&is_ts) < 0)
+        goto error;
+#ifdef H5_MEMORY_ALLOC_SANITY_CHECK
+    is_ts = FALSE;
+#endif /* H5_MEMORY_ALLOC_SANITY_CHECK */
+
+    /* Check the property */
+    if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        goto error;
+    if(H5Pget_tconv_nthreads(dxpl_id, &nthreads) < 0)
+        goto error;
+    if(nthreads != 1)
+        goto error;
+    H5E_BEGIN_TRY {
+        ret = H5Pset_tconv_nthreads(dxpl_id, 0);
+    } H5E_END_TRY;
+    if(ret >= 0)
+        goto error;
+    if(H5Pset_tconv_nthreads(dxpl_id, 4) < 0)
+        goto error;
+    if(H5Pget_tconv_nthreads(dxpl_id, &nthreads) < 0)
+        goto error;
+    if(nthreads != 4)
+        goto error;
+
+    if(NULL == (d = (double *)HDmalloc(nelmts * sizeof(double))))
+        goto error;
+    if(NULL == (f = (float *)HDmalloc(nelmts * sizeof(float))))
+        goto error;
+    if(NULL == (i = (int *)HDmalloc(nelmts * sizeof(int))))
+        goto error;
+    if(NULL == (wide = (wide_t *)HDcalloc(nelmts, sizeof(wide_t))))
+        goto error;
+    if(NULL == (narrow = (narrow_t *)HDcalloc(nelmts, sizeof(narrow_t))))
+        goto error;
+    for(j = 0; j < nelmts; j++) {
+        d[j] = ((double)j - (double)(nelmts / 2)) * 1.37e-3;
+        f[j] = (float)d[j];
+        i[j] = (int)(j % 100000) * 7919;
+        wide[j].a = (int)(j % 70001) - 35000;
+        wide[j].b = d[j];
+        narrow[j].a = (short)(j % 65536);
+        narrow[j].b = f[j];
+    } /* end for */
+
+    /* Narrow doubles, in place */
+    if(test_conv_nthreads_1(H5T_NATIVE_DOUBLE, H5T_NATIVE_FLOAT, d, nelmts, dxpl_id))
+        goto error;
+
+    /* Widen floats, in place */
+    if(test_conv_nthreads_1(H5T_NATIVE_FLOAT, H5T_NATIVE_DOUBLE, f, nelmts, dxpl_id))
+        goto error;
+
+    /* Swap bytes */
+    swapped_tid = (H5Tget_order(H5T_NATIVE_INT) == H5T_ORDER_LE) ? H5T_STD_I32BE : H5T_STD_I32LE;
+    if(H5Tget_size(H5T_NATIVE_INT) == 4 && test_conv_nthreads_1(H5T_NATIVE_INT, swapped_tid, i, nelmts, dxpl_id))
+        goto error;
+
+    /* Narrow and widen compounds, converting each member */
+    if((wide_tid = H5Tcreate(H5T_COMPOUND, sizeof(wide_t))) < 0)
+        goto error;
+    if(H5Tinsert(wide_tid, "a", HOFFSET(wide_t, a), H5T_NATIVE_INT) < 0)
+        goto error;
+    if(H5Tinsert(wide_tid, "b", HOFFSET(wide_t, b), H5T_NATIVE_DOUBLE) < 0)
+        goto error;
+    if((narrow_tid = H5Tcreate(H5T_COMPOUND, sizeof(narrow_t))) < 0)
+        goto error;
+    if(H5Tinsert(narrow_tid, "b", HOFFSET(narrow_t, b), H5T_NATIVE_FLOAT) < 0)
+        goto error;
+    if(H5Tinsert(narrow_tid, "a", HOFFSET(narrow_t, a), H5T_NATIVE_SHORT) < 0)
+        goto error;
+    if(test_conv_nthreads_1(wide_tid, narrow_tid, wide, nelmts, dxpl_id))
+        goto error;
+    if(test_conv_nthreads_1(narrow_tid, wide_tid, narrow, nelmts, dxpl_id))
+        goto error;
+
+    if(H5Tclose(wide_tid) < 0)
+        goto error;
+    wide_tid = -1;
+    if(H5Tclose(narrow_tid) < 0)
+        goto error;
+    narrow_tid = -1;
+    if(H5Pclose(dxpl_id) < 0)
+        goto error;
+    dxpl_id = -1;
+
+    HDfree(d);
+    HDfree(f);
+    HDfree(i);
+    HDfree(wide);
+    HDfree(narrow);
+
+    if(is_ts) {
+        PASSED();
+    } /* end if */
+    else {
+        SKIPPED();
+        HDputs("    Library is not thread-safe; conversions were not split.");
+    } /* end else */
+    return 0;
+
+error:
+    H5_FAILED();
+    H5E_BEGIN_TRY {
+        H5Tclose(wide_tid);
+        H5Tclose(narrow_tid);
+        H5Pclose(dxpl_id);
+    } H5E_END_TRY;
+    if(d)
+        HDfree(d);
+    if(f)
+        HDfree(f);
+    if(i)
+        HDfree(i);
+    if(wide)
+        HDfree(wide);
+    if(narrow)
+        HDfree(narrow);
+    return 1;
+}
+
+
 /*-------------------------------------------------------------------------
  * Function:    test_derived_flt
  *
@@ -5214,6 +5852,17 @@ main(void)
     /* Test a few special values for hardware float-integer conversions */
     nerrors += (unsigned long)test_particular_fp_integer();
 
+#ifdef H5_WANT_DCONV_EXCEPTION
+    /* Test overflows in hardware conversions of packed buffers */
+    nerrors += (unsigned long)test_hard_packed_overflow();
+#endif /* H5_WANT_DCONV_EXCEPTION */
+
+    /* Test hardware half-precision and bfloat16 conversions */
+    nerrors += (unsigned long)test_conv_flt16();
+
+    /* Test conversions split between threads */
+    nerrors += (unsigned long)test_conv_nthreads();
+
     /*----------------------------------------------------------------------
      * Software tests
      *----------------------------------------------------------------------
@@ -3392,6 +3392,125 @@ error:
     return 1;
 } /* end test_compound_18() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_compound_19
+ *
+ * Purpose:     Tests converting a packed compound to a reordered, aligned
+ *              compound where runs of adjacent members need no conversion
+ *              but move to new offsets, between members which are byte
+ *              swapped or grow.
+ *
+ * Return:      Success:        0
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_compound_19(void)
+{
+    typedef struct {
+        double  c;
+        int     a;
+        int     b;
+        short   d;
+        int     e;
+        int     f;
+        char    g;
+        char    h;
+    } dst_t;
+    const size_t nelmts = 100;
+    const size_t src_size = 4 + 4 + 8 + 2 + 2 + 4 + 1 + 1;
+    unsigned char *buf = NULL;          /* Conversion buffer */
+    unsigned char *bkg = NULL;          /* Background buffer */
+    dst_t       *dst_p;                 /* Converted elements */
+    hid_t       src = -1, dst = -1;     /* Datatypes */
+    H5T_order_t order;                  /* Native byte order */
+    size_t      u;
+
+    TESTING("compound element moving with members converted in between");
+
+    if((src = H5Tcreate(H5T_COMPOUND, src_size)) < 0) TEST_ERROR
+    if(H5Tinsert(src, "a", (size_t)0, H5T_NATIVE_INT) < 0) TEST_ERROR
+    if(H5Tinsert(src, "b", (size_t)4, H5T_NATIVE_INT) < 0) TEST_ERROR
+    if(H5Tinsert(src, "c", (size_t)8, H5T_IEEE_F64BE) < 0) TEST_ERROR
+    if(H5Tinsert(src, "d", (size_t)16, H5T_NATIVE_SHORT) < 0) TEST_ERROR
+    if(H5Tinsert(src, "e", (size_t)18, H5T_NATIVE_SHORT) < 0) TEST_ERROR
+    if(H5Tinsert(src, "f", (size_t)20, H5T_NATIVE_INT) < 0) TEST_ERROR
+    if(H5Tinsert(src, "g", (size_t)24, H5T_NATIVE_CHAR) < 0) TEST_ERROR
+    if(H5Tinsert(src, "h", (size_t)25, H5T_NATIVE_CHAR) < 0) TEST_ERROR
+
+    if((dst = H5Tcreate(H5T_COMPOUND, sizeof(dst_t))) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "c", HOFFSET(dst_t, c), H5T_NATIVE_DOUBLE) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "a", HOFFSET(dst_t, a), H5T_NATIVE_INT) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "b", HOFFSET(dst_t, b), H5T_NATIVE_INT) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "d", HOFFSET(dst_t, d), H5T_NATIVE_SHORT) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "e", HOFFSET(dst_t, e), H5T_NATIVE_INT) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "f", HOFFSET(dst_t, f), H5T_NATIVE_INT) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "g", HOFFSET(dst_t, g), H5T_NATIVE_CHAR) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "h", HOFFSET(dst_t, h), H5T_NATIVE_CHAR) < 0) TEST_ERROR
+
+    if(NULL == (buf = (unsigned char *)HDcalloc(nelmts, sizeof(dst_t)))) TEST_ERROR
+    if(NULL == (bkg = (unsigned char *)HDcalloc(nelmts, sizeof(dst_t)))) TEST_ERROR
+
+    /* Fill the packed source elements */
+    if(H5T_ORDER_ERROR == (order = H5Tget_order(H5T_NATIVE_DOUBLE))) TEST_ERROR
+    for(u = 0; u < nelmts; u++) {
+        unsigned char *elmt = buf + u * src_size;
+        int     a = (int)u, b = -(int)u, f = (int)u * 1000;
+        short   d = (short)(u + 1), e = (short)-(short)(u + 2);
+        double  c = (double)u + 0.5;
+        unsigned char c_be[8];
+        unsigned char *c_ne = (unsigned char *)&c;
+        size_t  v;
+
+        for(v = 0; v < 8; v++)
+            c_be[v] = H5T_ORDER_LE == order ? c_ne[7 - v] : c_ne[v];
+        HDmemcpy(elmt + 0, &a, 4);
+        HDmemcpy(elmt + 4, &b, 4);
+        HDmemcpy(elmt + 8, c_be, 8);
+        HDmemcpy(elmt + 16, &d, 2);
+        HDmemcpy(elmt + 18, &e, 2);
+        HDmemcpy(elmt + 20, &f, 4);
+        elmt[24] = (unsigned char)('a' + u % 26);
+        elmt[25] = (unsigned char)('A' + u % 26);
+    } /* end for */
+
+    if(H5Tconvert(src, dst, nelmts, buf, bkg, H5P_DEFAULT) < 0) TEST_ERROR
+
+    dst_p = (dst_t *)buf;
+    for(u = 0; u < nelmts; u++)
+        if(dst_p[u].a != (int)u || dst_p[u].b != -(int)u ||
+                !H5_DBL_ABS_EQUAL(dst_p[u].c, (double)u + 0.5) ||
+                dst_p[u].d != (short)(u + 1) || dst_p[u].e != -(int)(u + 2) ||
+                dst_p[u].f != (int)u * 1000 || dst_p[u].g != (char)('a' + u % 26) ||
+                dst_p[u].h != (char)('A' + u % 26)) {
+            H5_FAILED();
+            printf("    element %u converted incorrectly\n", (unsigned)u);
+            goto error;
+        } /* end if */
+
+    if(H5Tclose(src) < 0) TEST_ERROR
+    if(H5Tclose(dst) < 0) TEST_ERROR
+    HDfree(buf);
+    HDfree(bkg);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Tclose(src);
+        H5Tclose(dst);
+    } H5E_END_TRY;
+    if(buf)
+        HDfree(buf);
+    if(bkg)
+        HDfree(bkg);
+    return 1;
+} /* end test_compound_19() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_query
@@ -6340,6 +6459,261 @@ error:
     return 1;
 } /* end test_set_order() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_swap
+ *
+ * Purpose:     Tests conversions which only reverse the byte order, of
+ *              integers of each size with a SIMD kernel (and one without)
+ *              and of compounds whose members all need swapping.  The
+ *              buffers are misaligned and the number of elements isn't a
+ *              multiple of the SIMD width.
+ *
+ * Return:      Success:        0
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_conv_swap(void)
+{
+    const size_t    nelmts = 37;            /* Number of elements converted */
+    const size_t    sizes[] = {2, 3, 4, 8, 16};  /* Integer sizes */
+    /* Sizes and offsets of the mixed compound's members, with a string
+     * member which isn't swapped */
+    const size_t    memb_size[] = {2, 4, 8, 1};
+    const size_t    memb_offset[] = {0, 2, 6, 14};
+    const size_t    cmpd_size = 15;
+    unsigned char   *orig = NULL;           /* Original data */
+    unsigned char   *buf = NULL;            /* Conversion buffer */
+    hid_t           src = -1, dst = -1;     /* Datatypes */
+    hid_t           str = -1;               /* String member datatype */
+    size_t          u, v, w;
+
+    TESTING("byte order conversions");
+
+    if(NULL == (orig = (unsigned char *)HDmalloc(nelmts * 16 + 1)))
+        TEST_ERROR
+    if(NULL == (buf = (unsigned char *)HDmalloc(nelmts * 16 + 1)))
+        TEST_ERROR
+    for(u = 0; u < nelmts * 16 + 1; u++)
+        orig[u] = (unsigned char)(u * 7 + 3);
+
+    /* Integers */
+    for(u = 0; u < sizeof(sizes) / sizeof(sizes[0]); u++) {
+        if((src = H5Tcopy(H5T_STD_U8BE)) < 0) TEST_ERROR
+        if(H5Tset_size(src, sizes[u]) < 0) TEST_ERROR
+        if((dst = H5Tcopy(src)) < 0) TEST_ERROR
+        if(H5Tset_order(dst, H5T_ORDER_LE) < 0) TEST_ERROR
+
+        HDmemcpy(buf, orig, nelmts * sizes[u] + 1);
+        if(H5Tconvert(src, dst, nelmts, buf + 1, NULL, H5P_DEFAULT) < 0)
+            TEST_ERROR
+        for(v = 0; v < nelmts; v++)
+            for(w = 0; w < sizes[u]; w++)
+                if(buf[1 + v * sizes[u] + w] != orig[1 + v * sizes[u] + sizes[u] - (w + 1)]) {
+                    H5_FAILED();
+                    printf("    %u byte element %u, byte %u: got %u, expected %u\n",
+                            (unsigned)sizes[u], (unsigned)v, (unsigned)w,
+                            (unsigned)buf[1 + v * sizes[u] + w],
+                            (unsigned)orig[1 + v * sizes[u] + sizes[u] - (w + 1)]);
+                    goto error;
+                } /* end if */
+
+        if(H5Tclose(src) < 0) TEST_ERROR
+        if(H5Tclose(dst) < 0) TEST_ERROR
+    } /* end for */
+
+    /* A compound of 32-bit integers, swapped without a background buffer */
+    if((src = H5Tcreate(H5T_COMPOUND, (size_t)12)) < 0) TEST_ERROR
+    if(H5Tinsert(src, "a", (size_t)0, H5T_STD_U32BE) < 0) TEST_ERROR
+    if(H5Tinsert(src, "b", (size_t)4, H5T_STD_U32BE) < 0) TEST_ERROR
+    if(H5Tinsert(src, "c", (size_t)8, H5T_STD_U32BE) < 0) TEST_ERROR
+    if((dst = H5Tcreate(H5T_COMPOUND, (size_t)12)) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "a", (size_t)0, H5T_STD_U32LE) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "b", (size_t)4, H5T_STD_U32LE) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "c", (size_t)8, H5T_STD_U32LE) < 0) TEST_ERROR
+
+    HDmemcpy(buf, orig, nelmts * 12 + 1);
+    if(H5Tconvert(src, dst, nelmts, buf + 1, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR
+    for(v = 0; v < nelmts * 3; v++)
+        for(w = 0; w < 4; w++)
+            if(buf[1 + v * 4 + w] != orig[1 + v * 4 + 3 - w]) {
+                H5_FAILED();
+                printf("    compound member %u, byte %u: got %u, expected %u\n",
+                        (unsigned)v, (unsigned)w, (unsigned)buf[1 + v * 4 + w],
+                        (unsigned)orig[1 + v * 4 + 3 - w]);
+                goto error;
+            } /* end if */
+
+    if(H5Tclose(src) < 0) TEST_ERROR
+    if(H5Tclose(dst) < 0) TEST_ERROR
+
+    /* A compound of members of different sizes, swapped member by member */
+    if((str = H5Tcopy(H5T_C_S1)) < 0) TEST_ERROR
+    if(H5Tset_size(str, memb_size[1]) < 0) TEST_ERROR
+    if((src = H5Tcreate(H5T_COMPOUND, cmpd_size)) < 0) TEST_ERROR
+    if(H5Tinsert(src, "a", memb_offset[0], H5T_STD_U16BE) < 0) TEST_ERROR
+    if(H5Tinsert(src, "b", memb_offset[1], str) < 0) TEST_ERROR
+    if(H5Tinsert(src, "c", memb_offset[2], H5T_IEEE_F64BE) < 0) TEST_ERROR
+    if(H5Tinsert(src, "d", memb_offset[3], H5T_STD_I8BE) < 0) TEST_ERROR
+    if((dst = H5Tcreate(H5T_COMPOUND, cmpd_size)) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "a", memb_offset[0], H5T_STD_U16LE) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "b", memb_offset[1], str) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "c", memb_offset[2], H5T_IEEE_F64LE) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "d", memb_offset[3], H5T_STD_I8LE) < 0) TEST_ERROR
+
+    HDmemcpy(buf, orig, nelmts * cmpd_size + 1);
+    if(H5Tconvert(src, dst, nelmts, buf + 1, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR
+    for(v = 0; v < nelmts; v++)
+        for(u = 0; u < sizeof(memb_size) / sizeof(memb_size[0]); u++)
+            for(w = 0; w < memb_size[u]; w++) {
+                size_t from = 1 + v * cmpd_size + memb_offset[u] +
+                        (u == 1 ? w : memb_size[u] - (w + 1));
+
+                if(buf[1 + v * cmpd_size + memb_offset[u] + w] != orig[from]) {
+                    H5_FAILED();
+                    printf("    compound %u, member %u, byte %u: got %u, expected %u\n",
+                            (unsigned)v, (unsigned)u, (unsigned)w,
+                            (unsigned)buf[1 + v * cmpd_size + memb_offset[u] + w],
+                            (unsigned)orig[from]);
+                    goto error;
+                } /* end if */
+            } /* end for */
+
+    if(H5Tclose(src) < 0) TEST_ERROR
+    if(H5Tclose(dst) < 0) TEST_ERROR
+    if(H5Tclose(str) < 0) TEST_ERROR
+
+    HDfree(orig);
+    HDfree(buf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Tclose(src);
+        H5Tclose(dst);
+        H5Tclose(str);
+    } H5E_END_TRY;
+    if(orig)
+        HDfree(orig);
+    if(buf)
+        HDfree(buf);
+    return 1;
+} /* end test_conv_swap() */
+
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_path_cache
+ *
+ * Purpose:     Tests that the conversion paths found for pairs of
+ *              datatypes aren't reused after one of the datatypes is
+ *              changed or after the path's function is unregistered, and
+ *              that equal compounds with members inserted in a different
+ *              order share a path.
+ *
+ * Return:      Success:        0
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_conv_path_cache(void)
+{
+    hid_t       src = -1, dst = -1;     /* Datatypes */
+    hid_t       src2 = -1;              /* Source compound built in reverse */
+    H5T_conv_t  func, func2;            /* Conversion functions */
+    H5T_cdata_t *cdata;                 /* Conversion data */
+    unsigned char buf[8];               /* Conversion buffer */
+    herr_t      status;
+    int         i;
+
+    TESTING("reuse of datatype conversion paths");
+
+    /* Changing the byte order of the source type between conversions */
+    if((src = H5Tcopy(H5T_STD_U32BE)) < 0) TEST_ERROR
+    if((dst = H5Tcopy(H5T_STD_U32LE)) < 0) TEST_ERROR
+    for(i = 0; i < 3; i++) {
+        buf[0] = 1; buf[1] = 2; buf[2] = 3; buf[3] = 4;
+        if(H5Tconvert(src, dst, (size_t)1, buf, NULL, H5P_DEFAULT) < 0) TEST_ERROR
+        if(buf[0] != (i == 1 ? 1 : 4) || buf[3] != (i == 1 ? 4 : 1)) {
+            H5_FAILED();
+            printf("    conversion %d: bytes not %s\n", i, i == 1 ? "kept" : "swapped");
+            goto error;
+        } /* end if */
+        if(H5Tset_order(src, i == 0 ? H5T_ORDER_LE : H5T_ORDER_BE) < 0) TEST_ERROR
+    } /* end for */
+    if(H5Tclose(src) < 0) TEST_ERROR
+    if(H5Tclose(dst) < 0) TEST_ERROR
+
+    /* Equal compounds built in a different order */
+    if((src = H5Tcreate(H5T_COMPOUND, (size_t)6)) < 0) TEST_ERROR
+    if(H5Tinsert(src, "a", (size_t)0, H5T_STD_U32BE) < 0) TEST_ERROR
+    if(H5Tinsert(src, "b", (size_t)4, H5T_STD_U16BE) < 0) TEST_ERROR
+    if((src2 = H5Tcreate(H5T_COMPOUND, (size_t)6)) < 0) TEST_ERROR
+    if(H5Tinsert(src2, "b", (size_t)4, H5T_STD_U16BE) < 0) TEST_ERROR
+    if(H5Tinsert(src2, "a", (size_t)0, H5T_STD_U32BE) < 0) TEST_ERROR
+    if((dst = H5Tcreate(H5T_COMPOUND, (size_t)6)) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "b", (size_t)0, H5T_STD_U16LE) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "a", (size_t)2, H5T_STD_U32LE) < 0) TEST_ERROR
+    if(NULL == (func = H5Tfind(src, dst, &cdata))) TEST_ERROR
+    if(NULL == (func2 = H5Tfind(src2, dst, &cdata))) TEST_ERROR
+    if(func != func2) TEST_ERROR
+    for(i = 0; i < 2; i++) {
+        unsigned char bkg[6];
+
+        buf[0] = 1; buf[1] = 2; buf[2] = 3; buf[3] = 4; buf[4] = 5; buf[5] = 6;
+        if(H5Tconvert(i ? src2 : src, dst, (size_t)1, buf, bkg, H5P_DEFAULT) < 0) TEST_ERROR
+        if(buf[0] != 6 || buf[1] != 5 || buf[2] != 4 || buf[3] != 3 || buf[4] != 2 || buf[5] != 1) {
+            H5_FAILED();
+            printf("    compound %d converted incorrectly\n", i);
+            goto error;
+        } /* end if */
+    } /* end for */
+    if(H5Tclose(src) < 0) TEST_ERROR
+    if(H5Tclose(src2) < 0) TEST_ERROR
+    if(H5Tclose(dst) < 0) TEST_ERROR
+
+    /* A path whose function is unregistered after it's been used */
+    num_opaque_conversions_g = 0;
+    if((src = H5Tcreate(H5T_OPAQUE, (size_t)4)) < 0) TEST_ERROR
+    if(H5Tset_tag(src, "cached opaque source type") < 0) TEST_ERROR
+    if((dst = H5Tcreate(H5T_OPAQUE, (size_t)4)) < 0) TEST_ERROR
+    if(H5Tset_tag(dst, "cached opaque destination type") < 0) TEST_ERROR
+    if(H5Tregister(H5T_PERS_HARD, "cache_test", src, dst, convert_opaque) < 0) TEST_ERROR
+    if(H5Tconvert(src, dst, (size_t)1, buf, NULL, H5P_DEFAULT) < 0) TEST_ERROR
+    if(H5Tconvert(src, dst, (size_t)1, buf, NULL, H5P_DEFAULT) < 0) TEST_ERROR
+    if(2 != num_opaque_conversions_g) TEST_ERROR
+    if(H5Tunregister(H5T_PERS_HARD, "cache_test", src, dst, convert_opaque) < 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        status = H5Tconvert(src, dst, (size_t)1, buf, NULL, H5P_DEFAULT);
+    } H5E_END_TRY;
+    if(status >= 0 || 2 != num_opaque_conversions_g) {
+        H5_FAILED();
+        printf("    unregistered conversion function was still used\n");
+        goto error;
+    } /* end if */
+    if(H5Tclose(src) < 0) TEST_ERROR
+    if(H5Tclose(dst) < 0) TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Tclose(src);
+        H5Tclose(src2);
+        H5Tclose(dst);
+    } H5E_END_TRY;
+    return 1;
+} /* end test_conv_path_cache() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_set_order_compound
@@ -7466,12 +7840,15 @@ main(void)
     nerrors += test_compound_16();
     nerrors += test_compound_17();
     nerrors += test_compound_18();
+    nerrors += test_compound_19();
     nerrors += test_conv_enum_1();
     nerrors += test_conv_enum_2();
     nerrors += test_conv_bitfield();
     nerrors += test_bitfield_funcs();
     nerrors += test_opaque();
     nerrors += test_set_order();
+    nerrors += test_conv_swap();
+    nerrors += test_conv_path_cache();
     nerrors += test_utf_ascii_conv();
 
     if(nerrors) {
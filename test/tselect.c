@@ -64,6 +64,9 @@
 /* Number of random hyperslab tests performed */
 #define NRAND_HYPER 100
 
+/* Number of random blocks selected at once */
+#define NHYPERBLOCKS 1024
+
 /* 5-D dataset with fixed dimensions */
 #define SPACE5_NAME  "Space5"
 #define SPACE5_RANK	5
@@ -13226,6 +13229,209 @@ test_hyper_regular(void)
     CHECK(ret, FAIL, "H5Sclose");
 }   /* test_hyper_regular() */
 
+/****************************************************************
+**
+**  test_select_hyper_blocks_mark(): Iterator callback to count
+**      the times each element of a buffer is selected.
+**
+****************************************************************/
+static herr_t
+test_select_hyper_blocks_mark(void *_elem, hid_t H5_ATTR_UNUSED type_id, unsigned H5_ATTR_UNUSED ndim, const hsize_t H5_ATTR_UNUSED *point, void H5_ATTR_UNUSED *_operator_data)
+{
+    uint8_t *elem = (uint8_t *)_elem;   /* Element to mark */
+
+    (*elem)++;
+
+    return(0);
+}   /* end test_select_hyper_blocks_mark() */
+
+/****************************************************************
+**
+**  test_select_hyper_blocks_check(): Check that a selection
+**      picks each element of a SPACE4 dataspace as many times
+**      as expected.
+**
+****************************************************************/
+static void
+test_select_hyper_blocks_check(hid_t sid, const uint8_t *expected)
+{
+    uint8_t    *mark;           /* Times each element is selected */
+    hssize_t    npoints;        /* # of elements in the selection */
+    hssize_t    enpoints = 0;   /* Expected # of elements */
+    size_t      u;              /* Local index variable */
+    herr_t      ret;            /* Generic return value */
+
+    for(u = 0; u < (SPACE4_DIM1 * SPACE4_DIM2 * SPACE4_DIM3); u++)
+        enpoints += expected[u];
+    npoints = H5Sget_select_npoints(sid);
+    VERIFY(npoints, enpoints, "H5Sget_select_npoints");
+
+    mark = (uint8_t *)HDcalloc(sizeof(uint8_t), SPACE4_DIM1 * SPACE4_DIM2 * SPACE4_DIM3);
+    CHECK(mark, NULL, "HDcalloc");
+
+    ret = H5Diterate(mark, H5T_NATIVE_UCHAR, sid, test_select_hyper_blocks_mark, NULL);
+    CHECK(ret, FAIL, "H5Diterate");
+
+    if(HDmemcmp(mark, expected, SPACE4_DIM1 * SPACE4_DIM2 * SPACE4_DIM3))
+        TestErrPrintf("Selection of blocks doesn't match!\n");
+
+    HDfree(mark);
+}   /* end test_select_hyper_blocks_check() */
+
+/****************************************************************
+**
+**  test_select_hyper_blocks(): Test selecting many hyperslab
+**      blocks with one call.
+**
+****************************************************************/
+static void
+test_select_hyper_blocks(void)
+{
+    hid_t       sid1, sid2;     /* Dataspace IDs */
+    hsize_t     dims[SPACE4_RANK] = {SPACE4_DIM1, SPACE4_DIM2, SPACE4_DIM3};
+    hsize_t     start[NHYPERBLOCKS * SPACE4_RANK];  /* Starts of the blocks */
+    hsize_t     count[NHYPERBLOCKS * SPACE4_RANK];  /* Sizes of the blocks */
+    hsize_t     all_start[SPACE4_RANK] = {0, 0, 0}; /* Start of the whole dataspace */
+    H5S_seloper_t ops[] = {H5S_SELECT_OR, H5S_SELECT_AND, H5S_SELECT_XOR,
+        H5S_SELECT_NOTB, H5S_SELECT_NOTA};  /* Operations to combine with */
+    uint8_t    *mark_a, *mark_b, *expected; /* Elements selected */
+    size_t      nelmts = SPACE4_DIM1 * SPACE4_DIM2 * SPACE4_DIM3;  /* # of elements in dataspace */
+    size_t      half = NHYPERBLOCKS / 2;    /* # of blocks in first half */
+    size_t      nblocks;        /* # of blocks to select */
+    size_t      u, v;           /* Local index variables */
+    unsigned    w;              /* Local index variable */
+    htri_t      check;          /* Regular hyperslab check return value */
+    herr_t      ret;            /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(6, ("Testing Selecting Many Hyperslab Blocks\n"));
+
+    /* Generate random blocks, some empty and many overlapping */
+    HDsrandom((unsigned)NHYPERBLOCKS);
+    for(u = 0; u < NHYPERBLOCKS; u++)
+        for(w = 0; w < SPACE4_RANK; w++) {
+            start[(u * SPACE4_RANK) + w] = (hsize_t)HDrandom() % dims[w];
+            count[(u * SPACE4_RANK) + w] = (hsize_t)HDrandom() % (dims[w] - start[(u * SPACE4_RANK) + w] + 1);
+        } /* end for */
+
+    mark_a = (uint8_t *)HDcalloc(sizeof(uint8_t), nelmts);
+    CHECK(mark_a, NULL, "HDcalloc");
+    mark_b = (uint8_t *)HDcalloc(sizeof(uint8_t), nelmts);
+    CHECK(mark_b, NULL, "HDcalloc");
+    expected = (uint8_t *)HDcalloc(sizeof(uint8_t), nelmts);
+    CHECK(expected, NULL, "HDcalloc");
+
+    sid1 = H5Screate_simple(SPACE4_RANK, dims, NULL);
+    CHECK(sid1, FAIL, "H5Screate_simple");
+    sid2 = H5Screate_simple(SPACE4_RANK, dims, NULL);
+    CHECK(sid2, FAIL, "H5Screate_simple");
+
+    /* Compare with selecting the blocks one at a time, for a few numbers
+     * of blocks */
+    for(nblocks = 1; nblocks <= NHYPERBLOCKS; nblocks *= 4) {
+        ret = H5Sselect_none(sid1);
+        CHECK(ret, FAIL, "H5Sselect_none");
+        for(u = 0; u < nblocks; u++) {
+            ret = H5Sselect_hyperslab(sid1, H5S_SELECT_OR, &start[u * SPACE4_RANK], NULL, &count[u * SPACE4_RANK], NULL);
+            CHECK(ret, FAIL, "H5Sselect_hyperslab");
+        } /* end for */
+        HDmemset(expected, 0, nelmts);
+        ret = H5Diterate(expected, H5T_NATIVE_UCHAR, sid1, test_select_hyper_blocks_mark, NULL);
+        CHECK(ret, FAIL, "H5Diterate");
+
+        ret = H5Sselect_hyperslab_blocks(sid2, H5S_SELECT_SET, nblocks, start, count);
+        CHECK(ret, FAIL, "H5Sselect_hyperslab_blocks");
+        test_select_hyper_blocks_check(sid2, expected);
+    } /* end for */
+
+    /* Mark the union of each half of the blocks, selected one at a time */
+    ret = H5Sselect_none(sid1);
+    CHECK(ret, FAIL, "H5Sselect_none");
+    for(u = 0; u < half; u++) {
+        ret = H5Sselect_hyperslab(sid1, H5S_SELECT_OR, &start[u * SPACE4_RANK], NULL, &count[u * SPACE4_RANK], NULL);
+        CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    } /* end for */
+    ret = H5Diterate(mark_a, H5T_NATIVE_UCHAR, sid1, test_select_hyper_blocks_mark, NULL);
+    CHECK(ret, FAIL, "H5Diterate");
+    ret = H5Sselect_none(sid1);
+    CHECK(ret, FAIL, "H5Sselect_none");
+    for(u = half; u < NHYPERBLOCKS; u++) {
+        ret = H5Sselect_hyperslab(sid1, H5S_SELECT_OR, &start[u * SPACE4_RANK], NULL, &count[u * SPACE4_RANK], NULL);
+        CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    } /* end for */
+    ret = H5Diterate(mark_b, H5T_NATIVE_UCHAR, sid1, test_select_hyper_blocks_mark, NULL);
+    CHECK(ret, FAIL, "H5Diterate");
+
+    /* Combine the second half of the blocks with a selection of the first
+     * half, using each operation */
+    for(v = 0; v < (sizeof(ops) / sizeof(ops[0])); v++) {
+        ret = H5Sselect_hyperslab_blocks(sid2, H5S_SELECT_SET, half, start, count);
+        CHECK(ret, FAIL, "H5Sselect_hyperslab_blocks");
+        ret = H5Sselect_hyperslab_blocks(sid2, ops[v], NHYPERBLOCKS - half, &start[half * SPACE4_RANK], &count[half * SPACE4_RANK]);
+        CHECK(ret, FAIL, "H5Sselect_hyperslab_blocks");
+
+        for(u = 0; u < nelmts; u++)
+            switch(ops[v]) {
+                case H5S_SELECT_OR:
+                    expected[u] = (uint8_t)(mark_a[u] | mark_b[u]);
+                    break;
+                case H5S_SELECT_AND:
+                    expected[u] = (uint8_t)(mark_a[u] & mark_b[u]);
+                    break;
+                case H5S_SELECT_XOR:
+                    expected[u] = (uint8_t)(mark_a[u] ^ mark_b[u]);
+                    break;
+                case H5S_SELECT_NOTB:
+                    expected[u] = (uint8_t)(mark_a[u] & !mark_b[u]);
+                    break;
+                case H5S_SELECT_NOTA:
+                default:
+                    expected[u] = (uint8_t)(!mark_a[u] & mark_b[u]);
+                    break;
+            } /* end switch */
+        test_select_hyper_blocks_check(sid2, expected);
+    } /* end for */
+
+    /* A block covering the whole dataspace selects it all */
+    ret = H5Sselect_hyperslab_blocks(sid2, H5S_SELECT_SET, (size_t)1, all_start, dims);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab_blocks");
+    VERIFY(H5Sget_select_npoints(sid2), (hssize_t)nelmts, "H5Sget_select_npoints");
+    check = H5Sis_regular_hyperslab(sid2);
+    VERIFY(check, TRUE, "H5Sis_regular_hyperslab");
+    ret = H5Sselect_all(sid1);
+    CHECK(ret, FAIL, "H5Sselect_all");
+
+    /* "XOR" with an "all" selection selects the rest of the dataspace */
+    ret = H5Sselect_hyperslab_blocks(sid1, H5S_SELECT_XOR, half, start, count);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab_blocks");
+    for(u = 0; u < nelmts; u++)
+        expected[u] = (uint8_t)!mark_a[u];
+    test_select_hyper_blocks_check(sid1, expected);
+
+    /* Selecting no blocks */
+    ret = H5Sselect_hyperslab_blocks(sid1, H5S_SELECT_OR, (size_t)0, NULL, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab_blocks");
+    test_select_hyper_blocks_check(sid1, expected);
+    ret = H5Sselect_hyperslab_blocks(sid1, H5S_SELECT_SET, (size_t)0, NULL, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab_blocks");
+    VERIFY(H5Sget_select_type(sid1), H5S_SEL_NONE, "H5Sget_select_type");
+
+    /* Missing blocks are an error */
+    H5E_BEGIN_TRY {
+        ret = H5Sselect_hyperslab_blocks(sid1, H5S_SELECT_SET, (size_t)1, NULL, count);
+    } H5E_END_TRY;
+    VERIFY(ret, FAIL, "H5Sselect_hyperslab_blocks");
+
+    ret = H5Sclose(sid1);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Sclose(sid2);
+    CHECK(ret, FAIL, "H5Sclose");
+
+    HDfree(mark_a);
+    HDfree(mark_b);
+    HDfree(expected);
+}   /* test_select_hyper_blocks() */
+
 /****************************************************************
 **
 **  test_hyper_unlim(): Tests unlimited hyperslab selections
@@ -13826,6 +14032,9 @@ test_select(void)
     /* Test unlimited hyperslab selections */
     test_hyper_unlim();
 
+    /* Test selecting many hyperslab blocks at once */
+    test_select_hyper_blocks();
+
 }   /* test_select() */
 
 
@@ -1155,6 +1155,237 @@ test_vltypes_compound_vlen_vlen(void)
     HDfree(rdata);
 } /* end test_vltypes_compound_vlen_vlen() */
 
+/****************************************************************
+**
+**  test_vltypes_vlen_arena(): Test reading VL data into an arena
+**      set on the dataset transfer property list.
+**
+****************************************************************/
+static void
+test_vltypes_vlen_arena(void)
+{
+    typedef struct {                    /* Struct that the compound type are composed of */
+        int i;
+        hvl_t v;
+        char *s;
+    } s1;
+    s1          *wdata;                 /* data to write */
+    s1          *rdata;                 /* data to read */
+    s1          *rdata2;                /* data read through a copy of the DXPL */
+    char        str[64];                /* Temporary string buffer */
+    hid_t	fid1;		        /* HDF5 File IDs		*/
+    hid_t	dataset;	        /* Dataset ID			*/
+    hid_t	sid1;                   /* Dataspace ID			*/
+    hid_t	tid1, tid2, tid3;       /* Datatype IDs         */
+    hid_t       xfer_pid, xfer_pid2;    /* Dataset transfer property list IDs */
+    hsize_t	dims1[] = {SPACE3_DIM1};
+    size_t      block_size;             /* Arena block size */
+    size_t      nblocks;                /* Number of arena blocks */
+    size_t      nbytes;                 /* Bytes of VL data in the arena */
+    size_t      payload = 0;            /* Bytes of VL data read */
+    unsigned    i, j;                   /* counting variables */
+    herr_t	ret;		        /* Generic return value		*/
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing VL Data Arena Functionality\n"));
+
+    /* Allocate and initialize VL data to write */
+    wdata = (s1 *)HDmalloc(sizeof(s1) * SPACE3_DIM1);
+    CHECK(wdata, NULL, "HDmalloc");
+    rdata = (s1 *)HDmalloc(sizeof(s1) * SPACE3_DIM1);
+    CHECK(rdata, NULL, "HDmalloc");
+    rdata2 = (s1 *)HDmalloc(sizeof(s1) * SPACE3_DIM1);
+    CHECK(rdata2, NULL, "HDmalloc");
+    for(i = 0; i < SPACE3_DIM1; i++) {
+        wdata[i].i = (int)(i * 10);
+        wdata[i].v.p = HDmalloc((i + L1_INCM) * sizeof(unsigned int));
+        wdata[i].v.len = i + L1_INCM;
+        for(j = 0; j < (i + L1_INCM); j++)
+            ((unsigned int *)wdata[i].v.p)[j] = i * 10 + j;
+        HDsnprintf(str, sizeof(str), "string %u", i * 1000);
+        wdata[i].s = HDstrdup(str);
+        payload += (i + L1_INCM) * sizeof(unsigned int) + HDstrlen(str) + 1;
+    } /* end for */
+
+    /* Create file */
+    fid1 = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fcreate");
+
+    /* Create dataspace for datasets */
+    sid1 = H5Screate_simple(SPACE3_RANK, dims1, NULL);
+    CHECK(sid1, FAIL, "H5Screate_simple");
+
+    /* Create a VL datatype to refer to */
+    tid1 = H5Tvlen_create(H5T_NATIVE_UINT);
+    CHECK(tid1, FAIL, "H5Tvlen_create");
+
+    /* Create a VL string datatype */
+    tid3 = H5Tcopy(H5T_C_S1);
+    CHECK(tid3, FAIL, "H5Tcopy");
+    ret = H5Tset_size(tid3, H5T_VARIABLE);
+    CHECK(ret, FAIL, "H5Tset_size");
+
+    /* Create the base compound type */
+    tid2 = H5Tcreate(H5T_COMPOUND, sizeof(s1));
+    CHECK(tid2, FAIL, "H5Tcreate");
+
+    /* Insert fields */
+    ret = H5Tinsert(tid2, "i", HOFFSET(s1, i), H5T_NATIVE_INT);
+    CHECK(ret, FAIL, "H5Tinsert");
+    ret = H5Tinsert(tid2, "v", HOFFSET(s1, v), tid1);
+    CHECK(ret, FAIL, "H5Tinsert");
+    ret = H5Tinsert(tid2, "s", HOFFSET(s1, s), tid3);
+    CHECK(ret, FAIL, "H5Tinsert");
+
+    /* Create a dataset */
+    dataset = H5Dcreate2(fid1, "Dataset_arena", tid2, sid1, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dcreate2");
+
+    /* Write dataset to disk */
+    ret = H5Dwrite(dataset, tid2, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata);
+    CHECK(ret, FAIL, "H5Dwrite");
+
+    /* Set up an arena on a dataset transfer property list */
+    xfer_pid = H5Pcreate(H5P_DATASET_XFER);
+    CHECK(xfer_pid, FAIL, "H5Pcreate");
+
+    ret = H5Pget_vlen_arena(xfer_pid, &block_size, &nblocks, &nbytes);
+    CHECK(ret, FAIL, "H5Pget_vlen_arena");
+    VERIFY(block_size, 0, "H5Pget_vlen_arena");
+
+    ret = H5Pset_vlen_arena(xfer_pid, (size_t)1024);
+    CHECK(ret, FAIL, "H5Pset_vlen_arena");
+
+    ret = H5Pget_vlen_arena(xfer_pid, &block_size, &nblocks, &nbytes);
+    CHECK(ret, FAIL, "H5Pget_vlen_arena");
+    VERIFY(block_size, 1024, "H5Pget_vlen_arena");
+    VERIFY(nblocks, 0, "H5Pget_vlen_arena");
+    VERIFY(nbytes, 0, "H5Pget_vlen_arena");
+
+    /* Read dataset into the arena */
+    ret = H5Dread(dataset, tid2, H5S_ALL, H5S_ALL, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+
+    /* All the VL data should be in a few blocks */
+    ret = H5Pget_vlen_arena(xfer_pid, &block_size, &nblocks, &nbytes);
+    CHECK(ret, FAIL, "H5Pget_vlen_arena");
+    if(nbytes < payload)
+        TestErrPrintf("%d: arena holds %u bytes, expected at least %u\n", __LINE__, (unsigned)nbytes, (unsigned)payload);
+    if(nblocks == 0 || nblocks >= SPACE3_DIM1)
+        TestErrPrintf("%d: arena has %u blocks for %u bytes\n", __LINE__, (unsigned)nblocks, (unsigned)nbytes);
+
+    /* Reclaiming the VL data with the arena set must leave it alone */
+    ret = H5Dvlen_reclaim(tid2, sid1, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dvlen_reclaim");
+
+    /* Read the dataset again through a copy of the property list */
+    xfer_pid2 = H5Pcopy(xfer_pid);
+    CHECK(xfer_pid2, FAIL, "H5Pcopy");
+    ret = H5Dread(dataset, tid2, H5S_ALL, H5S_ALL, xfer_pid2, rdata2);
+    CHECK(ret, FAIL, "H5Dread");
+    ret = H5Pclose(xfer_pid2);
+    CHECK(ret, FAIL, "H5Pclose");
+
+    /* The copy shares the arena */
+    ret = H5Pget_vlen_arena(xfer_pid, NULL, NULL, &nbytes);
+    CHECK(ret, FAIL, "H5Pget_vlen_arena");
+    if(nbytes < 2 * payload)
+        TestErrPrintf("%d: arena holds %u bytes, expected at least %u\n", __LINE__, (unsigned)nbytes, (unsigned)(2 * payload));
+
+    /* Compare data read in */
+    for(i = 0; i < SPACE3_DIM1; i++) {
+        if(wdata[i].i != rdata[i].i || wdata[i].i != rdata2[i].i) {
+            TestErrPrintf("Integer components don't match!, wdata[%d].i=%d, rdata[%d].i=%d\n", (int)i, (int)wdata[i].i, (int)i, (int)rdata[i].i);
+            continue;
+        } /* end if */
+        if(wdata[i].v.len != rdata[i].v.len || wdata[i].v.len != rdata2[i].v.len) {
+            TestErrPrintf("%d: VL data length don't match!, wdata[%d].v.len=%d, rdata[%d].v.len=%d\n", __LINE__, (int)i, (int)wdata[i].v.len, (int)i, (int)rdata[i].v.len);
+            continue;
+        } /* end if */
+        if(HDmemcmp(wdata[i].v.p, rdata[i].v.p, wdata[i].v.len * sizeof(unsigned int)) ||
+                HDmemcmp(wdata[i].v.p, rdata2[i].v.p, wdata[i].v.len * sizeof(unsigned int)))
+            TestErrPrintf("%d: VL data values don't match!, i=%d\n", __LINE__, (int)i);
+        if(HDstrcmp(wdata[i].s, rdata[i].s) || HDstrcmp(wdata[i].s, rdata2[i].s))
+            TestErrPrintf("%d: VL strings don't match!, wdata[%d].s=%s, rdata[%d].s=%s\n", __LINE__, (int)i, wdata[i].s, (int)i, rdata[i].s);
+    } /* end for */
+
+    /* Release all the VL data in one call */
+    ret = H5Pfree_vlen_arena(xfer_pid);
+    CHECK(ret, FAIL, "H5Pfree_vlen_arena");
+    ret = H5Pget_vlen_arena(xfer_pid, &block_size, &nblocks, &nbytes);
+    CHECK(ret, FAIL, "H5Pget_vlen_arena");
+    VERIFY(block_size, 1024, "H5Pget_vlen_arena");
+    VERIFY(nblocks, 0, "H5Pget_vlen_arena");
+    VERIFY(nbytes, 0, "H5Pget_vlen_arena");
+
+    /* Blocks smaller than the VL data: each sequence gets a block of its own */
+    ret = H5Pset_vlen_arena(xfer_pid, (size_t)16);
+    CHECK(ret, FAIL, "H5Pset_vlen_arena");
+    ret = H5Dread(dataset, tid2, H5S_ALL, H5S_ALL, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+    ret = H5Pget_vlen_arena(xfer_pid, NULL, &nblocks, &nbytes);
+    CHECK(ret, FAIL, "H5Pget_vlen_arena");
+    if(nblocks < SPACE3_DIM1 || nbytes < payload)
+        TestErrPrintf("%d: arena has %u blocks for %u bytes\n", __LINE__, (unsigned)nblocks, (unsigned)nbytes);
+    for(i = 0; i < SPACE3_DIM1; i++)
+        if(wdata[i].v.len != rdata[i].v.len || HDmemcmp(wdata[i].v.p, rdata[i].v.p, wdata[i].v.len * sizeof(unsigned int)) ||
+                HDstrcmp(wdata[i].s, rdata[i].s))
+            TestErrPrintf("%d: VL data don't match!, i=%d\n", __LINE__, (int)i);
+
+    /* Removing the arena frees its data and goes back to the VL memory manager */
+    ret = H5Pset_vlen_arena(xfer_pid, (size_t)0);
+    CHECK(ret, FAIL, "H5Pset_vlen_arena");
+    ret = H5Pget_vlen_arena(xfer_pid, &block_size, &nblocks, &nbytes);
+    CHECK(ret, FAIL, "H5Pget_vlen_arena");
+    VERIFY(block_size, 0, "H5Pget_vlen_arena");
+    H5E_BEGIN_TRY {
+        ret = H5Pfree_vlen_arena(xfer_pid);
+    } H5E_END_TRY;
+    VERIFY(ret, FAIL, "H5Pfree_vlen_arena");
+
+    ret = H5Dread(dataset, tid2, H5S_ALL, H5S_ALL, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+    ret = H5Dvlen_reclaim(tid2, sid1, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dvlen_reclaim");
+
+    /* Closing a property list frees the data left in its arena */
+    ret = H5Pset_vlen_arena(xfer_pid, (size_t)1024);
+    CHECK(ret, FAIL, "H5Pset_vlen_arena");
+    ret = H5Dread(dataset, tid2, H5S_ALL, H5S_ALL, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+    ret = H5Pclose(xfer_pid);
+    CHECK(ret, FAIL, "H5Pclose");
+
+    /* Reclaim the write VL data */
+    ret = H5Dvlen_reclaim(tid2, sid1, H5P_DEFAULT, wdata);
+    CHECK(ret, FAIL, "H5Dvlen_reclaim");
+
+    /* Close Dataset */
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+
+    /* Close disk dataspace */
+    ret = H5Sclose(sid1);
+    CHECK(ret, FAIL, "H5Sclose");
+
+    /* Close datatypes */
+    ret = H5Tclose(tid2);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(tid1);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(tid3);
+    CHECK(ret, FAIL, "H5Tclose");
+
+    /* Close file */
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    /* Release buffers */
+    HDfree(wdata);
+    HDfree(rdata);
+    HDfree(rdata2);
+} /* end test_vltypes_vlen_arena() */
+
 /****************************************************************
 **
 **  test_vltypes_compound_vlstr(): Test VL datatype code.
@@ -3184,6 +3415,7 @@ test_vltypes(void)
     rewrite_shorter_vltypes_vlen_vlen_atomic();  /*overwrite with VL data of shorted sequence*/
     test_vltypes_compound_vlen_vlen();/* Test compound datatypes with VL atomic components */
     test_vltypes_compound_vlstr();    /* Test data rewritten of nested VL data */
+    test_vltypes_vlen_arena();        /* Test reading VL data into an arena */
     test_vltypes_fill_value();        /* Test fill value for VL data */
 }   /* test_vltypes() */
 